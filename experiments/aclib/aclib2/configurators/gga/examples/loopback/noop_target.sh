@@ -0,0 +1,5 @@
+#!/bin/sh
+
+# Target algorithm of the loopback benchmark: reports a solved run at once.
+
+echo "Result for GGA: SAT, 0.01, 0, 0, $2"
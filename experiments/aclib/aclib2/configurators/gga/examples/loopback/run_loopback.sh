@@ -0,0 +1,32 @@
+#!/bin/sh
+
+# Load generator for distributed GGA: runs a master and <workers> workers over
+# the loopback interface with a target algorithm that does no work, so the
+# wall time is spent in the master, the workers and the protocol.
+#
+# Usage: run_loopback.sh <dgga> [workers] [population] [generations]
+
+if [ $# -lt 1 ]; then
+    echo "Usage: $0 <dgga> [workers] [population] [generations]" >&2
+    exit 1
+fi
+
+DGGA=$(readlink -f "$1")
+WORKERS=${2:-32}
+POPULATION=${3:-512}
+GENERATIONS=${4:-10}
+PORT=${PORT:-6900}
+
+cd "$(dirname "$0")"
+
+START=$(date +%s.%N)
+"$DGGA" loopback.xml instances.txt -p "$POPULATION" -g "$GENERATIONS" \
+    --gf 2 --is 4 --ie 8 -t 4 --tacl 5 --pe 10 -v 0 \
+    --master --nodes "$WORKERS" --port "$PORT" \
+    --start-worker-wrapper ./start_worker.sh
+STATUS=$?
+END=$(date +%s.%N)
+
+awk -v s="$START" -v e="$END" -v w="$WORKERS" \
+    'BEGIN { printf "%d workers: %.2f s wall time\n", w, e - s }'
+exit $STATUS
@@ -0,0 +1,9 @@
+#!/bin/sh
+
+# Worker start wrapper of the loopback benchmark (--start-worker-wrapper).
+# DGGA calls it as: start_worker.sh <cores> <dgga> --worker --port <p> --ip <ips>
+# Instead of submitting a job to a queue system the worker is started on this
+# host, in the background since the master waits for the wrapper to return.
+
+shift
+"$@" > /dev/null 2>&1 &
@@ -0,0 +1,123 @@
+//
+// This file is part of DGGA.
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Kevin Tierney and Josep Pon Farreny
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#ifndef _GGA_EVALUATION_CACHE_HPP_
+#define _GGA_EVALUATION_CACHE_HPP_
+
+#include <map>
+#include <string>
+
+#include <sys/types.h>
+
+#include <boost/thread/mutex.hpp>
+
+#include "ggatypedefs.hpp"
+#include "GGAInstance.hpp"
+#include "GGAParameterTree.hpp"
+
+
+// ===== GGAEvaluationCache =====
+
+/**
+ * @brief Results of target algorithm runs, kept on disk across generations
+ * and restarts.
+ *
+ * An evaluation is identified by the target algorithm (a hash of the command
+ * template and of the files it names, e.g. the binary), the active parameters
+ * of a genome (the ones which end up in the command line), the instance, its
+ * extra fields and the seed. The file given with --cache_file is only ever appended to, one line
+ * per run, and is indexed in memory when it is opened. Before looking up a
+ * missing evaluation the lines appended by other processes (e.g. DGGA workers
+ * sharing the file) are read in.
+ *
+ * Runs which hit the cutoff (or crashed) are stored as censored together with
+ * the cutoff they were run with, so they are only reused as long as the cutoff
+ * does not grow.
+ */
+class GGAEvaluationCache
+{
+public:
+    struct Entry {
+        Entry();
+        Entry(double value, bool censored, double cutoff);
+
+        double value;   // runtime or objective value of the run
+        bool censored;  // value is a lower bound: timed out or crashed
+        double cutoff;  // cpu limit the target algorithm was run with
+    };
+
+    static GGAEvaluationCache& instance();
+    static void deleteInstance();
+
+    virtual ~GGAEvaluationCache();
+
+    std::string makeKey(const GGAParameterTree& ptree, const GenomeMap& genome,
+                        const GGAInstance& inst);
+
+    bool enabled() const;
+
+    bool lookup(const std::string& key, double cutoff, bool runtimeTuning,
+                Entry& entry);
+    void store(const std::string& key, const Entry& entry);
+
+    size_t hits() const;
+
+private:
+    GGAEvaluationCache(const std::string& path);
+    GGAEvaluationCache(const GGAEvaluationCache&);            // Intentionally unimplemented
+    GGAEvaluationCache& operator=(const GGAEvaluationCache&); // Intentionally unimplemented
+
+    std::string targetId(const GGACommand& cmd);
+    void readAppended();
+    bool parseLine(const std::string& line);
+
+    static GGAEvaluationCache* s_pInstance;
+
+    typedef std::map<std::string, Entry> EntryMap;
+
+    std::string m_path;
+    int m_fd;
+    off_t m_offset;         // file position up to which lines are indexed
+    EntryMap m_entries;
+    StringMap m_targetIds;  // target identifier of each command template
+    size_t m_hits;
+    mutable boost::mutex m_mutex;
+};
+
+//==============================================================================
+// GGAEvaluationCache public in-line methods
+
+inline bool GGAEvaluationCache::enabled() const
+{ return m_fd >= 0; }
+
+inline size_t GGAEvaluationCache::hits() const
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+    return m_hits;
+}
+
+#endif // _GGA_EVALUATION_CACHE_HPP_
@@ -26,12 +26,14 @@
 #ifndef _GGA_GENOME_HPP_
 #define _GGA_GENOME_HPP_
 
+#include <cstddef>
 #include <limits>
 #include <vector>
 
 #include <boost/serialization/serialization.hpp>
 #include <boost/serialization/map.hpp>
 #include <boost/serialization/nvp.hpp>
+#include <boost/serialization/vector.hpp>
 
 #include "ggatypedefs.hpp"
 #include "GGAValue.hpp"
@@ -43,6 +45,11 @@
 // === GGAGenome ===
 // =================
 
+/*
+ * The configuration of a genome is a vector with the value of each parameter
+ * at the position of its id in the parameter tree. Genomes are only
+ * meaningful together with the tree they were built from.
+ */
 class GGAGenome 
 {
 public:
@@ -55,7 +62,8 @@ public:
     GGAGenome();
     GGAGenome(const GGAGenome&);
     GGAGenome(const GGAParameterTree& paramTree);
-    GGAGenome(const GGAParameterTree& paramTree, GenomeMap genome);
+    GGAGenome(const GGAParameterTree& paramTree, const GenomeMap& genome);
+    GGAGenome(const GGAParameterTree& paramTree, const ValueVector& values);
     virtual ~GGAGenome();
 
     void mutate(const GGAParameterTree&);
@@ -66,9 +74,11 @@ public:
     bool isFeasible(const GGAParameterTree&) const;
     void makeFeasible(const GGAParameterTree&);
 
-    const GenomeMap& genome() const;
-    void setGenome(GenomeMap& genome);
-    void setGenomeValue(std::string pname, GGAValue* val);
+    GenomeMap genome(const GGAParameterTree&) const;
+
+    const ValueVector& values() const;
+    const GGAValue& value(size_t id) const;
+    void setValues(const ValueVector& values);
 
     int age() const;
     void age(int age);
@@ -96,14 +106,16 @@ private:
 
     Gender randGender();
     void mutateParameter(GGAValue& val, GGAParameter::pointer param);
-    bool forbiddenSetViolated(const GenomeMap& settings) const;
+    bool forbiddenSetViolated(const FlatSetting& setting) const;
+    void rehash();
 
     // Serialization
     friend class boost::serialization::access;
     template <class Archiver> void serialize(Archiver&, const unsigned int);
 
     // A genome is identifiable by its configuration, age and gender
-    GenomeMap m_genome;
+    ValueVector m_values;
+    std::size_t m_hash; // of m_values
     int m_age;
     Gender m_gender;
 
@@ -134,14 +146,23 @@ GGAGenome crossover(const GGAParameterTree& ptree, const GGAGenome& gen1,
 /**
  *
  */
-inline const GenomeMap& GGAGenome::genome() const 
-{ return m_genome; }
+inline const ValueVector& GGAGenome::values() const
+{ return m_values; }
 
 /**
  *
  */
-inline void GGAGenome::setGenome(GenomeMap& genome) 
-{ m_genome = genome; }
+inline const GGAValue& GGAGenome::value(size_t id) const
+{ return m_values[id]; }
+
+/**
+ *
+ */
+inline void GGAGenome::setValues(const ValueVector& values)
+{ 
+    m_values = values; 
+    rehash();
+}
 
 /**
  *
@@ -220,7 +241,8 @@ inline void GGAGenome::setPerformance(const GGAInstance& inst, double perf)
  */
 inline GGAGenome& GGAGenome::operator=(const GGAGenome& other)
 {
-    m_genome = other.m_genome;
+    m_values = other.m_values;
+    m_hash = other.m_hash;
     m_age = other.m_age;
     m_gender = other.m_gender;
 
@@ -236,7 +258,10 @@ inline GGAGenome& GGAGenome::operator=(const GGAGenome& other)
  *
  */
 inline bool GGAGenome::operator==(const GGAGenome& o) const
-{ return m_genome == o.m_genome && m_age == o.m_age && m_gender == o.m_gender; }
+{ 
+    return m_hash == o.m_hash && m_age == o.m_age && m_gender == o.m_gender 
+            && m_values == o.m_values; 
+}
 
 
 //==============================================================================
@@ -245,12 +270,15 @@ inline bool GGAGenome::operator==(const GGAGenome& o) const
 template <class Archiver>
 void GGAGenome::serialize(Archiver& ar, const unsigned int version)
 {
-    ar & BOOST_SERIALIZATION_NVP(m_genome);
+    ar & BOOST_SERIALIZATION_NVP(m_values);
     ar & BOOST_SERIALIZATION_NVP(m_performance);
     ar & BOOST_SERIALIZATION_NVP(m_age);
     ar & BOOST_SERIALIZATION_NVP(m_gender);
     ar & BOOST_SERIALIZATION_NVP(m_highlander);
     ar & BOOST_SERIALIZATION_NVP(m_objValue);
+
+    if (Archiver::is_loading::value)
+        rehash();
 }
 
 #endif
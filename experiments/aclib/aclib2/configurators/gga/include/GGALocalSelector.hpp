@@ -26,8 +26,10 @@
 #define _GGA_LOCAL_SELECTOR_HPP_
 
 #include <limits>
+#include <map>
+#include <utility>
 
-#include <boost/interprocess/sync/named_semaphore.hpp>
+#include <boost/function.hpp>
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
 
@@ -36,27 +38,66 @@
 #include "GGASelector.hpp"
 #include "GGAGenome.hpp"
 #include "GGARunner.hpp"
+#include "GGARunnerLoop.hpp"
 
 
 class GGALocalSelector : public GGASelector {
 public:
+    /** Called with (tournament, participant, runner) as each runner finishes. */
+    typedef boost::function<void (size_t, size_t, const GGARunner&)>
+            RunnerFinishedHandler;
+
     GGALocalSelector();
     virtual ~GGALocalSelector();
 
     void forceStop();
     void resetTimeout(double new_timeout);
 
+    void setRunnerFinishedHandler(RunnerFinishedHandler handler);
+
     virtual GGASelectorResult select(const GGAGenomeVector& participants, 
                                      const GGAInstanceVector& instances,
                                      double timout = std::numeric_limits<double>::max());
+
+    GGASelectorResult selectTournaments(
+            const std::vector<GGAGenomeVector>& tournaments,
+            const GGAInstanceVector& instances,
+            double timeout = std::numeric_limits<double>::max());
 private:
     // Intentionally unimplemented
     GGALocalSelector(const GGALocalSelector&);
     GGALocalSelector& operator=(const GGASelector&);
 
-    void initializeTournament(const GGAGenomeVector& participants,
+    /**
+     * @brief State of one tournament of the generation being selected.
+     *
+     * Tournaments overlap: the runners of a tournament are started as soon as
+     * a thread is free, even if the previous tournaments have not finished.
+     */
+    struct Tournament {
+        Tournament();
+
+        GGAGenomeVector participants;
+        RunnerVector runners;
+        size_t num_started;
+        size_t num_finished;
+        double best_time;
+    };
+    typedef std::vector<Tournament> TournamentVector;
+
+    // Position (tournament, participant) of each runner of the generation
+    typedef std::map<const GGARunner*, std::pair<size_t, size_t> > RunnerIndex;
+
+    void initializeTournament(Tournament& tourny, size_t tournyIndex,
                               const GGAInstanceVector& instances,
-                              double timeout);
+                              double timeout, RunnerIndex& index);
+
+    void finishTournament(Tournament& tourny, unsigned tournyNum,
+                          const GGAInstanceVector& instances,
+                          GGASelectorResultBuilder& resultBuilder);
+
+    void resetTimeout(TournamentVector& tournaments, size_t first,
+                      size_t last, double timeout);
 
     void registerInstancesResults(const RunnerVector& runners,
                                   const GGAInstanceVector& instances,
@@ -64,17 +105,20 @@ private:
                                   GGASelectorResultBuilder& resultBuilder);
     
     void killRunners();
+    bool waitAfterTerm();
     void cleanUpRunners();
     void stopPoint();
            
     // attributes
     boost::mutex m_runners_mutex;
     RunnerVector m_runners;
-    boost::interprocess::interprocess_semaphore m_runners_ctrl_semaphore;
+    GGARunnerLoop m_loop;
 
     boost::mutex m_stop_mutex;
     bool m_stop_requested;
 
+    RunnerFinishedHandler m_runner_finished_handler;
+
     const size_t m_num_threads;
     const bool m_runtime_tuning;
     const int m_cpu_limit;
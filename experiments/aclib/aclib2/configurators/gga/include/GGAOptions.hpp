@@ -80,6 +80,7 @@ public:
     std::string conf_file;
     std::string traj_file;
     std::string scen_file;
+    std::string cache_file;
     //
     bool master;
     bool worker;
@@ -227,6 +228,7 @@ void GGAOptions::serialize(Archiver& ar, const unsigned int version)
     ar & conf_file;
     ar & traj_file;
     ar & scen_file;
+    ar & cache_file;
     //
     ar & master;
     ar & worker;
@@ -108,6 +108,26 @@ private:
 
 
 
+/*
+ * Setting of some parameters in the flat representation of the genomes:
+ * pairs of parameter id and value.
+ */
+typedef std::vector<std::pair<size_t, GGAValue> > FlatSetting;
+
+
+/*
+ * A node of the And-Or Tree in the flat representation of the genomes: the
+ * ids of its parameter and of the parameter of its parent (the root is its
+ * own parent).
+ */
+struct GGAFlatNode
+{
+    size_t id;
+    size_t parent;
+    GGATreeNode::NodeType type;
+};
+
+
 /*
  * Stores the And-Or Tree using the helper class GGATreeNode
  * Note that this object takes ownership of all GGAParameters given to it
@@ -138,6 +158,15 @@ public:
     const std::vector<GenomeMap>& forbiddenSettings() const { return m_forbidden; }
     const std::vector<std::string>& paramNames() const { return m_paramnames; }
 
+    // Parameters by id, the position of their name in paramNames()
+    size_t numParameters() const;
+    size_t parameterId(const std::string& name) const;
+    const std::vector<GGAParameter::pointer>& parametersById() const;
+
+    // Forbidden settings and nodes in breadth-first order, by parameter id
+    const std::vector<FlatSetting>& flatForbiddenSettings() const;
+    const std::vector<GGAFlatNode>& flatNodes() const;
+
     std::string toString() const;
     
 private:
@@ -167,6 +196,7 @@ private:
     bool isNameValid(const std::string& name);
  
     void propagateOrPaths();
+    void indexParameters();
 
     std::string strParamTreeHelper(GGATreeNode::pointer cur) const;
 
@@ -184,8 +214,14 @@ private:
     std::string m_resRegEx;
     ParameterMap m_parameters;
     std::vector<GenomeMap> m_seededGenomes;
-    std::vector<std::string> m_paramnames; // provides an ordering of the non-trivial parameter names for use in feature vectors. Trivial parameters are those with a 0 size domain (e.g. root AND node, etc)
+    std::vector<std::string> m_paramnames; // provides an ordering of the parameter names: the parameter ids of the genomes
     std::vector<GenomeMap> m_forbidden;
+
+    // Built by indexParameters (not serialized)
+    std::map<std::string, size_t> m_paramIds;
+    std::vector<GGAParameter::pointer> m_paramsById;
+    std::vector<FlatSetting> m_flatForbidden;
+    std::vector<GGAFlatNode> m_flatNodes;
 };
 
 
@@ -344,6 +380,24 @@ inline const GGACommand* GGAParameterTree::command() const
 inline const ParameterMap& GGAParameterTree::parameters() const
 { return m_parameters; }
 
+/** */
+inline size_t GGAParameterTree::numParameters() const
+{ return m_paramsById.size(); }
+
+/** */
+inline const std::vector<GGAParameter::pointer>& 
+GGAParameterTree::parametersById() const
+{ return m_paramsById; }
+
+/** */
+inline const std::vector<FlatSetting>& 
+GGAParameterTree::flatForbiddenSettings() const
+{ return m_flatForbidden; }
+
+/** */
+inline const std::vector<GGAFlatNode>& GGAParameterTree::flatNodes() const
+{ return m_flatNodes; }
+
 
 //==============================================================================
 // GGAParameterTree private inline/template methods
@@ -359,6 +413,9 @@ void GGAParameterTree::serialize(Archiver& ar, const unsigned int version)
     ar & m_seededGenomes;
     ar & m_paramnames;
     ar & m_forbidden;
+
+    if (Archiver::is_loading::value)
+        indexParameters();
 }
 
 
@@ -29,10 +29,10 @@
 #include <limits>
 #include <map>
 
-#include <boost/interprocess/mapped_region.hpp>
-#include <boost/interprocess/sync/interprocess_semaphore.hpp>
+#include <sys/resource.h>
+#include <sys/types.h>
+
 #include <boost/thread/locks.hpp>
-#include <boost/thread/thread.hpp>
 #include <boost/thread/shared_mutex.hpp>
 
 #include "ggatypedefs.hpp"
@@ -40,6 +40,7 @@
 #include "GGAEvaluationStatistics.hpp"
 #include "GGAGenome.hpp"
 #include "GGAInstance.hpp"
+#include "GGARunnerLoop.hpp"
 #include "GGAUtil.hpp"
 
 
@@ -51,16 +52,22 @@ class GGARunnerBuilder;
 
 /**
  * @brief Executes and stores the results of a genome configuration over a given set of instances.
+ *
+ * The runner does not block: it starts the target algorithm on one instance
+ * at a time and is driven by the events of its GGARunnerLoop. When all the
+ * instances are done the runner is handed out by GGARunnerLoop::wait().
  */
 class GGARunner 
 {
     friend class GGARunnerBuilder;
+    friend class GGARunnerLoop;
     
 public:
     virtual ~GGARunner();
 
-    void run(boost::interprocess::interprocess_semaphore& ctrlSem);
+    void run(GGARunnerLoop& loop);
     
+    void stop();
     void interrupt();        
     int evals();
 
@@ -94,13 +101,18 @@ private:
 
     void initializePerformanceData(size_t);
 
-    void runThread(boost::interprocess::interprocess_semaphore& ctrlSem);
-    void runCommand(const StringVector&, const size_t index);
-    void runCommandParent(int[2], const int child_pid, const size_t index);
+    void runNextCommand();
+    bool runCommand(const StringVector&);
     void runCommandChild(int[2], const StringVector&);
+    void handleEvents();
+    void readOutput();
+    void reapChild(bool block);
+    void commandFinished();
+    void closeChild();
 
     double computeRuntimePerformance(int exit_status, double user_time,
-                                     const std::string& last_line);
+                                     const std::string& last_line,
+                                     bool& censored);
 
     double computeOutputPerformance(int exit_status,
                                     const std::string& last_line);
@@ -109,14 +121,29 @@ private:
 
     //
     std::vector<StringVector> m_commands;
+    GGAInstanceVector m_commandInstances; // instance of each command
+    StringVector m_cacheKeys;             // evaluation cache key of each command
 
     const int m_id; // unique id among runners currently running
     const bool m_runtimeTuning;
     const double m_penalty;
     const unsigned m_cpuLimit;
     GGAInstanceVector m_instances;
+
+    // State of the command being run (owned by the loop's thread)
+    GGARunnerLoop* m_loop;
+    size_t m_index;         // index of the command being run
+    int m_pipeFd;           // read end of the child's stdout (or -1)
+    int m_pidFd;            // pidfd of the child (or -1 if not supported)
+    bool m_running;         // a command has been started and not finished
+    bool m_exited;          // child has been reaped
+    bool m_stopped;         // results are not wanted anymore
+    bool m_discard;         // result of the command is not reliable
+    int m_status;
+    struct rusage m_rusage;
+    std::string m_line;     // output line being read
+    std::string m_lastLine; // last complete output line
     
-    boost::thread m_runThread;
     mutable boost::shared_mutex m_rwMutex; // Modifiable in constant methods
 
     int m_evals;
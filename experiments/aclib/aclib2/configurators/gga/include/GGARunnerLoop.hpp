@@ -0,0 +1,84 @@
+//
+// This file is part of DGGA.
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Kevin Tierney and Josep Pon Farreny
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#ifndef _GGA_RUNNER_LOOP_HPP_
+#define _GGA_RUNNER_LOOP_HPP_
+
+#include <deque>
+#include <map>
+
+#include "GGAOSProber.hpp"
+
+
+// ===== Forward Declarations =====
+class GGARunner;
+
+
+// ===== GGARunnerLoop =====
+
+/**
+ * @brief Multiplexes the target algorithm processes of all runners.
+ *
+ * Runners register the read end of the pipe connected to the stdout of their
+ * child and (on Linux) a pidfd of the child. The selector thread calls wait(),
+ * which dispatches the ready descriptors to their runners and returns the
+ * runners that have evaluated their genome on all instances, one at a time.
+ * Other threads can interrupt a wait() with wakeUp().
+ */
+class GGARunnerLoop
+{
+public:
+    GGARunnerLoop();
+    virtual ~GGARunnerLoop();
+
+    GGARunner* wait(int timeout_ms = -1);
+    bool dispatch(int timeout_ms);
+    void wakeUp();
+
+    // Used by the runners
+    void watch(int fd, GGARunner* runner);
+    void unwatch(int fd);
+    void finished(GGARunner* runner);
+    void forget(GGARunner* runner);
+
+private:
+    GGARunnerLoop(const GGARunnerLoop&);            // Intentionally unimplemented
+    GGARunnerLoop& operator=(const GGARunnerLoop&); // Intentionally unimplemented
+
+    void clearWakeUp();
+
+#if defined(OS_LINUX)
+    int m_epollFd;
+#else
+    std::map<int, GGARunner*> m_fds;
+#endif
+    int m_wakeUpPipe[2];
+    bool m_wokenUp;
+    std::deque<GGARunner*> m_finished;
+};
+
+#endif // _GGA_RUNNER_LOOP_HPP_
@@ -36,6 +36,7 @@
  */
 
 #include <cassert>
+#include <cstddef>
 
 #include <iosfwd>
 #include <string>
@@ -44,7 +45,6 @@
 #include <boost/serialization/serialization.hpp>
 #include <boost/serialization/split_member.hpp>
 #include <boost/serialization/string.hpp>
-#include <boost/scoped_ptr.hpp>
 
 
 class GGAValue 
@@ -87,12 +87,13 @@ public:
     bool isBool() const;
 
     std::string toString() const;    
+    std::size_t hash() const;
 
     GGAValue& operator=(const GGAValue& other);
     bool operator==(const GGAValue& other) const;
+    bool operator!=(const GGAValue& other) const;
 
 private:    
-    void resetValues();
 
     // stream
     friend std::ostream& operator<<(std::ostream& output, const GGAValue& val);
@@ -103,13 +104,16 @@ private:
     template <class Archiver> void save(Archiver&, const unsigned int) const;
     template <class Archiver> void load(Archiver&, const unsigned int);
 
-    // Only one value allowed
+    // Only one value allowed. Numbers are stored in place, genomes hold
+    // one GGAValue per parameter.
     ValueType m_type;
 
-    boost::scoped_ptr<bool> m_boolValue;
-    boost::scoped_ptr<long> m_longValue;
-    boost::scoped_ptr<double> m_dblValue;
-    boost::scoped_ptr<std::string> m_strValue;   
+    union {
+        bool m_boolValue;
+        long m_longValue;
+        double m_dblValue;
+    };
+    std::string m_strValue;
 };
 
 //==============================================================================
@@ -125,25 +129,31 @@ inline bool GGAValue::hasValue() const
  *
  */
 inline bool GGAValue::isLong() const 
-{ return m_longValue.get() != 0; }
+{ return m_type == LONG; }
 
 /**
  *
  */
 inline bool GGAValue::isDouble() const 
-{ return m_dblValue.get() != 0; }
+{ return m_type == DOUBLE; }
 
 /**
  *
  */
 inline bool GGAValue::isString() const 
-{ return m_strValue.get() != 0; }
+{ return m_type == STRING; }
 
 /**
  *
  */
 inline bool GGAValue::isBool() const 
-{ return m_boolValue.get() != 0; }
+{ return m_type == BOOL; }
+
+/**
+ *
+ */
+inline bool GGAValue::operator!=(const GGAValue& other) const
+{ return !(*this == other); }
 
 
 //==============================================================================
@@ -162,20 +172,16 @@ void GGAValue::save(Archiver& ar, const unsigned int version) const
 {
     switch (m_type) {
         case BOOL:
-            assert(isBool());
-            ar & BOOST_SERIALIZATION_NVP(*m_boolValue);
+            ar & BOOST_SERIALIZATION_NVP(m_boolValue);
             break;
         case LONG:
-            assert(isLong());
-            ar & BOOST_SERIALIZATION_NVP(*m_longValue);
+            ar & BOOST_SERIALIZATION_NVP(m_longValue);
             break;
         case DOUBLE:
-            assert(isDouble());
-            ar & BOOST_SERIALIZATION_NVP(*m_dblValue);
+            ar & BOOST_SERIALIZATION_NVP(m_dblValue);
             break;
         case STRING:
-            assert(isString());
-            ar & BOOST_SERIALIZATION_NVP(*m_strValue);
+            ar & BOOST_SERIALIZATION_NVP(m_strValue);
             break;
         case UNKNOWN:
             break;
@@ -188,22 +194,20 @@ void GGAValue::save(Archiver& ar, const unsigned int version) const
 template <class Archiver>
 void GGAValue::load(Archiver& ar, const unsigned int version)
 {
+    m_strValue.clear();
+
     switch (m_type) {
         case BOOL:
-            m_boolValue.reset(new bool());
-            ar & BOOST_SERIALIZATION_NVP(*m_boolValue);
+            ar & BOOST_SERIALIZATION_NVP(m_boolValue);
             break;
         case LONG:
-            m_longValue.reset(new long());
-            ar & BOOST_SERIALIZATION_NVP(*m_longValue);
+            ar & BOOST_SERIALIZATION_NVP(m_longValue);
             break;
         case DOUBLE:
-            m_dblValue.reset(new double());
-            ar & BOOST_SERIALIZATION_NVP(*m_dblValue);
+            ar & BOOST_SERIALIZATION_NVP(m_dblValue);
             break;
         case STRING:
-            m_strValue.reset(new std::string());
-            ar & BOOST_SERIALIZATION_NVP(*m_strValue);
+            ar & BOOST_SERIALIZATION_NVP(m_strValue);
             break;
         case UNKNOWN:
             break;
@@ -20,6 +20,7 @@
 #include <set>
 #include <sstream>
 #include <string>
+#include <vector>
 
 #include <boost/asio.hpp>
 
@@ -34,6 +35,9 @@
 /**
  * Handles connections and distributed jobs to workers.
  *
+ * Each worker gets a batch of tourneys at once and streams back the result
+ * of every run as soon as it finishes. The winners are picked here.
+ *
  * (NOT THREAD SAFE)
  */
 class DGGARemoteSelectorMaster : public GGASelector
@@ -53,9 +57,9 @@ public:
                                      double timout = std::numeric_limits<double>::max());
 
 private:
-    // start, accept, poll
+    // start, accept, dispatch
     void startWorkers();
-    void pollWorkers();
+    void dispatchTourneys();
 
     // Connection handlers
     void handleNewConnection(DGGATcpConnection::pointer);
@@ -67,12 +71,12 @@ private:
     void handleConfigAck(DGGATcpConnection::pointer, const std::string&);
     void handleIDLEState(DGGATcpConnection::pointer, const std::string&);
     void handleWorkingState(DGGATcpConnection::pointer, const std::string&);
-    void handleResultsState(DGGATcpConnection::pointer, const std::string&);
 
-    // Manage tourney
-    bool sendTourney(DGGATcpConnection::pointer);
-    void rollbackTourney(DGGATcpConnection::pointer);
-    void recoverResults(const std::string&);
+    // Manage tourneys
+    bool sendTourneys(DGGATcpConnection::pointer);
+    void rollbackTourneys(DGGATcpConnection::pointer);
+    void recoverRun(DGGATcpConnection::pointer, const std::string&);
+    void finishTourneys(DGGATcpConnection::pointer, const std::string&);
     void resetTimeout();
 
     // Private variables
@@ -98,13 +102,15 @@ private:
     double timeout_;
 
 
-    std::map<DGGATcpConnection::pointer, GGAGenomeVector> participantsInWorker_;    
+    std::map<DGGATcpConnection::pointer, std::vector<GGAGenomeVector> >
+                                                        participantsInWorker_;
 
     // Workers
     std::set<DGGATcpConnection::pointer> connections_;
     std::map<DGGATcpConnection::pointer, bool> connectionIdle_;
     std::map<DGGATcpConnection::pointer, std::string> connectionAddr_;
-    std::map<DGGATcpConnection::pointer, std::string> connectionResults_;
+    std::map<DGGATcpConnection::pointer, GGASelectorResult::InstancePerformancesMap>
+                                                        connectionPerformances_;
 
     // Network I/O
     boost::asio::io_service& ioService;
@@ -49,21 +49,25 @@ private:
 
     // State handlers
     void handleHelloAck(DGGATcpConnection::pointer, const std::string&);
-    void handleBegConfig(DGGATcpConnection::pointer, const std::string&);
     void handleGetConfig(DGGATcpConnection::pointer, const std::string&);
     void handleIDLEState(DGGATcpConnection::pointer, const std::string&);
-    void handleRecvTourneyState(DGGATcpConnection::pointer, const std::string&);
     void handleWorkingState(DGGATcpConnection::pointer, const std::string&);
 
     // Helpful methods
-    void executeTourney(DGGATcpConnection::pointer);
+    void recvTourneys(const std::string& body);
+    void executeTourneys(DGGATcpConnection::pointer);
+    void sendRun(DGGATcpConnection::pointer, size_t tourney, 
+                 size_t participant, const GGARunner& runner);
 
-    bool isResetTimeout(const std::string& msg) const;
-    void resetTimeout(const std::string& msg);
+    void resetTimeout(const std::string& body);
 
     //
     boost::scoped_ptr<GGALocalSelector> m_selector;
-    std::string m_recv_data_buffer;
+
+    // Tourneys being run
+    double m_timeout;
+    GGAInstanceVector m_instances;
+    std::vector<GGAGenomeVector> m_tourneys;
 
     boost::thread m_tourney_thread;
 
@@ -18,6 +18,9 @@
 
 #include <string>
 
+// Each message travels in its own frame (see DGGATcpConnection). Messages
+// carrying data are made of the tag, a '\0' and a binary body (dgga_wire).
+
 // communication constants
 //
 extern const std::string DGGA_MSG_ACK;
@@ -26,25 +29,18 @@ extern const std::string DGGA_MSG_HELLO;
 extern const std::string DGGA_MSG_READY;
 extern const std::string DGGA_MSG_WORKING;
 
-extern const std::string DGGA_MSG_RESULTS_BEG;
-extern const std::string DGGA_MSG_RESULTS_END;
-extern const std::string DGGA_MSG_TOURNEY_BEG;
-extern const std::string DGGA_MSG_TOURNEY_END;
+extern const std::string DGGA_MSG_TOURNEYS;       // master -> worker
+extern const std::string DGGA_MSG_RUN;            // worker -> master
+extern const std::string DGGA_MSG_TOURNEYS_DONE;  // worker -> master
 
 extern const std::string DGGA_MSG_GET_CONFIGURATION;
-extern const std::string DGGA_MSG_CONFIGURATION_BEG;
-extern const std::string DGGA_MSG_CONFIGURATION_END;
+extern const std::string DGGA_MSG_CONFIGURATION;
 
 extern const std::string DGGA_MSG_RESET_TIMEOUT;
 
-// boost serialization nvp names
-extern const char* DGGA_EVALS_TAG;
-extern const char* DGGA_WINNERS_TAG;
-extern const char* DGGA_TIMEOUT_TAG;
-extern const char* DGGA_INSTANCES_TAG;
-extern const char* DGGA_PARTICIPANTS_TAG;
-extern const char* DGGA_SELECT_RESULT_TAG;
-extern const char* DGGA_INSTANCES_STATISTICS_TAG;
-
+// tagged messages
+std::string makeMessage(const std::string& tag, const std::string& body);
+std::string messageTag(const std::string& msg);
+std::string messageBody(const std::string& msg);
 
-#endif // _DGGA_MESSAGES_HPP_
\ No newline at end of file
+#endif // _DGGA_MESSAGES_HPP_
@@ -0,0 +1,99 @@
+// This file is part of GGA.
+// 
+// GGA is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GGA is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with GGA.  If not, see <http://www.gnu.org/licenses/>.
+
+#ifndef _DGGA_WIRE_HPP_
+#define _DGGA_WIRE_HPP_
+
+#include <stdint.h>
+
+#include <map>
+#include <string>
+
+#include "GGAGenome.hpp"
+#include "GGAInstance.hpp"
+#include "GGAParameterTree.hpp"
+#include "GGAValue.hpp"
+
+/**
+ * Compact binary encoding of the data exchanged between master and workers.
+ *
+ * Integers are written as varints and doubles as 8 little endian bytes, so
+ * the encoding does not depend on the architecture. The values of a genome
+ * are written in the order of their parameter ids, which master and workers
+ * share after the configuration step, and instances are
+ * referred to by their position in the instance table of the message.
+ */
+
+typedef std::map<GGAInstance, uint64_t, GGAInstance::STLMapComparator>
+        DGGAInstanceIndex;
+
+/**
+ * Appends encoded data to a string.
+ */
+class DGGAWireWriter
+{
+public:
+    DGGAWireWriter(std::string& out);
+
+    void putUInt(uint64_t val);
+    void putInt(int64_t val);
+    void putDouble(double val);
+    void putString(const std::string& val);
+
+    void putValue(const GGAValue& val);
+    void putInstance(const GGAInstance& inst);
+    void putGenome(const GGAGenome& genome, const DGGAInstanceIndex& index);
+
+private:
+    std::string& m_out;
+};
+
+
+/**
+ * Decodes data written by a DGGAWireWriter. Throws a GGAException if the
+ * data is truncated or malformed.
+ */
+class DGGAWireReader
+{
+public:
+    DGGAWireReader(const std::string& in);
+
+    bool atEnd() const;
+
+    uint64_t getUInt();
+    size_t getCount();
+    int64_t getInt();
+    double getDouble();
+    std::string getString();
+
+    GGAValue getValue();
+    GGAInstance getInstance();
+    GGAGenome getGenome(const GGAParameterTree& ptree,
+                        const GGAInstanceVector& table);
+
+private:
+    void need(size_t bytes) const;
+
+    const std::string& m_in;
+    size_t m_pos;
+};
+
+//==============================================================================
+// Helpers
+
+void addToInstanceIndex(const GGAInstance& inst, GGAInstanceVector& table,
+                        DGGAInstanceIndex& index);
+
+#endif // _DGGA_WIRE_HPP_
@@ -31,6 +31,9 @@
 /**
  * Wraps a tcp connection and provides methods and handlers to interact with
  * the communication channel. (NOT THREAD SAFE)
+ *
+ * Messages are sent in frames made of a 4 byte (big endian) length followed
+ * by the message, so they may contain binary data.
  */
 class DGGATcpConnection
     : public boost::enable_shared_from_this<DGGATcpConnection>
@@ -41,7 +44,7 @@ public:
     typedef boost::function2<void, pointer, const std::string&> 
                                                             NewMessageHandler;
 
-    static const std::string DEF_EOM;
+    static const size_t MAX_MESSAGE_SIZE;
 
     //
     static pointer create(boost::asio::io_service&);
@@ -93,13 +96,11 @@ private:
     std::string m_in_buffer;
     std::string m_out_buffer;
 
-    boost::array<char, 1024> m_temp_in_buffer;
+    boost::array<char, 65536> m_temp_in_buffer;
     std::string m_temp_out_buffer;
 
     bool m_read_in_progress;
     bool m_write_in_progress;
-
-    std::string m_end_of_message_mark;
 };
 
 //==============================================================================
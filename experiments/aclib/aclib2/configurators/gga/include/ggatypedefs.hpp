@@ -48,4 +48,7 @@ typedef std::vector<std::string> StringVector;
 // Only for the context of the values in a genome
 typedef std::map<std::string, GGAValue> GenomeMap;
 
+// Values of a genome indexed by parameter id (see GGAParameterTree)
+typedef std::vector<GGAValue> ValueVector;
+
 #endif
@@ -0,0 +1,311 @@
+//
+// This file is part of DGGA.
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Kevin Tierney and Josep Pon Farreny
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#include <cerrno>
+#include <cstring>
+
+#include <iomanip>
+#include <sstream>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "GGAEvaluationCache.hpp"
+#include "GGAExceptions.hpp"
+#include "GGAOptions.hpp"
+#include "GGAUtil.hpp"
+#include "OutputLog.hpp"
+
+
+GGAEvaluationCache* GGAEvaluationCache::s_pInstance = NULL;
+
+//==============================================================================
+// GGAEvaluationCache::Entry
+
+GGAEvaluationCache::Entry::Entry()
+    : value(0.0)
+    , censored(false)
+    , cutoff(0.0)
+{ }
+
+GGAEvaluationCache::Entry::Entry(double value, bool censored, double cutoff)
+    : value(value)
+    , censored(censored)
+    , cutoff(cutoff)
+{ }
+
+//==============================================================================
+// GGAEvaluationCache public static methods
+
+/**
+ * The cache is opened on the file of the --cache_file option the first time
+ * it is requested. Runners look up and store results from the selector
+ * thread, which drives all target algorithm runs through one GGARunnerLoop,
+ * so this first call does not race with another one.
+ */
+GGAEvaluationCache& GGAEvaluationCache::instance()
+{
+    if (s_pInstance == NULL)
+        s_pInstance = new GGAEvaluationCache(GGAOptions::instance().cache_file);
+    return *s_pInstance;
+}
+
+/**
+ *
+ */
+void GGAEvaluationCache::deleteInstance()
+{
+    delete s_pInstance;
+    s_pInstance = NULL;
+}
+
+//==============================================================================
+// GGAEvaluationCache public methods
+
+/**
+ * The key starts with an identifier of the target algorithm, so that one
+ * cache file never mixes the results of different targets. Only the values
+ * which makeCommand puts on the command line are part of the key: genome
+ * entries not used by the command (e.g. and-nodes) and parameters which are
+ * not on an active or-path are left out.
+ */
+std::string GGAEvaluationCache::makeKey(const GGAParameterTree& ptree,
+                                        const GenomeMap& genome,
+                                        const GGAInstance& inst)
+{
+    std::stringstream ss;
+    ss << targetId(*ptree.command()) << '\t' << inst.getSeed() << '\t'
+       << inst.getInstance();
+
+    const StringVector& extra = inst.getExtra();
+    for (size_t i = 0; i < extra.size(); ++i)
+        ss << '\t' << extra[i];
+    ss << "\t|";
+
+    const GGACommand& cmd = *ptree.command();
+    const CommandArgVector& args = cmd.arguments();
+    CommandArgVector::const_iterator itr;
+    for (itr = args.begin(); itr != args.end(); ++itr) {
+        if (itr->type() != GGACommandArg::VARIABLE || itr->isProtected())
+            continue;
+        const GGAParameter::pointer param = mapAt(ptree.parameters(),
+                                                  itr->name());
+        if (cmd.isOrPathOk(param, genome))
+            ss << ' ' << itr->name() << '=' << mapAt(genome, itr->name());
+    }
+
+    return ss.str();
+}
+
+/**
+ *
+ */
+GGAEvaluationCache::~GGAEvaluationCache()
+{
+    if (m_fd >= 0)
+        ::close(m_fd);
+}
+
+/**
+ * Looks up the result of running the target algorithm with the given cutoff.
+ * In runtime tuning a solved run that took longer than the cutoff, and a
+ * censored run with at least the same cutoff, are returned as censored at
+ * the cutoff. Otherwise the cutoffs have to match, since the objective value
+ * may depend on it.
+ */
+bool GGAEvaluationCache::lookup(const std::string& key, double cutoff,
+                                bool runtimeTuning, Entry& entry)
+{
+    if (!enabled())
+        return false;
+
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    EntryMap::const_iterator itr = m_entries.find(key);
+    if (itr == m_entries.end()) {
+        readAppended();
+        if ((itr = m_entries.find(key)) == m_entries.end())
+            return false;
+    }
+
+    const Entry& e = itr->second;
+    if (!runtimeTuning) {
+        if (e.cutoff != cutoff)
+            return false;
+        entry = e;
+    } else if (!e.censored) {
+        if (e.value > cutoff - 0.5)
+            entry = Entry(cutoff, true, cutoff);
+        else
+            entry = e;
+    } else {
+        if (e.cutoff < cutoff)
+            return false;
+        entry = Entry(cutoff, true, cutoff);
+    }
+
+    ++m_hits;
+    return true;
+}
+
+/**
+ * Appends the result to the cache file. Each line is written with a single
+ * write on a file opened in append mode, so lines of different processes do
+ * not interleave.
+ */
+void GGAEvaluationCache::store(const std::string& key, const Entry& entry)
+{
+    if (!enabled())
+        return;
+
+    std::ostringstream oss;
+    oss << std::setprecision(17) << (entry.censored ? 1 : 0) << ' '
+        << entry.value << ' ' << entry.cutoff << '\t' << key << '\n';
+    const std::string line = oss.str();
+
+    boost::mutex::scoped_lock lock(m_mutex);
+    m_entries[key] = entry;
+
+    if (::write(m_fd, line.data(), line.size()) != (ssize_t) line.size())
+        LOG_ERROR("[GGAEvaluationCache::store] Error writing to \"" << m_path
+                  << "\": " << strerror(errno));
+}
+
+//==============================================================================
+// GGAEvaluationCache private methods
+
+/**
+ *
+ */
+GGAEvaluationCache::GGAEvaluationCache(const std::string& path)
+    : m_path(path)
+    , m_fd(-1)
+    , m_offset(0)
+    , m_entries()
+    , m_hits(0)
+    , m_mutex()
+{
+    if (m_path.empty())
+        return;
+
+    m_fd = ::open(m_path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (m_fd < 0)
+        throw GGAFileNotFoundException(m_path);
+
+    readAppended();
+    LOG("Evaluation cache \"" << m_path << "\": " << m_entries.size()
+        << " evaluations");
+}
+
+/**
+ * Hash (FNV-1a, stable across processes) of the command template and of the
+ * size and modification time of every fixed command word naming a file, such
+ * as the binary or the wrapper, so a rebuilt target gets new keys. Computed
+ * once per command template.
+ */
+std::string GGAEvaluationCache::targetId(const GGACommand& cmd)
+{
+    boost::mutex::scoped_lock lock(m_mutex);
+
+    StringMap::const_iterator itr = m_targetIds.find(cmd.rawCommand());
+    if (itr != m_targetIds.end())
+        return itr->second;
+
+    std::ostringstream target;
+    target << cmd.rawCommand();
+
+    const CommandArgVector& args = cmd.arguments();
+    for (size_t i = 0; i < args.size(); ++i) {
+        struct stat st;
+        if (args[i].type() == GGACommandArg::FIXED
+                && ::stat(args[i].fixedValue().c_str(), &st) == 0
+                && S_ISREG(st.st_mode))
+            target << '\n' << args[i].fixedValue() << ' ' << st.st_size
+                   << ' ' << st.st_mtime;
+    }
+
+    const std::string str = target.str();
+    unsigned long long hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < str.size(); ++i)
+        hash = (hash ^ (unsigned char) str[i]) * 1099511628211ULL;
+
+    std::ostringstream oss;
+    oss << std::hex << std::setw(16) << std::setfill('0') << hash;
+    return m_targetIds[cmd.rawCommand()] = oss.str();
+}
+
+/**
+ * Indexes the complete lines appended to the file since the last call. A
+ * trailing partial line (still being written by another process) is left for
+ * the next call.
+ */
+void GGAEvaluationCache::readAppended()
+{
+    struct stat st;
+    if (::fstat(m_fd, &st) != 0 || st.st_size <= m_offset)
+        return;
+
+    std::vector<char> buffer(st.st_size - m_offset);
+    ssize_t bytes = ::pread(m_fd, &buffer[0], buffer.size(), m_offset);
+    if (bytes <= 0)
+        return;
+
+    size_t begin = 0;
+    for (size_t i = 0; i < (size_t) bytes; ++i) {
+        if (buffer[i] != '\n')
+            continue;
+        std::string line(&buffer[begin], i - begin);
+        if (!parseLine(line))
+            LOG_ERROR("[GGAEvaluationCache] Ignoring malformed line in \""
+                      << m_path << "\": " << line);
+        begin = i + 1;
+    }
+    m_offset += begin;
+}
+
+/**
+ * Line format: "<censored> <value> <cutoff>\t<key>". Later lines override
+ * earlier ones of the same key.
+ */
+bool GGAEvaluationCache::parseLine(const std::string& line)
+{
+    size_t tab = line.find('\t');
+    if (tab == std::string::npos)
+        return false;
+
+    std::istringstream iss(line.substr(0, tab));
+    int censored;
+    Entry entry;
+    if (!(iss >> censored >> entry.value >> entry.cutoff))
+        return false;
+    entry.censored = censored != 0;
+
+    m_entries[line.substr(tab + 1)] = entry;
+    return true;
+}
@@ -25,9 +25,10 @@
 
 #include <limits>
 #include <map>
-#include <queue>
 #include <sstream>
 
+#include <boost/functional/hash.hpp>
+
 #include "ggatypedefs.hpp"
 #include "GGAGenome.hpp"
 #include "GGAOptions.hpp"
@@ -62,7 +63,8 @@ bool GGAGenome::compareObjValueAscendingOrder(const GGAGenome& first,
  * operator= or by calling the initializeRandom method
  */
 GGAGenome::GGAGenome()
-    : m_genome()
+    : m_values()
+    , m_hash(0)
     , m_age(0)
     , m_gender(randGender())
     , m_performance()
@@ -75,7 +77,8 @@ GGAGenome::GGAGenome()
  *
  */
 GGAGenome::GGAGenome(const GGAGenome& other)
-    : m_genome(other.m_genome)
+    : m_values(other.m_values)
+    , m_hash(other.m_hash)
     , m_age(other.m_age)
     , m_gender(other.m_gender)
     , m_performance(other.m_performance)
@@ -88,7 +91,8 @@ GGAGenome::GGAGenome(const GGAGenome& other)
  * Creates a new feasible genome without taking ownership of the paramTree pointer.
  */
 GGAGenome::GGAGenome(const GGAParameterTree& paramTree)
-    : m_genome()
+    : m_values()
+    , m_hash(0)
     , m_age(0)
     , m_gender(randGender())
     , m_performance()
@@ -103,8 +107,32 @@ GGAGenome::GGAGenome(const GGAParameterTree& paramTree)
  * Creates a new feasible genome without taking ownership of the paramTree
  * pointer and assigns this genome the given genome.
  */
-GGAGenome::GGAGenome(const GGAParameterTree& paramTree, GenomeMap genome)
-    : m_genome(genome)
+GGAGenome::GGAGenome(const GGAParameterTree& paramTree, 
+                     const GenomeMap& genome)
+    : m_values(paramTree.numParameters())
+    , m_hash(0)
+    , m_age(0)
+    , m_gender(randGender())
+    , m_performance()
+    , m_highlander(false)
+    , m_objValue(std::numeric_limits<double>::max()) 
+{
+    GenomeMap::const_iterator itr;
+    for (itr = genome.begin(); itr != genome.end(); ++itr)
+        m_values[paramTree.parameterId(itr->first)] = itr->second;
+
+    makeFeasible(paramTree);
+}
+
+
+/**
+ * Creates a new feasible genome without taking ownership of the paramTree
+ * pointer and assigns this genome the given values (indexed by parameter id).
+ */
+GGAGenome::GGAGenome(const GGAParameterTree& paramTree, 
+                     const ValueVector& values)
+    : m_values(values)
+    , m_hash(0)
     , m_age(0)
     , m_gender(randGender())
     , m_performance()
@@ -128,15 +156,12 @@ GGAGenome::~GGAGenome()
 void GGAGenome::mutate(const GGAParameterTree& ptree) 
 {
     const GGAOptions& opts = GGAOptions::instance();
-    ParameterMap params = ptree.parameters();
-
-    ParameterMap::iterator itr;
-    for(itr = params.begin(); itr != params.end(); ++itr) {
-        if(GGARandEngine::randDouble(0.0, 1.0) < opts.mutation_rate) {
-            GGAValue& val = m_genome[itr->first];
-            GGAParameter::pointer param = itr->second;
-            mutateParameter(val, param);
-        }
+    const std::vector<GGAParameter::pointer>& params = ptree.parametersById();
+    m_values.resize(params.size());
+
+    for(size_t id = 0; id < params.size(); ++id) {
+        if(GGARandEngine::randDouble(0.0, 1.0) < opts.mutation_rate)
+            mutateParameter(m_values[id], params[id]);
     }
 
     makeFeasible(ptree);
@@ -148,11 +173,11 @@ void GGAGenome::mutate(const GGAParameterTree& ptree)
  */
 void GGAGenome::initializeRandom(const GGAParameterTree& ptree)
 {
-    ParameterMap params = ptree.parameters();
+    const std::vector<GGAParameter::pointer>& params = ptree.parametersById();
+    m_values.resize(params.size());
 
-    ParameterMap::iterator itr;
-    for(itr = params.begin(); itr != params.end(); ++itr)
-        m_genome[itr->first] = itr->second->valueInRange();
+    for(size_t id = 0; id < params.size(); ++id)
+        m_values[id] = params[id]->valueInRange();
 
     makeFeasible(ptree);
 }
@@ -164,8 +189,8 @@ void GGAGenome::initializeRandom(const GGAParameterTree& ptree)
  */
 bool GGAGenome::isFeasible(const GGAParameterTree& ptree) const
 {
-    const std::vector<GenomeMap>& forbidden = ptree.forbiddenSettings();
-    for(std::vector<GenomeMap>::const_iterator itr = forbidden.begin(); itr != forbidden.end(); ++itr) {
+    const std::vector<FlatSetting>& forbidden = ptree.flatForbiddenSettings();
+    for(std::vector<FlatSetting>::const_iterator itr = forbidden.begin(); itr != forbidden.end(); ++itr) {
         if(forbiddenSetViolated(*itr)) {
             return false;
         }
@@ -180,17 +205,17 @@ bool GGAGenome::isFeasible(const GGAParameterTree& ptree) const
  */
 void GGAGenome::makeFeasible(const GGAParameterTree& ptree)
 {
-    const std::vector<GenomeMap>& forbidden = ptree.forbiddenSettings();
+    const std::vector<FlatSetting>& forbidden = ptree.flatForbiddenSettings();
+    const std::vector<GGAParameter::pointer>& params = ptree.parametersById();
     int giveUp = 0; // just to prevent infinite loops.. we still have to exit GGA if this happens, though TODO just kill the genome and replace it?
     int maxItrs = 5000;
     // Note: I realize this isn't really the best way to go about repairing the genome as with some probability we could be looping for a long time... but it is easy to implement and will usually be fast :)
     while(!isFeasible(ptree) && giveUp < maxItrs) {
-        for(std::vector<GenomeMap>::const_iterator itr = forbidden.begin(); itr != forbidden.end(); ++itr) {
+        for(std::vector<FlatSetting>::const_iterator itr = forbidden.begin(); itr != forbidden.end(); ++itr) {
             int innerGiveUp = 0;
             while(forbiddenSetViolated(*itr) && innerGiveUp < maxItrs) {
-                GenomeMap::const_iterator gmitr = itr->begin();
-                std::advance(gmitr, GGARandEngine::randInt(0, itr->size() - 1));
-                mutateParameter(m_genome[gmitr->first], mapAt(ptree.parameters(), gmitr->first));
+                size_t id = (*itr)[GGARandEngine::randInt(0, itr->size() - 1)].first;
+                mutateParameter(m_values[id], params[id]);
                 innerGiveUp++;
             }
             if(innerGiveUp >= maxItrs) {
@@ -204,6 +229,21 @@ void GGAGenome::makeFeasible(const GGAParameterTree& ptree)
         LOG_ERROR("Unable to find feasible setting for genome. The constraints are too hard for GGA, please consider relaxing them or handling them somehow in the wrapper.");
         exit(1);
     }
+
+    rehash();
+}
+
+
+/**
+ * Builds the name to value map of the configuration.
+ */
+GenomeMap GGAGenome::genome(const GGAParameterTree& ptree) const
+{
+    GenomeMap genome;
+    const StringVector& names = ptree.paramNames();
+    for (size_t id = 0; id < m_values.size() && id < names.size(); ++id)
+        genome[names[id]] = m_values[id];
+    return genome;
 }
 
 
@@ -216,7 +256,7 @@ std::string GGAGenome::toString() const
     ret << "[GGAGenome: " << this << "; Gender: " 
         << (m_gender == COMPETITIVE ? "C" : "N")
         << "; Age: " << m_age << "; Genome: " 
-        << OutputLog::genomeMapToString(m_genome)
+        << OutputLog::genomeMapToString(genome(GGAParameterTree::instance()))
         << "]";
     return ret.str();
 }
@@ -263,13 +303,24 @@ void GGAGenome::mutateParameter(GGAValue& val, GGAParameter::pointer param)
 /**
  *
  */
-bool GGAGenome::forbiddenSetViolated(const GenomeMap& settings) const 
+bool GGAGenome::forbiddenSetViolated(const FlatSetting& setting) const 
 {
-    bool allMatch = true;
-    for(GenomeMap::const_iterator gmitr = settings.begin(); gmitr != settings.end() && allMatch; ++gmitr) {
-        allMatch = allMatch && m_genome.at(gmitr->first) == gmitr->second;
+    for(FlatSetting::const_iterator itr = setting.begin(); itr != setting.end(); ++itr) {
+        if(m_values[itr->first] != itr->second)
+            return false;
     }
-    return allMatch;
+    return true;
+}
+
+/**
+ * Updates the hash of the configuration, which makes most comparisons of
+ * different genomes cheap.
+ */
+void GGAGenome::rehash()
+{
+    m_hash = 0;
+    for (size_t id = 0; id < m_values.size(); ++id)
+        boost::hash_combine(m_hash, m_values[id].hash());
 }
 
 
@@ -311,94 +362,62 @@ GGAGenome crossover(const GGAParameterTree& ptree, const GGAGenome& gen1,
         LOG_ERROR("Warning: Mating two genomes of the same gender. This"
                   " probably shouldn't happen.");
     
-    GenomeMap childGenome;
-    std::map<GGATreeNode::const_pointer, GGATreeNode::Label> node_label;
+    const std::vector<GGAFlatNode>& nodes = ptree.flatNodes();
+    ValueVector childGenome(ptree.numParameters());
+    std::vector<GGATreeNode::Label> node_label(ptree.numParameters(),
+                                               GGATreeNode::O);
     
     bool gen1_competitive = gen1.gender() == GGAGenome::COMPETITIVE;
-    const GenomeMap& nGenome = gen1_competitive ? gen1.genome() : gen2.genome();
-    const GenomeMap& cGenome = gen1_competitive ? gen2.genome() : gen1.genome();
+    const ValueVector& nGenome = gen1_competitive ? gen1.values() : gen2.values();
+    const ValueVector& cGenome = gen1_competitive ? gen2.values() : gen1.values();
 
-    GGATreeNode::const_pointer cur = ptree.root();
-    GGATreeNode::const_pointer childNode = cur;
-    GGAParameter::const_pointer curParam = cur->parameter();
-    std::string paramName = curParam->name();
-    
     // Label the root node
-    if(cur->type() == GGATreeNode::AND 
-       || mapAt(nGenome, paramName) == mapAt(cGenome, paramName)) 
+    size_t id = nodes.front().id;
+    if(nodes.front().type == GGATreeNode::AND 
+       || nGenome[id] == cGenome[id]) 
     {
-        node_label[cur] = GGATreeNode::O;
-        childGenome[paramName] = GGAValue(mapAt(cGenome, paramName));
+        node_label[id] = GGATreeNode::O;
+        childGenome[id] = cGenome[id];
     } else {
         if(GGARandEngine::coinFlip()) {
-            node_label[cur] = GGATreeNode::C;
-            childGenome[paramName] = GGAValue(mapAt(cGenome, paramName));
+            node_label[id] = GGATreeNode::C;
+            childGenome[id] = cGenome[id];
         } else {
-            node_label[cur] = GGATreeNode::N;
-            childGenome[paramName] = GGAValue(mapAt(nGenome, paramName));
+            node_label[id] = GGATreeNode::N;
+            childGenome[id] = nGenome[id];
         }
     }
 
+    // The nodes are visited in breadth-first order, parents before children
     const GGAOptions& opts = GGAOptions::instance();    
-    std::queue<GGATreeNode::const_pointer> unvisited;
-    unvisited.push(cur);
-    
-    while(!unvisited.empty()) {
-        cur = unvisited.front();
-        unvisited.pop();
-
-        for(size_t i = 0; i < cur->children().size(); ++i) {
-            childNode = cur->children()[i];
-            unvisited.push(childNode);            
-            curParam = childNode->parameter();
-
-            paramName = curParam->name();
-
-            GGAValue useValue;
-            GGAValue altValue;
-            GGATreeNode::Label useLabel;
-            GGATreeNode::Label altLabel;
-
-            if(node_label[cur] == GGATreeNode::O) {
-                if(mapAt(cGenome, paramName) == mapAt(nGenome, paramName))
-                {
-                    childGenome[paramName] = GGAValue(
-                                                    mapAt(cGenome, paramName));
-                    node_label[childNode] = GGATreeNode::O;
-                } else {
-                    if(GGARandEngine::coinFlip()) {
-                        childGenome[paramName] = GGAValue(
-                                                    mapAt(cGenome, paramName));
-                        node_label[childNode] = GGATreeNode::C;
-                    } else {
-                        node_label[childNode] = GGATreeNode::N;
-                        childGenome[paramName] = GGAValue(
-                                                    mapAt(nGenome, paramName));
-                    }
-                }
-
-            } else { 
-                if(node_label[cur] == GGATreeNode::C) {
-                    useValue = GGAValue(mapAt(cGenome, paramName));
-                    useLabel = GGATreeNode::C;
-                    altValue = GGAValue(mapAt(nGenome, paramName));
-                    altLabel = GGATreeNode::N;
+    for(size_t i = 1; i < nodes.size(); ++i) {
+        id = nodes[i].id;
+        GGATreeNode::Label parent_label = node_label[nodes[i].parent];
+
+        if(parent_label == GGATreeNode::O) {
+            if(cGenome[id] == nGenome[id]) {
+                childGenome[id] = cGenome[id];
+                node_label[id] = GGATreeNode::O;
+            } else {
+                if(GGARandEngine::coinFlip()) {
+                    childGenome[id] = cGenome[id];
+                    node_label[id] = GGATreeNode::C;
                 } else {
-                    useValue = GGAValue(mapAt(nGenome, paramName));
-                    useLabel = GGATreeNode::N;
-                    altValue = GGAValue(mapAt(cGenome, paramName));
-                    altLabel = GGATreeNode::C;
-                }
-                // With some probability, don't use the parameters from the
-                // same gender as the parent
-                if(GGARandEngine::randDouble(0.0, 1.0) < opts.subtree_split) {
-                    childGenome[paramName] = altValue;
-                    node_label[childNode] = altLabel;
-                } else {
-                    childGenome[paramName] = useValue;
-                    node_label[childNode] = useLabel;
+                    node_label[id] = GGATreeNode::N;
+                    childGenome[id] = nGenome[id];
                 }
             }
+
+        } else { 
+            bool use_c = parent_label == GGATreeNode::C;
+
+            // With some probability, don't use the parameters from the
+            // same gender as the parent
+            if(GGARandEngine::randDouble(0.0, 1.0) < opts.subtree_split)
+                use_c = !use_c;
+
+            childGenome[id] = use_c ? cGenome[id] : nGenome[id];
+            node_label[id] = use_c ? GGATreeNode::C : GGATreeNode::N;
         }
     }
 
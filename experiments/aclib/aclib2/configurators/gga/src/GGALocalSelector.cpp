@@ -94,22 +94,14 @@ static void dokill(const RunnerVector& runners)
 }
 
 
-/*
- * Returns whether or not it is safe to continue (all child processes
- * accepted SIGTERM)
- */
-static bool waitAfterTerm()
+static bool anyChildRunning(const RunnerVector& runners)
 {
-    int res = waitpid(0, NULL, WNOHANG);
-    int count = 0;
-
-    while(res == 0 && count < 500) {
-        sleepFor(0, 1000000); // 0.001 seconds
-        res = waitpid(0, NULL, WNOHANG);
-        ++count;
+    RunnerVector::const_iterator itr;
+    for(itr = runners.begin(); itr != runners.end(); ++itr) {
+        if ((*itr)->childPid() != 0)
+            return true;
     }
-
-    return res == -1;
+    return false;
 }
 
 
@@ -122,11 +114,13 @@ static bool waitAfterTerm()
 GGALocalSelector::GGALocalSelector()
     : m_runners_mutex()
     , m_runners()
-    , m_runners_ctrl_semaphore(0)
+    , m_loop()
 
     , m_stop_mutex()
     , m_stop_requested(false)
 
+    , m_runner_finished_handler()
+
     , m_num_threads(GGAOptions::instance().num_threads)
     , m_runtime_tuning(GGAOptions::instance().runtime_tuning)
     , m_cpu_limit(GGAOptions::instance().target_algo_cpu_limit)
@@ -160,8 +154,7 @@ void GGALocalSelector::forceStop()
     {
         boost::unique_lock<boost::mutex> lock(m_stop_mutex);
         m_stop_requested = true;
-        if (!m_runners_ctrl_semaphore.try_wait()) // release semaphore lock
-            m_runners_ctrl_semaphore.post();
+        m_loop.wakeUp();
     }
 }
 
@@ -178,123 +171,135 @@ void GGALocalSelector::resetTimeout(double new_timeout)
 }
 
 
+/**
+ *
+ */
+void GGALocalSelector::setRunnerFinishedHandler(RunnerFinishedHandler handler)
+{
+    m_runner_finished_handler = handler;
+}
+
+
 /**
  * Takes in a vector of participants and returns a subset of winners.
  */
 GGASelectorResult GGALocalSelector::select(const GGAGenomeVector& participants, 
                                            const GGAInstanceVector& instances,
                                            double start_timeout)
-{   
-    GGASelectorResultBuilder resultBuilder;
-    double timeout = start_timeout;
-
+{
     // TODO Sort instances in order of descending timeout!!
     UIntVector tournySizes = balanceTournaments(participants.size(),
                                                 m_num_threads);
     LOG_VERBOSE("Tournament sizes for this generation: [" 
                 << OutputLog::uintVectorToString(tournySizes) << "]");
     
-    // Run each tournament of this generation
-    unsigned numUsed = 0, tournyNum = 1;
-    UIntVector::const_iterator itr;
+    // Fill each tournament with references to participants
+    std::vector<GGAGenomeVector> tournaments(tournySizes.size());
+    unsigned numUsed = 0;
+    for (size_t t = 0; t < tournySizes.size(); ++t) {
+        tournaments[t].assign(participants.begin() + numUsed,
+                              participants.begin() + numUsed + tournySizes[t]);
+        numUsed += tournySizes[t];
+    }
 
-    for(itr = tournySizes.begin(); itr != tournySizes.end(); ++itr) {
-        LOG_VERY_VERBOSE("Beginning tournament " << tournyNum << " of " 
-                         << tournySizes.size());
-        
-        // Propagate previous timeout?
-        if (!m_propagate_timeout)
-            timeout = start_timeout;
-
-        // Fill with references to participants
-        GGAGenomeVector tournyParticipants;
-        tournyParticipants.assign(participants.begin() + numUsed,
-                                  participants.begin() + numUsed + *itr);
-                
-        // Does not pick the same genome twice (DGGA is happy with that :D)
-        initializeTournament(tournyParticipants, instances, timeout);
-        assert(tournyParticipants.size() == m_runners.size());
-
-        // Begin tournament execution
-        assert(!m_runners_ctrl_semaphore.try_wait());
-        for(size_t i = 0; i < m_runners.size(); ++i)
-            m_runners[i]->run(m_runners_ctrl_semaphore);
-        
-        // determine the number of winners to wait for
-        int numWinners = int(m_pct_winners * tournyParticipants.size());
-        if(numWinners <= 0)
-            numWinners = 1;
+    return selectTournaments(tournaments, instances, start_timeout);
+}
+
+
+/**
+ * Runs the given tournaments and returns their winners.
+ *
+ * The tournaments of the generation are pipelined: whenever a runner finishes,
+ * its slot is given to the next runner waiting to start, which may belong to
+ * the next tournament. Each tournament keeps its own timeout and winners.
+ * All the target algorithm runs are driven by the loop of this thread.
+ */
+GGASelectorResult GGALocalSelector::selectTournaments(
+                                const std::vector<GGAGenomeVector>& tournys,
+                                const GGAInstanceVector& instances,
+                                double start_timeout)
+{   
+    GGASelectorResultBuilder resultBuilder;
+    double timeout = start_timeout;
 
-        LOG_VERBOSE("Waiting for " << numWinners << " competitor" 
-                    << ((numWinners > 1) ? "s" : "") << " to finish.");
+    TournamentVector tournaments(tournys.size());
+    for (size_t t = 0; t < tournys.size(); ++t)
+        tournaments[t].participants = tournys[t];
 
-        // Wait until all the participants have finished
-        size_t nfinished = 0;
-        double local_best_time = std::numeric_limits<double>::max();
-        std::vector<bool> observed(m_runners.size(), false);
+    // Tournaments [first, last) have started and are not finished yet. The
+    // runners of tournament 'last - 1' may not all be started.
+    size_t first = 0, last = 0;
+    size_t num_running = 0;
+    RunnerIndex index;
 
-        stopPoint();
-        while (nfinished < m_runners.size()) {
-            m_runners_ctrl_semaphore.wait();
-            stopPoint();
-
-            for (size_t i = 0; i < m_runners.size(); ++i) {
-                if (m_runners[i]->hasFinished() && !observed[i]) {
-                    LOG("Registering runner " << m_runners[i] 
-                        << " as finished");
-
-                    nfinished += 1;
-                    observed[i] = true;
-
-                    local_best_time = std::min(local_best_time,
-                                               m_runners[i]->objValue());
-                    if (m_propagate_timeout)
-                        timeout = std::min(timeout, local_best_time);
-                    else
-                        timeout = local_best_time;
-
-                    for (size_t j = 0; j < m_runners.size(); ++j)
-                        m_runners[j]->resetTimeout(timeout);
-
-                    break;
-                }
+    stopPoint();
+    while (first < tournaments.size()) {
+        // Keep every thread busy
+        while (num_running < m_num_threads && (last < tournaments.size()
+               || tournaments[last - 1].num_started
+                    < tournaments[last - 1].runners.size()))
+        {
+            if (last == 0 || tournaments[last - 1].num_started
+                                == tournaments[last - 1].runners.size())
+            {
+                LOG_VERY_VERBOSE("Beginning tournament " << last + 1 << " of " 
+                                 << tournaments.size());
+
+                // Propagate previous timeout?
+                if (!m_propagate_timeout)
+                    timeout = start_timeout;
+
+                // Does not pick the same genome twice (DGGA is happy with that :D)
+                initializeTournament(tournaments[last], last, instances,
+                                     timeout, index);
+                ++last;
             }
-        }
 
-        // Register participants results
-        registerInstancesResults(m_runners, instances, tournyParticipants, resultBuilder);
-        
-        // Sort & select winners
-        std::sort(tournyParticipants.begin(), tournyParticipants.end(),
-                  GGAGenome::compareObjValueAscendingOrder);
-    
-        GGAGenomeVector::const_iterator winners_beg = 
-                                    tournyParticipants.begin();
-        GGAGenomeVector::const_iterator winners_end = 
-                                    tournyParticipants.begin() + numWinners;
-
-        resultBuilder.addWinners(GGAGenomeVector(winners_beg, winners_end));
-         
-        GGAGenomeVector::const_iterator gitr;
-        for(gitr = winners_beg; gitr != winners_end; ++gitr) {
-            LOG("Winner of tournament " << tournyNum << "." << std::endl
-                    << "\tObjective: " << gitr->objValue() << std::endl
-                    << "\tDetails: " << gitr->toString());
+            Tournament& tourny = tournaments[last - 1];
+            tourny.runners[tourny.num_started++]->run(m_loop);
+            ++num_running;
         }
-                
-        numUsed += *itr;
-        LOG_VERY_VERBOSE("Ending tournament " << tournyNum << " of " << tournySizes.size());
-        tournyNum += 1;
 
-        // Collect evaluations
-        for (RunnerVector::size_type i = 0; i < m_runners.size(); ++i)
-            resultBuilder.increaseNumEvaluations(m_runners[i]->evals());
-        LOG("Number of evaluations in this generation so far: " <<
-            resultBuilder.getNumEvaluations() << std::endl); 
+        GGARunner* finished = m_loop.wait();
+        stopPoint();
+        if (finished == NULL)
+            continue;
+
+        // Register the runner that has just finished
+        size_t t = mapAt(index, finished).first;
+        Tournament& tourny = tournaments[t];
+        LOG("Registering runner " << finished << " of tournament " << t + 1 
+            << " as finished");
+
+        if (!m_runner_finished_handler.empty())
+            m_runner_finished_handler(t, mapAt(index, finished).second,
+                                      *finished);
+
+        num_running -= 1;
+        tourny.num_finished += 1;
+        tourny.best_time = std::min(tourny.best_time, finished->objValue());
+
+        // A propagated timeout applies to the tournaments still running,
+        // otherwise only to the tournament itself
+        if (m_propagate_timeout) {
+            timeout = std::min(timeout, tourny.best_time);
+            resetTimeout(tournaments, first, last, timeout);
+        } else {
+            resetTimeout(tournaments, t, t + 1, tourny.best_time);
+        }
 
-        killRunners();
-        cleanUpRunners();
+        // Winners are registered in the order of the tournaments
+        while (first < last && tournaments[first].num_finished
+                                    == tournaments[first].runners.size())
+        {
+            finishTournament(tournaments[first], first + 1, instances,
+                             resultBuilder);
+            ++first;
+        }
     }
+
+    killRunners();
+    cleanUpRunners();
     stopPoint();
     
     return resultBuilder.build();
@@ -306,28 +311,99 @@ GGASelectorResult GGALocalSelector::select(const GGAGenomeVector& participants,
 /**
  *
  */
-void GGALocalSelector::initializeTournament(const GGAGenomeVector& participants, 
+GGALocalSelector::Tournament::Tournament()
+    : participants()
+    , runners()
+    , num_started(0)
+    , num_finished(0)
+    , best_time(std::numeric_limits<double>::max())
+{ }
+
+
+/**
+ *
+ */
+void GGALocalSelector::initializeTournament(Tournament& tourny, 
+                                            size_t tournyIndex,
                                             const GGAInstanceVector& instances,
-                                            double timeout)
+                                            double timeout, RunnerIndex& index)
 {
     boost::unique_lock<boost::mutex> lock(m_runners_mutex);
 
     int id = 0;
     GGARunnerBuilder builder;
     GGAGenomeVector::const_iterator itr;
-    for(itr = participants.begin(); itr != participants.end(); ++itr) {
+    for(itr = tourny.participants.begin(); itr != tourny.participants.end(); ++itr) {
         builder.setId(id).setRuntimeTuning(m_runtime_tuning).setPenaltyFactor(m_penalty)
                 .setCpuLimit(m_cpu_limit).setInstances(&instances)
                 .setParameterTree(&GGAParameterTree::instance())
                 .setGenome(&(*itr));
         GGARunner* r = builder.build();
         r->resetTimeout(timeout);
+        index[r] = std::make_pair(tournyIndex, tourny.runners.size());
+        tourny.runners.push_back(r);
         m_runners.push_back(r);
         ++id;
     }
 }
 
 
+/**
+ * Registers the results of a tournament whose runners have all finished and
+ * adds its winners to the result.
+ */
+void GGALocalSelector::finishTournament(Tournament& tourny, unsigned tournyNum,
+                                        const GGAInstanceVector& instances,
+                                        GGASelectorResultBuilder& resultBuilder)
+{
+    // determine the number of winners
+    int numWinners = int(m_pct_winners * tourny.participants.size());
+    if(numWinners <= 0)
+        numWinners = 1;
+
+    // Register participants results
+    registerInstancesResults(tourny.runners, instances, tourny.participants,
+                             resultBuilder);
+    
+    // Sort & select winners
+    std::sort(tourny.participants.begin(), tourny.participants.end(),
+              GGAGenome::compareObjValueAscendingOrder);
+
+    GGAGenomeVector::const_iterator winners_beg = tourny.participants.begin();
+    GGAGenomeVector::const_iterator winners_end = 
+                                tourny.participants.begin() + numWinners;
+
+    resultBuilder.addWinners(GGAGenomeVector(winners_beg, winners_end));
+     
+    GGAGenomeVector::const_iterator gitr;
+    for(gitr = winners_beg; gitr != winners_end; ++gitr) {
+        LOG("Winner of tournament " << tournyNum << "." << std::endl
+                << "\tObjective: " << gitr->objValue() << std::endl
+                << "\tDetails: " << gitr->toString());
+    }
+            
+    LOG_VERY_VERBOSE("Ending tournament " << tournyNum);
+
+    // Collect evaluations
+    for (RunnerVector::size_type i = 0; i < tourny.runners.size(); ++i)
+        resultBuilder.increaseNumEvaluations(tourny.runners[i]->evals());
+    LOG("Number of evaluations in this generation so far: " <<
+        resultBuilder.getNumEvaluations() << std::endl); 
+}
+
+
+/**
+ * Resets the timeout of the runners of tournaments [first, last).
+ */
+void GGALocalSelector::resetTimeout(TournamentVector& tournaments, size_t first,
+                                    size_t last, double timeout)
+{
+    for (size_t t = first; t < last; ++t)
+        for (size_t i = 0; i < tournaments[t].runners.size(); ++i)
+            tournaments[t].runners[i]->resetTimeout(timeout);
+}
+
+
 /**
  *
  */
@@ -359,6 +435,12 @@ void GGALocalSelector::registerInstancesResults(const RunnerVector& runners,
  */
 void GGALocalSelector::killRunners()
 {
+    for (size_t i = 0; i < m_runners.size(); ++i)
+        m_runners[i]->stop();
+
+    if (!anyChildRunning(m_runners))
+        return;
+
     // 0.5s of sleep between warn and term.
     doWarn(m_runners);
     sleepFor(0, 500000000);
@@ -372,6 +454,24 @@ void GGALocalSelector::killRunners()
 }
 
 
+/*
+ * Returns whether or not it is safe to continue (all child processes
+ * accepted SIGTERM). The children are reaped by their runners as the loop
+ * reports their exit.
+ */
+bool GGALocalSelector::waitAfterTerm()
+{
+    double deadline = wallClockTime() + 0.5;
+    while (anyChildRunning(m_runners)) {
+        int remaining = int(1000 * (deadline - wallClockTime()));
+        if (remaining <= 0)
+            return false;
+        m_loop.dispatch(remaining);
+    }
+    return true;
+}
+
+
 /**
  *
  */
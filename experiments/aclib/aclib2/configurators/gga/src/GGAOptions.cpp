@@ -533,6 +533,10 @@ void GGAOptions::setUpFileOptions()
         ("traj_file", po::value<std::string>(&traj_file)->default_value(""),
             "Trajectory file output path")
 
+        ("cache_file", po::value<std::string>(&cache_file)->default_value(""),
+            "Append-only file caching target algorithm results across"
+            " generations and runs (disabled if empty)")
+
         ("scen_file", po::value<std::string>(&scen_file)->default_value(""),
             "Specify a scenario file as used by ParamILS/SMAC."
             " Note this file overrides certain command line options.")
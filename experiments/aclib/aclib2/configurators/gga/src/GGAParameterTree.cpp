@@ -246,6 +246,20 @@ void GGAParameterTree::parseTreeFile(const std::string& filename)
 
     validateSeededGenomes();
     propagateOrPaths();
+    indexParameters();
+}
+
+
+/**
+ *
+ */
+size_t GGAParameterTree::parameterId(const std::string& name) const
+{
+    std::map<std::string, size_t>::const_iterator itr = m_paramIds.find(name);
+    if (itr == m_paramIds.end())
+        throw GGAParameterException("[GGAParameterTree::parameterId] Unknown"
+                                    " parameter: " + name);
+    return itr->second;
 }
 
 
@@ -276,6 +290,10 @@ GGAParameterTree::GGAParameterTree()
     , m_seededGenomes()
     , m_paramnames()
     , m_forbidden()
+    , m_paramIds()
+    , m_paramsById()
+    , m_flatForbidden()
+    , m_flatNodes()
 { }
 
 
@@ -704,6 +722,57 @@ void GGAParameterTree::propagateOrPaths()
 }
 
 
+/**
+ * Numbers the parameters (in the order of parameters()) and translates the
+ * forbidden settings and the tree to parameter ids, so that genomes can
+ * store their values in a vector.
+ */
+void GGAParameterTree::indexParameters()
+{
+    m_paramnames.clear();
+    m_paramIds.clear();
+    m_paramsById.clear();
+
+    ParameterMap::const_iterator pitr;
+    for (pitr = m_parameters.begin(); pitr != m_parameters.end(); ++pitr) {
+        m_paramIds[pitr->first] = m_paramnames.size();
+        m_paramnames.push_back(pitr->first);
+        m_paramsById.push_back(pitr->second);
+    }
+
+    m_flatForbidden.clear();
+    std::vector<GenomeMap>::const_iterator fitr;
+    for (fitr = m_forbidden.begin(); fitr != m_forbidden.end(); ++fitr) {
+        FlatSetting setting;
+        GenomeMap::const_iterator gitr;
+        for (gitr = fitr->begin(); gitr != fitr->end(); ++gitr)
+            setting.push_back(std::make_pair(parameterId(gitr->first),
+                                             gitr->second));
+        m_flatForbidden.push_back(setting);
+    }
+
+    m_flatNodes.clear();
+    if (m_root.get() == NULL)
+        return;
+
+    // The const children of deserialized nodes are not restored
+    std::vector<GGATreeNode::pointer> queue(1, m_root);
+    std::vector<size_t> parents(1, parameterId(m_root->parameter()->name()));
+    for (size_t i = 0; i < queue.size(); ++i) {
+        GGAFlatNode node;
+        node.id = parameterId(queue[i]->parameter()->name());
+        node.parent = parents[i];
+        node.type = queue[i]->type();
+        m_flatNodes.push_back(node);
+
+        const std::vector<GGATreeNode::pointer>& children = 
+                                                        queue[i]->children();
+        queue.insert(queue.end(), children.begin(), children.end());
+        parents.insert(parents.end(), children.size(), node.id);
+    }
+}
+
+
 /**
  *
  */
@@ -34,19 +34,19 @@
 #include <fstream>
 #include <stdexcept>
 
+#include <fcntl.h>
 #include <sys/resource.h>
+#include <sys/syscall.h>
 #include <sys/wait.h>
 #include <sys/types.h>
+#include <unistd.h>
 
 #include <boost/algorithm/string/find.hpp>
 #include <boost/algorithm/string/predicate.hpp>
-#include <boost/bind.hpp>
-#include <boost/interprocess/sync/interprocess_semaphore.hpp>
-#include <boost/iostreams/device/file_descriptor.hpp>
-#include <boost/iostreams/stream.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/tokenizer.hpp>
 
+#include "GGAEvaluationCache.hpp"
 #include "GGAExceptions.hpp"
 #include "GGAOSProber.hpp"
 #include "GGARandEngine.hpp"
@@ -58,9 +58,6 @@
 # include <sys/prctl.h>
 #endif
 
-/* namespace(s) alias */
-namespace bio = boost::iostreams;
-
 /* Local typedefs */
 typedef boost::char_separator<char> CharSeparator;
 typedef boost::tokenizer<CharSeparator> CharTokenizer;
@@ -88,9 +85,8 @@ static inline double getUserTimeInSeconds(const struct rusage& ru)
  */
 GGARunner::~GGARunner() 
 {
-    // Interrupt and wait thread
-    m_runThread.interrupt();
-    m_runThread.join();
+    // Kill and wait the running command
+    interrupt();
 
     // Release commands
     m_commands.clear();
@@ -99,36 +95,55 @@ GGARunner::~GGARunner()
 
 /*
  * Begins execution of the target algorithm. Note that run() returns 
- * immediately due to thread creation.
- *
- * When this thread is done, it will unlock the sontrol to indicate that that
- * the objective value stored is final.
+ * immediately, the commands are run one after the other by the loop.
  *
+ * When all of them are done, the runner is returned by loop.wait() to
+ * indicate that the objective value stored is final.
  */
-void GGARunner::run(boost::interprocess::interprocess_semaphore& ctrlSem)
+void GGARunner::run(GGARunnerLoop& loop)
 {
-    if (!m_runThread.joinable() && !hasFinished()) {
-        m_runThread = boost::thread(boost::bind(
-            &GGARunner::runThread, this, boost::ref(ctrlSem)));
+    if (m_loop == NULL && !hasFinished()) {
+        m_loop = &loop;
+
+        // TODO Don't do this if we are setting the objective value from output
+        // (runtime or not)
+        if(objValue() > 0.0)
+            LOG("GGARunner::run(): Runner " << m_id << " starting with a"
+                " performance time of " << objValue() << ".");
+
+        runNextCommand();
     }
 }
 
 
 /*
- * Cancels the execution of the running thread. This call waits until the thread
- * has completely stopped.
+ * Discards the results of the running command and does not start the next
+ * ones. The selector is expected to signal the child.
+ */
+void GGARunner::stop()
+{
+    m_stopped = true;
+}
+
+
+/*
+ * Cancels the execution of the runner. This call waits until the running
+ * child (if any) has been killed.
  */
 void GGARunner::interrupt()
 {
-    if (m_runThread.joinable()) {
-        if (childPid() != 0)
-            kill(childPid(), SIGKILL);
-        m_runThread.interrupt();
-        try {
-            m_runThread.join();
-        } catch (boost::thread_interrupted& e)
-        { }
+    m_stopped = true;
+    if (m_running) {
+        if (!m_exited) {
+            ::kill(childPid(), SIGKILL);
+            reapChild(true);
+        }
+        closeChild();
+        m_running = false;
     }
+
+    if (m_loop != NULL)
+        m_loop->forget(this);
 }
 
 //==================================================================================================
@@ -141,6 +156,8 @@ GGARunner::GGARunner(int id, bool runtimeTuning, double penalty, unsigned cpuLim
                      const GGAInstanceVector& instances, const GGAParameterTree& ptree,
                      const GGAGenome& genome)
     : m_commands()
+    , m_commandInstances()
+    , m_cacheKeys()
     
     , m_id(id)    
     , m_runtimeTuning(runtimeTuning)
@@ -148,7 +165,19 @@ GGARunner::GGARunner(int id, bool runtimeTuning, double penalty, unsigned cpuLim
     , m_cpuLimit(cpuLimit)
     , m_instances(instances)
 
-    , m_runThread()
+    , m_loop(NULL)
+    , m_index(0)
+    , m_pipeFd(-1)
+    , m_pidFd(-1)
+    , m_running(false)
+    , m_exited(false)
+    , m_stopped(false)
+    , m_discard(false)
+    , m_status(0)
+    , m_rusage()
+    , m_line()
+    , m_lastLine()
+
     , m_rwMutex()
 
     , m_evals(0)
@@ -169,6 +198,9 @@ void GGARunner::buildCommands(const GGAParameterTree& ptree,
     setObjectiveValue(0.0);
     initializePerformanceData(m_instances.size());
     
+    GGAEvaluationCache& cache = GGAEvaluationCache::instance();
+    GenomeMap values = genome.genome(ptree);
+
     // Rotate so each runner starts with a different instance
     std::rotate(m_instances.begin(),
                 m_instances.begin() + this->m_id % m_instances.size(),
@@ -182,40 +214,51 @@ void GGARunner::buildCommands(const GGAParameterTree& ptree,
         if (pitr != genome.allPerformances().end()) {
             setObjectiveValue(objValue() + pitr->second);
             setPerformance(*itr, pitr->second);
-        } else {
-            std::string tcmd = makeCommand(ptree, genome.genome(), *itr);
-            LOG_DEBUG("GGAGenome (" << &genome << "): " << tcmd);
-                        
-            StringVector splitCmd;
-            CharSeparator separators(" \t\n\v");
-            CharTokenizer tok(tcmd, separators);
-            for(CharTokenizer::iterator it = tok.begin(); it != tok.end(); ++it)
-                splitCmd.push_back(*it);
-
-            m_commands.push_back(splitCmd);
+            continue;
+        }
+
+        std::string key;
+        if (cache.enabled()) {
+            GGAEvaluationCache::Entry entry;
+            key = cache.makeKey(ptree, values, *itr);
+            if (cache.lookup(key, m_cpuLimit, m_runtimeTuning, entry)) {
+                double perf = entry.censored && m_runtimeTuning ?
+                                m_cpuLimit * m_penalty : entry.value;
+                LOG_DEBUG("GGAGenome (" << &genome << "): cached result "
+                          << perf << " on " << itr->toString());
+                setObjectiveValue(objValue() + perf);
+                setPerformance(*itr, perf);
+                continue;
+            }
         }
+
+        std::string tcmd = makeCommand(ptree, values, *itr);
+        LOG_DEBUG("GGAGenome (" << &genome << "): " << tcmd);
+                    
+        StringVector splitCmd;
+        CharSeparator separators(" \t\n\v");
+        CharTokenizer tok(tcmd, separators);
+        for(CharTokenizer::iterator it = tok.begin(); it != tok.end(); ++it)
+            splitCmd.push_back(*it);
+
+        m_commands.push_back(splitCmd);
+        m_commandInstances.push_back(*itr);
+        m_cacheKeys.push_back(key);
     }
 }
 
 
 /**
- *
+ * Starts the next command which is not skipped because of the timeout. If
+ * there is none left, the runner has finished.
  */
-void GGARunner::runThread(boost::interprocess::interprocess_semaphore& ctrlSem) 
+void GGARunner::runNextCommand()
 {
-    // TODO Don't do this if we are setting the objective value from output
-    // (runtime or not)
-    if(objValue() > 0.0)
-        LOG("GGARunner::run(): Runner " << m_id << " starting with a"
-            " performance time of " << objValue() << ".");
-
-    for (size_t index = 0; index < m_commands.size(); ++index) {       
-        boost::this_thread::interruption_point();
-
+    for (; m_index < m_commands.size() && !m_stopped; ++m_index) {
         if (m_runtimeTuning && objValue() > getTimeout()) { 
             LOG("GGARunner::run(): Runner " << m_id << " skipping next instance"
-                " (" << index << ") due to timeout... (" << objValue() << " > "
-                <<  getTimeout() << ")");
+                " (" << m_index << ") due to timeout... (" << objValue() 
+                << " > " <<  getTimeout() << ")");
 
             //performance(index, m_cpu_limit);
             setObjectiveValue(objValue() + m_cpuLimit); // Old version does not do this.
@@ -223,19 +266,23 @@ void GGARunner::runThread(boost::interprocess::interprocess_semaphore& ctrlSem)
 
         } else if (!m_runtimeTuning) { 
             LOG("GGARunner::run(): Runner " << m_id << " skipping next instance"
-                " (" << index << ") due to timeout... (" << objValue() << " > "
-                <<  getTimeout() << ")");
+                " (" << m_index << ") due to timeout... (" << objValue() 
+                << " > " <<  getTimeout() << ")");
 
             setObjectiveValue(objValue() + m_cpuLimit * m_penalty);
             continue; 
         }
 
         LOG("GGARunner::run(): Runner " << m_id << " running next instance (" 
-            << index << ") ... (" << objValue() << " <= " <<  getTimeout() << ")");
-        runCommand(m_commands[index], index);
-        ++m_evals;
+            << m_index << ") ... (" << objValue() << " <= " <<  getTimeout() 
+            << ")");
+        if (runCommand(m_commands[m_index]))
+            return;
     }
 
+    if (m_stopped)
+        return;
+
     if (m_runtimeTuning) {
         LOG("*   Runner " << m_id << ": performance: " <<  objValue() 
             << "  cutoff: " << m_cpuLimit << "   penalty: " << m_penalty
@@ -244,64 +291,55 @@ void GGARunner::runThread(boost::interprocess::interprocess_semaphore& ctrlSem)
     }
 
     hasFinished(true);
-    ctrlSem.post();
+    m_loop->finished(this);
 }
 
 
 /**
- *
+ * Forks the target algorithm and registers its stdout (and pidfd) with the
+ * loop. Returns false if the child could not be started.
  */
-void GGARunner::runCommand(const StringVector& cmd, size_t index)
+bool GGARunner::runCommand(const StringVector& cmd)
 {
     int pfd[2];
-    if (-1 == ::pipe(pfd))
-        LOG_ERROR("Error creating pipe");
+    if (-1 == ::pipe(pfd)) {
+        LOG_ERROR("Error creating pipe: " << strerror(errno));
+        return false;
+    }
 
     pid_t cpid = fork();
 
     if(cpid == 0) {                // child
         runCommandChild(pfd, cmd);
-    } else if(cpid > 0) {          // parent
-        childPid(cpid);        
-        runCommandParent(pfd, cpid, index);
-    } else {                       // fork failed
+    } else if(cpid < 0) {          // fork failed
         LOG_ERROR("Failed to fork child!");
-        // TODO Exception!
+        ::close(pfd[0]); ::close(pfd[1]);
+        return false;
     }
-}
 
+    // parent
+    ::close(pfd[1]);
+    ::fcntl(pfd[0], F_SETFL, ::fcntl(pfd[0], F_GETFL) | O_NONBLOCK);
+    ::fcntl(pfd[0], F_SETFD, FD_CLOEXEC);
+
+    childPid(cpid);
+    m_running = true;
+    m_exited = false;
+    m_discard = false;
+    m_line.clear();
+    m_lastLine.clear();
+
+    m_pipeFd = pfd[0];
+    m_loop->watch(m_pipeFd, this);
+
+#if defined(OS_LINUX) && defined(SYS_pidfd_open)
+    // Without pidfds (kernels before 5.3) the child is waited for on EOF
+    m_pidFd = ::syscall(SYS_pidfd_open, cpid, 0);
+    if (m_pidFd >= 0)
+        m_loop->watch(m_pidFd, this);
+#endif
 
-/**
- * Parent code after fork
- */
-void GGARunner::runCommandParent(int pipe[2], const int child_pid,
-                                 const size_t index)
-{
-    bio::stream_buffer<bio::file_descriptor_source> 
-        fpstream(pipe[0], bio::close_handle); // Automatically closes pipe[0] 
-    std::istream in(&fpstream);
-    ::close(pipe[1]);
-
-    std::string last_line, line;
-    while(in) {
-        last_line = line; // The last getline fails and sets the error flags
-        // TODO Do the following:
-        // -- Optionally check for error state
-        // -- Optionally grab CPU time from the target algo
-        // -- None runtime scenarios need to grep for the objective            
-        std::getline(in, line);
-    }
-
-    struct rusage ru;
-    int status;
-    wait4(child_pid, &status, 0, &ru);
-    double user_time = getUserTimeInSeconds(ru);
-
-    double perf = m_runtimeTuning ? 
-                    computeRuntimePerformance(status, user_time, last_line) :
-                    computeOutputPerformance(status, last_line);
-    setPerformance(m_instances[index], perf);
-    setObjectiveValue(objValue() + perf);
+    return true;
 }
 
 
@@ -333,11 +371,146 @@ void GGARunner::runCommandChild(int pipe[2], const StringVector& cmd)
 }
 
 
+/**
+ * Called by the loop when the pipe or the pidfd of the child is ready.
+ */
+void GGARunner::handleEvents()
+{
+    if (!m_running)
+        return;
+
+    if (m_pipeFd >= 0)
+        readOutput();
+
+    if (!m_exited && m_pidFd >= 0)
+        reapChild(false);
+    else if (!m_exited && m_pipeFd < 0)
+        reapChild(true);
+
+    if (m_exited && m_pipeFd < 0)
+        commandFinished();
+}
+
+
+/**
+ * Reads the available output of the child, keeping only the last line.
+ */
+void GGARunner::readOutput()
+{
+    char buffer[4096];
+    ssize_t n;
+    while ((n = ::read(m_pipeFd, buffer, sizeof(buffer))) > 0) {
+        const char* p = buffer;
+        const char* end = buffer + n;
+        const char* nl;
+        while ((nl = static_cast<const char*>(memchr(p, '\n', end - p)))) {
+            m_line.append(p, nl);
+            m_lastLine.swap(m_line);
+            m_line.clear();
+            p = nl + 1;
+        }
+        m_line.append(p, end);
+    }
+
+    if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR))
+        return;
+
+    // EOF (or error)
+    if (!m_line.empty())
+        m_lastLine.swap(m_line);
+    m_loop->unwatch(m_pipeFd);
+    ::close(m_pipeFd);
+    m_pipeFd = -1;
+}
+
+
+/**
+ *
+ */
+void GGARunner::reapChild(bool block)
+{
+    pid_t res;
+    do {
+        res = ::wait4(childPid(), &m_status, block ? 0 : WNOHANG, &m_rusage);
+    } while (res < 0 && errno == EINTR);
+
+    if (res == 0)
+        return; // still running
+
+    if (res < 0) {
+        LOG_ERROR("GGARunner: Runner " << m_id << " lost child " << childPid()
+                  << ": " << strerror(errno));
+        m_discard = true;
+        std::memset(&m_rusage, 0, sizeof(m_rusage));
+    }
+
+    m_exited = true;
+    childPid(0);
+    if (m_pidFd >= 0) {
+        m_loop->unwatch(m_pidFd);
+        ::close(m_pidFd);
+        m_pidFd = -1;
+    }
+}
+
+
+/**
+ * The child has exited and its output has been read: registers its
+ * performance and starts the next command.
+ */
+void GGARunner::commandFinished()
+{
+    m_running = false;
+    if (m_stopped)
+        return;
+
+    double user_time = getUserTimeInSeconds(m_rusage);
+
+    bool censored = false;
+    double perf = m_runtimeTuning ? 
+                    computeRuntimePerformance(m_status, user_time, m_lastLine,
+                                              censored) :
+                    computeOutputPerformance(m_status, m_lastLine);
+    setPerformance(m_commandInstances[m_index], perf);
+    setObjectiveValue(objValue() + perf);
+    ++m_evals;
+
+    if (!m_discard) {
+        GGAEvaluationCache::Entry entry(censored ? m_cpuLimit : 
+                                            (m_runtimeTuning ? user_time : perf),
+                                        censored, m_cpuLimit);
+        GGAEvaluationCache::instance().store(m_cacheKeys[m_index], entry);
+    }
+
+    ++m_index;
+    runNextCommand();
+}
+
+
+/**
+ *
+ */
+void GGARunner::closeChild()
+{
+    if (m_pipeFd >= 0) {
+        m_loop->unwatch(m_pipeFd);
+        ::close(m_pipeFd);
+        m_pipeFd = -1;
+    }
+    if (m_pidFd >= 0) {
+        m_loop->unwatch(m_pidFd);
+        ::close(m_pidFd);
+        m_pidFd = -1;
+    }
+}
+
+
 /**
  *
  */
 double GGARunner::computeRuntimePerformance(int exit_status, double user_time,
-                                            const std::string& last_line)
+                                            const std::string& last_line,
+                                            bool& censored)
 {
     static const std::string CRASHED_STR("CRASHED");
 
@@ -350,12 +523,14 @@ double GGARunner::computeRuntimePerformance(int exit_status, double user_time,
                 crashed = true;
         }
 
-        if (crashed || user_time > (m_cpuLimit - 0.5))
+        censored = crashed || user_time > (m_cpuLimit - 0.5);
+        if (censored)
             return m_cpuLimit * m_penalty;
         else
             return user_time;
 
     } else {//if (WIFSIGNALED(exit_status)) {
+        censored = true;
         return m_cpuLimit * m_penalty;
     }
 }
@@ -0,0 +1,263 @@
+//
+// This file is part of DGGA.
+// 
+// The MIT License (MIT)
+// 
+// Copyright (c) 2015 Kevin Tierney and Josep Pon Farreny
+// 
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+// 
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+// 
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+// THE SOFTWARE.
+
+
+
+#include <cerrno>
+#include <cstring>
+
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "GGAOSProber.hpp"
+
+#if defined(OS_LINUX)
+# include <sys/epoll.h>
+#else
+# include <poll.h>
+#endif
+
+#include "GGARunner.hpp"
+#include "GGARunnerLoop.hpp"
+#include "OutputLog.hpp"
+
+//==============================================================================
+// Functions local to this file
+
+/**
+ *
+ */
+static void setNonBlockingCloseOnExec(int fd)
+{
+    ::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK);
+    ::fcntl(fd, F_SETFD, ::fcntl(fd, F_GETFD) | FD_CLOEXEC);
+}
+
+
+//==============================================================================
+// GGARunnerLoop public methods
+
+/**
+ *
+ */
+GGARunnerLoop::GGARunnerLoop()
+#if defined(OS_LINUX)
+    : m_epollFd(::epoll_create1(EPOLL_CLOEXEC))
+#else
+    : m_fds()
+#endif
+    , m_wokenUp(false)
+    , m_finished()
+{
+#if defined(OS_LINUX)
+    if (m_epollFd < 0)
+        throw std::runtime_error(std::string("[GGARunnerLoop] Unable to"
+            " create epoll instance: ") + std::strerror(errno));
+#endif
+
+    if (::pipe(m_wakeUpPipe) != 0)
+        throw std::runtime_error(std::string("[GGARunnerLoop] Unable to"
+            " create wake up pipe: ") + std::strerror(errno));
+    setNonBlockingCloseOnExec(m_wakeUpPipe[0]);
+    setNonBlockingCloseOnExec(m_wakeUpPipe[1]);
+
+    watch(m_wakeUpPipe[0], NULL);
+}
+
+
+/**
+ *
+ */
+GGARunnerLoop::~GGARunnerLoop()
+{
+#if defined(OS_LINUX)
+    ::close(m_epollFd);
+#endif
+    ::close(m_wakeUpPipe[0]);
+    ::close(m_wakeUpPipe[1]);
+}
+
+
+/**
+ * Returns the next runner which has finished, or NULL if the loop has been
+ * woken up or the timeout (in milliseconds, -1 waits forever) has expired.
+ */
+GGARunner* GGARunnerLoop::wait(int timeout_ms)
+{
+    while (m_finished.empty() && !m_wokenUp) {
+        if (!dispatch(timeout_ms))
+            return NULL;
+    }
+
+    if (m_finished.empty()) {
+        m_wokenUp = false;
+        return NULL;
+    }
+
+    GGARunner* runner = m_finished.front();
+    m_finished.pop_front();
+    return runner;
+}
+
+
+/**
+ * Waits for events for at most timeout_ms milliseconds and hands them to the
+ * runners. Returns false if the timeout expired without any event.
+ */
+bool GGARunnerLoop::dispatch(int timeout_ms)
+{
+#if defined(OS_LINUX)
+    struct epoll_event events[64];
+    int n = ::epoll_wait(m_epollFd, events, 64, timeout_ms);
+    if (n < 0) {
+        if (errno != EINTR)
+            LOG_ERROR("[GGARunnerLoop::dispatch] epoll_wait failed: "
+                      << std::strerror(errno));
+        return true;
+    }
+
+    // A runner may get two events (pipe and pidfd), the second is harmless
+    for (int i = 0; i < n; ++i) {
+        GGARunner* runner = static_cast<GGARunner*>(events[i].data.ptr);
+        if (runner == NULL)
+            clearWakeUp();
+        else
+            runner->handleEvents();
+    }
+#else
+    std::vector<struct pollfd> fds;
+    std::vector<GGARunner*> runners;
+    std::map<int, GGARunner*>::const_iterator itr;
+    for (itr = m_fds.begin(); itr != m_fds.end(); ++itr) {
+        struct pollfd pfd;
+        pfd.fd = itr->first;
+        pfd.events = POLLIN;
+        pfd.revents = 0;
+        fds.push_back(pfd);
+        runners.push_back(itr->second);
+    }
+
+    int n = ::poll(&fds[0], fds.size(), timeout_ms);
+    if (n < 0) {
+        if (errno != EINTR)
+            LOG_ERROR("[GGARunnerLoop::dispatch] poll failed: "
+                      << std::strerror(errno));
+        return true;
+    }
+
+    // Runners may (un)register descriptors while handling their events
+    for (size_t i = 0; i < fds.size(); ++i) {
+        if (fds[i].revents == 0)
+            continue;
+        if (runners[i] == NULL)
+            clearWakeUp();
+        else
+            runners[i]->handleEvents();
+    }
+#endif
+    return n > 0;
+}
+
+
+/**
+ * Makes the current (or next) wait() return. Can be called from any thread.
+ */
+void GGARunnerLoop::wakeUp()
+{
+    char c = 0;
+    if (::write(m_wakeUpPipe[1], &c, 1) < 0 && errno != EAGAIN)
+        LOG_ERROR("[GGARunnerLoop::wakeUp] write failed: " 
+                  << std::strerror(errno));
+}
+
+
+/**
+ *
+ */
+void GGARunnerLoop::watch(int fd, GGARunner* runner)
+{
+#if defined(OS_LINUX)
+    struct epoll_event ev;
+    std::memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = runner;
+    if (::epoll_ctl(m_epollFd, EPOLL_CTL_ADD, fd, &ev) != 0)
+        throw std::runtime_error(std::string("[GGARunnerLoop::watch] Unable"
+            " to watch descriptor: ") + std::strerror(errno));
+#else
+    m_fds[fd] = runner;
+#endif
+}
+
+
+/**
+ *
+ */
+void GGARunnerLoop::unwatch(int fd)
+{
+#if defined(OS_LINUX)
+    struct epoll_event ev;
+    ::epoll_ctl(m_epollFd, EPOLL_CTL_DEL, fd, &ev);
+#else
+    m_fds.erase(fd);
+#endif
+}
+
+
+/**
+ *
+ */
+void GGARunnerLoop::finished(GGARunner* runner)
+{
+    m_finished.push_back(runner);
+}
+
+/**
+ * Drops a runner from the finished runners not yet returned by wait().
+ */
+void GGARunnerLoop::forget(GGARunner* runner)
+{
+    std::deque<GGARunner*>::iterator itr;
+    for (itr = m_finished.begin(); itr != m_finished.end(); )
+        itr = (*itr == runner) ? m_finished.erase(itr) : itr + 1;
+}
+
+//==============================================================================
+// GGARunnerLoop private methods
+
+/**
+ *
+ */
+void GGARunnerLoop::clearWakeUp()
+{
+    char buffer[64];
+    while (::read(m_wakeUpPipe[0], buffer, sizeof(buffer)) > 0)
+        ;
+    m_wokenUp = true;
+}
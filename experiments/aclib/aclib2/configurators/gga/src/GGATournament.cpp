@@ -110,7 +110,7 @@ void GGATournament::run()
                      extra);
 
     LOG("Final most fit command: " << makeCommand(GGAParameterTree::instance(),
-                                                  mostFit_.genome(), inst));
+                        mostFit_.genome(GGAParameterTree::instance()), inst));
     
     /*LOG_DEBUG("---- Instances statistics ----")
     for (size_t i = 0; i < m_instances.getNumberOfInstances(); ++i) {
@@ -229,12 +229,13 @@ const GGAGenomeVector GGATournament::performSelection(const GGAInstanceVector& i
     const GGAOptions& opts = GGAOptions::instance();
     StringVector extra;
     extra.push_back("SATISFIABLE");
-    std::string command = makeCommand(GGAParameterTree::instance(), mf.genome(),
+    const GGAParameterTree& ptree = GGAParameterTree::instance();
+    std::string command = makeCommand(ptree, mf.genome(ptree),
         GGAInstance(123456789, opts.target_algo_cpu_limit,
             "instance_here", extra));
 
     LOG("Generation " << gen_ << " most fit cmd: " << command);
-    outputTrajectory(GGAParameterTree::instance(), mf.genome(), 
+    outputTrajectory(ptree, mf.genome(ptree), 
                      userTime(), wallClockTime());
     LOG("Generation " << gen_ << " number of evaluations so far: " 
         << evalCount_);
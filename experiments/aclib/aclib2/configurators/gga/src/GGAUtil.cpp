@@ -253,6 +253,7 @@ void printOptions()
     LOG("Configuration file: \"" << opts.conf_file << "\"");
     LOG("Trajectory file: \"" << opts.traj_file << "\"");
     LOG("Scenario file (in): \"" << opts.scen_file << "\"");
+    LOG("Evaluation cache file: \"" << opts.cache_file << "\"");
     LOG("---");
     LOG("Run as master: " << opts.master);
     LOG("Run as worker: " << opts.worker);
@@ -26,6 +26,7 @@
 
 #include <stdexcept>
 
+#include <boost/functional/hash.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/regex.hpp>
 
@@ -67,9 +68,7 @@ GGAValue GGAValue::getValueFromStr(const std::string& str, ValueType forceType)
  */
 GGAValue::GGAValue()
     : m_type(UNKNOWN)
-    , m_boolValue()
-    , m_longValue()
-    , m_dblValue()
+    , m_longValue(0)
     , m_strValue()
 { }
 
@@ -79,21 +78,23 @@ GGAValue::GGAValue()
  */
 GGAValue::GGAValue(const GGAValue& cpy)
     : m_type(cpy.m_type)
-    , m_boolValue(m_type == BOOL ? new bool(*cpy.m_boolValue) : 0)
-    , m_longValue(m_type == LONG ? new long(*cpy.m_longValue) : 0)
-    , m_dblValue(m_type == DOUBLE ? new double(*cpy.m_dblValue) : 0)
-    , m_strValue(m_type == STRING ? new std::string(*cpy.m_strValue) : 0)
-    
-{ }
+    , m_longValue(0)
+    , m_strValue(cpy.m_strValue)
+{ 
+    if (m_type == BOOL)
+        m_boolValue = cpy.m_boolValue;
+    else if (m_type == LONG)
+        m_longValue = cpy.m_longValue;
+    else if (m_type == DOUBLE)
+        m_dblValue = cpy.m_dblValue;
+}
 
 /**
  *
  */
 GGAValue::GGAValue(bool val) 
     : m_type(BOOL)
-    , m_boolValue(new bool(val))
-    , m_longValue()
-    , m_dblValue()
+    , m_boolValue(val)
     , m_strValue() 
 { }
 
@@ -102,9 +103,7 @@ GGAValue::GGAValue(bool val)
  */
 GGAValue::GGAValue(long val)
     : m_type(LONG)
-    , m_boolValue()
-    , m_longValue(new long(val))
-    , m_dblValue()
+    , m_longValue(val)
     , m_strValue()
 { }
 
@@ -114,9 +113,7 @@ GGAValue::GGAValue(long val)
  */
 GGAValue::GGAValue(double val) 
     : m_type(DOUBLE)
-    , m_boolValue()
-    , m_longValue()
-    , m_dblValue(new double(val))
+    , m_dblValue(val)
     , m_strValue()    
 { }
 
@@ -125,10 +122,8 @@ GGAValue::GGAValue(double val)
  */
 GGAValue::GGAValue(const std::string& val)
     : m_type(STRING)
-    , m_boolValue()
-    , m_longValue()
-    , m_dblValue()
-    , m_strValue(new std::string(val))
+    , m_longValue(0)
+    , m_strValue(val)
 { }
 
 
@@ -144,9 +139,8 @@ GGAValue::~GGAValue()
  */
 void GGAValue::setValue(bool val) 
 {
-    resetValues();
-
-    m_boolValue.reset(new bool(val));
+    m_strValue.clear();
+    m_boolValue = val;
     m_type = BOOL;
 }
 
@@ -156,9 +150,8 @@ void GGAValue::setValue(bool val)
  */
 void GGAValue::setValue(long val)
 {
-    resetValues();
-
-    m_longValue.reset(new long(val));
+    m_strValue.clear();
+    m_longValue = val;
     m_type = LONG;
 }
 
@@ -169,9 +162,8 @@ void GGAValue::setValue(long val)
  */
 void GGAValue::setValue(double val) 
 {
-    resetValues();
-    
-    m_dblValue.reset(new double(val));
+    m_strValue.clear();
+    m_dblValue = val;
     m_type = DOUBLE;
 }
 
@@ -181,9 +173,7 @@ void GGAValue::setValue(double val)
  */
 void GGAValue::setValue(const std::string& val) 
 {
-    resetValues();
-
-    m_strValue.reset(new std::string(val));
+    m_strValue = val;
     m_type = STRING;
 }
 
@@ -194,7 +184,7 @@ void GGAValue::setValue(const std::string& val)
 bool GGAValue::getBool() const
 {
     if(isBool())
-        return *m_boolValue;
+        return m_boolValue;
     else
         throw std::domain_error("Attempted to access a bool value in GGAValue"
             "that is not storing a bool value.");
@@ -207,7 +197,7 @@ bool GGAValue::getBool() const
 long GGAValue::getLong() const
 {
     if(isLong())
-        return *m_longValue;
+        return m_longValue;
     else
         throw std::domain_error("Attempted to access a long value in GGAValue"
             "that is not storing a long value.");
@@ -220,7 +210,7 @@ long GGAValue::getLong() const
 double GGAValue::getDouble() const
 {
     if(isDouble())
-        return *m_dblValue;
+        return m_dblValue;
     else
         throw std::domain_error("Attempted to access a double value in GGAValue"
             "that is not storing a double value.");
@@ -233,7 +223,7 @@ double GGAValue::getDouble() const
 const std::string& GGAValue::getString() const
 {
     if(isString())
-        return *m_strValue;
+        return m_strValue;
     else
         throw std::domain_error("Attempted to access a string value in GGAValue"
             "that is not storing a string value.");
@@ -245,41 +235,70 @@ const std::string& GGAValue::getString() const
  */
 std::string GGAValue::toString() const {
     std::stringstream ss;
-    if(isLong() && m_longValue.get())
-        ss << *m_longValue;
-    else if(isBool() && m_boolValue.get())
-        ss << *m_boolValue;
-    else if(isDouble() && m_dblValue.get())
-        ss << *m_dblValue;
-    else if(isString() && m_strValue.get())
-        ss << *m_strValue;
+    if(isLong())
+        ss << m_longValue;
+    else if(isBool())
+        ss << m_boolValue;
+    else if(isDouble())
+        ss << m_dblValue;
+    else if(isString())
+        ss << m_strValue;
 
     return ss.str();
 }
 
 
+/**
+ * Hash of the type and the value, equal values have equal hashes.
+ */
+std::size_t GGAValue::hash() const
+{
+    std::size_t seed = static_cast<std::size_t>(m_type);
+    switch (m_type) {
+        case BOOL:
+            boost::hash_combine(seed, m_boolValue);
+            break;
+        case LONG:
+            boost::hash_combine(seed, m_longValue);
+            break;
+        case DOUBLE:
+            boost::hash_combine(seed, m_dblValue);
+            break;
+        case STRING:
+            boost::hash_combine(seed, m_strValue);
+            break;
+        default:
+            break;
+    }
+    return seed;
+}
+
+
 /**
  *
  */
 GGAValue& GGAValue::operator=(const GGAValue& cpy)
 {
-    resetValues();
     m_type = cpy.m_type;
 
     switch (cpy.m_type) {
         case BOOL:
-            m_boolValue.reset(new bool(*cpy.m_boolValue));
+            m_boolValue = cpy.m_boolValue;
+            m_strValue.clear();
             break;
         case LONG:
-            m_longValue.reset(new long(*cpy.m_longValue));
+            m_longValue = cpy.m_longValue;
+            m_strValue.clear();
             break;
         case DOUBLE:
-            m_dblValue.reset(new double(*cpy.m_dblValue));
+            m_dblValue = cpy.m_dblValue;
+            m_strValue.clear();
             break;
         case STRING:
-            m_strValue.reset(new std::string(*cpy.m_strValue));
+            m_strValue = cpy.m_strValue;
             break;
         default:
+            m_strValue.clear();
             break;
     }
 
@@ -292,35 +311,24 @@ GGAValue& GGAValue::operator=(const GGAValue& cpy)
  */
 bool GGAValue::operator==(const GGAValue& other) const
 {
-    if(isLong() && other.isLong())
-        return getLong() == other.getLong();
-    if(isBool() && other.isBool())
-        return getBool() == other.getBool();
-    if(isDouble() && other.isDouble())
-        return getDouble() == other.getDouble();
-    if(isString() && other.isString())
-        return getString() == other.getString();
-
-    return false;
-}
-
-
-//==============================================================================
-// GGAValue private methods
-
-/**
- *
- */
-void GGAValue::resetValues()
-{
-    m_type = UNKNOWN;
+    if(m_type != other.m_type)
+        return false;
 
-    m_longValue.reset();
-    m_boolValue.reset();
-    m_dblValue.reset();
-    m_strValue.reset();
+    switch (m_type) {
+        case BOOL:
+            return m_boolValue == other.m_boolValue;
+        case LONG:
+            return m_longValue == other.m_longValue;
+        case DOUBLE:
+            return m_dblValue == other.m_dblValue;
+        case STRING:
+            return m_strValue == other.m_strValue;
+        default:
+            return false;
+    }
 }
 
+
 //==============================================================================
 // GGAValue stream
 
@@ -13,23 +13,23 @@
 // You should have received a copy of the GNU General Public License
 // along with GGA.  If not, see <http://www.gnu.org/licenses/>.
 
+#include <algorithm>
 #include <cassert>
 #include <cerrno>
 #include <cstring>
 #include <stdexcept>
 
-#include <boost/algorithm/string/trim.hpp>
-#include <boost/archive/text_iarchive.hpp>
 #include <boost/archive/text_oarchive.hpp>
 #include <boost/bind.hpp>
 #include <boost/bind/placeholders.hpp> // _1, _2, ..., _9
-#include <boost/serialization/vector.hpp>
 
+#include "GGAExceptions.hpp"
 #include "GGAOptions.hpp"
 #include "GGAUtil.hpp"
 #include "OutputLog.hpp"
 
 #include "dgga/dgga_messages.hpp"
+#include "dgga/dgga_wire.hpp"
 #include "dgga/DGGARemoteSelectorMaster.hpp"
 
 //==============================================================================
@@ -59,7 +59,7 @@ DGGARemoteSelectorMaster::DGGARemoteSelectorMaster(
     , connections_()
     , connectionIdle_()
     , connectionAddr_()
-    , connectionResults_()
+    , connectionPerformances_()
 
     , ioService(io_service)
     , acceptor_(ioService, GGAOptions::instance().port)
@@ -92,7 +92,7 @@ GGASelectorResult DGGARemoteSelectorMaster::select(const GGAGenomeVector& partic
                 << OutputLog::uintVectorToString(tourneySizes_) << "]");
 
         startWorkers(); // Tries to wake up some workers
-        pollWorkers();
+        dispatchTourneys();
 
         while (participants_.size() > 0 || nparticipantsCompeting_ > 0)
             ioService.run_one();
@@ -121,14 +121,18 @@ void DGGARemoteSelectorMaster::startWorkers()
 
 
 /**
- *
+ * Sends tourneys to every idle worker.
  */
-void DGGARemoteSelectorMaster::pollWorkers()
+void DGGARemoteSelectorMaster::dispatchTourneys()
 {
     std::set<DGGATcpConnection::pointer>::iterator it;
-    for (it = connections_.begin(); it != connections_.end(); ++it)
-        if (connectionIdle_[*it])
-            (*it)->sendMessage(DGGA_MSG_POLL);
+    for (it = connections_.begin(); it != connections_.end(); ++it) {
+        if (connectionIdle_[*it] && sendTourneys(*it)) {
+            (*it)->setNewMessageHandler(boost::bind(
+                &DGGARemoteSelectorMaster::handleWorkingState, this, _1, _2));
+            connectionIdle_[*it] = false;
+        }
+    }
 }
 
 
@@ -151,7 +155,7 @@ void DGGARemoteSelectorMaster::handleNewConnection(DGGATcpConnection::pointer co
     } catch (...) { 
         connectionAddr_[con] = "addr_here";
     }
-    connectionResults_[con].clear();
+    connectionPerformances_[con].clear();
 }
 
 
@@ -164,14 +168,14 @@ void DGGARemoteSelectorMaster::handleDisconnection(
     LOG("Disconnected (" << mapAt(connectionAddr_, con) << ")");
 
     // Rollback any unfinished tourney associated with con
-    rollbackTourney(con);
+    rollbackTourneys(con);
 
     // Clean up data
     participantsInWorker_.erase(con);
 
     connections_.erase(con);
     connectionIdle_.erase(con);
-    connectionResults_.erase(con);
+    connectionPerformances_.erase(con);
 
     con->close();
 
@@ -179,7 +183,7 @@ void DGGARemoteSelectorMaster::handleDisconnection(
     
     if (participants_.size() > 0 || nparticipantsCompeting_ > 0) {
         startWorkers();
-        pollWorkers();
+        dispatchTourneys();
     }
 }
 
@@ -216,9 +220,7 @@ void DGGARemoteSelectorMaster::handleGetConfig(DGGATcpConnection::pointer con,
         oa << GGAOptions::instance();
         oa << GGAParameterTree::instance();
 
-        con->sendMessage(DGGA_MSG_CONFIGURATION_BEG);
-        con->sendMessage(ss.str());
-        con->sendMessage(DGGA_MSG_CONFIGURATION_END);
+        con->sendMessage(makeMessage(DGGA_MSG_CONFIGURATION, ss.str()));
 
         con->setNewMessageHandler(boost::bind(
             &DGGARemoteSelectorMaster::handleConfigAck, this, _1, _2));
@@ -244,7 +246,7 @@ void DGGARemoteSelectorMaster::handleConfigAck(DGGATcpConnection::pointer con,
         requestedNodes_ -= 1;
         avaliableNodes_ += 1;
 
-        con->sendMessage(DGGA_MSG_POLL);
+        dispatchTourneys();
     } else {
         LOG_ERROR("[DGGARemoteSelectorMaster::handleConfigAck] Unexpected"
                   " message, communication sequence broken ... Disconnecting");
@@ -259,15 +261,9 @@ void DGGARemoteSelectorMaster::handleConfigAck(DGGATcpConnection::pointer con,
 void DGGARemoteSelectorMaster::handleIDLEState(DGGATcpConnection::pointer con,
                                                const std::string& msg)
 {
-    if (DGGA_MSG_READY == msg) {
-        if (sendTourney(con)) {
-            con->setNewMessageHandler(boost::bind(
-                &DGGARemoteSelectorMaster::handleWorkingState, this, _1, _2));
-            connectionIdle_[con] = false;
-        }
-    } else {
-        LOG_ERROR("IDLE unexpected (" << mapAt(connectionAddr_, con) << "): " << msg);
-        LOG_ERROR("----  Received message ----\n" << msg);
+    if (DGGA_MSG_READY != msg) {
+        LOG_ERROR("IDLE unexpected (" << mapAt(connectionAddr_, con) << "): "
+                  << messageTag(msg));
     }
 }
 
@@ -279,57 +275,39 @@ void DGGARemoteSelectorMaster::handleWorkingState(
                                                 DGGATcpConnection::pointer con,
                                                 const std::string& msg)
 {
-    if (DGGA_MSG_RESULTS_BEG == msg) {
-        con->setNewMessageHandler(boost::bind(
-            &DGGARemoteSelectorMaster::handleResultsState, this, _1, _2));
-    } else if (DGGA_MSG_WORKING == msg) {
-        LOG_VERBOSE("Polled worker is working!");
-    } else {
-        LOG_ERROR("Working unexpected (" << mapAt(connectionAddr_, con) << ")");
-        LOG_ERROR("----  Received message ----\n" << msg);
-    }
-}
-
-
-/**
- *
- */
-void DGGARemoteSelectorMaster::handleResultsState(DGGATcpConnection::pointer con,
-                                                  const std::string& msg)
-{
-    if (DGGA_MSG_RESULTS_END == msg) {
-       LOG("Recovering tournament results (" << mapAt(connectionAddr_, con) << ")");
-       recoverResults(connectionResults_[con]);
-
-        GGAGenomeVector& con_participants = participantsInWorker_[con];
-        nparticipantsCompeting_ -= con_participants.size();
-        con_participants.clear();
-
-        // Clear buffer (forcing memory release)
-        std::string().swap(connectionResults_[con]);
+    std::string tag = messageTag(msg);
+    if (DGGA_MSG_RUN == tag) {
+        try {
+            recoverRun(con, messageBody(msg));
+        } catch (GGAException& e) {
+            // The disconnection handler rolls the tourneys back
+            LOG_ERROR(e.what() << " ... Disconnecting");
+            con->close();
+        }
+    } else if (DGGA_MSG_TOURNEYS_DONE == tag) {
+        LOG("Recovering tournament results (" << mapAt(connectionAddr_, con) << ")");
+        finishTourneys(con, messageBody(msg));
 
         con->setNewMessageHandler(boost::bind(
             &DGGARemoteSelectorMaster::handleIDLEState, this, _1, _2));
         connectionIdle_[con] = true;
 
-        // Propagate timeout updated in recoverResults(...)
-        if (propagateTimeout_)
-            resetTimeout();
-        
-        // If there are remaining participants, poll the worker again.
-        if (!participants_.empty())
-            con->sendMessage(DGGA_MSG_POLL);
+        // If there are remaining participants, keep the worker busy.
+        dispatchTourneys();
+    } else if (DGGA_MSG_WORKING == msg) {
+        LOG_VERBOSE("Polled worker is working!");
     } else {
-        // Initializes results buffer if necessary and appends new data
-        connectionResults_[con].append(msg);
+        LOG_ERROR("Working unexpected (" << mapAt(connectionAddr_, con) << "): "
+                  << tag);
     }
 }
 
 
 /**
- * Sends tourney instances and genomes.
+ * Sends a batch of tourneys: timeout, instance table and the genomes of each
+ * tourney. The remaining tourneys are shared out among the workers.
  */
-bool DGGARemoteSelectorMaster::sendTourney(DGGATcpConnection::pointer con)
+bool DGGARemoteSelectorMaster::sendTourneys(DGGATcpConnection::pointer con)
 {
     assert(participantsInWorker_[con].empty());
     assert(tourneySizes_.empty() == participants_.empty());
@@ -337,31 +315,59 @@ bool DGGARemoteSelectorMaster::sendTourney(DGGATcpConnection::pointer con)
     if (participants_.empty())
         return false;
 
+    // Workers still starting up get their share too
+    size_t nworkers = std::max<size_t>(std::max(nodes_, avaliableNodes_), 1);
+    size_t ntourneys = (tourneySizes_.size() + nworkers - 1) / nworkers;
+
     // Start from the back because this way it is more efficient.
-    assert(tourneySizes_.back() > 0);
-    size_t start = participants_.size() - tourneySizes_.back(); 
-    
-    GGAGenomeVector& wparticipants = participantsInWorker_[con];
-    wparticipants.assign(participants_.begin() + start, participants_.end());
-    participants_.erase(participants_.begin() + start, participants_.end());
-
-    nparticipantsCompeting_ += tourneySizes_.back();
-    tourneySizes_.pop_back();
-
-    // MSG_TOURNEY_BEG
-    // #instances instances #genomes genomes 1..m
-    // MSG_TOURNEY_END
-    std::stringstream ss;
-    boost::archive::text_oarchive oa(ss);
-    
-    oa << boost::serialization::make_nvp(DGGA_TIMEOUT_TAG, timeout_);
-    oa << boost::serialization::make_nvp(DGGA_INSTANCES_TAG, instances_);
-    oa << boost::serialization::make_nvp(DGGA_PARTICIPANTS_TAG, wparticipants);
+    std::vector<GGAGenomeVector>& wtourneys = participantsInWorker_[con];
+    for (size_t i = 0; i < ntourneys; ++i) {
+        assert(tourneySizes_.back() > 0);
+        size_t start = participants_.size() - tourneySizes_.back(); 
+
+        wtourneys.push_back(GGAGenomeVector(participants_.begin() + start,
+                                            participants_.end()));
+        participants_.erase(participants_.begin() + start, participants_.end());
+
+        nparticipantsCompeting_ += tourneySizes_.back();
+        tourneySizes_.pop_back();
+    }
+
+    // The instances to run come first in the table, then the ones the
+    // genomes already have a performance for
+    GGAInstanceVector table(instances_);
+    DGGAInstanceIndex index;
+    for (size_t i = 0; i < table.size(); ++i)
+        index[table[i]] = i;
+    for (size_t t = 0; t < wtourneys.size(); ++t) {
+        for (size_t g = 0; g < wtourneys[t].size(); ++g) {
+            const GGAInstancePerformanceMap& perfs = 
+                                            wtourneys[t][g].allPerformances();
+            GGAInstancePerformanceMap::const_iterator itr;
+            for (itr = perfs.begin(); itr != perfs.end(); ++itr)
+                addToInstanceIndex(itr->first, table, index);
+        }
+    }
 
-    con->sendMessage(DGGA_MSG_TOURNEY_BEG);
-    con->sendMessage(ss.str());
-    con->sendMessage(DGGA_MSG_TOURNEY_END);
-    LOG("Tournament sent (" << mapAt(connectionAddr_, con) << ")");
+    std::string body;
+    DGGAWireWriter out(body);
+
+    out.putDouble(timeout_);
+    out.putUInt(instances_.size());
+    out.putUInt(table.size());
+    for (size_t i = 0; i < table.size(); ++i)
+        out.putInstance(table[i]);
+
+    out.putUInt(wtourneys.size());
+    for (size_t t = 0; t < wtourneys.size(); ++t) {
+        out.putUInt(wtourneys[t].size());
+        for (size_t g = 0; g < wtourneys[t].size(); ++g)
+            out.putGenome(wtourneys[t][g], index);
+    }
+
+    con->sendMessage(makeMessage(DGGA_MSG_TOURNEYS, body));
+    LOG("Tournaments sent (" << mapAt(connectionAddr_, con) << "): "
+        << wtourneys.size());
 
     return true;
 }
@@ -370,43 +376,103 @@ bool DGGARemoteSelectorMaster::sendTourney(DGGATcpConnection::pointer con)
 /**
  *
  */
-void DGGARemoteSelectorMaster::rollbackTourney(DGGATcpConnection::pointer con)
+void DGGARemoteSelectorMaster::rollbackTourneys(DGGATcpConnection::pointer con)
 {
-    GGAGenomeVector& wparticipants = participantsInWorker_[con];
-    if (wparticipants.empty())
+    std::vector<GGAGenomeVector>& wtourneys = participantsInWorker_[con];
+    if (wtourneys.empty())
         return;
 
-    LOG("Rolling back a tournament (" << mapAt(connectionAddr_, con) << ")");
+    LOG("Rolling back " << wtourneys.size() << " tournaments (" 
+        << mapAt(connectionAddr_, con) << ")");
 
-    nparticipantsCompeting_ -= wparticipants.size();
-    tourneySizes_.push_back(wparticipants.size());
-    participants_.insert(participants_.end(), wparticipants.begin(),
-                                                wparticipants.end());
+    for (size_t t = 0; t < wtourneys.size(); ++t) {
+        nparticipantsCompeting_ -= wtourneys[t].size();
+        tourneySizes_.push_back(wtourneys[t].size());
+        participants_.insert(participants_.end(), wtourneys[t].begin(),
+                                                  wtourneys[t].end());
+    }
 
-    wparticipants.clear();
+    wtourneys.clear();
+    connectionPerformances_[con].clear();
 }
 
 
 /**
- *
+ * Registers the result of a single run: objective value and performance on
+ * each instance of the participant.
  */
-void DGGARemoteSelectorMaster::recoverResults(const std::string& results)
+void DGGARemoteSelectorMaster::recoverRun(DGGATcpConnection::pointer con,
+                                          const std::string& body)
 {
-    std::stringstream ss(results);
-    boost::archive::text_iarchive ia(ss);
+    DGGAWireReader in(body);
+    size_t t = in.getUInt();
+    size_t p = in.getUInt();
+
+    std::vector<GGAGenomeVector>& wtourneys = participantsInWorker_[con];
+    if (t >= wtourneys.size() || p >= wtourneys[t].size())
+        throw GGAException("[DGGARemoteSelectorMaster::"
+                    "recoverRun] Run of an unknown participant.");
+
+    GGAGenome& genome = wtourneys[t][p];
+    genome.objValue(in.getDouble());
+
+    GGASelectorResult::InstancePerformancesMap& perfs = 
+                                                connectionPerformances_[con];
+    for (size_t n = in.getUInt(); n > 0; --n) {
+        size_t i = in.getUInt();
+        double perf = in.getDouble();
+        if (i >= instances_.size())
+            throw GGAException("[DGGARemoteSelectorMaster::"
+                        "recoverRun] Unknown instance.");
+
+        genome.setPerformance(instances_[i], perf);
+        perfs[instances_[i]].push_back(perf);
+    }
 
-    GGASelectorResult result;
-    
-    ia >> boost::serialization::make_nvp(DGGA_SELECT_RESULT_TAG, result);    
-    resultBuilder_.addAll(result);
+    // Other workers can stop their runs earlier
+    if (propagateTimeout_ && genome.objValue() < timeout_) {
+        timeout_ = genome.objValue();
+        resetTimeout();
+    }
+}
 
-    LOG("Number of evaluations in this generation so far: " << resultBuilder_.getNumEvaluations());
 
-    const GGAGenomeVector& twinners = result.getWinners();
-    if (propagateTimeout_) {
-        for (unsigned i = 0; i < twinners.size(); ++i)
-            timeout_ = std::min(timeout_, twinners[i].objValue());
+/**
+ * All the runs of the batch have finished: picks the winners of each tourney.
+ */
+void DGGARemoteSelectorMaster::finishTourneys(DGGATcpConnection::pointer con,
+                                              const std::string& body)
+{
+    DGGAWireReader in(body);
+    int evals = static_cast<int>(in.getUInt());
+
+    GGASelectorResult::InstancePerformancesMap& perfs = 
+                                                connectionPerformances_[con];
+    GGASelectorResult::InstancePerformancesMap::const_iterator pitr;
+    for (pitr = perfs.begin(); pitr != perfs.end(); ++pitr)
+        resultBuilder_.addInstancePerformance(pitr->first, pitr->second);
+    perfs.clear();
+
+    double pct_winners = GGAOptions::instance().pct_winners;
+    std::vector<GGAGenomeVector>& wtourneys = participantsInWorker_[con];
+    for (size_t t = 0; t < wtourneys.size(); ++t) {
+        GGAGenomeVector& tourney = wtourneys[t];
+
+        int numWinners = int(pct_winners * tourney.size());
+        if (numWinners <= 0)
+            numWinners = 1;
+
+        std::sort(tourney.begin(), tourney.end(),
+                  GGAGenome::compareObjValueAscendingOrder);
+        resultBuilder_.addWinners(GGAGenomeVector(tourney.begin(),
+                                            tourney.begin() + numWinners));
+
+        nparticipantsCompeting_ -= tourney.size();
     }
+    wtourneys.clear();
+
+    resultBuilder_.increaseNumEvaluations(evals);
+    LOG("Number of evaluations in this generation so far: " << resultBuilder_.getNumEvaluations());
 }
 
 /**
@@ -414,15 +480,11 @@ void DGGARemoteSelectorMaster::recoverResults(const std::string& results)
  */
 void DGGARemoteSelectorMaster::resetTimeout()
 {
-    std::string msg(DGGA_MSG_RESET_TIMEOUT);
-    {
-        std::stringstream ss;
-        boost::archive::text_oarchive oa(ss);
-        oa << boost::serialization::make_nvp(DGGA_TIMEOUT_TAG, timeout_);
-        
-        msg += " ";
-        msg += ss.str();
-    }
+    std::string body;
+    DGGAWireWriter out(body);
+    out.putDouble(timeout_);
+
+    std::string msg(makeMessage(DGGA_MSG_RESET_TIMEOUT, body));
 
     std::set<DGGATcpConnection::pointer>::iterator it;
     for (it = connections_.begin(); it != connections_.end(); ++it)
@@ -17,13 +17,8 @@
 
 #include <sstream>
 
-#include <boost/algorithm/string/predicate.hpp>
-#include <boost/algorithm/string/trim.hpp>
 #include <boost/archive/text_iarchive.hpp>
-#include <boost/archive/text_oarchive.hpp>
 #include <boost/bind.hpp>
-#include <boost/lexical_cast.hpp>
-#include <boost/serialization/vector.hpp>
 
 #include "GGAExceptions.hpp"
 #include "GGAOptions.hpp"
@@ -32,6 +27,7 @@
 #include "OutputLog.hpp"
 
 #include "dgga/dgga_messages.hpp"
+#include "dgga/dgga_wire.hpp"
 #include "dgga/DGGARemoteSelectorWorker.hpp"
 
 
@@ -44,7 +40,10 @@
 DGGARemoteSelectorWorker::DGGARemoteSelectorWorker(
                                         boost::asio::io_service& io_service)
     : m_selector()
-    , m_recv_data_buffer()
+
+    , m_timeout(0.0)
+    , m_instances()
+    , m_tourneys()
 
     , m_tourney_thread()
 
@@ -105,7 +104,8 @@ void DGGARemoteSelectorWorker::handleDisconnection(
 
     if(m_selector.get() != NULL) {
         m_selector->forceStop();        
-        m_tourney_thread.join();
+        if (m_tourney_thread.joinable())
+            m_tourney_thread.join();
     }
 
 }
@@ -119,7 +119,7 @@ void DGGARemoteSelectorWorker::handleHelloAck(DGGATcpConnection::pointer con,
 {
     if (DGGA_MSG_ACK == msg) {
         con->setNewMessageHandler(boost::bind(
-            &DGGARemoteSelectorWorker::handleBegConfig, this, _1, _2));
+            &DGGARemoteSelectorWorker::handleGetConfig, this, _1, _2));
 
         con->sendMessage(DGGA_MSG_GET_CONFIGURATION);
     } else {
@@ -130,41 +130,22 @@ void DGGARemoteSelectorWorker::handleHelloAck(DGGATcpConnection::pointer con,
 }
 
 
-/**
- *
- */
-void DGGARemoteSelectorWorker::handleBegConfig(DGGATcpConnection::pointer con,
-                                               const std::string& msg)
-{
-    if (DGGA_MSG_CONFIGURATION_BEG == msg) {
-        con->setNewMessageHandler(boost::bind(
-            &DGGARemoteSelectorWorker::handleGetConfig, this, _1, _2));
-
-        m_recv_data_buffer.clear();
-    } else {
-        LOG_ERROR("[DGGARemoteSelectorWorker::handleBegConfig] Unexpected"
-                  " message, communication sequence broken ... Disconnecting");
-        con->close();
-    }
-}
-
-
 /**
  *
  */
 void DGGARemoteSelectorWorker::handleGetConfig(DGGATcpConnection::pointer con,
                                                const std::string& msg)
 {
-    if (DGGA_MSG_CONFIGURATION_END == msg) {
-        assert(!m_recv_data_buffer.empty());
-
-        std::stringstream ss(m_recv_data_buffer);
+    if (DGGA_MSG_CONFIGURATION == messageTag(msg)) {
+        std::stringstream ss(messageBody(msg));
         boost::archive::text_iarchive ia(ss);
 
         ia >> GGAOptions::mutableInstance();
         ia >> GGAParameterTree::mutableInstance();
 
         m_selector.reset(new GGALocalSelector());
+        m_selector->setRunnerFinishedHandler(boost::bind(
+            &DGGARemoteSelectorWorker::sendRun, this, con, _1, _2, _3));
 
         printOptions();
         LOG("Parameter Tree:");
@@ -175,7 +156,9 @@ void DGGARemoteSelectorWorker::handleGetConfig(DGGATcpConnection::pointer con,
 
         con->sendMessage(DGGA_MSG_ACK);
     } else {
-        m_recv_data_buffer.append(msg);
+        LOG_ERROR("[DGGARemoteSelectorWorker::handleGetConfig] Unexpected"
+                  " message, communication sequence broken ... Disconnecting");
+        con->close();
     }
 }
 
@@ -186,37 +169,23 @@ void DGGARemoteSelectorWorker::handleGetConfig(DGGATcpConnection::pointer con,
 void DGGARemoteSelectorWorker::handleIDLEState(DGGATcpConnection::pointer con,
                                               const std::string& msg)
 {
-    if (msg == DGGA_MSG_TOURNEY_BEG) {
-        con->setNewMessageHandler(boost::bind(
-            &DGGARemoteSelectorWorker::handleRecvTourneyState, this, _1, _2));
-
-        // Clear buffer
-        m_recv_data_buffer.clear();
-    } else if (msg == DGGA_MSG_POLL) {
-        m_connection->sendMessage(DGGA_MSG_READY);
-    } else {
-        LOG_ERROR("IDLE Unknown message: " << msg);
-    }
-}
+    std::string tag = messageTag(msg);
+    if (tag == DGGA_MSG_TOURNEYS) {
+        recvTourneys(messageBody(msg));
 
-
-/**
- *
- */
-void DGGARemoteSelectorWorker::handleRecvTourneyState(
-                                                DGGATcpConnection::pointer con,
-                                                const std::string& msg)
-{
-    if (msg == DGGA_MSG_TOURNEY_END) {
         con->setNewMessageHandler(boost::bind(
             &DGGARemoteSelectorWorker::handleWorkingState, this, _1, _2));
 
+        if (m_tourney_thread.joinable())
+            m_tourney_thread.join();
         m_tourney_thread = boost::thread(boost::bind(
-            &DGGARemoteSelectorWorker::executeTourney, this, con));
-    } else if (isResetTimeout(msg)) {
-        resetTimeout(msg);
+            &DGGARemoteSelectorWorker::executeTourneys, this, con));
+    } else if (tag == DGGA_MSG_RESET_TIMEOUT) {
+        // Sent before the master got our results, nothing to do
+    } else if (msg == DGGA_MSG_POLL) {
+        m_connection->sendMessage(DGGA_MSG_READY);
     } else {
-        m_recv_data_buffer.append(msg);
+        LOG_ERROR("IDLE Unknown message: " << tag);
     }
 }
 
@@ -227,87 +196,115 @@ void DGGARemoteSelectorWorker::handleRecvTourneyState(
 void DGGARemoteSelectorWorker::handleWorkingState(DGGATcpConnection::pointer con,
                                                  const std::string& msg)
 {
+    std::string tag = messageTag(msg);
     if (msg == DGGA_MSG_POLL) {
         con->sendMessage(DGGA_MSG_WORKING);
-    } else if (isResetTimeout(msg)) {
-        resetTimeout(msg);
+    } else if (tag == DGGA_MSG_RESET_TIMEOUT) {
+        resetTimeout(messageBody(msg));
     } else {
-        LOG_ERROR("WORKING Unknown message: " << msg);
+        LOG_ERROR("WORKING Unknown message: " << tag);
     }
 }
 
 
 /**
- *
+ * Decodes a batch of tourneys: timeout, instance table (the instances to run
+ * first, then the ones only referenced by the genomes) and the participants
+ * of each tourney.
  */
-void DGGARemoteSelectorWorker::executeTourney(DGGATcpConnection::pointer con)
+void DGGARemoteSelectorWorker::recvTourneys(const std::string& body)
 {
-    double timeout;
-    GGAInstanceVector instances;
-    GGAGenomeVector genomes;
-
-    { // scope begin
-        std::stringstream ss(m_recv_data_buffer);
-        
-        boost::archive::text_iarchive ia(ss);
+    const GGAParameterTree& ptree = GGAParameterTree::instance();
+    DGGAWireReader in(body);
+
+    m_timeout = in.getDouble();
+
+    size_t ninstances = in.getUInt();
+    GGAInstanceVector table(in.getCount());
+    for (size_t i = 0; i < table.size(); ++i)
+        table[i] = in.getInstance();
+    if (ninstances > table.size())
+        throw GGAException("[DGGARemoteSelectorWorker::recvTourneys] More"
+                           " instances than the instance table holds.");
+    m_instances.assign(table.begin(), table.begin() + ninstances);
+
+    m_tourneys.resize(in.getCount());
+    for (size_t t = 0; t < m_tourneys.size(); ++t) {
+        m_tourneys[t].clear();
+        for (size_t n = in.getUInt(); n > 0; --n)
+            m_tourneys[t].push_back(in.getGenome(ptree, table));
+    }
+}
 
-        ia >> boost::serialization::make_nvp(DGGA_TIMEOUT_TAG, timeout);
-        ia >> boost::serialization::make_nvp(DGGA_INSTANCES_TAG, instances);
-        ia >> boost::serialization::make_nvp(DGGA_PARTICIPANTS_TAG, genomes);
-    } // scope end: automatically destroys ss and ia objects
 
-    LOG("#INSTANCES: " << instances.size());
-    LOG("#PARTICIPANTS: " << genomes.size());
+/**
+ * Runs the tourneys with the local selector. The results of the runs are
+ * sent as they finish (sendRun), the master picks the winners.
+ */
+void DGGARemoteSelectorWorker::executeTourneys(DGGATcpConnection::pointer con)
+{
+    LOG("#INSTANCES: " << m_instances.size());
+    LOG("#TOURNEYS: " << m_tourneys.size());
 
     try {
-        GGASelectorResult result = m_selector->select(genomes, instances, timeout);
-        
-        { // scope begin
-            std::stringstream ss;
-            boost::archive::text_oarchive oa(ss);
-            oa << boost::serialization::make_nvp(DGGA_SELECT_RESULT_TAG, result);
-
-            con->sendMessage(DGGA_MSG_RESULTS_BEG);
-            con->sendMessage(ss.str());
-            con->sendMessage(DGGA_MSG_RESULTS_END);
-        } // scope end    
+        GGASelectorResult result = m_selector->selectTournaments(
+                                        m_tourneys, m_instances, m_timeout);
 
-        //con->sendMessage(DGGA_MSG_READY);
+        std::string body;
+        DGGAWireWriter out(body);
+        out.putUInt(result.getNumEvaluations());
 
+        // The master may answer with new tourneys right away
         con->setNewMessageHandler(boost::bind(
                 &DGGARemoteSelectorWorker::handleIDLEState, this, _1, _2));
 
+        con->sendMessage(makeMessage(DGGA_MSG_TOURNEYS_DONE, body));
+
     } catch (GGAInterruptedException &e) {
         // Ignore (only triggered by an abrupt disconnection)
     }
 }
 
+
 /**
- *
+ * Sends the objective value and the performance on each instance of a
+ * finished runner.
  */
-bool DGGARemoteSelectorWorker::isResetTimeout(const std::string& msg) const
+void DGGARemoteSelectorWorker::sendRun(DGGATcpConnection::pointer con,
+                                       size_t tourney, size_t participant,
+                                       const GGARunner& runner)
 {
-    return boost::starts_with(msg, DGGA_MSG_RESET_TIMEOUT);
+    std::string body;
+    DGGAWireWriter out(body);
+
+    out.putUInt(tourney);
+    out.putUInt(participant);
+    out.putDouble(runner.objValue());
+
+    size_t nperfs = 0;
+    for (size_t i = 0; i < m_instances.size(); ++i)
+        nperfs += runner.hasPerformance(m_instances[i]) ? 1 : 0;
+
+    out.putUInt(nperfs);
+    for (size_t i = 0; i < m_instances.size(); ++i) {
+        if (runner.hasPerformance(m_instances[i])) {
+            out.putUInt(i);
+            out.putDouble(runner.getPerformance(m_instances[i]));
+        }
+    }
+
+    con->sendMessage(makeMessage(DGGA_MSG_RUN, body));
 }
 
+
 /**
  *
  */
-void DGGARemoteSelectorWorker::resetTimeout(const std::string& msg)
+void DGGARemoteSelectorWorker::resetTimeout(const std::string& body)
 {
-    double new_timeout;
-
-    size_t pos = msg.find_first_of(" ");
-    std::string str_timeout(msg.substr(pos));
-    boost::trim(str_timeout);
-    assert(!str_timeout.empty());
-
-    {
-        std::stringstream ss(str_timeout);
-        boost::archive::text_iarchive ia(ss);
-        ia >> boost::serialization::make_nvp(DGGA_TIMEOUT_TAG, new_timeout);
-    }
+    DGGAWireReader in(body);
+    double new_timeout = in.getDouble();
 
     LOG_VERBOSE("Reset timeout: " << new_timeout);
     m_selector->resetTimeout(new_timeout);
-}
\ No newline at end of file
+}
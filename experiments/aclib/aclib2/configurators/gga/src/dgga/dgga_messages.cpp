@@ -23,22 +23,42 @@ const std::string DGGA_MSG_HELLO             ("DGGA_HELLO");
 const std::string DGGA_MSG_READY             ("DGGA_READY");
 const std::string DGGA_MSG_WORKING           ("DGGA_WORKING");
 
-const std::string DGGA_MSG_RESULTS_BEG       ("DGGA_RESULTS_BEG");
-const std::string DGGA_MSG_RESULTS_END       ("DGGA_RESULTS_END");
-const std::string DGGA_MSG_TOURNEY_BEG       ("DGGA_TOURNEY_BEG");
-const std::string DGGA_MSG_TOURNEY_END       ("DGGA_TOURNEY_END");
+const std::string DGGA_MSG_TOURNEYS          ("DGGA_TOURNEYS");
+const std::string DGGA_MSG_RUN               ("DGGA_RUN");
+const std::string DGGA_MSG_TOURNEYS_DONE     ("DGGA_TOURNEYS_DONE");
 
 const std::string DGGA_MSG_GET_CONFIGURATION ("DGGA_GET_CONFIGURATION");
-const std::string DGGA_MSG_CONFIGURATION_BEG ("DGGA_CONFIGURATION_BEG");
-const std::string DGGA_MSG_CONFIGURATION_END ("DGGA_CONFIGURATION_END");
+const std::string DGGA_MSG_CONFIGURATION     ("DGGA_CONFIGURATION");
 
 const std::string DGGA_MSG_RESET_TIMEOUT     ("DGGA_RESET_TIMEOUT");
 
-// boost serialization nvp names
-const char* DGGA_EVALS_TAG                ("dgga_evals");
-const char* DGGA_WINNERS_TAG              ("dgga_winners");
-const char* DGGA_TIMEOUT_TAG              ("dgga_timeout");
-const char* DGGA_INSTANCES_TAG            ("dgga_instances");
-const char* DGGA_PARTICIPANTS_TAG         ("dgga_participants");
-const char* DGGA_SELECT_RESULT_TAG        ("dgga_select_result");
-const char* DGGA_INSTANCES_STATISTICS_TAG ("dgga_instances_statistics");
+
+/**
+ *
+ */
+std::string makeMessage(const std::string& tag, const std::string& body)
+{
+    std::string msg;
+    msg.reserve(tag.size() + 1 + body.size());
+    msg.append(tag);
+    msg.push_back('\0');
+    msg.append(body);
+    return msg;
+}
+
+/**
+ *
+ */
+std::string messageTag(const std::string& msg)
+{
+    return msg.substr(0, msg.find('\0'));
+}
+
+/**
+ *
+ */
+std::string messageBody(const std::string& msg)
+{
+    size_t pos = msg.find('\0');
+    return pos == std::string::npos ? std::string() : msg.substr(pos + 1);
+}
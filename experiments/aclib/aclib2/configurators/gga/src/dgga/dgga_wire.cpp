@@ -0,0 +1,326 @@
+// This file is part of GGA.
+// 
+// GGA is free software: you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation, either version 3 of the License, or
+// (at your option) any later version.
+// 
+// GGA is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+// 
+// You should have received a copy of the GNU General Public License
+// along with GGA.  If not, see <http://www.gnu.org/licenses/>.
+
+#include <cstring>
+
+#include "GGAExceptions.hpp"
+#include "GGAUtil.hpp"
+
+#include "dgga/dgga_wire.hpp"
+
+//==============================================================================
+// DGGAWireWriter public methods
+
+/**
+ *
+ */
+DGGAWireWriter::DGGAWireWriter(std::string& out)
+    : m_out(out)
+{ }
+
+
+/**
+ * Seven bits per byte, the high bit tells whether more bytes follow.
+ */
+void DGGAWireWriter::putUInt(uint64_t val)
+{
+    while (val >= 0x80) {
+        m_out.push_back(static_cast<char>((val & 0x7f) | 0x80));
+        val >>= 7;
+    }
+    m_out.push_back(static_cast<char>(val));
+}
+
+
+/**
+ * Zig-zag encoding keeps small negative numbers short.
+ */
+void DGGAWireWriter::putInt(int64_t val)
+{
+    putUInt((static_cast<uint64_t>(val) << 1) ^ static_cast<uint64_t>(val >> 63));
+}
+
+
+/**
+ *
+ */
+void DGGAWireWriter::putDouble(double val)
+{
+    uint64_t bits;
+    std::memcpy(&bits, &val, sizeof(bits));
+    for (int i = 0; i < 8; ++i)
+        m_out.push_back(static_cast<char>((bits >> (8 * i)) & 0xff));
+}
+
+
+/**
+ *
+ */
+void DGGAWireWriter::putString(const std::string& val)
+{
+    putUInt(val.size());
+    m_out.append(val);
+}
+
+
+/**
+ *
+ */
+void DGGAWireWriter::putValue(const GGAValue& val)
+{
+    if (val.isBool()) {
+        putUInt(GGAValue::BOOL);
+        putUInt(val.getBool() ? 1 : 0);
+    } else if (val.isLong()) {
+        putUInt(GGAValue::LONG);
+        putInt(val.getLong());
+    } else if (val.isDouble()) {
+        putUInt(GGAValue::DOUBLE);
+        putDouble(val.getDouble());
+    } else if (val.isString()) {
+        putUInt(GGAValue::STRING);
+        putString(val.getString());
+    } else {
+        putUInt(GGAValue::UNKNOWN);
+    }
+}
+
+
+/**
+ *
+ */
+void DGGAWireWriter::putInstance(const GGAInstance& inst)
+{
+    putString(inst.getInstance());
+    putInt(inst.getSeed());
+
+    const StringVector& extra = inst.getExtra();
+    putUInt(extra.size());
+    for (size_t i = 0; i < extra.size(); ++i)
+        putString(extra[i]);
+}
+
+
+/**
+ * The values are written in parameter id order, one per parameter of the
+ * tree (UNKNOWN if not set), preceded by their count. The performances are
+ * written as (instance index, performance) pairs, so all performances of the
+ * genome must be in the index.
+ */
+void DGGAWireWriter::putGenome(const GGAGenome& genome,
+                               const DGGAInstanceIndex& index)
+{
+    putUInt(genome.age());
+    putUInt(genome.gender());
+    putUInt(genome.bestInPopulation() ? 1 : 0);
+    putDouble(genome.objValue());
+
+    const ValueVector& values = genome.values();
+    putUInt(values.size());
+    for (size_t id = 0; id < values.size(); ++id)
+        putValue(values[id]);
+
+    const GGAInstancePerformanceMap& perfs = genome.allPerformances();
+    putUInt(perfs.size());
+    GGAInstancePerformanceMap::const_iterator itr;
+    for (itr = perfs.begin(); itr != perfs.end(); ++itr) {
+        putUInt(mapAt(index, itr->first));
+        putDouble(itr->second);
+    }
+}
+
+//==============================================================================
+// DGGAWireReader public methods
+
+/**
+ *
+ */
+DGGAWireReader::DGGAWireReader(const std::string& in)
+    : m_in(in)
+    , m_pos(0)
+{ }
+
+
+/**
+ *
+ */
+bool DGGAWireReader::atEnd() const
+{
+    return m_pos >= m_in.size();
+}
+
+
+/**
+ *
+ */
+uint64_t DGGAWireReader::getUInt()
+{
+    uint64_t val = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        need(1);
+        unsigned char byte = static_cast<unsigned char>(m_in[m_pos++]);
+        val |= static_cast<uint64_t>(byte & 0x7f) << shift;
+        if ((byte & 0x80) == 0)
+            return val;
+    }
+    throw GGAException("[DGGAWireReader::getUInt] Malformed varint.");
+}
+
+
+/**
+ * Reads the number of elements of a sequence that follows. Every element
+ * takes at least one byte, so a count larger than the remaining data is
+ * rejected before the caller allocates for it.
+ */
+size_t DGGAWireReader::getCount()
+{
+    uint64_t count = getUInt();
+    need(count);
+    return static_cast<size_t>(count);
+}
+
+
+/**
+ *
+ */
+int64_t DGGAWireReader::getInt()
+{
+    uint64_t val = getUInt();
+    return static_cast<int64_t>((val >> 1) ^ (~(val & 1) + 1));
+}
+
+
+/**
+ *
+ */
+double DGGAWireReader::getDouble()
+{
+    need(8);
+    uint64_t bits = 0;
+    for (int i = 0; i < 8; ++i)
+        bits |= static_cast<uint64_t>(
+                    static_cast<unsigned char>(m_in[m_pos++])) << (8 * i);
+
+    double val;
+    std::memcpy(&val, &bits, sizeof(val));
+    return val;
+}
+
+
+/**
+ *
+ */
+std::string DGGAWireReader::getString()
+{
+    uint64_t size = getUInt();
+    need(size);
+    std::string val(m_in, m_pos, size);
+    m_pos += size;
+    return val;
+}
+
+
+/**
+ *
+ */
+GGAValue DGGAWireReader::getValue()
+{
+    switch (getUInt()) {
+        case GGAValue::BOOL:   return GGAValue(getUInt() != 0);
+        case GGAValue::LONG:   return GGAValue(static_cast<long>(getInt()));
+        case GGAValue::DOUBLE: return GGAValue(getDouble());
+        case GGAValue::STRING: return GGAValue(getString());
+        case GGAValue::UNKNOWN: return GGAValue();
+        default:
+            throw GGAException("[DGGAWireReader::getValue] Unknown value type.");
+    }
+}
+
+
+/**
+ *
+ */
+GGAInstance DGGAWireReader::getInstance()
+{
+    std::string name = getString();
+    int seed = static_cast<int>(getInt());
+
+    StringVector extra(getCount());
+    for (size_t i = 0; i < extra.size(); ++i)
+        extra[i] = getString();
+
+    return GGAInstance(seed, 0.0, name, extra);
+}
+
+
+/**
+ *
+ */
+GGAGenome DGGAWireReader::getGenome(const GGAParameterTree& ptree,
+                                    const GGAInstanceVector& table)
+{
+    GGAGenome genome;
+    genome.age(static_cast<int>(getUInt()));
+    genome.gender(static_cast<GGAGenome::Gender>(getUInt()));
+    genome.bestInPopulation(getUInt() != 0);
+    genome.objValue(getDouble());
+
+    if (getUInt() != ptree.numParameters())
+        throw GGAException("[DGGAWireReader::getGenome] The genome does not"
+                           " match the parameter tree.");
+
+    ValueVector values(ptree.numParameters());
+    for (size_t id = 0; id < values.size(); ++id)
+        values[id] = getValue();
+    genome.setValues(values);
+
+    for (uint64_t nperfs = getUInt(); nperfs > 0; --nperfs) {
+        uint64_t inst = getUInt();
+        double perf = getDouble();
+        if (inst >= table.size())
+            throw GGAException("[DGGAWireReader::getGenome] Instance index"
+                               " out of range.");
+        genome.setPerformance(table[inst], perf);
+    }
+
+    return genome;
+}
+
+//==============================================================================
+// DGGAWireReader private methods
+
+/**
+ *
+ */
+void DGGAWireReader::need(size_t bytes) const
+{
+    if (bytes > m_in.size() - m_pos)
+        throw GGAException("[DGGAWireReader] Truncated message.");
+}
+
+//==============================================================================
+// Helpers
+
+/**
+ * Adds the instance to the table of the message, unless it is already there.
+ */
+void addToInstanceIndex(const GGAInstance& inst, GGAInstanceVector& table,
+                        DGGAInstanceIndex& index)
+{
+    if (index.count(inst) == 0) {
+        index[inst] = table.size();
+        table.push_back(inst);
+    }
+}
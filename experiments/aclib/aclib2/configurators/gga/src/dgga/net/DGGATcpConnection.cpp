@@ -17,7 +17,6 @@
 
 #include <stdexcept>
 
-#include <boost/algorithm/string/trim.hpp>
 #include <boost/bind.hpp>
 #include <boost/lexical_cast.hpp>
 
@@ -27,7 +26,7 @@
 
 //==============================================================================
 // DGGATcpConnection public constants
-const std::string DGGATcpConnection::DEF_EOM ("\n\n");
+const size_t DGGATcpConnection::MAX_MESSAGE_SIZE (1u << 30);
 
 //==============================================================================
 // DGGATcpConnection public static methods
@@ -111,11 +110,21 @@ bool DGGATcpConnection::connect(const std::vector<std::string>& hosts,
  */
 void DGGATcpConnection::sendMessage(const std::string& msg)
 {
+    if (msg.size() > MAX_MESSAGE_SIZE)
+        throw std::invalid_argument("[DGGATcpConnection::sendMessage] Message"
+                                    " too long; the peer would reject it.");
+
     boost::unique_lock<boost::recursive_mutex> lock(m_write_mutex);
 
     if (!msg.empty()) {
+        char header[4];
+        header[0] = static_cast<char>((msg.size() >> 24) & 0xff);
+        header[1] = static_cast<char>((msg.size() >> 16) & 0xff);
+        header[2] = static_cast<char>((msg.size() >> 8) & 0xff);
+        header[3] = static_cast<char>(msg.size() & 0xff);
+
+        m_temp_out_buffer.append(header, sizeof(header));
         m_temp_out_buffer.append(msg);
-        m_temp_out_buffer.append(m_end_of_message_mark);
 
         if (!m_write_in_progress) {
             m_temp_out_buffer.swap(m_out_buffer);
@@ -149,7 +158,7 @@ void DGGATcpConnection::startWrite()
 {
     boost::unique_lock<boost::recursive_mutex> lock(m_write_mutex);
 
-    m_socket.async_write_some(boost::asio::buffer(m_out_buffer),
+    boost::asio::async_write(m_socket, boost::asio::buffer(m_out_buffer),
         boost::bind(&DGGATcpConnection::handleWriteSome,
             shared_from_this(),
             boost::asio::placeholders::error,
@@ -180,7 +189,6 @@ DGGATcpConnection::DGGATcpConnection(boost::asio::io_service& io_service)
     , m_temp_out_buffer()
     , m_read_in_progress(false)
     , m_write_in_progress(false)
-    , m_end_of_message_mark(DEF_EOM)
 { }
 
 
@@ -226,17 +234,9 @@ void DGGATcpConnection::handleWriteSome(const boost::system::error_code& error,
     boost::unique_lock<boost::recursive_mutex> lock(m_write_mutex);
 
     if (!error) {
-        if (!m_out_buffer.empty()) {
-            assert(bytes % sizeof(std::string::value_type) == 0);
-
-            size_t ncharacters = bytes / sizeof(std::string::value_type);
-            m_out_buffer.erase(0, ncharacters);        
-        }
-        
-        if (!m_temp_out_buffer.empty()) {
-            m_out_buffer.append(m_temp_out_buffer);
-            m_temp_out_buffer.clear();
-        }
+        // async_write has sent the whole buffer
+        m_out_buffer.clear();
+        m_out_buffer.swap(m_temp_out_buffer);
 
         m_write_in_progress = false;
         if (!m_out_buffer.empty()) {
@@ -254,19 +254,33 @@ void DGGATcpConnection::handleWriteSome(const boost::system::error_code& error,
  */
 void DGGATcpConnection::processReadData()
 {
-    size_t msg_end_pos;
-    for (msg_end_pos = m_in_buffer.find(m_end_of_message_mark);
-         msg_end_pos != std::string::npos;
-         msg_end_pos = m_in_buffer.find(m_end_of_message_mark))
-    {
+    size_t pos = 0;
+    while (m_in_buffer.size() - pos >= 4) {
+        const unsigned char* header = 
+            reinterpret_cast<const unsigned char*>(m_in_buffer.data() + pos);
+        size_t size = (size_t(header[0]) << 24) | (size_t(header[1]) << 16)
+                    | (size_t(header[2]) << 8) | size_t(header[3]);
+
+        if (size > MAX_MESSAGE_SIZE) {
+            LOG_ERROR("[DGGATcpConnection::processReadData] Message too long"
+                      " (" << size << " bytes) ... Disconnecting");
+            m_in_buffer.clear();
+            close();
+            return;
+        }
+
+        if (m_in_buffer.size() - pos - 4 < size)
+            break;
+
         boost::unique_lock<boost::recursive_mutex> lock(
             m_new_message_handler_mutex);
 
-        std::string msg = m_in_buffer.substr(0, msg_end_pos);
-        m_in_buffer.erase(0, msg_end_pos + 1);
+        std::string msg(m_in_buffer, pos + 4, size);
+        pos += 4 + size;
 
-        boost::trim(msg);
         if (!m_new_message_handler.empty())
             m_new_message_handler(shared_from_this(), msg);
     }
+
+    m_in_buffer.erase(0, pos);
 }
@@ -36,6 +36,7 @@
 
 #include "dgga/dgga.hpp"
 #include "gga.hpp"
+#include "GGAEvaluationCache.hpp"
 #include "GGAExceptions.hpp"
 #include "GGAOptions.hpp"
 #include "GGAParameterTree.hpp"
@@ -184,6 +185,7 @@ void atExitHandler(void)
     //    - Set a terminate handler to deal with this situations
     if (getpid() == OutputLog::masterPid()) {
         // Clean up memory
+        GGAEvaluationCache::deleteInstance();
         GGAParameterTree::deleteInstance();
         GGAOptions::deleteInstance();
         //
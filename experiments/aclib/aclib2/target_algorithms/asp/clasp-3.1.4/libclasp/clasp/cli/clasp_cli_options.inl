@@ -194,6 +194,7 @@ OPTION(loops, "" , ARG(arg("<type>"), DEFINE_ENUM_MAPPING(DefaultUnfoundedCheck:
        "        shared  : Create loop formula for a whole unfounded set\n" \
        "        no      : Do not learn loop formulas", FUN(str) {DefaultUnfoundedCheck::ReasonStrategy arg; return stringTo(str, arg) && SET(SELF.loopRep, (uint32)arg);},\
        toString(static_cast<DefaultUnfoundedCheck::ReasonStrategy>(SELF.loopRep)))
+OPTION(loops_split, ",@1", ARG(arg("{0..7}")), "Check independent sccs for unfounded sets on %A extra threads", STORE_LEQ(SELF.loopSplit, 7u), toString(SELF.loopSplit))
 GROUP_END(SELF)
 #undef CLASP_SOLVER_OPTIONS
 #undef SELF
@@ -348,11 +349,11 @@ OPTION(solve_limit , "", ARG(arg("<n>[,<m>]")), "Stop search after <n> conflicts
 OPTION(parallel_mode, ",t", ARG(arg("<arg>"), DEFINE_ENUM_MAPPING(SolveOptions::Algorithm::SearchMode,\
        MAP("compete", SolveOptions::Algorithm::mode_compete), MAP("split", SolveOptions::Algorithm::mode_split))),\
        "Run parallel search with given number of threads\n" \
-       "      %A: <n {1..64}>[,<mode {compete|split}>]\n"   \
+       "      %A: <n {1..4095}>[,<mode {compete|split}>]\n" \
        "        <n>   : Number of threads to use in search\n"\
        "        <mode>: Run competition or splitting based search [compete]\n", FUN(str){\
        ARG_T(uint32, SolveOptions::Algorithm::SearchMode) arg(1,SolveOptions::Algorithm::mode_compete);\
-       return stringTo(str, arg) && SET_R(SELF.algorithm.threads, arg.first, 1u, 64u) && SET(SELF.algorithm.mode, arg.second);},\
+       return stringTo(str, arg) && SET_R(SELF.algorithm.threads, arg.first, 1u, SolveOptions::supportedSolvers()) && SET(SELF.algorithm.mode, arg.second);},\
        toString(SELF.algorithm.threads, (SolveOptions::Algorithm::SearchMode)SELF.algorithm.mode))
 OPTION(global_restarts, ",@1", ARG(implicit("5")->arg("<X>")), "Configure global restart policy\n" \
        "      %A: <n>[,<sched>] / Implicit: %I\n"                         \
@@ -389,6 +390,17 @@ OPTION(integrate, ",@1", ARG(defaultsTo("gp")->state(Value::value_defaulted), CO
        ARG_T(SolveOptions::Integration::Filter, uint32, SolveOptions::Integration::Topology) arg(SolveOptions::Integration::filter_no, 1024, SolveOptions::Integration::topo_all);\
        return stringTo(str, arg)&& SET(SELF.integrate.filter, (uint32)arg.first) && SET_OR_FILL(SELF.integrate.grace, arg.second) && SET(SELF.integrate.topo, (uint32)arg.third);\
        }, toString((SolveOptions::Integration::Filter)SELF.integrate.filter, SELF.integrate.grace, (SolveOptions::Integration::Topology)SELF.integrate.topo))
+OPTION(cubes, ",@1", ARG(arg("<arg>")), "Split search into cubes by lookahead (cube-and-conquer)\n" \
+       "      %A: <n>[,<file>]\n" \
+       "        <n>   : Number of cubes to generate (implies split mode)\n" \
+       "        <file>: Also write cubes to <file> as lines \"a <lits> 0\"", FUN(str) { return SELF.cubes.parse(str); },\
+       TO_STR_IF(SELF.cubes.num, SELF.cubes.str()))
+OPTION(net, ",@1", ARG(arg("<arg>")), "Distribute search over processes via coordinator\n" \
+       "      %A: [<host>:]<port>[,serve]\n" \
+       "        <host> : Host running the coordinator [localhost]\n" \
+       "        <port> : Port of the coordinator\n" \
+       "        serve  : Run the coordinator in this process", FUN(str) { return SELF.network.parse(str); },\
+       TO_STR_IF(SELF.network.enabled(), SELF.network.str()))
 #endif
 OPTION(enum_mode   , ",e", ARG(defaultsTo("auto")->state(Value::value_defaulted), DEFINE_ENUM_MAPPING(SolveOptions::EnumType,\
        MAP("bt", SolveOptions::enum_bt), MAP("record", SolveOptions::enum_record), MAP("domRec", SolveOptions::enum_dom_record),\
@@ -0,0 +1,229 @@
+//
+// Copyright (c) 2026, the MOSMAC-ECJ contributors
+//
+// This file adds distributed solving over several processes to Clasp 3.1.4.
+// Clasp is Copyright (c) 2006-2014, Benjamin Kaufmann.
+// See http://www.cs.uni-potsdam.de/clasp/
+//
+// This file is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this file; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+//
+#ifndef CLASP_NET_SOLVE_H_INCLUDED
+#define CLASP_NET_SOLVE_H_INCLUDED
+
+#ifdef _MSC_VER
+#pragma once
+#endif
+
+#if WITH_THREADS
+
+#include <clasp/shared_context.h>
+#include <clasp/util/thread.h>
+#include <clasp/util/mutex.h>
+#include <clasp/util/multi_queue.h>
+#include <string>
+
+/*!
+ * \file
+ * Defines classes for distributing a parallel search over several processes.
+ *
+ * All processes solve the same problem. One of them runs a coordinator
+ * to which every process (including the serving one) connects via TCP.
+ * The coordinator relays shared nogoods and improved optimization bounds,
+ * passes guiding paths from busy to idle processes in splitting mode,
+ * and tells all processes when and how to stop.
+ *
+ * Messages are framed as a 4-byte length followed by a 1-byte type and
+ * a payload of 32- or 64-bit integers, all in network byte order.
+ */
+namespace Clasp { namespace mt {
+
+//! Options for distributing a search over several processes.
+struct NetOptions {
+	NetOptions() : port(0), serve(0) {}
+	bool        enabled() const { return port != 0; }
+	//! Parses "[<host>:]<port>[,serve]".
+	bool        parse(const char* x);
+	//! Returns the options in the format accepted by parse().
+	std::string str()     const;
+	std::string host;  /**< Host running the coordinator (default: localhost). */
+	uint32      port;  /**< Port of the coordinator (0: no distribution).     */
+	uint32      serve; /**< Run the coordinator in this process?              */
+};
+
+namespace Net {
+	enum MsgType {
+		msg_hello   = 1, /**< client: fingerprint of problem and options      */
+		msg_welcome = 2, /**< server: client id and whether it owns the root  */
+		msg_reject  = 3, /**< server: fingerprint does not match              */
+		msg_nogood  = 4, /**< both  : a shared nogood                         */
+		msg_bound   = 5, /**< both  : a new (unadjusted) optimization bound   */
+		msg_done    = 6, /**< client: local search stopped (one of Done)      */
+		msg_stop    = 7, /**< server: stop searching (one of Verdict)         */
+		msg_request = 8, /**< client: all threads idle, give me a path        */
+		msg_wanted  = 9, /**< server: some client is idle, please split       */
+		msg_path    = 10 /**< both  : a guiding path                          */
+	};
+	enum Done    { done_model = 1, done_complete = 2 };
+	enum Verdict { verdict_none = 0, verdict_abort = 1, verdict_complete = 2 };
+	typedef PodVector<uint8>::type  Buffer;
+	typedef PodVector<uint64>::type Fingerprint;
+}
+
+//! Relays messages between the processes of a distributed search.
+/*!
+ * The coordinator runs in its own thread and serves all connections
+ * from a single poll loop. The first client to connect is the root, i.e.
+ * the only one that starts with the (empty) initial guiding path in
+ * splitting mode. A distributed search is complete once some client proved
+ * its problem unsatisfiable w.r.t the best known bound or, in splitting mode,
+ * once all clients are idle and no paths are left.
+ */
+class NetCoordinator {
+public:
+	NetCoordinator();
+	~NetCoordinator();
+	//! Listens on the given port and starts serving in a new thread.
+	bool start(uint32 port, std::string& err);
+	//! Sends any pending verdicts and stops serving.
+	void stop();
+private:
+	NetCoordinator(const NetCoordinator&);
+	NetCoordinator& operator=(const NetCoordinator&);
+	struct Peer;
+	typedef PodVector<Peer*>::type   PeerVec;
+	typedef PodVector<uint8>::type   Payload;
+	typedef PodVector<Payload*>::type PathQueue;
+	void run();
+	void accept();
+	bool read(Peer& p);
+	bool write(Peer& p);
+	void handle(Peer& p, uint8 type, const uint8* data, uint32 size);
+	void send(Peer& p, uint8 type, const uint8* data, uint32 size, bool drop = false);
+	void sendVerdict(Peer& p);
+	void decide(Net::Verdict v);
+	void dispatch();
+	void requestSplits();
+	void removePeer(uint32 i);
+	PeerVec        peers_;    // connected clients
+	PathQueue      paths_;    // guiding paths not yet handed out
+	Net::Fingerprint fp_;     // fingerprint of first client
+	Payload        bound_;    // best bound so far (msg_bound payload)
+	Clasp::thread  thread_;   // serving thread
+	int            listen_;   // listening socket
+	uint32         nextId_;   // id of next client
+	uint32         holder_;   // id of client that found best bound
+	uint32         verdict_;  // final verdict (one of Net::Verdict)
+	double         lastSplit_;// time of last split request
+	bool           split_;    // true if some client requested work
+	bool           lost_;     // true if a busy client was lost in splitting mode
+	Clasp::atomic<uint32> stop_;
+};
+
+//! Connection of one process to the coordinator of a distributed search.
+/*!
+ * An io thread reads incoming messages and writes outgoing ones.
+ * Solver threads only append to the output buffer and consume received
+ * nogoods from a queue holding one handle per thread.
+ * Received control messages are announced via notify().
+ */
+class NetClient {
+public:
+	typedef Net::Verdict Verdict;
+	explicit NetClient(uint32 numThreads);
+	virtual ~NetClient();
+	//! Connects to the coordinator given in opts and waits for its welcome.
+	/*!
+	 * \param maxVar Largest variable accepted in received nogoods and paths.
+	 * \param root   Set to true if this client owns the initial guiding path.
+	 */
+	bool   connect(const NetOptions& opts, const Net::Fingerprint& fp, Var maxVar, bool& root, std::string& err);
+	//! Sends pending messages and closes the connection.
+	void   close();
+	bool   connected() const { return fd_ != -1 && !lost(); }
+	bool   lost()      const { return lost_ != 0; }
+	// sending - all functions are thread-safe
+	void   publish(const SharedLiterals& lits);
+	void   sendBound(const wsum_t* sum, uint32 size);
+	void   sendDone(Net::Done d);
+	void   sendPath(const LitVec& path);
+	void   requestPath();
+	// receiving
+	//! Moves up to maxOut received nogoods for solver sId to out.
+	uint32 receive(uint32 sId, SharedLiterals** out, uint32 maxOut);
+	//! Waits at most ms milliseconds for a path requested via requestPath().
+	LitVec*  waitPath(uint32 ms);
+	Verdict  verdict()  const { return static_cast<Verdict>(uint32(verdict_)); }
+	//! Returns true and the most recent bound if a new one was received.
+	bool     takeBound(SumVec& out);
+	//! Returns true if a split was requested since the last call.
+	bool     takeWanted() { return wanted_.fetch_and_store(0) != 0; }
+protected:
+	//! Called by the io thread whenever a control message was received.
+	virtual void notify() {}
+private:
+	NetClient(const NetClient&);
+	NetClient& operator=(const NetClient&);
+	class Inbox : public MultiQueue<SharedLiterals*> {
+	public:
+		typedef MultiQueue<SharedLiterals*> base_type;
+		using base_type::publish;
+		Inbox(uint32 m) : base_type(m) {}
+	};
+	typedef PodVector<LitVec*>::type PathVec;
+	void   run();
+	void   send(uint8 type, const Net::Buffer& data, bool drop = false);
+	bool   handle(uint8 type, const uint8* data, uint32 size);
+	Inbox             inbox_;    // received nogoods
+	Inbox::ThreadId*  ids_;      // one handle on inbox_ per thread
+	Net::Buffer       out_;      // messages not yet written (guarded by outM_)
+	Net::Buffer       in_;       // partially read messages (io thread)
+	Net::Buffer       pending_;  // messages being written (io thread)
+	SumVec            bound_;    // most recent bound (guarded by inM_)
+	PathVec           paths_;    // received paths (guarded by inM_)
+	mutex             outM_;
+	mutex             inM_;
+	condition_variable pathCond_;
+	Clasp::thread     thread_;
+	int               fd_;
+	uint32            numThreads_;
+	Var               maxVar_;
+	bool              newBound_;
+	Clasp::atomic<uint32> verdict_;
+	Clasp::atomic<uint32> wanted_;
+	Clasp::atomic<uint32> lost_;
+	Clasp::atomic<uint32> closing_;
+};
+
+//! Publishes nogoods to local threads and to the other processes.
+/*!
+ * Wraps the distributor used between the threads of this process
+ * (if any) and adds nogoods received from other processes.
+ */
+class NetDistribution : public Distributor {
+public:
+	//! Creates a distributor forwarding to local (may be 0) and net.
+	explicit NetDistribution(const Policy& p, Distributor* local, NetClient& net);
+	~NetDistribution();
+	uint32  receive(const Solver& in, SharedLiterals** out, uint32 maxOut);
+	void    publish(const Solver& source, SharedLiterals* n);
+private:
+	Distributor* local_;
+	NetClient*   net_;
+};
+
+} }
+#endif
+
+#endif
@@ -31,7 +31,9 @@
 #include <clasp/shared_context.h>
 #include <clasp/util/thread.h>
 #include <clasp/util/multi_queue.h>
+#include <clasp/util/mutex.h>
 #include <clasp/solver_types.h>
+#include <clasp/net_solve.h>
 
 /*!
  * \file 
@@ -45,6 +47,33 @@ namespace mt {
 class ParallelHandler;
 class ParallelSolve;
 
+//! Maps solver threads to the NUMA nodes of the machine.
+/*!
+ * Nodes are read from /sys/devices/system/node and restricted to the
+ * cpus the process may run on. Threads are assigned to nodes in
+ * contiguous blocks so that solvers with neighbouring ids share a node.
+ * On systems without (or with only one usable) NUMA node, all threads
+ * are mapped to node 0 and pin() is a noop.
+ */
+class NumaMap {
+public:
+	NumaMap() : numThreads_(1), probed_(false) {}
+	//! Prepares a mapping for the given number of threads.
+	void   init(uint32 numThreads);
+	uint32 numThreads()     const { return numThreads_; }
+	//! Returns the number of nodes used, which is at most the number of threads.
+	uint32 numNodes()       const { return cpuStart_.empty() ? 1u : std::min(cpuStart_.size() - 1, numThreads_); }
+	uint32 node(uint32 sId) const { return (sId * numNodes()) / numThreads_; }
+	//! Restricts the calling thread to the cpus of the node of the given solver.
+	bool   pin(uint32 sId)  const;
+private:
+	typedef PodVector<uint32>::type CpuVec;
+	CpuVec cpus_;       // usable cpus ordered by node
+	CpuVec cpuStart_;   // cpus of node i are [cpuStart_[i], cpuStart_[i+1])
+	uint32 numThreads_;
+	bool   probed_;
+};
+
 struct ParallelSolveOptions : BasicSolveOptions {
 	struct Distribution : Distributor::Policy {
 		enum Mode { mode_global = 0, mode_local = 1 };
@@ -73,18 +102,32 @@ struct ParallelSolveOptions : BasicSolveOptions {
 		uint32           maxR;
 		ScheduleStrategy sched;
 	};
+	struct Cubes {       /**< Options for cube-and-conquer. */
+		Cubes() : num(0) {}
+		//! Parses "<n>[,<file>]".
+		bool        parse(const char* x);
+		//! Returns the options in the format accepted by parse().
+		std::string str() const;
+		uint32      num;  /**< Split initial path into about num cubes (0: disable). */
+		std::string file; /**< Also write generated cubes to this file.            */
+	};
 	Integration  integrate; /**< Nogood integration parameters.     */
 	Distribution distribute;/**< Nogood distribution parameters.    */
 	GRestarts    restarts;  /**< Global restart strategy.           */
+	Cubes        cubes;     /**< Cube-and-conquer parameters.       */
 	Algorithm    algorithm; /**< Parallel algorithm to use.         */
+	NetOptions   network;   /**< Distribution over several processes. */
 	//! Allocates a new solve object.
 	SolveAlgorithm* createSolveObject() const;
 	//! Returns the number of threads that can run concurrently on the current hardware.
 	static uint32   recommendedSolvers()     { return Clasp::thread::hardware_concurrency(); }
 	//! Returns number of maximal number of supported threads.
-	static uint32   supportedSolvers()       { return 64; }
+	/*!
+	 * \note The limit is imposed by the 12-bit solver count in SharedContext.
+	 */
+	static uint32   supportedSolvers()       { return 4095; }
 	//! Returns the peers of the solver with the given id assuming the given topology.
-	static uint64   initPeerMask(uint32 sId, Integration::Topology topo, uint32 numThreads);
+	static SolverSet initPeerSet(uint32 sId, Integration::Topology topo, uint32 numThreads);
 	uint32          numSolver()        const { return algorithm.threads; }
 	void            setSolvers(uint32 i)     { algorithm.threads = std::max(uint32(1), i); }
 	bool            defaultPortfolio() const { return algorithm.mode == Algorithm::mode_compete; }
@@ -97,6 +140,9 @@ struct ParallelSolveOptions : BasicSolveOptions {
  * a problem using a given number of threads.
  * It supports guiding path based solving, portfolio based solving, as well
  * as a combination of these two approaches.
+ * In splitting mode, the initial guiding path can optionally be split into a
+ * fixed number of cubes by lookahead before the threads start to search
+ * (cube-and-conquer).
  */
 class ParallelSolve : public SolveAlgorithm {
 public:
@@ -112,7 +158,7 @@ public:
 	bool   integrateUseHeuristic() const { return test_bit(intFlags_, 31); }
 	uint32 integrateGrace()        const { return intGrace_; }
 	uint32 integrateFlags()        const { return intFlags_; }
-	uint64 hasErrors()             const;
+	bool   hasErrors()             const;
 	//! Requests a global restart.
 	void   requestRestart();
 	bool   handleMessages(Solver& s);
@@ -142,19 +188,31 @@ private:
 	bool   doInterrupt();
 	void   solveParallel(uint32 id);
 	void   initQueue();
+	const LitVec* initCubes(Solver& s);
 	bool   requestWork(Solver& s, PathPtr& out);
 	void   terminate(Solver& s, bool complete);
 	bool   waitOnSync(Solver& s);
 	void   exception(uint32 id, PathPtr& path, ErrorCode e, const char* what);
 	void   reportProgress(const Event& ev) const;
 	// -------------------------------------------------------------------------------------------
+	// Distributed search
+	struct NetLink;
+	void   startNet(SharedContext& ctx);
+	void   stopNet();
+	void   handleNetMessages(Solver& s);
+	LitVec*requestNetWork(Solver& s);
+	// -------------------------------------------------------------------------------------------
 	typedef ParallelSolveOptions::Distribution Distribution;
+	typedef ParallelSolveOptions::Cubes        Cubes;
 	struct SharedData;
 	// SHARED DATA
 	SharedData*       shared_;       // Shared control data
 	ParallelHandler** thread_;       // Thread-locl control data
+	NumaMap           numa_;         // thread to numa node mapping
 	// READ ONLY
 	Distribution      distribution_; // distribution options
+	NetOptions        net_;          // options for distributed search
+	Cubes             cubes_;        // cube-and-conquer options
 	uint32            maxRestarts_;  // disable global restarts once reached 
 	uint32            intGrace_ : 30;// grace period for clauses to integrate
 	uint32            intTopo_  :  2;// integration topology
@@ -292,9 +350,16 @@ private:
 	} gp_;
 };
 
+//! Distributes shared nogoods via one queue per NUMA node.
+/*!
+ * Solvers publish to and consume from the queue of their node only.
+ * Nogoods published on one node are forwarded to the queues of the
+ * other nodes by whichever thread of the target node first finds the
+ * forwarding lock free in receive().
+ */
 class GlobalDistribution : public Distributor {
 public:
-	explicit GlobalDistribution(const Policy& p, uint32 maxShare, uint32 topo);
+	explicit GlobalDistribution(const Policy& p, uint32 maxShare, uint32 topo, const NumaMap& numa = NumaMap());
 	~GlobalDistribution();
 	uint32  receive(const Solver& in, SharedLiterals** out, uint32 maxOut);
 	void    publish(const Solver& source, SharedLiterals* n);
@@ -311,18 +376,29 @@ private:
 		using base_type::publish;
 		Queue(uint32 m) : base_type(m) {}
 	};
-	struct ThreadInfo {
-		uint64          peerMask;
-		union {
-			Queue::ThreadId id;
-			uint64          rep;
-		};
-		char            pad[64 - (sizeof(uint64)*2)];
+	typedef PodVector<Queue::ThreadId>::type IdVec;
+	struct ThreadData {
+		SolverSet       peers;  // set of peers from which this thread receives clauses
+		Queue::ThreadId id;     // handle on the queue of the thread's node
+		uint32          node;   // node of this thread
+	};
+	struct ThreadInfo : ThreadData {
+		char            pad[64 - sizeof(ThreadData)];
+	};
+	struct NodeInfo {
+		Queue*          queue;   // clauses published on or forwarded to this node
+		IdVec           remote;  // handles on the queues of the other nodes
+		SolverSet       senders; // union of the peers of the node's threads
+		uint32          size;    // number of threads on this node
+		spin_mutex      forward; // held by the thread currently forwarding to this node
 	};
+	void             forward(uint32 node);
 	Queue::ThreadId& getThreadId(uint32 sId) const { return threadId_[sId].id; }
-	uint64           getPeerMask(uint32 sId) const { return threadId_[sId].peerMask; }
-	Queue*           queue_;
+	const SolverSet& getPeers(uint32 sId)    const { return threadId_[sId].peers; }
+	NodeInfo*        node_;
 	ThreadInfo*      threadId_;
+	uint32           numNode_;
+	uint32           numThread_;
 };
 
 class LocalDistribution : public Distributor {
@@ -339,7 +415,7 @@ private:
 	void   freeNode(uint32  tId, QNode* n) const;
 	struct ThreadData {
 		MPSCPtrQueue received; // queue holding received clauses
-		uint64       peers;    // set of peers from which this thread receives clauses
+		SolverSet    peers;    // set of peers from which this thread receives clauses
 		QNode        sentinal; // sentinal node for simplifying queue impl
 		QNode*       free;     // local free list - only accessed by this thread
 	}**            thread_;    // one entry for each thread
@@ -348,6 +348,36 @@ private:
 	bool       shared_;
 };
 
+//! A set of solver ids.
+/*!
+ * Unlike a plain bitmask, the set is not limited to 64 solvers.
+ */
+class SolverSet {
+public:
+	SolverSet() {}
+	//! Creates an empty set that can hold ids in the range [0, numSolvers) without growing.
+	explicit SolverSet(uint32 numSolvers) : set_((numSolvers + 63) / 64, uint64(0)) {}
+	bool contains(uint32 id) const { return (id >> 6) < set_.size() && test_bit(set_[id >> 6], id & 63); }
+	bool empty()             const {
+		for (SetVec::const_iterator it = set_.begin(), end = set_.end(); it != end; ++it) { if (*it) return false; }
+		return true;
+	}
+	void add(uint32 id) {
+		if ((id >> 6) >= set_.size()) { set_.resize((id >> 6) + 1, uint64(0)); }
+		store_set_bit(set_[id >> 6], id & 63);
+	}
+	void remove(uint32 id)         { if ((id >> 6) < set_.size()) { store_clear_bit(set_[id >> 6], id & 63); } }
+	void clear()                   { set_.clear(); }
+	SolverSet& operator|=(const SolverSet& other) {
+		if (other.set_.size() > set_.size()) { set_.resize(other.set_.size(), uint64(0)); }
+		for (uint32 i = 0, end = other.set_.size(); i != end; ++i) { set_[i] |= other.set_[i]; }
+		return *this;
+	}
+private:
+	typedef PodVector<uint64>::type SetVec;
+	SetVec set_;
+};
+
 //! Base class for distributing learnt knowledge between solvers.
 class Distributor {
 public:
@@ -364,9 +394,6 @@ public:
 		uint32 lbd   :  7; /*!< Allow distribution up to this lbd only.  */
 		uint32 types :  3; /*!< Restrict distribution to these types.    */
 	};
-	static  uint64  mask(uint32 i)             { return uint64(1) << i; }
-	static  uint32  initSet(uint32 sz)         { return (uint64(1) << sz) - 1; }
-	static  bool    inSet(uint64 s, uint32 id) { return (s & mask(id)) != 0; }
 	explicit Distributor(const Policy& p);
 	virtual ~Distributor();
 	bool            isCandidate(uint32 size, uint32 lbd, uint32 type) const {
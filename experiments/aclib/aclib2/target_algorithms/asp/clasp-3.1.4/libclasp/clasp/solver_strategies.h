@@ -149,9 +149,11 @@ struct SolverStrategies {
 	uint32    signDef       : 3;  /*!< Default sign heuristic.        */
 	uint32    signFix       : 1;  /*!< Disable all sign heuristics and always use default sign. */
 	uint32    hasConfig     : 1;  // config applied to solver?
-	uint32    id            : 6;  // Solver id - SHALL ONLY BE SET BY Shared Context!
 	uint32    heuReserved   : 3;  // id of active heuristic - SHALL ONLY BE SET BY Solver!
-	uint32    reserved      : 1;
+	uint32    loopSplit     : 3;  /*!< Check independent sccs for unfounded sets on this many extra threads. */
+	uint32    reserved      : 4;
+	//----- 32 bit ------------
+	uint32    id;                 // Solver id - SHALL ONLY BE SET BY Shared Context!
 };
 
 //! Parameter-Object for configuring a solver.
@@ -366,7 +368,7 @@ struct ContextParams {
 		share_all     = 3, /*!< Share all constraints.                                    */
 		share_auto    = 4, /*!< Use share_no or share_all depending on number of solvers. */
 	};
-	ContextParams() : shareMode(share_auto), stats(0), shortMode(short_implicit), seed(1), hasConfig(0), cliConfig(0), cliId(0), cliMode(0) {}
+	ContextParams() : shareMode(share_auto), stats(0), shortMode(short_implicit), seed(1), hasConfig(0), cliConfig(0), cliMode(0), cliId(0) {}
 	SatPreParams satPre;        /*!< Preprocessing options.                    */
 	uint8        shareMode : 3; /*!< Physical sharing mode (one of ShareMode). */
 	uint8        stats     : 2; /*!< See SharedContext::enableStats().         */
@@ -374,8 +376,8 @@ struct ContextParams {
 	uint8        seed      : 1; /*!< Apply new seed when adding solvers.       */
 	uint8        hasConfig : 1; /*!< Reserved for command-line interface.      */
 	uint8        cliConfig;     /*!< Reserved for command-line interface.      */
-	uint8        cliId;         /*!< Reserved for command-line interface.      */
 	uint8        cliMode;       /*!< Reserved for command-line interface.      */
+	uint16       cliId;         /*!< Reserved for command-line interface.      */
 };
 
 //! Interface for configuring a SharedContext object and its associated solvers.
@@ -45,6 +45,11 @@ class LoopFormula;
  *    - For each B' s.th B' is not external to Q
  *      - add { a' | source(a') = B } to Q
  *  - Try to find new sources for all atoms a in Q
+ *
+ * Since unfounded sets are always contained in one strongly connected component, 
+ * atoms from independent components can be checked concurrently. If enabled via setWorkers(),
+ * the todo queue is split by component and distributed over a set of worker threads
+ * whenever enough atoms lost their source.
  */
 class DefaultUnfoundedCheck : public PostPropagator {
 public:
@@ -66,6 +71,12 @@ public:
 
 	ReasonStrategy reasonStrategy() const { return strategy_; }
 	void           setReasonStrategy(ReasonStrategy rs);
+	//! Checks independent components on up to n additional threads (0: disable).
+	/*!
+	 * \note Ignored if clasp was built without thread support.
+	 */
+	void           setWorkers(uint32 n);
+	uint32         workers() const;
 	
 	DependencyGraph* graph() const { return graph_; }
 	uint32           nodes() const { return static_cast<uint32>(atoms_.size() + bodies_.size()); }
@@ -154,6 +165,20 @@ private:
 		uint32 ufs    :  1; // in ufs-queue?
 		uint32 validS :  1; // is source valid?
 	};
+	// Queues used while searching for unfounded sets
+	typedef PodQueue<NodeId> IdQueue;
+	struct Queues {
+		Queues() : defer(false) {}
+		IdQueue todo;    // ids of atoms that recently lost their source
+		IdQueue ufs;     // ids of atoms that are unfounded wrt the current assignment (limited to one scc)
+		VarVec  source;  // source-pointer propagation queue
+		VarVec  check;   // atoms still without source - checked again once findSource() is done
+		VarVec  watch;   // deferred watch updates of bodies from other sccs: (body << 1) | inc
+		VarVec  fwd;     // deferred sources for atoms from other sccs: (atom, body)
+		bool    defer;   // defer updates that affect other sccs?
+	};
+	// Worker threads for checking independent sccs in parallel
+	struct Workers;
 	// Watch-structure used to update extended bodies affected by literal assignments
 	struct ExtWatch {
 		NodeId bodyId;
@@ -208,42 +233,46 @@ private:
 	};
 	// -------------------------------------------------------------------------------------------  
 	// propagating source pointers
-	void propagateSource();
+	void propagateSource(Queues& q);
 	struct AddSource { // an atom in a body has a new source, check if body is now a valid source
-		explicit AddSource(DefaultUnfoundedCheck* u) : self(u) {}
+		AddSource(DefaultUnfoundedCheck* u, Queues& aq) : self(u), q(&aq) {}
 		// normal body
 		void operator()(NodeId bId) const {
 			BodyPtr n(self->getBody(bId));
-			if (--self->bodies_[bId].lower_or_ext == 0 && !self->solver_->isFalse(n.node->lit)) { self->forwardSource(n); }
+			if (--self->bodies_[bId].lower_or_ext == 0 && !self->solver_->isFalse(n.node->lit)) { self->forwardSource(*q, n); }
 		}
 		// extended body
 		void operator()(NodeId bId, uint32 idx) const;
 		DefaultUnfoundedCheck* self;
+		Queues*                q;
 	};
 	struct RemoveSource {// an atom in a body has lost its source, check if body is no longer a valid source 
-		explicit RemoveSource(DefaultUnfoundedCheck* u, bool add = false) : self(u), addTodo(add) {}
+		RemoveSource(DefaultUnfoundedCheck* u, Queues& aq, bool add = false) : self(u), q(&aq), addTodo(add) {}
 		// normal body
 		void operator()(NodeId bId) const { 
 			if (++self->bodies_[bId].lower_or_ext == 1 && self->bodies_[bId].watches != 0) { 
-				self->forwardUnsource(self->getBody(bId), addTodo); 
+				self->forwardUnsource(*q, self->getBody(bId), addTodo); 
 			}
 		}
 		// extended body
 		void operator()(NodeId bId, uint32 idx) const;
 		DefaultUnfoundedCheck* self;
+		Queues*                q;
 		bool                   addTodo;
 	};
-	void setSource(NodeId atom, const BodyPtr& b);
+	void setSource(Queues& q, NodeId atom, const BodyPtr& b);
 	void removeSource(NodeId bodyId);
-	void forwardSource(const BodyPtr& n);
-	void forwardUnsource(const BodyPtr& n, bool add);
-	void updateSource(AtomData& atom, const BodyPtr& n);
+	void forwardSource(Queues& q, const BodyPtr& n);
+	void forwardUnsource(Queues& q, const BodyPtr& n, bool add);
+	void updateSource(Queues& q, NodeId atom, const BodyPtr& n);
+	void updateWatches(Queues& q, NodeId body, NodeId atom, bool inc);
 	// -------------------------------------------------------------------------------------------  
 	// finding & propagating unfounded sets
 	void updateAssignment(Solver& s);
-	bool findSource(NodeId atom);
+	bool findSources(Queues& q);
+	bool findSource(Queues& q, NodeId atom);
 	bool isValidSource(const BodyPtr&);
-	void addUnsourced(const BodyPtr&);
+	void addUnsourced(Queues& q, const BodyPtr&);
 	bool falsifyUfs(UfsType t);
 	bool assertAtom(Literal a, UfsType t);
 	void computeReason(UfsType t);
@@ -258,16 +287,15 @@ private:
 	UfsType findUfs(Solver& s, bool checkNonHcf);
 	UfsType findNonHcfUfs(Solver& s);
 	// -------------------------------------------------------------------------------------------  
-	bool pushTodo(NodeId at) { return (atoms_[at].todo == 0 && (todo_.push(at), atoms_[at].todo = 1) != 0); }
-	bool pushUfs(NodeId at)  { return (atoms_[at].ufs  == 0 && (ufs_.push(at),  atoms_[at].ufs  = 1) != 0); }
-	void resetTodo()         { while (!todo_.empty()){ atoms_[todo_.pop_ret()].todo = 0; } todo_.clear();   }
-	void resetUfs()          { while (!ufs_.empty()) { atoms_[ufs_.pop_ret()].ufs   = 0; } ufs_.clear();    } 
+	bool pushTodo(Queues& q, NodeId at) { return (atoms_[at].todo == 0 && (q.todo.push(at), atoms_[at].todo = 1) != 0); }
+	bool pushUfs(Queues& q, NodeId at)  { return (atoms_[at].ufs  == 0 && (q.ufs.push(at),  atoms_[at].ufs  = 1) != 0); }
+	void resetTodo(Queues& q)           { while (!q.todo.empty()){ atoms_[q.todo.pop_ret()].todo = 0; } q.todo.clear(); }
+	void resetUfs(Queues& q)            { while (!q.ufs.empty()) { atoms_[q.ufs.pop_ret()].ufs   = 0; } q.ufs.clear();  } 
 	// -------------------------------------------------------------------------------------------  
 	typedef PodVector<AtomData>::type       AtomVec;
 	typedef PodVector<BodyData>::type       BodyVec;
 	typedef PodVector<ExtData*>::type       ExtVec;
 	typedef PodVector<ExtWatch>::type       WatchVec;
-	typedef PodQueue<NodeId>                IdQueue;
 	typedef SingleOwnerPtr<MinimalityCheck> MiniPtr;
 	// -------------------------------------------------------------------------------------------  
 	Solver*          solver_;      // my solver
@@ -275,10 +303,9 @@ private:
 	MiniPtr          mini_;        // minimality checker (only for DLPs)
 	AtomVec          atoms_;       // data for each atom       
 	BodyVec          bodies_;      // data for each body
-	IdQueue          todo_;        // ids of atoms that recently lost their source
-	IdQueue          ufs_;         // ids of atoms that are unfounded wrt the current assignment (limited to one scc)
+	Queues           queues_;      // queues of the solver's thread
+	Workers*         workers_;     // optional workers for checking sccs in parallel
 	VarVec           invalidQ_;    // ids of invalid elements to be processed
-	VarVec           sourceQ_;     // source-pointer propagation queue
 	ExtVec           extended_;    // data for each extended body
 	WatchVec         watches_;     // watches for handling choice-, cardinality- and weight rules
 	VarVec           pickedExt_;   // extended bodies visited during reason computation
@@ -30,3 +30,6 @@ void example2();
 void example3();
 #endif
 void example4();
+#if WITH_THREADS
+void example5();
+#endif
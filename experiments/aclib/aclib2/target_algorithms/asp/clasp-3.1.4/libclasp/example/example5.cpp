@@ -0,0 +1,105 @@
+//
+// Copyright (c) 2026, the MOSMAC-ECJ contributors
+//
+// This example was added to Clasp 3.1.4 together with the parallel
+// unfounded set check.
+// Clasp is Copyright (c) 2006-2014, Benjamin Kaufmann.
+// See http://www.cs.uni-potsdam.de/clasp/
+//
+// This file is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this file; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+//
+#if WITH_THREADS
+// Add the libclasp directory to the list of 
+// include directoies of your build system.
+#include <clasp/clasp_facade.h>
+#include <clasp/solver.h>
+#include "example.h"
+#include <cstdio>
+
+// This example compares sequential and parallel unfounded set checking
+// on a loop-heavy program. The program searches for Hamiltonian cycles
+// in a random graph and checks reachability from several roots:
+//    {in(U,V)} :- edge(U,V).
+//    r(G,V) :- in(G,V).                      % root(G) = G
+//    r(G,V) :- in(U,V), r(G,U), U != G.
+//    :- node(V), root(G), not r(G,V).
+//    :- in(U,V), in(U,W), V != W.
+//    :- in(U,V), in(W,V), U != W.
+// The reachability atoms of each root form their own strongly connected 
+// component, while the edge atoms in(U,V) are shared by all components.
+// Hence, whenever an edge is removed, atoms of many components lose their 
+// source at once, and the unfounded set check has enough work to be split 
+// over several threads.
+static void addCycleProgram(Clasp::Asp::LogicProgram& asp, uint32 roots, uint32 nodes, uint32 degree) {
+	using namespace Clasp;
+	using namespace Clasp::Asp;
+	RNG rng(4711);
+	Var bot = asp.newAtom();
+	asp.setCompute(bot, false);
+	PodVector<VarVec>::type reach(roots, VarVec(nodes));
+	for (uint32 g = 0; g != roots; ++g) {
+		for (uint32 v = 0; v != nodes; ++v) { reach[g][v] = asp.newAtom(); }
+	}
+	PodVector<VarVec>::type pred(nodes);
+	VarVec out;
+	for (uint32 u = 0; u != nodes; ++u) {
+		out.clear();
+		for (uint32 k = 0; k != degree; ++k) {
+			uint32 v = k == 0 ? (u + 1) % nodes : rng.irand(nodes);
+			if (v == u) { continue; }
+			Var e = asp.newAtom();
+			asp.startRule(CHOICERULE).addHead(e).endRule();
+			for (uint32 g = 0; g != roots; ++g) {
+				asp.startRule().addHead(reach[g][v]).addToBody(e, true);
+				if (u != g) { asp.addToBody(reach[g][u], true); }
+				asp.endRule();
+			}
+			for (VarVec::const_iterator it = out.begin(); it != out.end(); ++it) {
+				asp.startRule().addHead(bot).addToBody(e, true).addToBody(*it, true).endRule();
+			}
+			for (VarVec::const_iterator it = pred[v].begin(); it != pred[v].end(); ++it) {
+				asp.startRule().addHead(bot).addToBody(e, true).addToBody(*it, true).endRule();
+			}
+			out.push_back(e);
+			pred[v].push_back(e);
+		}
+	}
+	for (uint32 g = 0; g != roots; ++g) {
+		for (uint32 v = 0; v != nodes; ++v) {
+			asp.startRule().addHead(bot).addToBody(reach[g][v], false).endRule();
+		}
+	}
+}
+
+void example5() {
+	const uint32 workers[] = {0, 1, 3};
+	for (uint32 i = 0; i != sizeof(workers)/sizeof(workers[0]); ++i) {
+		Clasp::ClaspConfig config;
+		config.solve.numModels = 1000;
+		// Check independent components on additional threads.
+		config.addSolver(0).loopSplit = workers[i];
+		
+		Clasp::ClaspFacade libclasp;
+		addCycleProgram(libclasp.startAsp(config), 16, 60, 3);
+		libclasp.prepare();
+		libclasp.solve();
+
+		const Clasp::ClaspFacade::Summary& sum = libclasp.summary();
+		std::printf("workers: %u models: %llu choices: %llu time: %.3fs\n", workers[i]
+			, (unsigned long long)sum.enumerated()
+			, (unsigned long long)libclasp.ctx.master()->stats.choices, sum.solveTime);
+	}
+}
+#endif
@@ -40,4 +40,7 @@ int main() {
 	RUN(example3);
 #endif
 	RUN(example4);
+#if WITH_THREADS
+	RUN(example5);
+#endif
 }
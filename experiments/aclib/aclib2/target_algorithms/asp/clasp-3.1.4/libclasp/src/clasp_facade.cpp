@@ -67,7 +67,8 @@ bool ClaspConfig::addPost(Solver& s) const {
 	if (s.sharedContext() && s.sharedContext()->sccGraph.get()) {
 		DefaultUnfoundedCheck* pp = static_cast<DefaultUnfoundedCheck*>(s.getPost(PostPropagator::priority_reserved_ufs));
 		if (pp) { pp->setReasonStrategy(static_cast<DefaultUnfoundedCheck::ReasonStrategy>(solver(s.id()).loopRep)); }
-		else    { ok = s.addPost(new DefaultUnfoundedCheck(static_cast<DefaultUnfoundedCheck::ReasonStrategy>(solver(s.id()).loopRep))); }
+		else    { ok = s.addPost(pp = new DefaultUnfoundedCheck(static_cast<DefaultUnfoundedCheck::ReasonStrategy>(solver(s.id()).loopRep))); }
+		pp->setWorkers(solver(s.id()).loopSplit);
 	}
 	return ok && BasicSatConfig::addPost(s);
 }
@@ -322,13 +322,16 @@ static const NodeKey nodes_g[] = {
 /* 4: */ {"tester.", "Tester Options", key_solver  , option_category_context_end},
 /* 5: */ {".", "Options", key_tester, option_category_context_end}
 };
+// Key handle: 4-bit mode | 12-bit solver id | 16-bit key id.
+// The solver id covers all ids below SolveOptions::supportedSolvers().
+static const uint32 key_max_solver = 4095;
 static uint32 makeKeyHandle(int16 kId, uint32 mode, uint32 sId) {
-	assert(sId <= 255 && mode <= 255);
-	return (mode << 24) | (sId << 16) | static_cast<uint16>(kId);
+	assert(sId <= key_max_solver && mode <= 15);
+	return (mode << 28) | (sId << 16) | static_cast<uint16>(kId);
 }
-static int16 decodeKey(uint32 key)   { return static_cast<int16>(static_cast<uint16>(key)); }
-static uint8 decodeMode(uint32 key)  { return static_cast<uint8>( (key >> 24) ); }
-static uint8 decodeSolver(uint32 key){ return static_cast<uint8>( (key >> 16) ); }
+static int16  decodeKey(uint32 key)   { return static_cast<int16>(static_cast<uint16>(key)); }
+static uint8  decodeMode(uint32 key)  { return static_cast<uint8>( (key >> 28) ); }
+static uint32 decodeSolver(uint32 key){ return (key >> 16) & key_max_solver; }
 static bool  isValidId(int16 id)     { return id >= key_root && id < detail__num_options; }
 static bool  isLeafId(int16 id)      { return id >= key_leaf && id < detail__num_options; }
 const ClaspCliConfig::KeyType ClaspCliConfig::KEY_ROOT   = makeKeyHandle(key_root, 0, 0);
@@ -531,7 +534,7 @@ bool        ConfigIter::next()       {
 /////////////////////////////////////////////////////////////////////////////////////////
 ClaspCliConfig::ScopedSet::ScopedSet(ClaspCliConfig& s, uint8 mode, uint32 sId) : self(&s) {
 	if (sId) { mode |= mode_solver; }
-	s.cliId   = static_cast<uint8>(sId);
+	s.cliId   = static_cast<uint16>(sId);
 	s.cliMode = mode;
 }
 ClaspCliConfig::ScopedSet::~ScopedSet() { self->cliId = self->cliMode = 0; }
@@ -641,7 +644,7 @@ ClaspCliConfig::KeyType ClaspCliConfig::getKey(KeyType k, const char* path) cons
 	if (id == key_solver) {
 		uint32 solverId;
 		if ((mode & mode_solver) == 0 && *path != '.' && bk_lib::xconvert(path, solverId, &path, 0) == 1) {
-			return getKey(makeKeyHandle(id, mode | mode_solver, std::min(solverId, (uint32)uint8(-1))), path);
+			return getKey(makeKeyHandle(id, mode | mode_solver, std::min(solverId, key_max_solver)), path);
 		}
 		mode |= mode_solver;
 	}
@@ -821,7 +824,7 @@ int ClaspCliConfig::setActive(int id, const char* setVal) {
 		for (uint32 sId = 0; it.valid(); it.next(), ++sId) {
 			(act->addSolver(sId) = SolverParams()).id = sId;
 			(act->addSearch(sId) = SolveParams());
-			cliId = static_cast<uint8>(sId);
+			cliId = static_cast<uint16>(sId);
 			if (!setConfig(it, false, ParsedOpts(), 0)){ return false; }
 			cliMode |= mode_solver;
 		}
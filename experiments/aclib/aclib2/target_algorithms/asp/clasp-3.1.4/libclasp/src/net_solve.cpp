@@ -0,0 +1,674 @@
+//
+// Copyright (c) 2026, the MOSMAC-ECJ contributors
+//
+// This file adds distributed solving over several processes to Clasp 3.1.4.
+// Clasp is Copyright (c) 2006-2014, Benjamin Kaufmann.
+// See http://www.cs.uni-potsdam.de/clasp/
+//
+// This file is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This file is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this file; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin St, Fifth Floor, Boston, MA  02110-1301  USA
+//
+#if WITH_THREADS
+#include <clasp/net_solve.h>
+#include <clasp/solver.h>
+#include <clasp/clause.h>
+#include <clasp/util/timer.h>
+#include <tbb/tick_count.h>
+#include <functional>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#if !defined(_WIN32)
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <netdb.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <errno.h>
+#define CLASP_HAS_NET 1
+#if defined(MSG_NOSIGNAL)
+#define CLASP_NET_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define CLASP_NET_SEND_FLAGS 0
+#endif
+#else
+#define CLASP_HAS_NET 0
+#endif
+namespace Clasp { namespace mt {
+/////////////////////////////////////////////////////////////////////////////////////////
+// NetOptions
+/////////////////////////////////////////////////////////////////////////////////////////
+bool NetOptions::parse(const char* x) {
+	*this = NetOptions();
+	if (!x || std::strcmp(x, "no") == 0 || std::strcmp(x, "off") == 0) { return x != 0; }
+	std::string in(x);
+	std::string::size_type pos = in.find(',');
+	if (pos != std::string::npos) {
+		if (in.compare(pos + 1, std::string::npos, "serve") != 0) { return false; }
+		serve = 1;
+		in.erase(pos);
+	}
+	if ((pos = in.rfind(':')) != std::string::npos) {
+		host.assign(in, 0, pos);
+		in.erase(0, pos + 1);
+	}
+	char* end;
+	unsigned long p = std::strtoul(in.c_str(), &end, 10);
+	if (in.empty() || *end || p == 0 || p > 65535) { *this = NetOptions(); return false; }
+	port = static_cast<uint32>(p);
+	return true;
+}
+std::string NetOptions::str() const {
+	char buf[16];
+	std::sprintf(buf, "%u", port);
+	std::string res(host);
+	if (!res.empty()) { res += ':'; }
+	res += buf;
+	if (serve) { res += ",serve"; }
+	return res;
+}
+/////////////////////////////////////////////////////////////////////////////////////////
+// Message encoding and socket helpers
+/////////////////////////////////////////////////////////////////////////////////////////
+namespace {
+using Net::Buffer;
+const uint32 MAX_FRAME  = uint32(1) << 28; // sanity limit on message size
+const uint32 MAX_QUEUED = uint32(1) << 24; // drop nogoods once this many bytes are queued
+inline void   put32(Buffer& b, uint32 x) {
+	uint8 d[4] = { uint8(x >> 24), uint8(x >> 16), uint8(x >> 8), uint8(x) };
+	b.insert(b.end(), d, d + 4);
+}
+inline void   put64(Buffer& b, uint64 x) { put32(b, uint32(x >> 32)); put32(b, uint32(x)); }
+inline uint32 get32(const uint8* p)      { return (uint32(p[0]) << 24) | (uint32(p[1]) << 16) | (uint32(p[2]) << 8) | uint32(p[3]); }
+inline uint64 get64(const uint8* p)      { return (uint64(get32(p)) << 32) | get32(p + 4); }
+// Appends the message (type, data) to out.
+inline void   frame(Buffer& out, uint8 type, const uint8* data, uint32 size) {
+	put32(out, size + 1);
+	out.push_back(type);
+	out.insert(out.end(), data, data + size);
+}
+// Decodes a sequence of literals and checks that all variables are in [1..maxVar].
+bool decodeLits(const uint8* data, uint32 n, Var maxVar, LitVec& out) {
+	out.clear();
+	for (const uint8* end = data + (n * 4); data != end; data += 4) {
+		Literal p = Literal::fromIndex(get32(data));
+		if (p.var() == 0 || p.var() > maxVar) { return false; }
+		out.push_back(p);
+	}
+	return true;
+}
+#if CLASP_HAS_NET
+void sleepMs(int ms) { ::poll(0, 0, ms); }
+void closeSocket(int fd) { if (fd != -1) { ::close(fd); } }
+bool setNonBlocking(int fd) {
+	int f = ::fcntl(fd, F_GETFL, 0);
+	return f != -1 && ::fcntl(fd, F_SETFL, f | O_NONBLOCK) != -1;
+}
+void setOptions(int fd) {
+	int one = 1;
+	::setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (const char*)&one, sizeof(one));
+#if defined(SO_NOSIGPIPE)
+	::setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, (const char*)&one, sizeof(one));
+#endif
+}
+int connectTo(const std::string& host, uint32 port) {
+	addrinfo hints, *res = 0;
+	std::memset(&hints, 0, sizeof(hints));
+	hints.ai_family   = AF_UNSPEC;
+	hints.ai_socktype = SOCK_STREAM;
+	char service[16];
+	std::sprintf(service, "%u", port);
+	if (::getaddrinfo(host.empty() ? "localhost" : host.c_str(), service, &hints, &res) != 0) { return -1; }
+	int fd = -1;
+	for (addrinfo* it = res; it && fd == -1; it = it->ai_next) {
+		fd = ::socket(it->ai_family, it->ai_socktype, it->ai_protocol);
+		if (fd != -1 && ::connect(fd, it->ai_addr, it->ai_addrlen) != 0) { closeSocket(fd); fd = -1; }
+	}
+	::freeaddrinfo(res);
+	return fd;
+}
+int listenOn(uint32 port) {
+	int fd = ::socket(AF_INET, SOCK_STREAM, 0), one = 1;
+	if (fd == -1) { return -1; }
+	::setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, (const char*)&one, sizeof(one));
+	sockaddr_in addr;
+	std::memset(&addr, 0, sizeof(addr));
+	addr.sin_family      = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_ANY);
+	addr.sin_port        = htons(static_cast<uint16>(port));
+	if (::bind(fd, (sockaddr*)&addr, sizeof(addr)) != 0 || ::listen(fd, 64) != 0 || !setNonBlocking(fd)) {
+		closeSocket(fd);
+		return -1;
+	}
+	return fd;
+}
+// Writes data from buf starting at pos. Returns false on error.
+bool writeSome(int fd, Buffer& buf, uint32& pos) {
+	while (pos != buf.size()) {
+		ssize_t n = ::send(fd, (const char*)&buf[pos], buf.size() - pos, CLASP_NET_SEND_FLAGS);
+		if      (n > 0)          { pos += static_cast<uint32>(n); }
+		else if (errno == EINTR) { continue; }
+		else                     { return n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK); }
+	}
+	buf.clear();
+	pos = 0;
+	return true;
+}
+// Appends all available data to buf. Returns false on eof or error.
+bool readSome(int fd, Buffer& buf) {
+	uint8 temp[65536];
+	for (;;) {
+		ssize_t n = ::recv(fd, (char*)temp, sizeof(temp), 0);
+		if      (n > 0)          { buf.insert(buf.end(), temp, temp + n); if (size_t(n) < sizeof(temp)) return true; }
+		else if (n == 0)         { return false; }
+		else if (errno != EINTR) { return errno == EAGAIN || errno == EWOULDBLOCK; }
+	}
+}
+#endif
+// Returns the length of the complete message starting at buf[pos] or 0 if there is none.
+uint32 nextFrame(const Buffer& buf, uint32 pos, bool& ok) {
+	if (buf.size() - pos < 5) { return 0; }
+	uint32 len = get32(&buf[pos]);
+	if (len == 0 || len > MAX_FRAME) { ok = false; return 0; }
+	return buf.size() - pos - 4 >= len ? len : 0;
+}
+} // namespace
+/////////////////////////////////////////////////////////////////////////////////////////
+// NetCoordinator
+/////////////////////////////////////////////////////////////////////////////////////////
+struct NetCoordinator::Peer {
+	explicit Peer(int a_fd) : fd(a_fd), id(0), pos(0), hello(false), idle(false), closing(false) {}
+	int             fd;
+	uint32          id;     // 0 until hello was accepted
+	Buffer          in;     // partially read messages
+	Buffer          out;    // messages not yet written
+	uint32          pos;    // written part of out
+	bool            hello;  // hello accepted?
+	bool            idle;   // waiting for a path?
+	bool            closing;// close once out is written
+};
+
+NetCoordinator::NetCoordinator()
+	: listen_(-1), nextId_(1), holder_(0), verdict_(Net::verdict_none), lastSplit_(0), split_(false), lost_(false) {
+	stop_ = 0;
+}
+NetCoordinator::~NetCoordinator() {
+	stop();
+	while (!peers_.empty())  { removePeer(static_cast<uint32>(peers_.size() - 1)); }
+	for (PathQueue::iterator it = paths_.begin(), end = paths_.end(); it != end; ++it) { delete *it; }
+}
+
+bool NetCoordinator::start(uint32 port, std::string& err) {
+#if CLASP_HAS_NET
+	if ((listen_ = listenOn(port)) == -1) {
+		err = "could not listen on port ";
+		err += std::strerror(errno);
+		return false;
+	}
+	Clasp::thread x(std::mem_fun(&NetCoordinator::run), this);
+	thread_.swap(x);
+	return true;
+#else
+	(void)port;
+	err = "distributed search is not supported on this platform";
+	return false;
+#endif
+}
+
+void NetCoordinator::stop() {
+	stop_ = 1;
+	if (thread_.joinable()) { thread_.join(); }
+#if CLASP_HAS_NET
+	closeSocket(listen_);
+#endif
+	listen_ = -1;
+}
+
+void NetCoordinator::run() {
+#if CLASP_HAS_NET
+	PodVector<pollfd>::type fds;
+	for (uint32 closeRounds = 0;;) {
+		bool pending = false;
+		for (PeerVec::iterator it = peers_.begin(), end = peers_.end(); it != end; ++it) { pending |= !(*it)->out.empty(); }
+		// on stop, give clients up to a second to receive pending verdicts
+		if (stop_ && (!pending || ++closeRounds > 10)) { break; }
+		fds.clear();
+		pollfd x = { listen_, POLLIN, 0 };
+		fds.push_back(x);
+		for (PeerVec::iterator it = peers_.begin(), end = peers_.end(); it != end; ++it) {
+			x.fd     = (*it)->fd;
+			x.events = short(POLLIN | ((*it)->out.empty() ? 0 : POLLOUT));
+			fds.push_back(x);
+		}
+		if (::poll(&fds[0], fds.size(), 100) < 0 && errno != EINTR) { break; }
+		// peers_ may grow in accept - handle existing peers first
+		for (uint32 i = static_cast<uint32>(peers_.size()); i-- != 0; ) {
+			Peer&  p  = *peers_[i];
+			short  ev = fds[i + 1].revents;
+			bool   ok = true;
+			if (ev & (POLLIN | POLLHUP | POLLERR)) { ok = read(p); }
+			if (ok && !p.out.empty())              { ok = write(p); }
+			if (!ok || (p.closing && p.out.empty())) { removePeer(i); }
+		}
+		if (fds[0].revents & POLLIN) { accept(); }
+		if (RealTime::getTime() - lastSplit_ > 0.5) { requestSplits(); }
+	}
+#endif
+}
+
+void NetCoordinator::accept() {
+#if CLASP_HAS_NET
+	for (int fd; (fd = ::accept(listen_, 0, 0)) != -1; ) {
+		if (!setNonBlocking(fd)) { closeSocket(fd); continue; }
+		setOptions(fd);
+		peers_.push_back(new Peer(fd));
+	}
+#endif
+}
+
+bool NetCoordinator::read(Peer& p) {
+#if CLASP_HAS_NET
+	bool   ok   = readSome(p.fd, p.in), valid = true;
+	uint32 pos  = 0;
+	// handle everything read so far even if the peer is gone
+	for (uint32 len; !p.closing && (len = nextFrame(p.in, pos, valid)) != 0; pos += 4 + len) {
+		handle(p, p.in[pos + 4], p.in.begin() + pos + 5, len - 1);
+	}
+	p.in.erase(p.in.begin(), p.in.begin() + pos);
+	return ok && valid;
+#else
+	(void)p;
+	return false;
+#endif
+}
+
+bool NetCoordinator::write(Peer& p) {
+#if CLASP_HAS_NET
+	if (!writeSome(p.fd, p.out, p.pos)) { return false; }
+	if (p.pos > MAX_QUEUED) {
+		p.out.erase(p.out.begin(), p.out.begin() + p.pos);
+		p.pos = 0;
+	}
+	return true;
+#else
+	(void)p;
+	return false;
+#endif
+}
+
+void NetCoordinator::removePeer(uint32 i) {
+	Peer* p = peers_[i];
+	// in splitting mode, the search space of a busy client is lost with it
+	if (p->hello && split_ && !p->idle && verdict_ == Net::verdict_none) { lost_ = true; }
+#if CLASP_HAS_NET
+	closeSocket(p->fd);
+#endif
+	peers_.erase(peers_.begin() + i);
+	delete p;
+	if (!stop_) { dispatch(); }
+}
+
+void NetCoordinator::send(Peer& p, uint8 type, const uint8* data, uint32 size, bool drop) {
+	if (!drop || p.out.size() - p.pos < MAX_QUEUED) { frame(p.out, type, data, size); }
+}
+
+void NetCoordinator::handle(Peer& p, uint8 type, const uint8* data, uint32 size) {
+	if (!p.hello && type != Net::msg_hello) { p.closing = true; return; }
+	switch (type) {
+		case Net::msg_hello: {
+			Net::Fingerprint fp;
+			for (uint32 i = 0; i + 8 <= size; i += 8) { fp.push_back(get64(data + i)); }
+			if (fp_.empty()) { fp_ = fp; }
+			if (p.hello || fp.empty() || fp != fp_) {
+				send(p, Net::msg_reject, 0, 0);
+				p.closing = true;
+				return;
+			}
+			Buffer welcome;
+			p.hello = true;
+			p.id    = nextId_++;
+			put32(welcome, p.id);
+			put32(welcome, uint32(p.id == 1)); // first client owns the root path
+			send(p, Net::msg_welcome, &welcome[0], welcome.size());
+			if (!bound_.empty())              { send(p, Net::msg_bound, &bound_[0], bound_.size()); }
+			if (verdict_ != Net::verdict_none){ sendVerdict(p); }
+			break; }
+		case Net::msg_nogood:
+			for (PeerVec::iterator it = peers_.begin(), end = peers_.end(); it != end; ++it) {
+				if (*it != &p && (*it)->hello) { send(**it, type, data, size, true); }
+			}
+			break;
+		case Net::msg_bound: {
+			// bounds are compared lexicographically - lower is better
+			bool better = bound_.empty();
+			for (uint32 i = 0; !better && i + 8 <= size && i + 8 <= bound_.size(); i += 8) {
+				int64 lhs = static_cast<int64>(get64(data + i)), rhs = static_cast<int64>(get64(&bound_[i]));
+				if (lhs != rhs) { better = lhs < rhs; break; }
+			}
+			if (better && size) {
+				bound_.assign(data, data + size);
+				holder_ = p.id;
+				for (PeerVec::iterator it = peers_.begin(), end = peers_.end(); it != end; ++it) {
+					if (*it != &p && (*it)->hello) { send(**it, type, data, size); }
+				}
+			}
+			break; }
+		case Net::msg_done:
+			if (verdict_ == Net::verdict_none && size >= 4) {
+				decide(get32(data) == Net::done_complete ? Net::verdict_complete : Net::verdict_abort);
+			}
+			break;
+		case Net::msg_request:
+			p.idle = true;
+			split_ = true;
+			dispatch();
+			requestSplits();
+			break;
+		case Net::msg_path:
+			paths_.push_back(new Payload(data, data + size));
+			dispatch();
+			break;
+		default: p.closing = true; break;
+	}
+}
+
+// A complete search ends with the best bound: its holder reports the optimum,
+// all others abort. Without bound, the verdict is the same for all clients.
+void NetCoordinator::sendVerdict(Peer& p) {
+	Buffer v;
+	put32(v, verdict_ == Net::verdict_complete && (holder_ == 0 || holder_ == p.id) ? Net::verdict_complete : Net::verdict_abort);
+	send(p, Net::msg_stop, &v[0], v.size());
+}
+
+void NetCoordinator::decide(Net::Verdict v) {
+	verdict_ = v;
+	for (PeerVec::iterator it = peers_.begin(), end = peers_.end(); it != end; ++it) {
+		if ((*it)->hello) { sendVerdict(**it); }
+	}
+}
+
+// Hands out pending paths to idle clients and checks whether the search space is exhausted.
+void NetCoordinator::dispatch() {
+	bool allIdle = true, any = false;
+	for (PeerVec::iterator it = peers_.begin(), end = peers_.end(); it != end; ++it) {
+		Peer& p = **it;
+		if (!p.hello) { continue; }
+		if (p.idle && !paths_.empty()) {
+			Payload* path = paths_.back();
+			paths_.pop_back();
+			send(p, Net::msg_path, path->empty() ? 0 : &(*path)[0], path->size());
+			delete path;
+			p.idle = false;
+		}
+		allIdle &= p.idle;
+		any      = true;
+	}
+	if (split_ && any && allIdle && verdict_ == Net::verdict_none) {
+		decide(lost_ ? Net::verdict_abort : Net::verdict_complete);
+	}
+}
+
+// Asks busy clients to split off a path if some client is idle.
+void NetCoordinator::requestSplits() {
+	lastSplit_ = RealTime::getTime();
+	bool idle  = false;
+	for (PeerVec::iterator it = peers_.begin(), end = peers_.end(); it != end; ++it) { idle |= (*it)->hello && (*it)->idle; }
+	if (!idle || !paths_.empty() || verdict_ != Net::verdict_none) { return; }
+	for (PeerVec::iterator it = peers_.begin(), end = peers_.end(); it != end; ++it) {
+		if ((*it)->hello && !(*it)->idle) { send(**it, Net::msg_wanted, 0, 0); }
+	}
+}
+/////////////////////////////////////////////////////////////////////////////////////////
+// NetClient
+/////////////////////////////////////////////////////////////////////////////////////////
+NetClient::NetClient(uint32 numThreads)
+	: inbox_(numThreads)
+	, ids_(new Inbox::ThreadId[numThreads])
+	, fd_(-1)
+	, numThreads_(numThreads)
+	, maxVar_(0)
+	, newBound_(false) {
+	for (uint32 i = 0; i != numThreads; ++i) { ids_[i] = inbox_.addThread(); }
+	verdict_ = Net::verdict_none;
+	wanted_  = 0;
+	lost_    = 0;
+	closing_ = 0;
+}
+
+NetClient::~NetClient() {
+	close();
+	for (uint32 i = 0; i != numThreads_; ++i) {
+		for (SharedLiterals* x; inbox_.tryConsume(ids_[i], x); ) { x->release(); }
+	}
+	for (PathVec::iterator it = paths_.begin(), end = paths_.end(); it != end; ++it) { delete *it; }
+	delete [] ids_;
+}
+
+bool NetClient::connect(const NetOptions& opts, const Net::Fingerprint& fp, Var maxVar, bool& root, std::string& err) {
+#if CLASP_HAS_NET
+	maxVar_ = maxVar;
+	// the coordinator may still be starting up - retry for a while
+	for (uint32 i = 0; i != 100 && (fd_ = connectTo(opts.host, opts.port)) == -1; ++i) { sleepMs(100); }
+	if (fd_ == -1 || !setNonBlocking(fd_)) {
+		err = "could not connect to coordinator at " + opts.str();
+		return false;
+	}
+	setOptions(fd_);
+	Buffer hello, in;
+	for (Net::Fingerprint::const_iterator it = fp.begin(), end = fp.end(); it != end; ++it) { put64(hello, *it); }
+	frame(pending_, Net::msg_hello, &hello[0], hello.size());
+	// wait at most 10s for the welcome
+	uint32 pos = 0;
+	for (double start = RealTime::getTime(); RealTime::getTime() - start < 10.0; ) {
+		pollfd x = { fd_, short(POLLIN | (pending_.empty() ? 0 : POLLOUT)), 0 };
+		if (::poll(&x, 1, 100) < 0 && errno != EINTR) { break; }
+		if (!writeSome(fd_, pending_, pos) || ((x.revents & (POLLIN|POLLHUP|POLLERR)) && !readSome(fd_, in_))) { break; }
+		if (in_.size() >= 5 && in_.size() - 4 >= get32(&in_[0])) {
+			uint8 type = in_[4];
+			if (type == Net::msg_welcome && get32(&in_[0]) >= 9) {
+				root = get32(&in_[9]) != 0;
+				in_.erase(in_.begin(), in_.begin() + 4 + get32(&in_[0]));
+				Clasp::thread t(std::mem_fun(&NetClient::run), this);
+				thread_.swap(t);
+				return true;
+			}
+			err = type == Net::msg_reject ? "coordinator rejected this process: problem or options differ" : "unexpected message from coordinator";
+			closeSocket(fd_);
+			fd_ = -1;
+			return false;
+		}
+	}
+	err = "no answer from coordinator at " + opts.str();
+	closeSocket(fd_);
+	fd_ = -1;
+	return false;
+#else
+	(void)opts; (void)fp; (void)maxVar; (void)root;
+	err = "distributed search is not supported on this platform";
+	return false;
+#endif
+}
+
+void NetClient::close() {
+	if (thread_.joinable()) {
+		closing_ = 1;
+		thread_.join();
+	}
+#if CLASP_HAS_NET
+	closeSocket(fd_);
+#endif
+	fd_ = -1;
+}
+
+void NetClient::run() {
+#if CLASP_HAS_NET
+	uint32 pos = 0;
+	for (uint32 closeRounds = 0; !lost(); ) {
+		if (pending_.empty()) {
+			lock_guard<mutex> lock(outM_);
+			pending_.swap(out_);
+		}
+		// on close, try to write pending messages for up to a second
+		if (closing_ && (pending_.empty() || ++closeRounds > 50)) { break; }
+		pollfd x = { fd_, short(POLLIN | (pending_.empty() ? 0 : POLLOUT)), 0 };
+		bool ok = ::poll(&x, 1, 20) >= 0 || errno == EINTR;
+		if (ok && (x.revents & (POLLIN|POLLHUP|POLLERR))) { ok = readSome(fd_, in_); }
+		// handle everything read so far even if the coordinator is gone
+		uint32 len, rd = 0;
+		for (bool valid = true; valid && (len = nextFrame(in_, rd, valid)) != 0; rd += 4 + len) {
+			valid = handle(in_[rd + 4], in_.begin() + rd + 5, len - 1);
+		}
+		in_.erase(in_.begin(), in_.begin() + rd);
+		if (ok && !pending_.empty()) { ok = writeSome(fd_, pending_, pos); }
+		if (!ok) {
+			unique_lock<mutex> lock(inM_);
+			lost_ = 1;
+			lock.unlock();
+			pathCond_.notify_all();
+			notify();
+		}
+	}
+#endif
+}
+
+bool NetClient::handle(uint8 type, const uint8* data, uint32 size) {
+	LitVec lits;
+	switch (type) {
+		case Net::msg_nogood: {
+			uint32 n = size >= 8 ? get32(data + 4) : 0;
+			if (size < 8 || n > (size - 8) / 4 || size != 8 + (n * 4)) { return false; }
+			if (!n || !decodeLits(data + 8, n, maxVar_, lits))   { return true;  } // not for us
+			ConstraintType t = get32(data) == Constraint_t::learnt_loop ? Constraint_t::learnt_loop : Constraint_t::learnt_conflict;
+			inbox_.publish(SharedLiterals::newShareable(lits, t, numThreads_), ids_[0]);
+			return true; }
+		case Net::msg_bound: {
+			lock_guard<mutex> lock(inM_);
+			bound_.clear();
+			for (uint32 i = 0; i + 8 <= size; i += 8) { bound_.push_back(static_cast<wsum_t>(get64(data + i))); }
+			newBound_ = true;
+			break; }
+		case Net::msg_stop:
+			if (size < 4) { return false; }
+			{
+				unique_lock<mutex> lock(inM_);
+				verdict_ = get32(data) == Net::verdict_complete ? Net::verdict_complete : Net::verdict_abort;
+			}
+			pathCond_.notify_all();
+			break;
+		case Net::msg_wanted:
+			wanted_ = 1;
+			break;
+		case Net::msg_path: {
+			if ((size % 4) != 0 || !decodeLits(data, size / 4, maxVar_, lits)) { return false; }
+			{
+				lock_guard<mutex> lock(inM_);
+				paths_.push_back(new LitVec(lits));
+			}
+			pathCond_.notify_all();
+			return true; }
+		default: return true;
+	}
+	notify();
+	return true;
+}
+
+void NetClient::send(uint8 type, const Net::Buffer& data, bool drop) {
+	if (!connected()) { return; }
+	lock_guard<mutex> lock(outM_);
+	if (!drop || out_.size() < MAX_QUEUED) { frame(out_, type, data.empty() ? 0 : &data[0], data.size()); }
+}
+
+void NetClient::publish(const SharedLiterals& lits) {
+	Buffer data;
+	put32(data, lits.type());
+	put32(data, lits.size());
+	for (const Literal* it = lits.begin(), *end = lits.end(); it != end; ++it) { put32(data, it->index()); }
+	send(Net::msg_nogood, data, true);
+}
+
+void NetClient::sendBound(const wsum_t* sum, uint32 size) {
+	Buffer data;
+	for (uint32 i = 0; i != size; ++i) { put64(data, static_cast<uint64>(sum[i])); }
+	send(Net::msg_bound, data);
+}
+
+void NetClient::sendDone(Net::Done d) {
+	Buffer data;
+	put32(data, d);
+	send(Net::msg_done, data);
+}
+
+void NetClient::sendPath(const LitVec& path) {
+	Buffer data;
+	for (LitVec::const_iterator it = path.begin(), end = path.end(); it != end; ++it) { put32(data, it->index()); }
+	send(Net::msg_path, data);
+}
+
+void NetClient::requestPath() {
+	send(Net::msg_request, Buffer());
+}
+
+uint32 NetClient::receive(uint32 sId, SharedLiterals** out, uint32 maxOut) {
+	uint32 n = 0;
+	while (n != maxOut && inbox_.tryConsume(ids_[sId], out[n])) { ++n; }
+	return n;
+}
+
+LitVec* NetClient::waitPath(uint32 ms) {
+	unique_lock<mutex> lock(inM_);
+	if (paths_.empty() && !lost() && verdict() == Net::verdict_none) {
+		pathCond_.wait_for(lock, tbb::tick_count::interval_t(ms / 1000.0));
+	}
+	if (paths_.empty()) { return 0; }
+	LitVec* p = paths_.back();
+	paths_.pop_back();
+	return p;
+}
+
+bool NetClient::takeBound(SumVec& out) {
+	lock_guard<mutex> lock(inM_);
+	if (!newBound_) { return false; }
+	out       = bound_;
+	newBound_ = false;
+	return true;
+}
+/////////////////////////////////////////////////////////////////////////////////////////
+// NetDistribution
+/////////////////////////////////////////////////////////////////////////////////////////
+NetDistribution::NetDistribution(const Policy& p, Distributor* local, NetClient& net)
+	: Distributor(p)
+	, local_(local)
+	, net_(&net) {
+}
+NetDistribution::~NetDistribution() {
+	delete local_;
+}
+void NetDistribution::publish(const Solver& source, SharedLiterals* n) {
+	// send first - once published locally, n may be released by other threads
+	net_->publish(*n);
+	if      (local_) { local_->publish(source, n); }
+	else if (n->size() <= Clause::MAX_SHORT_LEN || !source.sharedContext()->physicalShare(n->type())) {
+		// single thread: source does not keep a reference
+		n->release();
+	}
+}
+uint32 NetDistribution::receive(const Solver& in, SharedLiterals** out, uint32 maxOut) {
+	uint32 n = local_ ? local_->receive(in, out, maxOut) : 0;
+	return n + net_->receive(in.id(), out + n, maxOut - n);
+}
+} }
+#endif
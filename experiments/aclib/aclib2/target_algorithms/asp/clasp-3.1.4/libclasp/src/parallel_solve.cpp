@@ -24,8 +24,15 @@
 #include <clasp/enumerator.h>
 #include <clasp/util/timer.h>
 #include <clasp/minimize_constraint.h>
+#include <clasp/lookahead.h>
 #include <clasp/util/mutex.h>
 #include <tbb/concurrent_queue.h>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#if defined(__linux__)
+#include <sched.h>
+#endif
 namespace Clasp { namespace mt {
 /////////////////////////////////////////////////////////////////////////////////////////
 // BarrierSemaphore
@@ -105,6 +112,12 @@ public:
 		}
 		if (notify) semCond_.notify_one();
 	}
+	// Takes back the last down() of a thread
+	// that has found work elsewhere.
+	void cancelDown() {
+		lock_guard<mutex> lock(semMutex_);
+		++counter_;
+	}
 private:
 	BarrierSemaphore(const BarrierSemaphore&);
 	BarrierSemaphore& operator=(const BarrierSemaphore&);
@@ -142,6 +155,7 @@ struct ParallelSolve::SharedData {
 		forbid_restart_flag   = 128u,// set if restarts are no longer allowed
 		cancel_restart_flag   = 256u,// set if current restart request was cancelled by some thread
 		restart_abandoned_flag= 512u,// set to signal that threads must not give up their gp
+		net_flag              = 1024u// set if messages from other processes are pending
 	};
 	enum Message {
 		msg_terminate      = (terminate_flag),
@@ -149,20 +163,26 @@ struct ParallelSolve::SharedData {
 		msg_sync_restart   = (sync_flag | restart_flag),
 		msg_split          = split_flag
 	};
-	SharedData() : path(0) { reset(0); control = 0; }
+	SharedData() : path(0), net(0), server(0) { reset(0); control = 0; }
+	~SharedData() { clearQueue(); }
 	void reset(SharedContext* a_ctx) {
 		clearQueue();
 		syncT.reset();
 		workSem.unsafe_init(0, a_ctx ? a_ctx->concurrency() : 0);
 		globalR.reset();
 		maxConflict = globalR.current();
-		error       = 0;
-		initMask    = 0;
+		error.clear();
+		initPath.assign(a_ctx ? a_ctx->concurrency() : 0, uint8(0));
 		ctx         = a_ctx;
 		path        = 0;
 		nextId      = 1;
 		workReq     = 0;
 		restartReq  = 0;
+		netRoot     = true;
+		netStop     = 0;
+		netBetter   = 0;
+		netDemand   = 0;
+		cubes       = 0;
 	}
 	void clearQueue() {
 		for (const LitVec* a = 0; workQ.try_pop(a); ) {
@@ -171,16 +191,14 @@ struct ParallelSolve::SharedData {
 	}
 	const LitVec* requestWork(uint32 id) {
 		// try to get initial path
-		uint64 m(uint64(1) << id);
-		uint64 init = initMask;
-		if ((m & init) == m) { initMask -= m; return path; }
+		if (id < initPath.size() && initPath[id]) { initPath[id] = 0; return path; }
 		// try to get path from split queue
 		const LitVec* res = 0;
 		if (workQ.try_pop(res)) { return res; }
 		return 0;
 	}
 	// MESSAGES
-	bool        hasMessage()  const { return (control & uint32(7)) != 0; }
+	bool        hasMessage()  const { return (control & uint32(7 | net_flag)) != 0; }
 	bool        synchronize() const { return (control & uint32(sync_flag))      != 0; }
 	bool        terminate()   const { return (control & uint32(terminate_flag)) != 0; }
 	bool        split()       const { return (control & uint32(split_flag))     != 0; }
@@ -198,10 +216,10 @@ struct ParallelSolve::SharedData {
 	bool        clearControl(uint32 flags) { return (fetch_and_and(control, ~flags) & flags) == flags; }
 	ScheduleStrategy globalR;     // global restart strategy
 	uint64           maxConflict; // current restart limit
-	uint64           error;       // bitmask of erroneous solvers
+	SolverSet        error;       // set of erroneous solvers
 	SharedContext*   ctx;         // shared context object
 	const LitVec*    path;        // initial guiding path - typically empty
-	atomic<uint64>   initMask;    // bitmask for initialization
+	PodVector<uint8>::type initPath;// initPath[i] != 0: solver i starts with initial path
 	Timer<RealTime>  syncT;       // thread sync time
 	mutex            modelM;      // model-mutex 
 	BarrierSemaphore workSem;     // work-semaphore
@@ -211,6 +229,20 @@ struct ParallelSolve::SharedData {
 	atomic<uint32>   restartReq;  // == numThreads(): restart
 	atomic<uint32>   control;     // set of active message flags
 	atomic<uint32>   modCount;    // coounter for synchronizing models
+	NetLink*         net;         // connection to other processes or 0
+	NetCoordinator*  server;      // coordinator if served by this process
+	bool             netRoot;     // process starts with initial gp in split mode
+	atomic<uint32>   netStop;     // 1 once other processes were told or told us to stop
+	atomic<uint32>   netBetter;   // 1 if current bound was found by another process
+	atomic<uint32>   netDemand;   // 1 if other processes are waiting for a split
+	uint32           cubes;       // > 0: split initial path into this many cubes once
+};
+
+// Connection to other processes - raises net_flag on new messages.
+struct ParallelSolve::NetLink : NetClient {
+	NetLink(SharedData& s, uint32 numThreads) : NetClient(numThreads), shared(&s) {}
+	void notify() { shared->setControl(SharedData::net_flag); }
+	SharedData* shared;
 };
 
 // post message to all threads
@@ -247,11 +279,13 @@ ParallelSolve::ParallelSolve(Enumerator* e, const ParallelSolveOptions& opts)
 	, shared_(new SharedData)
 	, thread_(0)
 	, distribution_(opts.distribute)
+	, net_(opts.network)
+	, cubes_(opts.cubes)
 	, maxRestarts_(0)
 	, intGrace_(1024)
 	, intTopo_(opts.integrate.topo)
 	, intFlags_(ClauseCreator::clause_not_root_sat | ClauseCreator::clause_no_add)
-	, modeSplit_(opts.algorithm.mode == ParallelSolveOptions::Algorithm::mode_split) {
+	, modeSplit_(opts.algorithm.mode == ParallelSolveOptions::Algorithm::mode_split || opts.cubes.num != 0) {
 	setRestarts(opts.restarts.maxR, opts.restarts.sched);
 	setIntegrate(opts.integrate.grace, opts.integrate.filter);
 }
@@ -264,6 +298,7 @@ ParallelSolve::~ParallelSolve() {
 		shared_->workSem.removeParty(true);
 		joinThreads();
 	}
+	stopNet();
 	destroyThread(masterId);
 	delete shared_;
 }
@@ -280,13 +315,25 @@ bool ParallelSolve::beginSolve(SharedContext& ctx) {
 	}
 	shared_->setControl(modeSplit_ ? SharedData::allow_split_flag : SharedData::forbid_restart_flag);
 	shared_->modCount = uint32(enumerator().optimize());
-	if (distribution_.types != 0 && ctx.distributor.get() == 0 && numThreads() > 1) {
-		if (distribution_.mode == ParallelSolveOptions::Distribution::mode_local) {
-			ctx.distributor.reset(new mt::LocalDistribution(distribution_, ctx.concurrency(), intTopo_));
-		}
-		else {
-			ctx.distributor.reset(new mt::GlobalDistribution(distribution_, ctx.concurrency(), intTopo_));
+	numa_.init(ctx.concurrency());
+	if (net_.enabled()) { startNet(ctx); }
+	if (modeSplit_ && cubes_.num) {
+		// cubes are a fixed partition of the search space - do not throw them away
+		shared_->cubes = cubes_.num;
+		shared_->setControl(SharedData::forbid_restart_flag);
+	}
+	if (distribution_.types != 0 && ctx.distributor.get() == 0 && (numThreads() > 1 || shared_->net)) {
+		Distributor* d = 0;
+		if (numThreads() > 1) {
+			if (distribution_.mode == ParallelSolveOptions::Distribution::mode_local) {
+				d = new mt::LocalDistribution(distribution_, ctx.concurrency(), intTopo_);
+			}
+			else {
+				d = new mt::GlobalDistribution(distribution_, ctx.concurrency(), intTopo_, numa_);
+			}
 		}
+		if (shared_->net) { d = new mt::NetDistribution(distribution_, d, *shared_->net); }
+		ctx.distributor.reset(d);
 	}
 	shared_->setControl(SharedData::sync_flag); // force initial sync with all threads
 	shared_->syncT.start();
@@ -349,10 +396,11 @@ inline void ParallelSolve::reportProgress(const Event& ev) const {
 void ParallelSolve::joinThreads() {
 	int    ec     = thread_[masterId]->error();
 	uint32 winner = thread_[masterId]->winner() ? uint32(masterId) : UINT32_MAX;
-	shared_->error= ec ? 1 : 0;
+	shared_->error.clear();
+	if (ec) { shared_->error.add(masterId); }
 	for (uint32 i = 1, end = shared_->nextId; i != end; ++i) {
 		if (thread_[i]->join() != 0) {
-			shared_->error |= uint64(1) << i;
+			shared_->error.add(i);
 			ec = std::max(ec, thread_[i]->error());
 		}
 		if (thread_[i]->winner() && i < winner) {
@@ -382,6 +430,7 @@ bool ParallelSolve::doSolve(SharedContext& ctx, const LitVec& path) {
 		int err = thread_[masterId]->error();
 		destroyThread(masterId);
 		shared_->ctx->distributor.reset(0);
+		stopNet();
 		switch(err) {
 			case error_none   : break;
 			case error_oom    : throw std::bad_alloc();
@@ -399,6 +448,10 @@ void ParallelSolve::solveParallel(uint32 id) {
 	SolveLimits lim     = limits();
 	SolverStats agg;
 	PathPtr a(0);
+	// Client threads are pinned to their numa node before attaching so that
+	// memory allocated while cloning the problem is local to the node.
+	// The master thread belongs to the caller and is left alone.
+	if (id != masterId) { numa_.pin(id); }
 	try {
 		// establish solver<->handler connection and attach to shared context
 		// should this fail because of an initial conflict, we'll terminate
@@ -476,6 +529,8 @@ bool ParallelSolve::requestWork(Solver& s, PathPtr& out) {
 		}
 		else if (a || (a = shared_->requestWork(s.id())) != 0) {
 			assert(s.decisionLevel() == 0);
+			// lookahead phase of cube-and-conquer - replace initial gp with cubes
+			if (a == shared_->path && shared_->cubes) { a = initCubes(s); }
 			// got new work from work-queue
 			out = a;
 			// do not take over ownership of initial gp!
@@ -494,8 +549,13 @@ bool ParallelSolve::requestWork(Solver& s, PathPtr& out) {
 			shared_->postMessage(SharedData::msg_split, false);
 			if (!shared_->workSem.down() && !shared_->synchronize()) {
 				// we are the last man standing, there is no
-				// work left - quitting time?
-				terminate(s, true);
+				// work left - quitting time unless other 
+				// processes have work for us
+				if (!shared_->net) { terminate(s, true); }
+				else if ((a = requestNetWork(s)) != 0) {
+					shared_->workSem.cancelDown();
+					shared_->aboutToSplit();
+				}
 			}
 		}
 		else {
@@ -511,6 +571,15 @@ bool ParallelSolve::requestWork(Solver& s, PathPtr& out) {
 // check if there is more to do
 void ParallelSolve::terminate(Solver& s, bool complete) {
 	if (!shared_->terminate()) {
+		if (shared_->net) {
+			// tell other processes why we stop unless they told us
+			bool model = enumerator().lastModel().num != 0 && !enumerator().minimizer();
+			if ((model || complete) && shared_->netStop.compare_and_swap(1, 0) == 0) {
+				shared_->net->sendDone(model ? Net::done_model : Net::done_complete);
+			}
+			// the optimum was found by another process
+			complete = complete && shared_->netBetter == 0;
+		}
 		if (enumerator().tentative() && complete) {
 			if (shared_->setControl(SharedData::sync_flag|SharedData::complete_flag)) {
 				thread_[s.id()]->setWinner();
@@ -573,26 +642,108 @@ bool ParallelSolve::waitOnSync(Solver& s) {
 //  heuristic for initial splits?
 void ParallelSolve::initQueue() {
 	shared_->clearQueue();
-	uint64 init = UINT64_MAX;
+	uint8 init = 1;
 	if (shared_->allowSplit()) {
 		if (modeSplit_ && !enumerator().supportsSplitting(*shared_->ctx)) {
 			shared_->ctx->report(warning(Event::subsystem_solve, "Selected strategies imply Mode=compete."));
 			shared_->clearControl(SharedData::allow_split_flag);
 			shared_->setControl(SharedData::forbid_restart_flag);
 			modeSplit_ = false;
+			shared_->cubes = 0;
 		}
 		else {
 			init = 0;
-			shared_->workQ.push(shared_->path);
+			// other processes get work from the root process
+			if (shared_->netRoot) { shared_->workQ.push(shared_->path); }
 		}
 	}
-	shared_->initMask = init;
+	std::fill(shared_->initPath.begin(), shared_->initPath.end(), init);
 	assert(shared_->allowSplit() || shared_->hasControl(SharedData::forbid_restart_flag));
 }
 
+// Lookahead phase of cube-and-conquer:
+// Splits the initial path breadth-first on the best literal w.r.t lookahead
+// until the requested number of cubes is reached or no literal is left.
+// Cubes refuted by lookahead are dropped. All but the first cube, which is
+// returned, are added to the work-queue so that threads waiting for work
+// pick them up as disjoint guiding paths. Once the cubes are exhausted,
+// threads fall back to dynamic splitting.
+const LitVec* ParallelSolve::initCubes(Solver& s) {
+	typedef PodVector<LitVec*>::type CubeVec;
+	CubeVec open, cubes;
+	uint32  max = shared_->cubes;
+	shared_->cubes = 0;
+	if (!s.hasConflict()) {
+		// use existing lookahead if any - otherwise only lookahead once a cube is assigned
+		Lookahead* look = static_cast<Lookahead*>(s.getPost(PostPropagator::priority_reserved_look));
+		Lookahead* own  = look ? 0 : (look = new Lookahead(Lookahead::Params(Lookahead::atom_lookahead)));
+		bool stop = false;
+		open.push_back(new LitVec(*shared_->path));
+		for (uint32 i = 0; i != open.size(); ++i) {
+			LitVec* c = open[i];
+			bool   ok = true;
+			Literal x = posLit(0);
+			if (cubes.size() + (open.size() - i) < max && !stop) {
+				ok   = s.pushRoot(*c) && (!own || (s.addPost(own) && s.propagate()));
+				x    = ok ? look->heuristic(s) : posLit(0);
+				stop = s.hasStopConflict() || shared_->terminate();
+				ok   = ok || stop;
+				if (own) { s.removePost(own); }
+				s.popRootLevel(s.rootLevel());
+			}
+			if      (!ok)          { delete c; }            // refuted
+			else if (x.var() == 0) { cubes.push_back(c); }  // enough cubes or nothing left to branch on
+			else {
+				LitVec* d = new LitVec(*c);
+				c->push_back(x);
+				d->push_back(~x);
+				open.push_back(c);
+				open.push_back(d);
+			}
+		}
+		// all levels are undone, hence there are no undo watches left to remove
+		if (own) { own->clear(); own->destroy(&s, false); }
+	}
+	if (cubes.empty()) {
+		// nothing to split or problem is unsat - let the threads find out
+		return shared_->path;
+	}
+	if (!cubes_.file.empty()) {
+		if (FILE* out = std::fopen(cubes_.file.c_str(), "w")) {
+			for (CubeVec::const_iterator it = cubes.begin(), end = cubes.end(); it != end; ++it) {
+				std::fputs("a", out);
+				for (LitVec::const_iterator x = (*it)->begin(), xEnd = (*it)->end(); x != xEnd; ++x) {
+					std::fprintf(out, " %d", x->sign() ? -int(x->var()) : int(x->var()));
+				}
+				std::fputs(" 0\n", out);
+			}
+			std::fclose(out);
+		}
+		else { reportProgress(warning(Event::subsystem_solve, "Could not open cube file.", &s)); }
+	}
+	char msg[64];
+	std::sprintf(msg, "Generated %u cubes", (uint32)cubes.size());
+	reportProgress(message(Event::subsystem_solve, msg, &s));
+	for (CubeVec::size_type i = 1; i != cubes.size(); ++i) {
+		shared_->workQ.push(cubes[i]);
+		// serve pending split requests like a splitting thread would
+		if (shared_->workReq > 0) {
+			shared_->aboutToSplit();
+			shared_->workSem.up();
+		}
+	}
+	return cubes[0];
+}
+
 // adds work to the work-queue
 void ParallelSolve::pushWork(LitVec* v) { 
 	assert(v);
+	if (shared_->netDemand != 0 && shared_->workSem.counter() >= 0 && shared_->netDemand.compare_and_swap(0, 1) == 1) {
+		// no thread of this process is waiting - give work to other process
+		shared_->net->sendPath(*v);
+		delete v;
+		return;
+	}
 	shared_->workQ.push(v);
 	shared_->workSem.up();
 }
@@ -633,6 +784,10 @@ bool ParallelSolve::commitModel(Solver& s) {
 			enumerator().setDisjoint(s, true);
 		}
 		++shared_->modCount;
+		if (shared_->net && enumerator().minimizer()) {
+			shared_->net->sendBound(enumerator().minimizer()->sum(), enumerator().minimizer()->numRules());
+			shared_->netBetter = 0;
+		}
 		if ((stop = !reportModel(s)) == true) {
 			// must be called while holding the lock - otherwise
 			// we have a race condition with solvers that
@@ -644,8 +799,8 @@ bool ParallelSolve::commitModel(Solver& s) {
 	return !stop;
 }
 
-uint64 ParallelSolve::hasErrors() const {
-	return shared_->error;
+bool ParallelSolve::hasErrors() const {
+	return !shared_->error.empty();
 }
 bool ParallelSolve::interrupted() const {
 	return shared_->interrupt();
@@ -662,6 +817,9 @@ bool ParallelSolve::handleMessages(Solver& s) {
 		// nothing to do
 		return true; 
 	}
+	if (shared_->clearControl(SharedData::net_flag)) {
+		handleNetMessages(s);
+	}
 	ParallelHandler* h = thread_[s.id()];
 	if (shared_->terminate()) {
 		reportProgress(MessageEvent(s, "TERMINATE", MessageEvent::received));
@@ -702,8 +860,111 @@ void ParallelSolve::requestRestart() {
 	}
 }
 
+// Connects to (and optionally starts) the coordinator of a distributed search.
+void ParallelSolve::startNet(SharedContext& ctx) {
+	const SharedMinimizeData* m = enumerator().minimizer();
+	if (m ? m->mode() != MinimizeMode_t::optimize : maxModels() != 1) {
+		ctx.report(warning(Event::subsystem_solve, "Distributed search requires a single model or optimization: running standalone."));
+		return;
+	}
+	std::string err;
+	if (net_.serve) {
+		shared_->server = new NetCoordinator();
+		if (!shared_->server->start(net_.port, err)) {
+			ctx.report(warning(Event::subsystem_solve, err.c_str()));
+			stopNet();
+			return;
+		}
+	}
+	// all processes must solve the same problem in the same way
+	Net::Fingerprint fp;
+	fp.push_back(ctx.numVars());
+	fp.push_back(ctx.numEliminatedVars());
+	fp.push_back(ctx.numConstraints());
+	fp.push_back(ctx.numBinary());
+	fp.push_back(ctx.numTernary());
+	fp.push_back(modeSplit_);
+	fp.push_back(m ? m->numRules() : 0);
+	for (uint32 i = 0; m && i != m->numRules(); ++i) { fp.push_back(static_cast<uint64>(m->adjust(i))); }
+	bool root = true;
+	shared_->net = new NetLink(*shared_, ctx.concurrency());
+	if (!shared_->net->connect(net_, fp, ctx.numVars(), root, err)) {
+		ctx.report(warning(Event::subsystem_solve, err.c_str()));
+		stopNet();
+		return;
+	}
+	shared_->netRoot = root;
+	// global restarts would move paths back to the root process
+	if (modeSplit_) { shared_->setControl(SharedData::forbid_restart_flag); }
+}
+
+void ParallelSolve::stopNet() {
+	if (shared_->net)    { shared_->net->close();    delete shared_->net;    shared_->net    = 0; }
+	if (shared_->server) { shared_->server->stop();  delete shared_->server; shared_->server = 0; }
+}
+
+// Integrates bounds, split requests and stop messages from other processes.
+void ParallelSolve::handleNetMessages(Solver& s) {
+	NetLink* net = shared_->net;
+	SumVec bound;
+	// the model mutex may be held by the caller's thread if called during propagation
+	if (shared_->modelM.try_lock()) {
+		SharedMinimizeData* m = const_cast<SharedMinimizeData*>(enumerator().minimizer());
+		if (net->takeBound(bound) && m && m->optimize() && bound.size() == m->numRules()
+			&& std::lexicographical_compare(bound.begin(), bound.end(), m->upper(), m->upper() + bound.size())) {
+			m->setOptimum(&bound[0]);
+			shared_->netBetter = 1;
+			++shared_->modCount;
+		}
+		shared_->modelM.unlock();
+	}
+	else {
+		shared_->setControl(SharedData::net_flag);
+	}
+	if (net->takeWanted() && shared_->allowSplit()) {
+		shared_->netDemand = 1;
+		if (shared_->workReq <= 0) { shared_->postMessage(SharedData::msg_split, false); }
+	}
+	if (net->verdict() != Net::verdict_none && shared_->netStop.compare_and_swap(1, 0) == 0) {
+		reportProgress(MessageEvent(s, "STOP", MessageEvent::received));
+		terminate(s, net->verdict() == Net::verdict_complete);
+	}
+}
+
+// Waits for a guiding path from other processes once all threads of this process are idle.
+LitVec* ParallelSolve::requestNetWork(Solver& s) {
+	NetLink* net = shared_->net;
+	reportProgress(MessageEvent(s, "SPLIT", MessageEvent::sent));
+	net->requestPath();
+	while (!shared_->terminate()) {
+		if (LitVec* path = net->waitPath(50)) { return path; }
+		shared_->clearControl(SharedData::net_flag);
+		handleNetMessages(s);
+		if (net->lost()) { terminate(s, false); }
+	}
+	return 0;
+}
+
 SolveAlgorithm* ParallelSolveOptions::createSolveObject() const {
-	return numSolver() > 1 ? new ParallelSolve(0, *this) : BasicSolveOptions::createSolveObject();
+	return numSolver() > 1 || network.enabled() || cubes.num ? new ParallelSolve(0, *this) : BasicSolveOptions::createSolveObject();
+}
+bool ParallelSolveOptions::Cubes::parse(const char* x) {
+	*this = Cubes();
+	if (!x || std::strcmp(x, "no") == 0 || std::strcmp(x, "off") == 0) { return x != 0; }
+	const char* sep = std::strchr(x, ',');
+	char* end;
+	unsigned long n = std::strtoul(x, &end, 10);
+	if (end == x || end != (sep ? sep : x + std::strlen(x)) || n == 0 || n > UINT32_MAX || (sep && !sep[1])) { return false; }
+	num = static_cast<uint32>(n);
+	if (sep) { file = sep + 1; }
+	return true;
+}
+std::string ParallelSolveOptions::Cubes::str() const {
+	char buf[16];
+	std::sprintf(buf, "%u", num);
+	std::string res(buf);
+	if (!file.empty()) { res += ','; res += file; }
+	return res;
 }
 ////////////////////////////////////////////////////////////////////////////////////
 // ParallelHandler
@@ -900,46 +1161,147 @@ void ParallelHandler::add(ClauseHead* h) {
 /////////////////////////////////////////////////////////////////////////////////////////
 // Distribution
 /////////////////////////////////////////////////////////////////////////////////////////
-uint64 ParallelSolveOptions::initPeerMask(uint32 id, Integration::Topology topo, uint32 maxT)  {
-	if (topo == Integration::topo_all) { return Distributor::initSet(maxT) ^ Distributor::mask(id); }
+SolverSet ParallelSolveOptions::initPeerSet(uint32 id, Integration::Topology topo, uint32 maxT)  {
+	SolverSet res(maxT);
+	if (topo == Integration::topo_all) {
+		for (uint32 i = 0; i != maxT; ++i) {
+			if (i != id) { res.add(i); }
+		}
+		return res;
+	}
 	if (topo == Integration::topo_ring){
-		uint32 prev = id > 0 ? id - 1 : maxT - 1;
-		uint32 next = (id + 1) % maxT;
-		return Distributor::mask(prev) | Distributor::mask(next);
+		res.add(id > 0 ? id - 1 : maxT - 1);
+		res.add((id + 1) % maxT);
+		return res;
 	}
 	bool ext = topo == Integration::topo_cubex;
 	uint32 n = maxT;
 	uint32 k = 1;
 	for (uint32 i = n / 2; i > 0; i /= 2, k *= 2) { }
-	uint64 res = 0, x = 1;
 	for (uint32 m = 1; m <= k; m *= 2) {
 		uint32 i = m ^ id;
-		if      (i < n)         { res |= (x << i);     }
-		else if (ext && k != m) { res |= (x << (i^k)); }
+		if      (i < n)         { res.add(i);     }
+		else if (ext && k != m) { res.add(i^k);   }
 	}
 	if (ext) {
 		uint32 s = k ^ id;
 		for(uint32 m = 1; m < k && s >= n; m *= 2) {
 			uint32 i = m ^ s;
-			if (i < n) { res |= (x << i); }
+			if (i < n) { res.add(i); }
 		}
 	}
-	assert( (res & (x<<id)) == 0 );
+	assert(!res.contains(id));
 	return res;
 }
 /////////////////////////////////////////////////////////////////////////////////////////
+// NumaMap
+/////////////////////////////////////////////////////////////////////////////////////////
+#if defined(__linux__)
+// Reads a sysfs list like "0-3,8-11" and calls f(x) for each x in the list.
+template <class F>
+static bool readCpuList(const char* path, F f) {
+	FILE* in = std::fopen(path, "r");
+	if (!in) { return false; }
+	for (unsigned lo, hi; std::fscanf(in, "%u", &lo) == 1; ) {
+		int c = std::fgetc(in);
+		hi    = lo;
+		if (c == '-' && std::fscanf(in, "%u", &hi) == 1) { c = std::fgetc(in); }
+		for (; lo <= hi; ++lo) { f(lo); }
+		if (c != ',') { break; }
+	}
+	std::fclose(in);
+	return true;
+}
+namespace {
+struct AddNode {
+	explicit AddNode(PodVector<uint32>::type* n) : nodes(n) {}
+	void operator()(unsigned x) const { nodes->push_back(x); }
+	PodVector<uint32>::type* nodes;
+};
+struct AddCpu {
+	AddCpu(PodVector<uint32>::type* c, const cpu_set_t* a) : cpus(c), allowed(a) {}
+	void operator()(unsigned x) const {
+		if (x < CPU_SETSIZE && CPU_ISSET(x, allowed)) { cpus->push_back(x); }
+	}
+	PodVector<uint32>::type* cpus;
+	const cpu_set_t*         allowed;
+};
+}
+#endif
+void NumaMap::init(uint32 numThreads) {
+	numThreads_ = std::max(numThreads, uint32(1));
+	if (probed_) { return; }
+	probed_ = true;
+#if defined(__linux__)
+	cpu_set_t allowed;
+	CPU_ZERO(&allowed);
+	PodVector<uint32>::type nodes;
+	if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0 || !readCpuList("/sys/devices/system/node/online", AddNode(&nodes))) {
+		return;
+	}
+	char path[64];
+	for (PodVector<uint32>::type::const_iterator it = nodes.begin(), end = nodes.end(); it != end; ++it) {
+		uint32 first = cpus_.size();
+		std::sprintf(path, "/sys/devices/system/node/node%u/cpulist", *it);
+		readCpuList(path, AddCpu(&cpus_, &allowed));
+		// ignore nodes without usable cpus
+		if (cpus_.size() != first) { cpuStart_.push_back(first); }
+	}
+	if (cpuStart_.size() < 2) {
+		cpus_.clear();
+		cpuStart_.clear();
+		return;
+	}
+	cpuStart_.push_back(cpus_.size());
+#endif
+}
+bool NumaMap::pin(uint32 sId) const {
+#if defined(__linux__)
+	if (numNodes() < 2) { return false; }
+	uint32 n = node(sId);
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	for (uint32 i = cpuStart_[n], end = cpuStart_[n+1]; i != end; ++i) {
+		CPU_SET(cpus_[i], &set);
+	}
+	return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+	(void)sId;
+	return false;
+#endif
+}
+/////////////////////////////////////////////////////////////////////////////////////////
 // GlobalDistribution
 /////////////////////////////////////////////////////////////////////////////////////////
-GlobalDistribution::GlobalDistribution(const Policy& p, uint32 maxT, uint32 topo) : Distributor(p), queue_(0) {
+GlobalDistribution::GlobalDistribution(const Policy& p, uint32 maxT, uint32 topo, const NumaMap& numa) : Distributor(p), node_(0), threadId_(0), numNode_(0), numThread_(0) {
 	typedef ParallelSolveOptions::Integration::Topology Topology;
 	assert(maxT <= ParallelSolveOptions::supportedSolvers());
 	Topology t = static_cast<Topology>(topo);
-	queue_     = new Queue(maxT);
+	numThread_ = maxT;
+	numNode_   = numa.numThreads() == maxT ? numa.numNodes() : 1;
+	node_      = new NodeInfo[numNode_];
 	threadId_  = (ThreadInfo*)alignedAlloc((maxT * sizeof(ThreadInfo)), 64);
+	for (uint32 i = 0; i != numNode_; ++i) { node_[i].size = 0; }
 	for (uint32 i = 0; i != maxT; ++i) {
 		new (&threadId_[i]) ThreadInfo;
-		threadId_[i].id       = queue_->addThread();
-		threadId_[i].peerMask = ParallelSolveOptions::initPeerMask(i, t, maxT);
+		threadId_[i].node  = numNode_ > 1 ? numa.node(i) : 0;
+		threadId_[i].peers = ParallelSolveOptions::initPeerSet(i, t, maxT);
+		NodeInfo& n = node_[threadId_[i].node];
+		n.senders  |= threadId_[i].peers;
+		++n.size;
+	}
+	// each queue is consumed by the threads of its node and
+	// by one forwarding handle for each of the other nodes
+	for (uint32 i = 0; i != numNode_; ++i) {
+		node_[i].queue = new Queue(node_[i].size + (numNode_ - 1));
+	}
+	for (uint32 i = 0; i != maxT; ++i) {
+		threadId_[i].id = node_[threadId_[i].node].queue->addThread();
+	}
+	for (uint32 i = 0; i != numNode_; ++i) {
+		for (uint32 j = 0; j != numNode_; ++j) {
+			node_[i].remote.push_back(j != i ? node_[j].queue->addThread() : Queue::ThreadId(0));
+		}
 	}
 }
 GlobalDistribution::~GlobalDistribution() {
@@ -947,30 +1309,64 @@ GlobalDistribution::~GlobalDistribution() {
 	release();
 }
 void GlobalDistribution::release() {
-	if (queue_) {
-		for (uint32 i = 0; i != queue_->maxThreads(); ++i) {
+	if (node_) {
+		for (uint32 i = 0; i != numThread_; ++i) {
 			Queue::ThreadId& id = getThreadId(i);
-			for (ClausePair n; queue_->tryConsume(id, n); ) { 
+			Queue* q = node_[threadId_[i].node].queue;
+			for (ClausePair n; q->tryConsume(id, n); ) { 
 				if (n.sender != i) { n.lits->release(); }
 			}
+		}
+		// clauses not yet forwarded still hold one reference for each thread of the target node
+		for (uint32 i = 0; i != numNode_; ++i) {
+			for (uint32 j = 0; j != numNode_; ++j) {
+				if (j == i) { continue; }
+				for (ClausePair n; node_[j].queue->tryConsume(node_[i].remote[j], n); ) {
+					if (threadId_[n.sender].node == j) { n.lits->release(node_[i].size); }
+				}
+			}
+		}
+		for (uint32 i = 0; i != numThread_; ++i) {
 			threadId_[i].~ThreadInfo();
 		}
-		delete queue_;
-		queue_ = 0;
+		for (uint32 i = 0; i != numNode_; ++i) {
+			delete node_[i].queue;
+		}
+		delete [] node_;
+		node_ = 0;
 		alignedFree(threadId_);
 	}
 }
 void GlobalDistribution::publish(const Solver& s, SharedLiterals* n) {
-	assert(n->refCount() >= (queue_->maxThreads()-1));
-	queue_->publish(ClausePair(s.id(), n), getThreadId(s.id()));
+	assert(n->refCount() >= (numThread_-1));
+	node_[threadId_[s.id()].node].queue->publish(ClausePair(s.id(), n), getThreadId(s.id()));
+}
+// moves clauses published on other nodes to the queue of the given node
+void GlobalDistribution::forward(uint32 nId) {
+	NodeInfo& to = node_[nId];
+	for (uint32 j = 0; j != numNode_; ++j) {
+		if (j == nId) { continue; }
+		Queue::ThreadId& id = to.remote[j];
+		for (ClausePair n; node_[j].queue->tryConsume(id, n); ) {
+			// skip clauses forwarded to j from some other node
+			if (threadId_[n.sender].node != j) { continue; }
+			if (n.lits->size() == 1 || to.senders.contains(n.sender)) { to.queue->publish(n, id); }
+			else                                                       { n.lits->release(to.size); }
+		}
+	}
 }
 uint32 GlobalDistribution::receive(const Solver& in, SharedLiterals** out, uint32 maxn) {
 	uint32 r = 0;
+	uint32 nId = threadId_[in.id()].node;
+	if (numNode_ > 1 && node_[nId].forward.try_lock()) {
+		forward(nId);
+		node_[nId].forward.unlock();
+	}
 	Queue::ThreadId& id = getThreadId(in.id());
-	uint64 peers = getPeerMask(in.id());
-	for (ClausePair n; r != maxn && queue_->tryConsume(id, n); ) {
+	const SolverSet& peers = getPeers(in.id());
+	for (ClausePair n; r != maxn && node_[nId].queue->tryConsume(id, n); ) {
 		if (n.sender != in.id()) {
-			if (inSet(peers, n.sender))  { out[r++] = n.lits; }
+			if (peers.contains(n.sender)) { out[r++] = n.lits; }
 			else if (n.lits->size() == 1){ out[r++] = n.lits; }
 			else                         { n.lits->release(); }
 		}
@@ -990,7 +1386,7 @@ LocalDistribution::LocalDistribution(const Policy& p, uint32 maxT, uint32 topo)
 	for (uint32 i = 0; i != maxT; ++i) {
 		ThreadData* ti = new (alignedAlloc(sz, 64)) ThreadData;
 		ti->received.init(&ti->sentinal);
-		ti->peers = ParallelSolveOptions::initPeerMask(i, t, maxT);
+		ti->peers = ParallelSolveOptions::initPeerSet(i, t, maxT);
 		ti->free  = 0;
 		thread_[i]= ti;
 	}
@@ -1046,7 +1442,7 @@ void LocalDistribution::publish(const Solver& s, SharedLiterals* n) {
 	uint32 decRef = 0;
 	for (uint32 i = 0; i != numThread_; ++i) {
 		if (i == sender) { continue; }
-		if (size > 1 && !inSet(thread_[i]->peers, sender)) { ++decRef; }
+		if (size > 1 && !thread_[i]->peers.contains(sender)) { ++decRef; }
 		else {
 			QNode* node = allocNode(sender, n);
 			thread_[i]->received.push(node);
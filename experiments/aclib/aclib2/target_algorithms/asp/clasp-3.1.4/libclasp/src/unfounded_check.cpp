@@ -23,7 +23,10 @@
 
 #include <clasp/unfounded_check.h>
 #include <clasp/clause.h>
+#include <clasp/util/thread.h>
+#include <clasp/util/mutex.h>
 #include <algorithm>
+#include <functional>
 #include <cmath>
 namespace Clasp { 
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -68,16 +71,48 @@ namespace Clasp {
 //   If l is an external literal, new valid external literals are searched and added to WS 
 //   until the source condition holds again.
 // - If the condition cannot be restored, the body is marked as invalid source.
+//
+// Checking sccs in parallel:
+// - Unfounded sets never span more than one scc and a body from another scc is a valid source
+//   as long as it is not false. Hence, the todo queue can be split by scc and each part
+//   can be processed on a different thread while the assignment is fixed.
+// - Each thread only modifies data of atoms and bodies from its own sccs. The only exceptions are
+//   watch counts of external bodies and sources of heads from other sccs. Updates of these are
+//   recorded in the thread's queues and applied once all threads are done.
+#if WITH_THREADS
+struct DefaultUnfoundedCheck::Workers {
+	enum { min_todo = 64 }; // don't split smaller todo queues
+	Workers(DefaultUnfoundedCheck& self, uint32 n);
+	~Workers();
+	Queues& queue(uint32 i) { return i ? q[i-1] : self->queues_; }
+	bool    split();
+	void    run(uint32 id);
+	DefaultUnfoundedCheck* self;
+	Queues*                q;       // queues of workers
+	Clasp::thread*         threads; // one for each worker
+	mutex                  lock;
+	condition_variable     wake;    // signaled when a new round starts
+	condition_variable     done;    // signaled when the last worker of a round is done
+	uint32                 size;    // number of workers
+	uint32                 round;   // current round
+	uint32                 busy;    // number of workers still active in current round
+	bool                   stop;
+};
+#else
+struct DefaultUnfoundedCheck::Workers { uint32 size; };
+#endif
 
 DefaultUnfoundedCheck::DefaultUnfoundedCheck(ReasonStrategy st)
 	: solver_(0) 
 	, graph_(0)
 	, mini_(0)
+	, workers_(0)
 	, reasons_(0)
 	, strategy_(st) {
 	mini_.release();
 }
 DefaultUnfoundedCheck::~DefaultUnfoundedCheck() { 
+	setWorkers(0);
 	for (ExtVec::size_type i = 0; i != extended_.size(); ++i) {
 		::operator delete(extended_[i]);
 	}
@@ -94,6 +129,19 @@ void DefaultUnfoundedCheck::addWatch(Literal p, uint32 data, WatchType type) {
 void DefaultUnfoundedCheck::setReasonStrategy(ReasonStrategy rs) {
 	strategy_ = rs;
 }
+
+void DefaultUnfoundedCheck::setWorkers(uint32 n) {
+#if WITH_THREADS
+	if (n != workers()) {
+		delete workers_;
+		workers_ = n ? new Workers(*this, n) : 0;
+	}
+#else
+	(void)n;
+#endif
+}
+uint32 DefaultUnfoundedCheck::workers() const { return workers_ ? workers_->size : 0; }
+
 // inits unfounded set checker with graph, i.e.
 // - creates data objects for bodies and atoms
 // - adds necessary watches to the solver
@@ -113,9 +161,9 @@ bool DefaultUnfoundedCheck::init(Solver& s) {
 	}
 	// process any leftovers from previous steps
 	while (findUfs(s, false) != ufs_none) {
-		while (!ufs_.empty()) {
-			if (!s.force(~graph_->getAtom(ufs_.front()).lit, 0)) { return false; }
-			atoms_[ufs_.pop_ret()].ufs = 0;
+		while (!queues_.ufs.empty()) {
+			if (!s.force(~graph_->getAtom(queues_.ufs.front()).lit, 0)) { return false; }
+			atoms_[queues_.ufs.pop_ret()].ufs = 0;
 		}
 	}
 	AtomVec::size_type startAtom = atoms_.size();
@@ -139,7 +187,7 @@ bool DefaultUnfoundedCheck::init(Solver& s) {
 		addWatch(~n.node->lit, n.id, watch_source_false);
 	}
 	// check for initially unfounded atoms
-	propagateSource();
+	propagateSource(queues_);
 	for (AtomVec::size_type i = startAtom, end = atoms_.size(); i != end; ++i) {
 		const AtomNode& a = graph_->getAtom(NodeId(i));
 		if (!atoms_[i].hasSource() && !solver_->force(~a.lit, 0)) {
@@ -187,7 +235,7 @@ void DefaultUnfoundedCheck::initSuccessors(const BodyPtr& n, weight_t lower) {
 		for (const NodeId* x = n.node->heads_begin(); x != n.node->heads_end(); ++x) {
 			const AtomNode& a = graph_->getAtom(*x);
 			if (a.scc != n.node->scc || lower <= 0) {
-				setSource(*x, n);
+				setSource(queues_, *x, n);
 			}
 		}
 	}
@@ -220,7 +268,7 @@ bool DefaultUnfoundedCheck::propagateFixpoint(Solver& s, PostPropagator* ctx) {
 	bool checkMin = ctx == 0 && mini_.get() && mini_->partialCheck(s.decisionLevel());
 	for (UfsType t; (t = findUfs(s, checkMin)) != ufs_none; ) {
 		if (!falsifyUfs(t)) { 
-			resetTodo(); 
+			resetTodo(queues_); 
 			return false;
 		}
 	}
@@ -228,7 +276,7 @@ bool DefaultUnfoundedCheck::propagateFixpoint(Solver& s, PostPropagator* ctx) {
 }
 
 void DefaultUnfoundedCheck::reset() {
-	assert(loopAtoms_.empty() && sourceQ_.empty() && ufs_.empty() && todo_.empty());
+	assert(loopAtoms_.empty() && queues_.source.empty() && queues_.ufs.empty() && queues_.todo.empty());
 	// remember assignments from top-level -
 	// the reset may come from a stop request and we might
 	// want to continue later
@@ -276,27 +324,39 @@ void DefaultUnfoundedCheck::destroy(Solver* s, bool detach) {
 // DefaultUnfoundedCheck - source pointer propagation
 /////////////////////////////////////////////////////////////////////////////////////////
 // propagates recently set source pointers within one strong component.
-void DefaultUnfoundedCheck::propagateSource() {
-	for (LitVec::size_type i = 0; i < sourceQ_.size(); ++i) {
-		NodeId atom = sourceQ_[i];
+void DefaultUnfoundedCheck::propagateSource(Queues& q) {
+	for (LitVec::size_type i = 0; i < q.source.size(); ++i) {
+		NodeId atom = q.source[i];
 		if (atoms_[atom].hasSource()) {
 			// propagate a newly added source-pointer
-			graph_->getAtom(atom).visitSuccessors(AddSource(this));
+			graph_->getAtom(atom).visitSuccessors(AddSource(this, q));
 		}
 		else {
-			graph_->getAtom(atom).visitSuccessors(RemoveSource(this));
+			graph_->getAtom(atom).visitSuccessors(RemoveSource(this, q));
 		}
 	}
-	sourceQ_.clear();
+	q.source.clear();
 }
 
 // replaces current source of atom with n
-void DefaultUnfoundedCheck::updateSource(AtomData& atom, const BodyPtr& n) {
+void DefaultUnfoundedCheck::updateSource(Queues& q, NodeId atomId, const BodyPtr& n) {
+	AtomData& atom = atoms_[atomId];
 	if (atom.watch() != AtomData::nill_source) {
-		--bodies_[atom.watch()].watches;
+		updateWatches(q, atom.watch(), atomId, false);
 	}
 	atom.setSource(n.id);
-	++bodies_[n.id].watches;
+	updateWatches(q, n.id, atomId, true);
+}
+
+// adds/removes atom to/from the watches of body
+// Bodies from other sccs may be shared with other threads - 
+// if requested, their update is deferred.
+void DefaultUnfoundedCheck::updateWatches(Queues& q, NodeId body, NodeId atom, bool inc) {
+	if (q.defer && graph_->getBody(body).scc != graph_->getAtom(atom).scc) {
+		q.watch.push_back((body << 1) | uint32(inc));
+	}
+	else if (inc) { ++bodies_[body].watches; }
+	else          { --bodies_[body].watches; }
 }
 
 // an atom in extended body n has a new source, check if n is now a valid source
@@ -309,7 +369,7 @@ void DefaultUnfoundedCheck::AddSource::operator()(NodeId bodyId, uint32 idx) con
 	}
 	if (!self->solver_->isFalse(n.node->lit) && ext->lower <= 0) {
 		// valid source - propagate to heads
-		self->forwardSource(n);
+		self->forwardSource(*q, n);
 	}
 }
 // an atom in extended body n has lost its source, check if n is no longer a valid source
@@ -320,26 +380,32 @@ void DefaultUnfoundedCheck::RemoveSource::operator()(NodeId bodyId, uint32 idx)
 	if (ext->lower > 0 && self->bodies_[n.id].watches > 0) {
 		// extended bodies don't always become false if a predecessor becomes false
 		// eagerly enqueue all successors watching this body
-		self->forwardUnsource(n, true);
+		self->forwardUnsource(*q, n, true);
 	}
 }
 
 // n is a valid source again, forward propagate this information to its heads
-void DefaultUnfoundedCheck::forwardSource(const BodyPtr& n) {
+void DefaultUnfoundedCheck::forwardSource(Queues& q, const BodyPtr& n) {
 	for (const NodeId* x = n.node->heads_begin(); x != n.node->heads_end(); ++x) {
-		setSource(*x, n);
+		if (!q.defer || graph_->getAtom(*x).scc == n.node->scc) {
+			setSource(q, *x, n);
+		}
+		else { // head from other scc - set source once all threads are done
+			q.fwd.push_back(*x);
+			q.fwd.push_back(n.id);
+		}
 	}
 }
 
 // n is no longer a valid source, forward propagate this information to its heads
-void DefaultUnfoundedCheck::forwardUnsource(const BodyPtr& n, bool add) {
+void DefaultUnfoundedCheck::forwardUnsource(Queues& q, const BodyPtr& n, bool add) {
 	for (const NodeId* x = n.node->heads_begin(); x != n.node->heads_end() && graph_->getAtom(*x).scc == n.node->scc; ++x) {
 		if (atoms_[*x].hasSource() && atoms_[*x].watch() == n.id) {
 			atoms_[*x].markSourceInvalid();
-			sourceQ_.push_back(*x);
+			q.source.push_back(*x);
 		}
 		if (add && atoms_[*x].watch() == n.id) {
-			pushTodo(*x);
+			pushTodo(q, *x);
 		}
 	}
 }
@@ -347,40 +413,40 @@ void DefaultUnfoundedCheck::forwardUnsource(const BodyPtr& n, bool add) {
 // sets body as source for head if necessary.
 // PRE: value(body) != value_false
 // POST: source(head) != 0
-void DefaultUnfoundedCheck::setSource(NodeId head, const BodyPtr& body) {
+void DefaultUnfoundedCheck::setSource(Queues& q, NodeId head, const BodyPtr& body) {
 	assert(!solver_->isFalse(body.node->lit));
 	// For normal rules from not false B follows not false head, but
 	// for choice rules this is not the case. Therefore, the 
 	// check for isFalse(head) is needed so that we do not inadvertantly
 	// source a head that is currently false.
 	if (!atoms_[head].hasSource() && !solver_->isFalse(graph_->getAtom(head).lit)) {
-		updateSource(atoms_[head], body);
-		sourceQ_.push_back(head);
+		updateSource(q, head, body);
+		q.source.push_back(head);
 	}
 }
 
 // This function is called for each body that became invalid during propagation.
 // Heads having the body as source have their source invalidated and are added
-// to the todo queue. Furthermore, source pointer removal is propagated forward
+// to the todo queue. Forward propagation of source pointer removal is 
+// done once for all invalid bodies in updateAssignment().
 void DefaultUnfoundedCheck::removeSource(NodeId bodyId) {
 	const BodyNode& body = graph_->getBody(bodyId);
 	for (const NodeId* x = body.heads_begin(); x != body.heads_end(); ++x) {
 		if (atoms_[*x].watch() == bodyId) {
 			if (atoms_[*x].hasSource()) {
 				atoms_[*x].markSourceInvalid();
-				sourceQ_.push_back(*x);
+				queues_.source.push_back(*x);
 			}
-			pushTodo(*x);
+			pushTodo(queues_, *x);
 		}
 	}
-	propagateSource();
 } 
 
 /////////////////////////////////////////////////////////////////////////////////////////
 // DefaultUnfoundedCheck - Finding & propagating unfounded sets
 /////////////////////////////////////////////////////////////////////////////////////////
 void DefaultUnfoundedCheck::updateAssignment(Solver& s) {
-	assert(sourceQ_.empty() && ufs_.empty() && pickedExt_.empty());
+	assert(queues_.source.empty() && queues_.ufs.empty() && pickedExt_.empty());
 	for (VarVec::const_iterator it = invalidQ_.begin(), end = invalidQ_.end(); it != end; ++it) {
 		uint32 index = (*it) >> 2;
 		uint32 type  = (*it) & 3u;
@@ -394,8 +460,7 @@ void DefaultUnfoundedCheck::updateAssignment(Solver& s) {
 			// for choice rules we must force source removal explicity
 			if (atoms_[index].hasSource() && !s.isFalse(graph_->getBody(atoms_[index].watch()).lit)) {
 				atoms_[index].markSourceInvalid();
-				graph_->getAtom(index).visitSuccessors(RemoveSource(this, true));
-				propagateSource();
+				graph_->getAtom(index).visitSuccessors(RemoveSource(this, queues_, true));
 			}
 		}
 		else if (type == watch_head_true) { 
@@ -421,35 +486,52 @@ void DefaultUnfoundedCheck::updateAssignment(Solver& s) {
 	}
 	pickedExt_.clear();
 	invalidQ_.clear();
+	// propagate removal of all invalid sources at once
+	propagateSource(queues_);
 }
 
 DefaultUnfoundedCheck::UfsType DefaultUnfoundedCheck::findUfs(Solver& s, bool checkMin) {
 	// first: remove all sources that were recently falsified
 	updateAssignment(s);
-	// second: try to re-establish sources.
-	while (!todo_.empty()) {
-		NodeId head       = todo_.pop_ret();
+	// second: try to re-establish sources - in parallel if possible.
+#if WITH_THREADS
+	if (workers_ && workers_->split() && !queues_.ufs.empty()) {
+		return ufs_poly;
+	}
+#endif
+	if (!findSources(queues_)) {
+		return ufs_poly;  // found an unfounded set - contained in queues_.ufs
+	}
+	return !checkMin ? ufs_none : findNonHcfUfs(s);
+}
+
+// tries to re-establish sources for all atoms in q.todo.
+// Returns false if an unfounded set was found. In that case, 
+// the set is contained in q.ufs and q.todo contains the atoms not yet checked.
+bool DefaultUnfoundedCheck::findSources(Queues& q) {
+	while (!q.todo.empty()) {
+		NodeId head       = q.todo.pop_ret();
 		atoms_[head].todo = 0;
-		if (!atoms_[head].hasSource() && !s.isFalse(graph_->getAtom(head).lit) && !findSource(head)) {
-			return ufs_poly;  // found an unfounded set - contained in unfounded_
+		if (!atoms_[head].hasSource() && !solver_->isFalse(graph_->getAtom(head).lit) && !findSource(q, head)) {
+			return false;
 		}
-		assert(sourceQ_.empty());
+		assert(q.source.empty());
 	}
-	todo_.clear();
-	return !checkMin ? ufs_none : findNonHcfUfs(s);
+	q.todo.clear();
+	return true;
 }
 
 // searches a new source for the atom node head.
 // If a new source is found the function returns true.
-// Otherwise the function returns false and unfounded_ contains head
+// Otherwise the function returns false and q.ufs contains head
 // as well as atoms with no source that circularly depend on head.
-bool DefaultUnfoundedCheck::findSource(NodeId headId) {
-	assert(ufs_.empty() && invalidQ_.empty());
+bool DefaultUnfoundedCheck::findSource(Queues& q, NodeId headId) {
+	assert(q.ufs.empty() && q.check.empty());
 	const NodeId* bodyIt, *bodyEnd;
 	uint32 newSource = 0;
-	pushUfs(headId); // unfounded, unless we find a new source
-	while (!ufs_.empty()) {
-		headId         = ufs_.pop_ret(); // still marked and in vector!
+	pushUfs(q, headId); // unfounded, unless we find a new source
+	while (!q.ufs.empty()) {
+		headId         = q.ufs.pop_ret(); // still marked and in vector!
 		AtomData& head = atoms_[headId];
 		if (!head.hasSource()) {
 			const AtomNode& headNode = graph_->getAtom(headId);
@@ -457,17 +539,17 @@ bool DefaultUnfoundedCheck::findSource(NodeId headId) {
 				BodyPtr bodyNode(getBody(*bodyIt));
 				if (!solver_->isFalse(bodyNode.node->lit)) {
 					if (bodyNode.node->scc != headNode.scc || isValidSource(bodyNode)) {
-						head.ufs = 0;               // found a new source,
-						setSource(headId, bodyNode);// set the new source
-						propagateSource();          // and propagate it forward
+						head.ufs = 0;                  // found a new source,
+						setSource(q, headId, bodyNode);// set the new source
+						propagateSource(q);            // and propagate it forward
 						++newSource;
 						break;
 					}
-					else { addUnsourced(bodyNode); }
+					else { addUnsourced(q, bodyNode); }
 				}
 			}
 			if (!head.hasSource()) { // still no source - check again once we are done
-				invalidQ_.push_back(headId); 
+				q.check.push_back(headId); 
 			}
 		}
 		else {  // head has a source and is thus not unfounded
@@ -475,21 +557,21 @@ bool DefaultUnfoundedCheck::findSource(NodeId headId) {
 			head.ufs = 0;
 		}
 	} // while unfounded_.emtpy() == false
-	ufs_.rewind();
+	q.ufs.rewind();
 	if (newSource != 0) {
-		// some atoms in unfounded_ have a new source
+		// some atoms in q.ufs have a new source
 		// clear queue and check possible candidates for atoms that are still unfounded
-		uint32 visited = ufs_.vec.size();
-		ufs_.clear();
+		uint32 visited = q.ufs.vec.size();
+		q.ufs.clear();
 		if (visited != newSource) {
 			// add elements that are still unfounded
-			for (VarVec::iterator it = invalidQ_.begin(), end = invalidQ_.end(); it != end; ++it) {
-				if ( (atoms_[*it].ufs = (1u - atoms_[*it].validS)) == 1 ) { ufs_.push(*it); }
+			for (VarVec::iterator it = q.check.begin(), end = q.check.end(); it != end; ++it) {
+				if ( (atoms_[*it].ufs = (1u - atoms_[*it].validS)) == 1 ) { q.ufs.push(*it); }
 			}
 		}
 	}
-	invalidQ_.clear();
-	return ufs_.empty();
+	q.check.clear();
+	return q.ufs.empty();
 }
 
 // checks whether the body can source its heads
@@ -527,20 +609,21 @@ bool DefaultUnfoundedCheck::isValidSource(const BodyPtr& n) {
 
 // enqueues all predecessors of this body that currently lack a source
 // PRE: isValidSource(n) == false
-void DefaultUnfoundedCheck::addUnsourced(const BodyPtr& n) {
+void DefaultUnfoundedCheck::addUnsourced(Queues& q, const BodyPtr& n) {
 	const uint32 inc = n.node->pred_inc();
 	for (const NodeId* x = n.node->preds(); *x != idMax; x += inc) {
 		if (!atoms_[*x].hasSource() && !solver_->isFalse(graph_->getAtom(*x).lit)) {
-			pushUfs(*x);
+			pushUfs(q, *x);
 		}
 	}
 }
 
-// falsifies the atoms one by one from the unfounded set stored in unfounded_
+// falsifies the atoms one by one from the unfounded set stored in queues_.ufs
 bool DefaultUnfoundedCheck::falsifyUfs(UfsType t) {
+	IdQueue& ufs = queues_.ufs;
 	activeClause_.clear();
-	for (uint32 rDL = 0; !ufs_.empty(); ) {
-		Literal a = graph_->getAtom(ufs_.front()).lit;
+	for (uint32 rDL = 0; !ufs.empty(); ) {
+		Literal a = graph_->getAtom(ufs.front()).lit;
 		if (!solver_->isFalse(a) && !(assertAtom(a, t) && solver_->propagateUntil(this))) {
 			if (t == ufs_non_poly) {
 				mini_->schedNext(solver_->decisionLevel(), false);
@@ -548,14 +631,14 @@ bool DefaultUnfoundedCheck::falsifyUfs(UfsType t) {
 			break;
 		}
 		assert(solver_->isFalse(a));
-		atoms_[ufs_.pop_ret()].ufs = 0;
-		if      (ufs_.qFront == 1)               { rDL = solver_->decisionLevel(); }
+		atoms_[ufs.pop_ret()].ufs = 0;
+		if      (ufs.qFront == 1)                { rDL = solver_->decisionLevel(); }
 		else if (solver_->decisionLevel() != rDL){ break; /* atoms may no longer be unfounded after backtracking */ }
 	}
 	if (!loopAtoms_.empty()) {
 		createLoopFormula();
 	}
-	resetUfs();
+	resetUfs(queues_);
 	activeClause_.clear();
 	return !solver_->hasConflict();
 }
@@ -608,9 +691,10 @@ void DefaultUnfoundedCheck::createLoopFormula() {
 // computes the reason why a set of atoms is unfounded
 void DefaultUnfoundedCheck::computeReason(UfsType t) {
 	if (strategy_ == no_reason) { return; }
-	uint32 ufsScc = graph_->getAtom(ufs_.front()).scc;
-	for (VarVec::size_type i = ufs_.qFront; i != ufs_.vec.size(); ++i) {
-		const AtomNode& atom = graph_->getAtom(ufs_.vec[i]);
+	const IdQueue& ufs = queues_.ufs;
+	uint32 ufsScc = graph_->getAtom(ufs.front()).scc;
+	for (VarVec::size_type i = ufs.qFront; i != ufs.vec.size(); ++i) {
+		const AtomNode& atom = graph_->getAtom(ufs.vec[i]);
 		if (!solver_->isFalse(atom.lit)) {
 			assert(atom.scc == ufsScc);
 			for (const NodeId* x = atom.bodies_begin(); x != atom.bodies_end(); ++x) {
@@ -730,6 +814,126 @@ void DefaultUnfoundedCheck::addReasonLit(Literal p) {
 	}
 }
 
+#if WITH_THREADS
+/////////////////////////////////////////////////////////////////////////////////////////
+// DefaultUnfoundedCheck - Checking sccs in parallel
+/////////////////////////////////////////////////////////////////////////////////////////
+DefaultUnfoundedCheck::Workers::Workers(DefaultUnfoundedCheck& u, uint32 n)
+	: self(&u)
+	, q(new Queues[n])
+	, threads(new Clasp::thread[n])
+	, size(n)
+	, round(0)
+	, busy(0)
+	, stop(false) {
+	for (uint32 i = 0; i != n; ++i) {
+		q[i].defer = true;
+		Clasp::thread x(std::mem_fun(&Workers::run), this, i+1);
+		threads[i].swap(x);
+	}
+}
+DefaultUnfoundedCheck::Workers::~Workers() {
+	{
+		unique_lock<mutex> guard(lock);
+		stop = true;
+	}
+	wake.notify_all();
+	for (uint32 i = 0; i != size; ++i) {
+		if (threads[i].joinable()) { threads[i].join(); }
+	}
+	delete [] threads;
+	delete [] q;
+}
+
+// waits for new rounds and processes the queue of worker id
+void DefaultUnfoundedCheck::Workers::run(uint32 id) {
+	for (uint32 seen = 0;;) {
+		{
+			unique_lock<mutex> guard(lock);
+			while (round == seen && !stop) { wake.wait(guard); }
+			if (stop) { return; }
+			seen = round;
+		}
+		self->findSources(queue(id));
+		unique_lock<mutex> guard(lock);
+		if (--busy == 0) { done.notify_one(); }
+	}
+}
+
+// distributes the todo queue of the solver's thread by scc and
+// processes all parts in parallel.
+// Returns false if the queue is too small or contains only atoms
+// of one part. Otherwise, queues_.ufs contains the first unfounded set found
+// (if any) and queues_.todo the atoms not yet checked.
+bool DefaultUnfoundedCheck::Workers::split() {
+	Queues& main = self->queues_;
+	VarVec& todo = main.todo.vec;
+	if (main.todo.size() < min_todo) { return false; }
+	const SharedDependencyGraph& graph = *self->graph_;
+	const uint32 parts = size + 1;
+	uint32 first = graph.getAtom(main.todo.front()).scc % parts;
+	VarVec::size_type i = main.todo.qFront, end = todo.size(), keep = i;
+	while (i != end && graph.getAtom(todo[i]).scc % parts == first) { ++i; }
+	if (i == end) { return false; }
+	// keep atoms of part 0 and move all others to their worker
+	for (i = keep; i != end; ++i) {
+		uint32 p = graph.getAtom(todo[i]).scc % parts;
+		if (p == 0) { todo[keep++] = todo[i]; }
+		else        { q[p-1].todo.push(todo[i]); }
+	}
+	shrinkVecTo(todo, keep);
+	main.defer = true;
+	{
+		unique_lock<mutex> guard(lock);
+		busy = size;
+		++round;
+	}
+	wake.notify_all();
+	self->findSources(main);
+	{
+		unique_lock<mutex> guard(lock);
+		while (busy != 0) { done.wait(guard); }
+	}
+	main.defer = false;
+	// apply deferred updates
+	for (uint32 p = 0; p != parts; ++p) {
+		VarVec& w = queue(p).watch;
+		for (VarVec::const_iterator it = w.begin(), wEnd = w.end(); it != wEnd; ++it) {
+			BodyData& b = self->bodies_[*it >> 1];
+			if ((*it & 1u) != 0) { ++b.watches; }
+			else                 { --b.watches; }
+		}
+		w.clear();
+	}
+	for (uint32 p = 0; p != parts; ++p) {
+		VarVec& f = queue(p).fwd;
+		for (VarVec::size_type k = 0; k != f.size(); k += 2) {
+			self->setSource(main, f[k], self->getBody(f[k+1]));
+		}
+		f.clear();
+	}
+	self->propagateSource(main);
+	// keep first unfounded set - all other atoms are checked again later
+	Queues* ufs = main.ufs.empty() ? 0 : &main;
+	for (uint32 p = 1; p != parts; ++p) {
+		Queues& w = queue(p);
+		if (!w.ufs.empty() && !ufs) {
+			main.ufs.vec.swap(w.ufs.vec);
+			std::swap(main.ufs.qFront, w.ufs.qFront);
+			ufs = &w;
+		}
+		while (!w.ufs.empty()) {
+			NodeId a = w.ufs.pop_ret();
+			self->atoms_[a].ufs = 0;
+			self->pushTodo(main, a);
+		}
+		w.ufs.clear();
+		while (!w.todo.empty()) { main.todo.push(w.todo.pop_ret()); }
+		w.todo.clear();
+	}
+	return true;
+}
+#endif
 /////////////////////////////////////////////////////////////////////////////////////////
 // DefaultUnfoundedCheck - Minimality check for disjunctive logic programs
 /////////////////////////////////////////////////////////////////////////////////////////
@@ -746,12 +950,12 @@ DefaultUnfoundedCheck::UfsType DefaultUnfoundedCheck::findNonHcfUfs(Solver& s) {
 			for (VarVec::const_iterator it = invalidQ_.begin(), end = invalidQ_.end(); it != end; ++it) {
 				if (s.isTrue(graph_->getAtom(*it).lit) && s.level(graph_->getAtom(*it).lit.var()) < minDL) {
 					minDL = s.level(graph_->getAtom(*it).lit.var());
-					pos   = (uint32)ufs_.vec.size();
+					pos   = (uint32)queues_.ufs.vec.size();
 				}
-				pushUfs(*it);
+				pushUfs(queues_, *it);
 			}
 			if (pos) {
-				std::swap(ufs_.vec.front(), ufs_.vec[pos]);
+				std::swap(queues_.ufs.vec.front(), queues_.ufs.vec[pos]);
 			}
 			invalidQ_.clear();
 			loopAtoms_.clear();
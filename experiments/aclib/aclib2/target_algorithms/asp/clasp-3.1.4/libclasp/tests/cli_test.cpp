@@ -41,6 +41,7 @@ class CliTest : public CppUnit::TestFixture {
 	CPPUNIT_TEST(testConfigEnumerateKeys);
 	CPPUNIT_TEST(testConfigQueryKeys);
 	CPPUNIT_TEST(testConfigQueryArrKey);
+	CPPUNIT_TEST(testConfigQueryArrKeyLargeId);
 
 	CPPUNIT_TEST(testConfigInit);
 	CPPUNIT_TEST(testConfigInitFromFile);
@@ -60,6 +61,7 @@ class CliTest : public CppUnit::TestFixture {
 	CPPUNIT_TEST(testSetParallelMode);
 	CPPUNIT_TEST(testSetDistribute);
 	CPPUNIT_TEST(testSetIntegrate);
+	CPPUNIT_TEST(testSetCubes);
 #endif
 	CPPUNIT_TEST(testConfigQueryStrValues);
 	CPPUNIT_TEST(testSetOptBound);
@@ -205,7 +207,8 @@ public:
 		ClaspCliConfig::KeyType s0 = config.getArrKey(ClaspCliConfig::KEY_SOLVER, 0);		
 		CPPUNIT_ASSERT(s0 != ClaspCliConfig::INVALID_KEY);
 		CPPUNIT_ASSERT(s0 != ClaspCliConfig::KEY_SOLVER);
-		CPPUNIT_ASSERT(config.getArrKey(ClaspCliConfig::KEY_SOLVER, 64) == ClaspCliConfig::INVALID_KEY);
+		CPPUNIT_ASSERT(config.getArrKey(ClaspCliConfig::KEY_SOLVER, 64) != ClaspCliConfig::INVALID_KEY);
+		CPPUNIT_ASSERT(config.getArrKey(ClaspCliConfig::KEY_SOLVER, SolveOptions::supportedSolvers()) == ClaspCliConfig::INVALID_KEY);
 		
 		ClaspCliConfig::KeyType st0 = config.getArrKey(config.getKey(ClaspCliConfig::KEY_TESTER, "solver"), 0);		
 		CPPUNIT_ASSERT(s0 != st0 && st0 != ClaspCliConfig::INVALID_KEY);
@@ -214,6 +217,23 @@ public:
 		config.setValue(config.getKey(s5, "heuristic"), "unit");
 		CPPUNIT_ASSERT(config.solver(5).heuId == Heuristic_t::heu_unit);	
 	}
+	void testConfigQueryArrKeyLargeId() {
+		ClaspCliConfig config;
+		uint32 maxId = SolveOptions::supportedSolvers() - 1;
+		ClaspCliConfig::KeyType s300 = config.getArrKey(ClaspCliConfig::KEY_SOLVER, 300);
+		ClaspCliConfig::KeyType sMax = config.getArrKey(ClaspCliConfig::KEY_SOLVER, maxId);
+		CPPUNIT_ASSERT(s300 != ClaspCliConfig::INVALID_KEY && sMax != ClaspCliConfig::INVALID_KEY && s300 != sMax);
+		CPPUNIT_ASSERT(s300 != config.getArrKey(ClaspCliConfig::KEY_SOLVER, 300 - 256));
+		CPPUNIT_ASSERT(s300 == config.getKey(ClaspCliConfig::KEY_ROOT, "solver.300"));
+
+		config.setValue(config.getKey(s300, "heuristic"), "unit");
+		config.setValue(config.getKey(sMax, "heuristic"), "vmtf");
+		CPPUNIT_ASSERT(config.solver(300).heuId == Heuristic_t::heu_unit);
+		CPPUNIT_ASSERT(config.solver(maxId).heuId == Heuristic_t::heu_vmtf);
+		CPPUNIT_ASSERT(config.solver(300 - 256).heuId != Heuristic_t::heu_unit);
+		CPPUNIT_ASSERT(config.solver(maxId & 255).heuId != Heuristic_t::heu_vmtf);
+		CPPUNIT_ASSERT(config.getValue("solver.300.heuristic").find("unit") == 0);
+	}
 	void testConfigInit() {
 		ClaspCliConfig config;
 		ClaspCliConfig::KeyType initGen  = config.getKey(ClaspCliConfig::KEY_ROOT, "configuration");
@@ -438,7 +458,9 @@ public:
 		CPPUNIT_ASSERT_EQUAL(uint32(10), config.solve.algorithm.threads);
 		CPPUNIT_ASSERT(SolveOptions::Algorithm::mode_split == config.solve.algorithm.mode);
 
-		CPPUNIT_ASSERT_EQUAL(0, config.setValue(pMode, "65"));
+		CPPUNIT_ASSERT_EQUAL(1, config.setValue(pMode, "65"));
+		CPPUNIT_ASSERT_EQUAL(uint32(65), config.solve.algorithm.threads);
+		CPPUNIT_ASSERT_EQUAL(0, config.setValue(pMode, "4096"));
 	}
 	void testSetDistribute() {
 		ClaspCliConfig config;
@@ -485,6 +507,34 @@ public:
 		CPPUNIT_ASSERT(77 == config.solve.integrate.grace);
 		CPPUNIT_ASSERT(SolveOptions::Integration::topo_cube == config.solve.integrate.topo);
 	}
+	void testSetCubes() {
+		ClaspCliConfig config;
+		ClaspCliConfig::KeyType cubes = config.getKey(ClaspCliConfig::KEY_ROOT, "solve.cubes");
+		std::string out;
+		CPPUNIT_ASSERT_EQUAL(1, config.setValue(cubes, "64"));
+		CPPUNIT_ASSERT(64 == config.solve.cubes.num && config.solve.cubes.file.empty());
+		CPPUNIT_ASSERT(config.getValue(cubes, out) > 0 && out == "64");
+
+		CPPUNIT_ASSERT_EQUAL(1, config.setValue(cubes, "8,cubes.txt"));
+		CPPUNIT_ASSERT(8 == config.solve.cubes.num && config.solve.cubes.file == "cubes.txt");
+		CPPUNIT_ASSERT(config.getValue(cubes, out) > 0 && out == "8,cubes.txt");
+
+		CPPUNIT_ASSERT_EQUAL(1, config.setValue(cubes, "no"));
+		CPPUNIT_ASSERT(0 == config.solve.cubes.num && config.solve.cubes.file.empty());
+
+		const char* bad[] = {"0", "0,cubes.txt", "8,", ",cubes.txt", "x", "8x", "-1", "4294967296", 0};
+		for (const char** x = bad; *x; ++x) {
+			CPPUNIT_ASSERT_EQUAL(0, config.setValue(cubes, *x));
+		}
+
+		const char* good[] = {"1", "16", "4294967295", "2,a", "3,dir/cubes.txt", "4,a,b", 0};
+		for (const char** x = good; *x; ++x) {
+			SolveOptions::Cubes c;
+			CPPUNIT_ASSERT(c.parse(*x) && c.str() == *x);
+			SolveOptions::Cubes d;
+			CPPUNIT_ASSERT(d.parse(c.str().c_str()) && d.num == c.num && d.file == c.file);
+		}
+	}
 	#endif
 
 	void testConfigQueryStrValues() {
@@ -24,6 +24,17 @@
 #include <clasp/minimize_constraint.h>
 #include <clasp/heuristics.h>
 #include <clasp/lookahead.h>
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#if WITH_THREADS && !defined(_WIN32)
+#include <clasp/net_solve.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <unistd.h>
+#define CLASP_TEST_NET 1
+#endif
 
 namespace Clasp { namespace Test {
 using namespace Clasp::mt;
@@ -68,6 +79,12 @@ class FacadeTest : public CppUnit::TestFixture {
 	CPPUNIT_TEST(testDestroyAsyncResultNoFacade);
 	CPPUNIT_TEST(testDestroyDanglingAsyncResult);
 	CPPUNIT_TEST(testCancelDanglingAsyncOperation);
+	CPPUNIT_TEST(testCubesFindSameModels);
+#if CLASP_TEST_NET
+	CPPUNIT_TEST(testNetSolveSat);
+	CPPUNIT_TEST(testNetSolveUnsat);
+	CPPUNIT_TEST(testNetSolveOptimum);
+#endif
 #endif
 	CPPUNIT_TEST_SUITE_END(); 
 public:
@@ -699,6 +716,171 @@ public:
 		CPPUNIT_ASSERT_EQUAL(true, step1.cancel());
 		CPPUNIT_ASSERT(!libclasp.solving());
 	}
+	struct ModelSet : EventHandler {
+		explicit ModelSet(const Asp::LogicProgram& p) : prg(&p) {}
+		bool onModel(const Solver&, const Model& m) {
+			uint32 atoms = 0;
+			for (Var v = 1; v <= 10; ++v) {
+				if (m.isTrue(prg->getLiteral(v))) { atoms |= (1u << v); }
+			}
+			models.push_back(atoms);
+			return true;
+		}
+		const Asp::LogicProgram* prg;
+		std::vector<uint32>      models;
+	};
+	// {1..10}. :- i, i+1. has 144 answer sets
+	std::vector<uint32> enumerateNoAdjacent(ClaspConfig& config, uint64& numEnum) {
+		ClaspFacade libclasp;
+		config.solve.numModels = 0;
+		Asp::LogicProgram& asp = libclasp.startAsp(config, true);
+		asp.startRule(Asp::CHOICERULE);
+		for (Var v = 1; v <= 10; ++v) { asp.addHead(v); }
+		asp.endRule();
+		asp.setAtomName(11, "x").setCompute(11, false);
+		for (Var v = 1; v != 10; ++v) {
+			asp.startRule().addHead(11).addToBody(v, true).addToBody(v+1, true).endRule();
+		}
+		libclasp.prepare();
+		ModelSet mh(asp);
+		libclasp.solve(&mh);
+		numEnum = libclasp.summary().numEnum;
+		std::sort(mh.models.begin(), mh.models.end());
+		return mh.models;
+	}
+	void testCubesFindSameModels() {
+		const char* cubeFile = ".test_testCubesFindSameModels.cubes";
+		ClaspConfig plain, cubes;
+		cubes.solve.algorithm.threads = 2;
+		cubes.solve.cubes.num  = 8;
+		cubes.solve.cubes.file = cubeFile;
+		uint64 nPlain = 0, nCubes = 0;
+		std::vector<uint32> exp = enumerateNoAdjacent(plain, nPlain);
+		std::vector<uint32> res = enumerateNoAdjacent(cubes, nCubes);
+		CPPUNIT_ASSERT_EQUAL(uint64(144), nPlain);
+		CPPUNIT_ASSERT_EQUAL(nPlain, nCubes);
+		CPPUNIT_ASSERT(exp == res);
+		// the search was actually split
+		std::ifstream in(cubeFile);
+		std::string line;
+		uint32 numCubes = 0;
+		while (std::getline(in, line)) { numCubes += line.compare(0, 2, "a ") == 0; }
+		in.close();
+		std::remove(cubeFile);
+		CPPUNIT_ASSERT(numCubes > 1);
+	}
+#if CLASP_TEST_NET
+	// One process of a distributed search on 127.0.0.1.
+	struct NetProcess : EventHandler {
+		NetProcess() : warnings(0) {}
+		void onEvent(const Event& ev) {
+			const LogEvent* log = event_cast<LogEvent>(ev);
+			if (log && log->isWarning()) { ++warnings; }
+		}
+		ClaspConfig config;
+		ClaspFacade libclasp;
+		int         warnings;
+	};
+	static uint32 freePort() {
+		int fd = ::socket(AF_INET, SOCK_STREAM, 0);
+		sockaddr_in addr;
+		socklen_t   len = sizeof(addr);
+		std::memset(&addr, 0, sizeof(addr));
+		addr.sin_family      = AF_INET;
+		addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+		uint32 port = 0;
+		if (fd != -1 && ::bind(fd, (sockaddr*)&addr, sizeof(addr)) == 0 && ::getsockname(fd, (sockaddr*)&addr, &len) == 0) {
+			port = ntohs(addr.sin_port);
+		}
+		if (fd != -1) { ::close(fd); }
+		return port;
+	}
+	// Pigeons are placed in holes, no two in the same hole.
+	// If weighted, placing pigeon p in hole h costs 1 + (p*h) % 3.
+	static void addPigeons(Asp::LogicProgram& asp, uint32 pigeons, uint32 holes, bool weighted) {
+		Var x = pigeons * holes + 1;
+		asp.setAtomName(x, "x").setCompute(x, false);
+		asp.startRule(Asp::CHOICERULE);
+		for (Var v = 1; v != x; ++v) { asp.addHead(v); }
+		asp.endRule();
+		for (uint32 p = 0; p != pigeons; ++p) {
+			asp.startRule().addHead(x);
+			for (uint32 h = 0; h != holes; ++h) { asp.addToBody(1 + p*holes + h, false); }
+			asp.endRule();
+			for (uint32 q = p + 1; q != pigeons; ++q) {
+				for (uint32 h = 0; h != holes; ++h) {
+					asp.startRule().addHead(x).addToBody(1 + p*holes + h, true).addToBody(1 + q*holes + h, true).endRule();
+				}
+			}
+		}
+		if (weighted) {
+			asp.startRule(Asp::OPTIMIZERULE);
+			for (uint32 p = 0; p != pigeons; ++p) {
+				for (uint32 h = 0; h != holes; ++h) { asp.addToBody(1 + p*holes + h, true, 1 + (p*h) % 3); }
+			}
+			asp.endRule();
+		}
+	}
+	// Solves the problem with a coordinator and two clients (the first one serving it) in splitting mode.
+	// The second client starts without a guiding path, so it can only finish through the coordinator.
+	void netSolve(NetProcess* proc, uint32 pigeons, uint32 holes, bool weighted) {
+		uint32 port = freePort();
+		CPPUNIT_ASSERT(port != 0);
+		for (uint32 i = 0; i != 2; ++i) {
+			ClaspConfig& config = proc[i].config;
+			config.solve.numModels      = weighted ? 0 : 1;
+			config.solve.algorithm.mode = SolveOptions::Algorithm::mode_split;
+			config.solve.network.host   = "127.0.0.1";
+			config.solve.network.port   = port;
+			config.solve.network.serve  = i == 0;
+			addPigeons(proc[i].libclasp.startAsp(config), pigeons, holes, weighted);
+			proc[i].libclasp.prepare();
+			proc[i].libclasp.ctx.setEventHandler(&proc[i]);
+		}
+		AsyncResult first  = proc[0].libclasp.solveAsync();
+		AsyncResult second = proc[1].libclasp.solveAsync();
+		CPPUNIT_ASSERT(first.waitFor(60.0) && second.waitFor(60.0));
+		CPPUNIT_ASSERT_EQUAL(0, proc[0].warnings + proc[1].warnings);
+	}
+	void testNetSolveSat() {
+		NetProcess proc[2];
+		netSolve(proc, 5, 5, false);
+		// the process that found the model stops the other one
+		const ClaspFacade::Summary& s0 = proc[0].libclasp.summary(), &s1 = proc[1].libclasp.summary();
+		CPPUNIT_ASSERT(s0.sat() || s1.sat());
+		CPPUNIT_ASSERT(!s0.unsat() && !s1.unsat());
+	}
+	void testNetSolveUnsat() {
+		NetProcess proc[2];
+		netSolve(proc, 6, 5, false);
+		CPPUNIT_ASSERT(proc[0].libclasp.summary().unsat());
+		CPPUNIT_ASSERT(proc[1].libclasp.summary().unsat());
+	}
+	void testNetSolveOptimum() {
+		ClaspConfig config;
+		ClaspFacade single;
+		config.solve.numModels = 0;
+		addPigeons(single.startAsp(config), 5, 5, true);
+		single.prepare();
+		single.solve();
+		CPPUNIT_ASSERT(single.summary().optimum());
+		wsum_t opt = (*single.summary().costs())[0];
+
+		NetProcess proc[2];
+		netSolve(proc, 5, 5, true);
+		// the process holding the best bound reports the optimum, the other one is stopped
+		uint32 optimum = 0;
+		for (uint32 i = 0; i != 2; ++i) {
+			const ClaspFacade::Summary& s = proc[i].libclasp.summary();
+			CPPUNIT_ASSERT(!s.unsat());
+			if (s.optimum()) {
+				CPPUNIT_ASSERT_EQUAL(opt, (*s.costs())[0]);
+				++optimum;
+			}
+		}
+		CPPUNIT_ASSERT_EQUAL(uint32(1), optimum);
+	}
+#endif
 #endif
 };
 CPPUNIT_TEST_SUITE_REGISTRATION(FacadeTest);
@@ -51,6 +51,9 @@ namespace Clasp { namespace Test {
 	CPPUNIT_TEST(testDetachRemovesWatches);
 
 	CPPUNIT_TEST(testApproxUfs);
+#if WITH_THREADS
+	CPPUNIT_TEST(testSplitSccsLikeSequential);
+#endif
 	CPPUNIT_TEST_SUITE_END(); 
 public:
 	class WrapDefaultUnfoundedCheck : public DefaultUnfoundedCheck {
@@ -524,6 +527,58 @@ public:
 		CPPUNIT_ASSERT_MESSAGE("TODO: Implement approx. ufs!", solver().isFalse(ctx.symbolTable()[4].lit));
 		
 	}
+#if WITH_THREADS
+	// {x, z}.
+	// For each of 8 sccs k, a loop of 16 atoms a(k,0..15):
+	// a(k,i) :- not x.  a(k,i+1) :- a(k,i).  a(k,0) :- a(k,15).
+	// a(k,8) :- z.     % only if k is even
+	// Assuming x falsifies the common source of all 128 loop atoms at once,
+	// so that the todo queue exceeds min_todo and is split over the workers.
+	// Atoms of odd sccs are then unfounded.
+	enum { chain_sccs = 8, chain_len = 16 };
+	ValueVec checkChains(uint32 workers) {
+		SharedContext c;
+		LogicProgram  prg;
+		prg.start(c, LogicProgram::AspOptions().noEq());
+		prg.setAtomName(1, "x").setAtomName(2, "z").startRule(CHOICERULE).addHead(1).addHead(2).endRule();
+		for (uint32 k = 0; k != chain_sccs; ++k) {
+			Var a = 3 + k*chain_len;
+			for (uint32 i = 0; i != chain_len; ++i) {
+				prg.startRule().addHead(a + i).addToBody(1, false).endRule();
+				prg.startRule().addHead(a + (i+1) % chain_len).addToBody(a + i, true).endRule();
+			}
+			if ((k & 1) == 0) { prg.startRule().addHead(a + chain_len/2).addToBody(2, true).endRule(); }
+		}
+		CPPUNIT_ASSERT_EQUAL(true, prg.endProgram());
+		CPPUNIT_ASSERT(uint32(chain_sccs) == prg.stats.sccs);
+		WrapDefaultUnfoundedCheck* u = new WrapDefaultUnfoundedCheck();
+		u->setWorkers(workers);
+		CPPUNIT_ASSERT_EQUAL(workers, u->workers());
+		c.master()->addPost(u);
+		c.endInit();
+		Solver& s = *c.master();
+		CPPUNIT_ASSERT_EQUAL(true, s.propagateUntil(u));
+		CPPUNIT_ASSERT_EQUAL(true, s.assume(c.symbolTable()[2].lit) && s.propagate());
+		CPPUNIT_ASSERT_EQUAL(true, s.assume(c.symbolTable()[1].lit) && s.propagateUntil(u));
+		CPPUNIT_ASSERT_EQUAL(true, u->propagate(s));
+		ValueVec res;
+		for (Var v = 1; v != 3 + chain_sccs*chain_len; ++v) {
+			Literal p = prg.getLiteral(v);
+			res.push_back(s.isTrue(p) ? value_true : s.isFalse(p) ? value_false : value_free);
+		}
+		return res;
+	}
+	void testSplitSccsLikeSequential() {
+		ValueVec seq = checkChains(0);
+		ValueVec par = checkChains(3);
+		CPPUNIT_ASSERT(seq == par);
+		for (uint32 k = 0; k != chain_sccs; ++k) {
+			for (uint32 i = 0; i != chain_len; ++i) {
+				CPPUNIT_ASSERT_EQUAL((k & 1) != 0, par[2 + k*chain_len + i] == value_false);
+			}
+		}
+	}
+#endif
 private:
 	SharedContext ctx;
 	SingleOwnerPtr<WrapDefaultUnfoundedCheck> ufs;
@@ -872,7 +872,7 @@ const vector<const_symbol_list*> getParametersDiscrete(goal * g,operator_ * op,
       getPNEs(comp->getLHS(),pnes);
       getPNEs(comp->getRHS(),pnes);
 
-      set<const FuncExp *> changedPNEs = s.getChangedPNEs();
+      const set<const FuncExp *> & changedPNEs = s.getChangedPNEs();
 
       for(set<const func_term*>::iterator pne = pnes.begin(); pne != pnes.end(); ++pne)
       {
@@ -922,7 +922,7 @@ const vector<const_symbol_list*> getParametersDiscrete(goal * g,operator_ * op,
 
       //check if literal is one that has changed since last happening
       //if so fill in parameters with one from a simple prop
-      set<const SimpleProposition *> changedLiterals = s.getChangedLiterals();  
+      const set<const SimpleProposition *> & changedLiterals = s.getChangedLiterals();  
       for(set<const SimpleProposition *>::const_iterator sp = changedLiterals.begin(); sp != changedLiterals.end(); ++sp)
       {             
          if( ((*sp)->getPropName()  == literalName) && ((!neg && s.evaluate(*sp)) || (neg && !s.evaluate(*sp)))
@@ -1319,15 +1319,15 @@ const vector<const_symbol_list*> getParametersList(goal * g,operator_ * op,Valid
       string literalName = sg->getProp()->head->getName();
       bool isDerivedPred = v->getDerivRules()->isDerivedPred(literalName);
      
-      LogicalState logState = v->getState().getLogicalState(); 
+      const State & st = v->getState(); 
       if(!neg && !isDerivedPred)
       {
-        for(LogicalState::const_iterator i = logState.begin(); i != logState.end(); ++i)
+        for(State::const_iterator i = st.begin(); i != st.end(); ++i)
         {
-            if(i->second && (i->first->getPropName() == literalName))
+            if((*i)->getPropName() == literalName)
             {          
-                if(i->first->checkParametersConstantsMatch(sg->getProp()->args))
-                    addToListOfParameters(listOfparameters,lop,i->first->getConstants(op->parameters,sg->getProp()->args,v));
+                if((*i)->checkParametersConstantsMatch(sg->getProp()->args))
+                    addToListOfParameters(listOfparameters,lop,(*i)->getConstants(op->parameters,sg->getProp()->args,v));
             };
         };
       }
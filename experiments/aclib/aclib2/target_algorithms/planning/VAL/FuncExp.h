@@ -46,6 +46,7 @@
  ----------------------------------------------------------------------------*/
 #include <iostream>
 #include <stdlib.h>
+#include <vector>
 
 #include "ptree.h"
 #include "Environment.h"
@@ -56,6 +57,7 @@
 
 //#define map std::map
 using std::map;
+using std::vector;
 
 namespace VAL {
   
@@ -67,15 +69,17 @@ class FuncExp {
 private:
 	const Environment & bindings;
 	const func_term * fe;
+	const unsigned int id; // dense index from the FuncExpFactory, used to address the value in a State
 
   bool hasChangedCtsly; //for testing robustness w.r.t. numerical accuracy
 public:
-	FuncExp(const func_term * f,const Environment &bs) :
-		bindings(bs), fe(f), hasChangedCtsly(false)
+	FuncExp(unsigned int i,const func_term * f,const Environment &bs) :
+		bindings(bs), fe(f), id(i), hasChangedCtsly(false)
 	{};
 
 	 double evaluate(const State * s) const;
    string getName() const {return fe->getFunction()->getName();};
+   unsigned int getID() const {return id;};
    string getParameter(int paraNo) const;
    bool checkConstantsMatch(const parameter_symbol_list* psl) const;
    void setChangedCtsly();
@@ -110,6 +114,7 @@ class FuncExpFactory {
 private:
 	static Environment nullEnv;
 	map<string,const FuncExp *> funcexps;
+	vector<const FuncExp *> funcexpsByID;
 public:
 	const FuncExp * buildFuncExp(const func_term * f)
 	{
@@ -123,7 +128,8 @@ public:
 		map<string,const FuncExp*>::const_iterator i1 = funcexps.find(s);
 		if(i1 != funcexps.end())
 			return i1->second;
-		const FuncExp * p = funcexps[s] = new FuncExp(f,nullEnv);
+		const FuncExp * p = funcexps[s] = new FuncExp(funcexpsByID.size(),f,nullEnv);
+		funcexpsByID.push_back(p);
 		return p;
 	};
 	const FuncExp * buildFuncExp(const func_term * f,const Environment & bs)
@@ -153,9 +159,15 @@ public:
 		map<string,const FuncExp*>::const_iterator i1 = funcexps.find(s);
 		if(i1 != funcexps.end())
 			return i1->second;
-		const FuncExp * p = funcexps[s] = new FuncExp(f,bs);
+		const FuncExp * p = funcexps[s] = new FuncExp(funcexpsByID.size(),f,bs);
+		funcexpsByID.push_back(p);
 		return p;
 	};
+	const FuncExp * getFuncExp(unsigned int id) const
+	{
+		return funcexpsByID[id];
+	};
+	unsigned int numFuncExps() const {return funcexpsByID.size();};
  
 	~FuncExpFactory();
 };	
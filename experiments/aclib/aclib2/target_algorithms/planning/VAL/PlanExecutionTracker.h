@@ -112,7 +112,7 @@ public:
 		std::cout << "****** State changed\n" << "Applied: " << *h << "\n";
 		
 		set<const SimpleProposition *> ignores;
-		set<const SimpleProposition *> sc = s->getChangedLiterals();
+		const set<const SimpleProposition *> & sc = s->getChangedLiterals();
 		for(set<const SimpleProposition *>::const_iterator i = sc.begin();i != sc.end();++i)
 		{
 			if(s->evaluate(*i))
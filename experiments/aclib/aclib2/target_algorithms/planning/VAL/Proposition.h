@@ -127,13 +127,16 @@ private:
 	static Environment nullEnvironment;
 
 	const proposition * prop;
+	// Dense index handed out by the PropositionFactory, used to address the
+	// literal in a State.
+	const unsigned int id;
 
 public:
-	SimpleProposition(const parse_category * p,const Environment &bs) :
-		Proposition(bs), prop(dynamic_cast<const proposition*>(p))
+	SimpleProposition(unsigned int i,const parse_category * p,const Environment &bs) :
+		Proposition(bs), prop(dynamic_cast<const proposition*>(p)), id(i)
 	{};
-	SimpleProposition(const parse_category *p) :
-		Proposition(nullEnvironment), prop(dynamic_cast<const proposition*>(p))
+	SimpleProposition(unsigned int i,const parse_category *p) :
+		Proposition(nullEnvironment), prop(dynamic_cast<const proposition*>(p)), id(i)
 	{};
 
 	bool evaluate(const State * s,vector<const DerivedGoal*> = vector<const DerivedGoal*>()) const;
@@ -160,6 +163,7 @@ public:
 
 	const pred_symbol * getPred() const {return prop->head;};
 	const proposition * getProp() const {return prop;};
+	unsigned int getID() const {return id;};
 	const Environment * getEnv() const {return &bindings;};
 	void write(ostream & o) const;
 	string toString() const;
@@ -543,6 +547,7 @@ class Validator;
 class PropositionFactory {
 private:
 	map<string,const SimpleProposition *> literals;
+	vector<const SimpleProposition *> literalsByID;
     
 	Validator * vld;
 
@@ -562,7 +567,7 @@ private:
 	};
 			
 public:
-	PropositionFactory(Validator * v) : literals(), vld(v) {};
+	PropositionFactory(Validator * v) : literals(), literalsByID(), vld(v) {};
 
 
 	~PropositionFactory()
@@ -584,7 +589,8 @@ public:
 		map<string,const SimpleProposition*>::const_iterator i1 = literals.find(s);
 		if(i1 != literals.end())
 			return i1->second;
-		const SimpleProposition * prp = literals[s] = new SimpleProposition(p);
+		const SimpleProposition * prp = literals[s] = new SimpleProposition(literalsByID.size(),p);
+		literalsByID.push_back(prp);
 		return prp;
 	};
 
@@ -621,7 +627,8 @@ public:
 		map<string,const SimpleProposition*>::const_iterator i1 = literals.find(s);
 		if(i1 != literals.end())
 			{return i1->second;}
-		const SimpleProposition * prp = literals[s] = new SimpleProposition(p,bs);
+		const SimpleProposition * prp = literals[s] = new SimpleProposition(literalsByID.size(),p,bs);
+		literalsByID.push_back(prp);
 		return prp;
 	};
 
@@ -630,6 +637,12 @@ public:
 		return buildLiteral(eff->prop,bs);
 	};
 
+	const SimpleProposition * getLiteral(unsigned int id) const
+	{
+		return literalsByID[id];
+	};
+	unsigned int numLiterals() const {return literalsByID.size();};
+
   //bool evaluate(const proposition * p,const Environment & bs,const State * state) const;
 	const Proposition * buildProposition(const goal * g,const Environment &bs,bool buildNewLiterals = true,const State * state = 0);
 	const Proposition * buildProposition(const goal * g,bool buildNewLiterals = true,const State * state = 0);
@@ -68,12 +68,13 @@ void State::setNew(const effect_lists * is)
 {
 	logState.clear();
 	feValue.clear();
+	feDefined.clear();
 	changedPNEs.clear();
 	
 	for(list<simple_effect*>::const_iterator i = is->add_effects.begin();
 		i != is->add_effects.end();++i)
 	{
-		logState[vld->pf.buildLiteral(*i)] = true;
+		logState.set(vld->pf.buildLiteral(*i)->getID());
 	};
 
 	for(pc_list<assignment*>::const_iterator i1 = is->assign_effects.begin();
@@ -85,7 +86,7 @@ void State::setNew(const effect_lists * is)
 		changedPNEs.insert(fe);
 		FEScalar feNewValue = dynamic_cast<const num_expression *>((*i1)->getExpr())->double_value();
 
-		feValue[fe]	= feNewValue;
+		defineValue(fe) = feNewValue;
 
 		//setup initial value for LaTeX graph
 		if(LaTeX)
@@ -111,23 +112,14 @@ State::State(Validator * const v,const effect_lists* is) :
 
 bool State::evaluate(const SimpleProposition * p) const
 {
-	LogicalState::const_iterator i = logState.find(p);
-	if(i != logState.end())
-	{
-		return i->second;
-	}
-	else
-	{
-		return false;
-	};
+	return logState.test(p->getID());
 };
 
 FEScalar State::evaluateFE(const FuncExp * fe) const
 {        
-	NumericalState::const_iterator i = feValue.find(fe);
-	if(i!=feValue.end())
+	if(feDefined.test(fe->getID()))
 	{    
-		return i->second;
+		return feValue[fe->getID()];
 	}
 	else
 	{
@@ -146,6 +138,31 @@ FEScalar State::evaluateFE(const FuncExp * fe) const
 	};
 };
 
+FEScalar & State::defineValue(const FuncExp * fe)
+{
+	const unsigned int id = fe->getID();
+	if(id >= feValue.size()) feValue.resize(id+1,0);
+	feDefined.set(id);
+	return feValue[id];
+};
+
+const SimpleProposition * State::literal(unsigned int id) const
+{
+	return vld->pf.getLiteral(id);
+};
+
+void State::write(ostream & o) const
+{
+	for(const_iterator i = begin();i != end();++i)
+	{
+		o << **i << "\n";
+	};
+	for(unsigned int i = feDefined.next(0);i < feDefined.limit();i = feDefined.next(i+1))
+	{
+		o << *(vld->fef.getFuncExp(i)) << " = " << feValue[i] << "\n";
+	};
+};
+
 FEScalar State::evaluate(const expression * e,const Environment & bs) const
 {
 	if(dynamic_cast<const div_expression *>(e))
@@ -288,7 +305,7 @@ State::add(const SimpleProposition * a)
 		cout << "Adding " << *a << "\n";
 
 		
-	logState[a] = true;
+	logState.set(a->getID());
 };
 
 void
@@ -298,7 +315,7 @@ State::del(const SimpleProposition * a)
 		*report << " \\> \\deleting{"<<*a<<"}\\\\\n";
 	else if(Verbose)
 		cout << "Deleting " << *a << "\n";
-	logState[a] = false;
+	logState.reset(a->getID());
 
 };
 
@@ -310,8 +327,7 @@ State::addChange(const SimpleProposition * a)
 	else if(Verbose)
 		cout << "Adding " << *a << "\n";
 
-   if(!(logState[a])) changedLiterals.insert(a);
-	logState[a] = true;
+   if(!logState.set(a->getID())) changedLiterals.insert(a);
 };
 
 void
@@ -322,18 +338,17 @@ State::delChange(const SimpleProposition * a)
 	else if(Verbose)
 		cout << "Deleting " << *a << "\n";
 
-   if(logState[a]) changedLiterals.insert(a);
-	logState[a] = false;
+   if(logState.reset(a->getID())) changedLiterals.insert(a);
 };
 
 void
 State::updateChange(const FuncExp * fe,assign_op aop,FEScalar value)
 {
-   FEScalar initialValue = feValue[fe];
+   FEScalar initialValue = defineValue(fe);
      
    update(fe,aop,value);
           
-   if(feValue[fe] != initialValue) changedPNEs.insert(fe);
+   if(defineValue(fe) != initialValue) changedPNEs.insert(fe);
 
 };
 
@@ -341,6 +356,7 @@ State & State::operator=(const State & s)
 {
 	logState = s.logState;
 	feValue = s.feValue;
+	feDefined = s.feDefined;
 	time = s.time;
 	changedLiterals = s.changedLiterals;
 	changedPNEs = s.changedPNEs;
@@ -361,10 +377,7 @@ State::update(const FuncExp * fe,assign_op aop,FEScalar value)
 		//setup initial value if nec
 		if( (feg->initialTime == -1) )
 		{
-			map<const FuncExp*,FEScalar>::const_iterator i = feValue.find(fe);
-
-			
-			if(i != feValue.end())
+			if(feDefined.test(fe->getID()))
 			{
 				feg->initialTime = 0;
 				feg->initialValue = fe->evaluate(this);
@@ -384,59 +397,61 @@ State::update(const FuncExp * fe,assign_op aop,FEScalar value)
 
 
 	
-	if(Verbose && !LaTeX) *report << "Updating " << *fe << " (" << feValue[fe] << ") by " << value << " ";
+	FEScalar & feVal = defineValue(fe);
+
+	if(Verbose && !LaTeX) *report << "Updating " << *fe << " (" << feVal << ") by " << value << " ";
 
-	FEScalar feValueInt = feValue[fe];
+	FEScalar feValueInt = feVal;
 
 	switch(aop)
 	{
 		case E_ASSIGN:
 			if(LaTeX)
 			{
-				*report << " \\> \\assignment{"<<*fe<<"}{"<<feValue[fe]<<"}{"<<value<<"}\\\\\n";
+				*report << " \\> \\assignment{"<<*fe<<"}{"<<feVal<<"}{"<<value<<"}\\\\\n";
 			}
 			else if(Verbose) cout << "assignment\n";
-			feValue[fe] = value;
+			feVal = value;
 			break;
 		case E_ASSIGN_CTS:
 			if(LaTeX)
 			{
-				*report << " \\> \\assignmentcts{"<<*fe<<"}{"<<feValue[fe]<<"}{"<<value<<"}\\\\\n";
+				*report << " \\> \\assignmentcts{"<<*fe<<"}{"<<feVal<<"}{"<<value<<"}\\\\\n";
 			}
 			else if(Verbose) cout << "assignment\n";
-			feValue[fe] = value;
+			feVal = value;
 			return;
 		case E_INCREASE:
 			if(LaTeX)
 			{
-				*report << " \\> \\increase{"<<*fe<<"}{"<<feValue[fe]<<"}{"<<value<<"}\\\\\n";
+				*report << " \\> \\increase{"<<*fe<<"}{"<<feVal<<"}{"<<value<<"}\\\\\n";
 			}
 			else if(Verbose) cout << "increase\n";
-			feValue[fe] += value;
+			feVal += value;
 			break;
 		case E_DECREASE:
 			if(LaTeX)
 			{
-				*report << " \\> \\decrease{"<<*fe<<"}{"<<feValue[fe]<<"}{"<<value<<"}\\\\\n";
+				*report << " \\> \\decrease{"<<*fe<<"}{"<<feVal<<"}{"<<value<<"}\\\\\n";
 			}
 			else if(Verbose) cout << "decrease\n";
-			feValue[fe] -= value;
+			feVal -= value;
 			break;
 		case E_SCALE_UP:
 			if(LaTeX)
 			{
-				*report << " \\> \\scaleup{"<<*fe<<"}{"<<feValue[fe]<<"}{"<<value<<"}\\\\\n";
+				*report << " \\> \\scaleup{"<<*fe<<"}{"<<feVal<<"}{"<<value<<"}\\\\\n";
 			}
 			else if(Verbose) cout << "scale up\n";
-			feValue[fe] *= value;
+			feVal *= value;
 			break;
 		case E_SCALE_DOWN:
 			if(LaTeX)
 			{
-				*report << " \\> \\scaledown{"<<*fe<<"}{"<<feValue[fe]<<"}{"<<value<<"}\\\\\n";
+				*report << " \\> \\scaledown{"<<*fe<<"}{"<<feVal<<"}{"<<value<<"}\\\\\n";
 			}
 			else if(Verbose) cout << "scale down\n";
-			feValue[fe] /= value;
+			feVal /= value;
 			break;
 		default:
 			return;
@@ -447,24 +462,24 @@ State::update(const FuncExp * fe,assign_op aop,FEScalar value)
 	{
 		if(setInitialValue)
 		{
-			feValueInt = feValue[fe];
+			feValueInt = feVal;
 			feg->initialValue = feValueInt;
 		};
 		
 
-		if( (feValueInt != feValue[fe]) || setInitialValue )
+		if( (feValueInt != feVal) || setInitialValue )
 		{          
 			//check value is already defined, may be communitive updates at the same time
 			map<double,pair<double,double> >::iterator j = feg->discons.find(time);
 
 			if(j == feg->discons.end())
 			{
-				feg->discons[time] = make_pair(feValueInt,feValue[fe]);
+				feg->discons[time] = make_pair(feValueInt,feVal);
 				feg->happenings.insert(time);
 			}
 			else
 			{
-				j->second.second = feValue[fe];
+				j->second.second = feVal;
 			};
 			
 		};
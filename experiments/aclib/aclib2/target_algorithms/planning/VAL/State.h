@@ -48,7 +48,9 @@
 #include "FuncExp.h"
 #include "StateObserver.h"
 #include<set>
+#include<vector>
 using std::set;
+using std::vector;
 
 namespace VAL {
 class Validator;
@@ -62,8 +64,67 @@ namespace VAL {
   
 typedef long double FEScalar;
 
-typedef map<const SimpleProposition*,bool> LogicalState;
-typedef map<const FuncExp*,FEScalar> NumericalState;
+// A set of dense ids (of SimplePropositions or FuncExps) stored as one bit
+// per id. The set grows on demand, because literals can be created by the
+// factories at any time during validation.
+class IDBitSet {
+private:
+	typedef unsigned long Word;
+	enum {WORDBITS = 8*sizeof(Word)};
+
+	vector<Word> words;
+
+public:
+	IDBitSet() : words() {};
+
+	bool test(unsigned int i) const
+	{
+		return i/WORDBITS < words.size() && ((words[i/WORDBITS] >> (i%WORDBITS)) & 1);
+	};
+	// set and reset return the previous value of the bit.
+	bool set(unsigned int i)
+	{
+		if(i/WORDBITS >= words.size()) words.resize(i/WORDBITS + 1,0);
+		const Word m = Word(1) << (i%WORDBITS);
+		const bool was = words[i/WORDBITS] & m;
+		words[i/WORDBITS] |= m;
+		return was;
+	};
+	bool reset(unsigned int i)
+	{
+		if(i/WORDBITS >= words.size()) return false;
+		const Word m = Word(1) << (i%WORDBITS);
+		const bool was = words[i/WORDBITS] & m;
+		words[i/WORDBITS] &= ~m;
+		return was;
+	};
+	void clear() {words.clear();};
+
+	// One past the largest id that can currently be in the set.
+	unsigned int limit() const {return words.size()*WORDBITS;};
+	// The smallest id >= i in the set, or limit() if there is none. Empty
+	// words are skipped as a whole.
+	unsigned int next(unsigned int i) const
+	{
+		while(i/WORDBITS < words.size())
+		{
+			const Word w = words[i/WORDBITS] >> (i%WORDBITS);
+			if(!w)
+			{
+				i = (i/WORDBITS + 1)*WORDBITS;
+				continue;
+			};
+			for(Word v = w;!(v & 1);v >>= 1) ++i;
+			return i;
+		};
+		return limit();
+	};
+};
+
+// Truth values indexed by SimpleProposition::getID().
+typedef IDBitSet LogicalState;
+// Values indexed by FuncExp::getID(), only meaningful for defined ids.
+typedef vector<FEScalar> NumericalState;
 
 
 class State {
@@ -74,6 +135,7 @@ private:
 
 	LogicalState logState;
 	NumericalState feValue;
+	IDBitSet feDefined;
 	
 	double time;
 
@@ -86,6 +148,9 @@ private:
    	map<const FuncExp *,set<const Action*> > responsibleForPNEs;
    	
    	FEScalar evaluateFE(const FuncExp * fe) const;
+   	// The value of fe, which becomes defined (as 0) if it was not.
+   	FEScalar & defineValue(const FuncExp * fe);
+   	const SimpleProposition * literal(unsigned int id) const;
 
    	static vector<StateObserver *> sos;
    
@@ -113,35 +178,24 @@ public:
   	void addChange(const SimpleProposition *);
 	void delChange(const SimpleProposition *);
 	void updateChange(const FuncExp * fe,assign_op aop,FEScalar value);
-   set<const SimpleProposition *> getChangedLiterals() const {return changedLiterals;};
-   set<const FuncExp *> getChangedPNEs() const {return changedPNEs;};
+   const set<const SimpleProposition *> & getChangedLiterals() const {return changedLiterals;};
+   const set<const FuncExp *> & getChangedPNEs() const {return changedPNEs;};
    void resetChanged() {changedLiterals.clear(); changedPNEs.clear();};
 
 	void setNew(const effect_lists * effs);
 
-	void write(ostream & o) const
-	{
-		for(LogicalState::const_iterator i = logState.begin();i != logState.end();++i)
-		{
-			if(i->second) o << *(i->first) << "\n";
-		};
-		for(NumericalState::const_iterator i = feValue.begin();i != feValue.end();++i)
-		{
-			o << *(i->first) << " = " << i->second << "\n";
-		};
-	};
+	void write(ostream & o) const;
 
 	//	friend class const_iterator;
 
+	// Iterates over the true literals, in the order they were created.
 	class const_iterator {
 	private:
 		const State & st;
-		LogicalState::const_iterator it;
+		unsigned int it;
 	public:
-		const_iterator(const State & s) : st(s), it(st.logState.begin())
-		{
-			while(it != st.logState.end() && !it->second) ++it;
-		};
+		const_iterator(const State & s) : st(s), it(st.logState.next(0))
+		{};
 		
 		bool operator==(const const_iterator & itr) const
 		{
@@ -155,19 +209,18 @@ public:
 
 		const_iterator & operator++()
 		{
-			++it;
-			while(it != st.logState.end() && !it->second) ++it;
+			it = st.logState.next(it+1);
 			return *this;
 		};
 
 		const SimpleProposition * operator*() const
 		{
-			return it->first;
+			return st.literal(it);
 		};
 
 		void toEnd()
 		{
-			it = st.logState.end();
+			it = st.logState.limit();
 		};
 	};
 
@@ -54,10 +54,21 @@
 #include <cstdio>
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <algorithm>
 
 // Needed on Windows for time().
 #include <time.h>
 
+#ifndef _WIN32
+#include <unistd.h>
+#include <errno.h>
+#include <poll.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#endif
+
 #include "ptree.h"
 #include "FlexLexer.h"
 #include "Utils.h"
@@ -135,6 +146,11 @@ void usage()
 			 << "    -m         -- Use makespan as metric for temporal plans (overrides any other metric).\n"
 	     << "    -L         -- Add step length as metric (in addition to any other metric).\n"
 			 << "    -f <file>  -- LaTeX report will be stored in file 'file.tex'\n" 
+		     << "    -b <list>  -- Batch mode: also check the plans named in file 'list' (one per line, - for standard input),\n"
+		     << "                  or all files in directory 'list'. Prints one line per plan: name, status and final value.\n"
+		     << "                  The exit status is the number of plans that failed or did not achieve the goal,\n"
+		     << "                  at most 255 (as without -b, bad plans and validation errors are not counted).\n"
+		     << "    -P <n>     -- Batch mode: check the plans with n worker processes (default 1).\n"
 		     << "Multiple plan file arguments can be appended for checking.\n\n";
 
 };
@@ -546,6 +562,240 @@ void executePlans(int & argc,char * argv[],int & argcount,TypeChecker & tc,const
 
 };
 
+//batch mode: add the plans named in file src (one per line, "-" for standard input), or
+//all regular files in directory src, in name order
+bool readPlanList(const string & src,vector<string> & plans)
+{
+#ifndef _WIN32
+	struct stat st;
+	if(stat(src.c_str(),&st) == 0 && S_ISDIR(st.st_mode))
+	{
+		DIR * dir = opendir(src.c_str());
+		if(!dir) return false;
+		vector<string> files;
+		while(struct dirent * e = readdir(dir))
+		{
+			string f = src + "/" + e->d_name;
+			if(stat(f.c_str(),&st) == 0 && S_ISREG(st.st_mode)) files.push_back(f);
+		};
+		closedir(dir);
+		sort(files.begin(),files.end());
+		plans.insert(plans.end(),files.begin(),files.end());
+		return true;
+	};
+#endif
+	ifstream listFile;
+	if(src != "-")
+	{
+		listFile.open(src.c_str());
+		if(!listFile) return false;
+	};
+	std::istream & in = (src == "-") ? std::cin : listFile;
+	string line;
+	while(getline(in,line))
+	{
+		if(!line.empty() && line[line.size()-1] == '\r') line.erase(line.size()-1);
+		if(!line.empty()) plans.push_back(line);
+	};
+	return true;
+};
+
+//check a single plan for batch mode and describe the outcome in one line:
+//the plan name, then valid (followed by the final value), invariants (valid subject to
+//invariant checks, followed by the final value), goal (goal not satisfied), failed (plan
+//failed to execute), bad (plan file could not be read or typechecked) or error.
+//The timed initial literal actions are built once for the batch, each plan gets its own
+//steps for them.
+string batchValidatePlan(const string & name,const vector<plan_step *> & timedInitialLiteralActions,TypeChecker & tc,
+							const DerivationRules * derivRules,double tolerance,bool lengthDefault)
+{
+	ifstream planFile(name.c_str());
+	if(!planFile) return name + "\tbad";
+
+	top_thing = 0;
+	yfl = new yyFlexLexer(&planFile,&cout);
+	yyparse();
+	delete yfl;
+
+	plan * the_plan = dynamic_cast<plan*>(top_thing);
+	if(!the_plan || !tc.typecheckPlan(the_plan))
+	{
+		delete the_plan;
+		return name + "\tbad";
+	};
+
+	for(vector<plan_step *>::const_iterator ps = timedInitialLiteralActions.begin(); ps != timedInitialLiteralActions.end(); ++ps)
+	{
+		plan_step * a_plan_step = new plan_step((*ps)->op_sym,new const_symbol_list());
+		a_plan_step->start_time_given = (*ps)->start_time_given;
+		a_plan_step->start_time = (*ps)->start_time;
+		a_plan_step->duration_given = (*ps)->duration_given;
+		the_plan->push_back(a_plan_step);
+	};
+
+	string result;
+	try {
+		Validator v(derivRules,tolerance,tc,an_analysis.the_domain->ops,an_analysis.the_problem->initial_state,
+					the_plan,an_analysis.the_problem->metric,lengthDefault,an_analysis.the_domain->isDurative(),
+					an_analysis.the_domain->constraints,an_analysis.the_problem->constraints);
+
+		if(!v.execute())
+		{
+			result = "failed";
+		}
+		else if(!v.checkGoal(an_analysis.the_problem->the_goal))
+		{
+			result = "goal";
+		}
+		else
+		{
+			result = v.hasInvariantWarnings() ? "invariants" : "valid";
+			vector<double> vs(v.finalValue());
+			for(unsigned int i = 0;i < vs.size();++i)
+				result += "\t" + toString(vs[i]);
+		};
+	}
+	catch(exception & e)
+	{
+		result = "error";
+	};
+
+	delete the_plan;
+	return name + "\t" + result;
+};
+
+//batch mode: check all plans, on the given number of worker processes. Each worker is
+//forked after the domain and problem have been parsed and typechecked, so it shares the
+//analysis and has its own Validator, State and parser globals. The result lines are
+//printed in the order of the plans. Returns the number of plans that failed or did not
+//achieve the goal. As when plans are checked one by one, plans that are valid subject to
+//invariant warnings, plans that could not be read or typechecked (bad) and plans that gave
+//an error are not counted; their result lines report them.
+int executePlanBatch(const vector<string> & plans,unsigned int workers,TypeChecker & tc,const DerivationRules * derivRules,double tolerance,bool lengthDefault)
+{
+	vector<plan_step *> timedInitialLiteralActions = getTimedInitialLiteralActions();
+
+	vector<string> results(plans.size());
+	vector<bool> done(plans.size(),false);
+	if(workers > plans.size()) workers = plans.size();
+
+	// Anything the validator would report goes nowhere, the result lines are the output.
+	std::streambuf * out = cout.rdbuf();
+	ostream resultStream(out);
+	resultStream.precision(10);
+	cout.rdbuf(0);
+	report = &cout;
+
+#ifndef _WIN32
+	if(workers > 1)
+	{
+		resultStream.flush();
+		vector<pid_t> pids;
+		vector<struct pollfd> fds;
+		for(unsigned int w = 0;w < workers;++w)
+		{
+			int fd[2];
+			if(pipe(fd) != 0) break;
+			pid_t pid = fork();
+			if(pid == 0)
+			{
+				close(fd[0]);
+				for(unsigned int j = 0;j < fds.size();++j) close(fds[j].fd);
+				for(unsigned int i = w;i < plans.size();i += workers)
+				{
+					string line = toString(i) + " " + batchValidatePlan(plans[i],timedInitialLiteralActions,tc,derivRules,tolerance,lengthDefault) + "\n";
+					for(size_t k = 0;k < line.size();)
+					{
+						ssize_t n = write(fd[1],line.data() + k,line.size() - k);
+						if(n < 0 && errno != EINTR) _exit(1);
+						if(n > 0) k += n;
+					};
+				};
+				_exit(0);
+			};
+			close(fd[1]);
+			if(pid < 0)
+			{
+				close(fd[0]);
+				break;
+			};
+			pids.push_back(pid);
+			struct pollfd pfd;
+			pfd.fd = fd[0];
+			pfd.events = POLLIN;
+			fds.push_back(pfd);
+		};
+
+		// Collect the lines of all workers as they arrive, so that no worker blocks on a full pipe.
+		vector<string> buffers(fds.size());
+		unsigned int remaining = fds.size();
+		char buf[4096];
+		while(remaining > 0)
+		{
+			if(poll(&fds[0],fds.size(),-1) < 0)
+			{
+				if(errno == EINTR) continue;
+				break;
+			};
+			for(unsigned int j = 0;j < fds.size();++j)
+			{
+				if(fds[j].fd < 0 || !fds[j].revents) continue;
+				ssize_t n = read(fds[j].fd,buf,sizeof(buf));
+				if(n > 0)
+				{
+					buffers[j].append(buf,n);
+					continue;
+				};
+				if(n < 0 && errno == EINTR) continue;
+				close(fds[j].fd);
+				fds[j].fd = -1;
+				--remaining;
+			};
+		};
+		for(unsigned int j = 0;j < pids.size();++j) waitpid(pids[j],0,0);
+
+		for(unsigned int j = 0;j < buffers.size();++j)
+		{
+			std::istringstream lines(buffers[j]);
+			unsigned int i;
+			string line;
+			while(lines >> i && getline(lines,line))
+			{
+				if(i >= plans.size()) continue;
+				results[i] = line.substr(1);
+				done[i] = true;
+			};
+		};
+
+		// Plans of a worker that died are reported as errors, those of workers that
+		// could not be started are checked here.
+		for(unsigned int i = 0;i < plans.size();++i)
+		{
+			if(!done[i] && i % workers < pids.size())
+			{
+				results[i] = plans[i] + "\terror";
+				done[i] = true;
+			};
+		};
+	};
+#endif
+
+	int notValid = 0;
+	for(unsigned int i = 0;i < plans.size();++i)
+	{
+		if(!done[i]) results[i] = batchValidatePlan(plans[i],timedInitialLiteralActions,tc,derivRules,tolerance,lengthDefault);
+		string status = results[i].substr(plans[i].size()+1);
+		status = status.substr(0,status.find('\t'));
+		if(status == "failed" || status == "goal") ++notValid;
+		resultStream << results[i] << "\n";
+	};
+	resultStream.flush();
+	deleteTimedIntitialLiteralActions(timedInitialLiteralActions);
+
+	cout.rdbuf(out);
+	return notValid;
+};
+
 void analysePlansForRobustness(int & argc,char * argv[],int & argcount,TypeChecker & tc,const DerivationRules * derivRules,
           double tolerance,bool lengthDefault,bool giveAdvice,double robustMeasure,int noTestPlans,bool car,bool cpr,RobustMetric robm,RobustDist robd)
 {
@@ -620,6 +870,9 @@ int main(int argc,char * argv[])
   
 	string s;
 	bool ganttObjectsGot = false;
+	bool batch = false;
+	vector<string> batchPlans;
+	unsigned int batchWorkers = 1;
 	
     int argcount = 1;
     while(argcount < argc && argv[argcount][0] == '-')
@@ -810,6 +1063,28 @@ int main(int argc,char * argv[])
 	    		giveAdvice = false;
  	    		++argcount;
 	    		break;       
+	    	case 'b':
+	    		batch = true;
+	    		++argcount;
+	    		if(argcount >= argc || !readPlanList(argv[argcount],batchPlans))
+	    		{
+	    			cerr << "Bad plan list!\n";
+	    			exit(-1);
+	    		};
+	    		++argcount;
+	    		break;
+	    	case 'P':
+	    		batch = true;
+	    		++argcount;
+	    		if(argcount >= argc)
+	    		{
+	    			cerr << "Missing number of workers!\n";
+	    			exit(-1);
+	    		};
+	    		batchWorkers = atoi(argv[argcount]);
+	    		if(batchWorkers < 1) batchWorkers = 1;
+	    		++argcount;
+	    		break;
 	    	case 'f':
 	    		{
 	    			LaTeX = true;
@@ -835,6 +1110,14 @@ int main(int argc,char * argv[])
 		return 0;
 	};
 
+	//batch mode only prints the result lines
+	if(batch && !Robust)
+	{
+		LaTeX = false;
+		Verbose = false;
+		ErrorReport = false;
+		Silent = 2;
+	};
 
 	if(LaTeX)
 	{
@@ -926,7 +1209,13 @@ int main(int argc,char * argv[])
 
 	};
       
-  if(Robust)
+  if(batch && !Robust)
+  {
+     while(argcount < argc) batchPlans.push_back(argv[argcount++]);
+     errorCount = executePlanBatch(batchPlans,batchWorkers,tc,derivRules,tolerance,lengthDefault);
+     if(errorCount > 255) errorCount = 255;
+  }
+  else if(Robust)
      analysePlansForRobustness(argc,argv,argcount,tc,derivRules,tolerance,lengthDefault,giveAdvice,robustMeasure,noTestPlans,calculateActionRobustness,calculatePNERobustness,robustMetric,robustDist);
   else     
      executePlans(argc,argv,argcount,tc,derivRules,tolerance,lengthDefault,giveAdvice);
@@ -698,6 +698,8 @@ opt_uhd_probe     (_cat_uhd, "cp3_uhdProbe",     "Approximate probing (bin cls)
 opt_uhd_fullProbe (_cat_uhd, "cp3_uhdPrSize",    "Enable unhide probing for larger clauses, size <= given parameter", 2, IntRange(2, INT32_MAX), optionListPtr ),
 opt_uhd_probeEE   (_cat_uhd, "cp3_uhdPrEE",      "Find Equivalences during uhd probing (requ. uhdProbe > 1)", false, optionListPtr  ),
 opt_uhd_fullBorder(_cat_uhd, "cp3_uhdPrSiBo",    "Check larger clauses only in first and last iteration", true, optionListPtr  ),
+opt_uhd_par       (_cat_uhd, "cp3_par_uhd",      "par UHTE/UHLE analysis: 0 never, 1 heuristic, 2 always", 1, IntRange(0, 2), optionListPtr ),
+opt_uhd_par_minCls(_cat_uhd, "par_uhd_minCls",   "number of clauses to start parallel UHTE/UHLE analysis", 100000, IntRange(1, INT32_MAX), optionListPtr ),
 #if defined TOOLVERSION  
 opt_uhd_Debug(0),
 #else
@@ -685,6 +685,8 @@ BoolOption opt_sls_adopt      ;
  IntOption  opt_uhd_fullProbe ;
  BoolOption opt_uhd_probeEE   ;
  BoolOption opt_uhd_fullBorder;
+ IntOption  opt_uhd_par       ;
+ IntOption  opt_uhd_par_minCls;
 #if defined TOOLVERSION  
  const int opt_uhd_Debug;
 #else
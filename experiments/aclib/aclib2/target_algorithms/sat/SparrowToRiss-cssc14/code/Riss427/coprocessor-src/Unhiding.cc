@@ -40,6 +40,8 @@ Unhiding::Unhiding(CP3Config &_config, ClauseAllocator& _ca, ThreadController& _
 , uhdProbeEEChecks(0)
 , uhdProbeEECandss(0)
 , uhdProbeEE(0)
+, uhdParCalls(0)
+, uhdParSkipped(0)
 {
 
 }
@@ -291,25 +293,41 @@ bool Unhiding::unhideSimplify(bool borderIteration, bool& foundEE)
   
   // TODO implement second for loop to iterate also over learned clauses and check whether one of them is not learned!
   
+  // sorting and scanning the stamps of each clause is independent of all other clauses, hence do this in parallel
+  // the loop below then only visits the clauses that will actually be modified (or probed), so that the result is the same as sequentially
+  const bool useParallel = controller.size() > 0 && ( config.opt_uhd_par == 2 || (config.opt_uhd_par == 1 && data.getClauses().size() > config.opt_uhd_par_minCls) );
+  if( useParallel ) {
+    parallelAnalysis( borderIteration );
+    uhdParCalls ++;
+  }
+  
   for( uint32_t i = 0 ; i < data.getClauses().size() && !data.isInterupted() ; ++ i ) 
   {
     // run UHTE before UHLE !!  (remark in paper)
     const uint32_t clRef =  data.getClauses()[i] ;
     Clause& clause = ca[clRef];
     if( clause.can_be_deleted() ) continue;
+    if( useParallel && !uhdCandidate[i] ) { uhdParSkipped ++; continue; }
 
     if( config.opt_uhd_Debug > 3 ) { cerr << "c [UHD] work on [" << clRef << "]" << clause << " state ok? " << data.ok() << endl; }
     
     const uint32_t cs = clause.size();
-    Lit Splus  [cs];
-    Lit Sminus [cs];
+    Lit SplusStack  [ useParallel ? 1 : cs ];
+    Lit SminusStack [ useParallel ? 1 : cs ];
+    Lit* Splus  = SplusStack;
+    Lit* Sminus = SminusStack;
 
-    for( uint32_t ci = 0 ; ci < cs; ++ ci ) {
-      Splus [ci] = clause[ci];
-      Sminus[ci] = ~clause[ci];
+    if( useParallel ) { // the parallel analysis already sorted the literals of the candidate
+      Splus  = uhdCandidate[i];
+      Sminus = Splus + cs;
+    } else {
+      for( uint32_t ci = 0 ; ci < cs; ++ ci ) {
+	Splus [ci] = clause[ci];
+	Sminus[ci] = ~clause[ci];
+      }
+      sortStampTime( Splus , cs );
+      sortStampTime( Sminus, cs );
     }
-    sortStampTime( Splus , cs );
-    sortStampTime( Sminus, cs );
     
     if( config.opt_uhd_Debug > 4 ) {
       if( config.opt_uhd_Debug > 4 ) {
@@ -682,6 +700,107 @@ bool Unhiding::unhideSimplify(bool borderIteration, bool& foundEE)
   return didSomething;
 }
 
+bool Unhiding::isSimplifyCandidate( const Clause& clause, bool borderIteration, Lit* Splus, Lit* Sminus )
+{
+  if( clause.can_be_deleted() ) return false;
+  const uint32_t cs = clause.size();
+  
+  for( uint32_t ci = 0 ; ci < cs; ++ ci ) {
+    Splus [ci] = clause[ci];
+    Sminus[ci] = ~clause[ci];
+  }
+  sortStampTime( Splus , cs );
+  sortStampTime( Sminus, cs );
+  
+  // clauses that are used for probing have to be handled sequentially
+  if( config.opt_uhd_probe > 0 && cs == 2 ) return true;
+  if( (borderIteration || config.opt_uhd_fullBorder ) && cs > 2 && cs < config.opt_uhd_fullProbe ) return true;
+  
+  // same checks as in unhideSimplify, without modifying anything
+  if( doUHTE && cs != 2 ) {
+    uint32_t pp = 0, pn = 0;
+    Lit lpos = Splus [pp];
+    Lit lneg = Sminus[pn];
+    while( true ) {
+      if( stampInfo[ toInt(lneg) ].dsc > stampInfo[ toInt(lpos) ].dsc ) {
+	if( pp + 1 == cs ) break;
+	lpos = Splus[ ++ pp ];
+      } else if ( stampInfo[ toInt(lneg) ].fin < stampInfo[ toInt(lpos) ].fin ) {
+	if( pn + 1 == cs ) break;
+	lneg = Sminus [ ++ pn ];
+      } else return true; // UHTE
+    }
+  }
+  
+  if( doUHLE == 1 || doUHLE == 3 ) {
+    uint32_t finished = stampInfo[ toInt(Splus[cs-1]) ].fin;
+    for( uint32_t pp = cs-1 ; pp > 0; -- pp ) {
+      const uint32_t fin = stampInfo[ toInt(Splus[ pp - 1]) ].fin;
+      if( fin > finished ) return true; // UHLE removes a positive literal
+      finished = fin;
+    }
+  }
+  
+  // if no literal has been removed above, the second UHLE works on the unmodified clause
+  if( doUHLE == 2 || doUHLE == 3 ) {
+    uint32_t finished = stampInfo[ toInt(Sminus[0]) ].fin;
+    for( uint32_t pn = 1; pn < cs; ++ pn) {
+      const uint32_t fin = stampInfo[ toInt(Sminus[ pn ]) ].fin;
+      if( fin < finished ) return true; // UHLE removes a negative literal
+      finished = fin;
+    }
+  }
+  
+  return false;
+}
+
+void Unhiding::parallelAnalysis( bool borderIteration )
+{
+  if( config.opt_uhd_Debug > 3 ) cerr << "c parallel unhide analysis with " << controller.size() << " threads" << endl;
+  AnalysisData workData[ controller.size() ];
+  vector<Job> jobs( controller.size() );
+  
+  const uint32_t queueSize = data.getClauses().size();
+  const uint32_t partitionSize = queueSize / controller.size();
+  uhdCandidate.assign( queueSize, 0 );
+  uhdSorted.resize( controller.size() );
+  // setup data for workers
+  for( int i = 0 ; i < controller.size(); ++ i ) {
+    workData[i].uhd   = this;
+    workData[i].start = i * partitionSize;
+    workData[i].end   = (i + 1 == controller.size()) ? queueSize : (i+1) * partitionSize; // last element is not processed!
+    workData[i].borderIteration = borderIteration;
+    workData[i].sorted = &(uhdSorted[i]);
+    jobs[i].function  = Unhiding::runParallelAnalysis;
+    jobs[i].argument  = &(workData[i]);
+  }
+  controller.runJobs( jobs );
+}
+
+void* Unhiding::runParallelAnalysis(void* arg)
+{
+  AnalysisData* workData = (AnalysisData*) arg;
+  Unhiding& uhd = *(workData->uhd);
+  // each worker writes only its own part of the candidates, and keeps the sorted literals of its candidates in its own storage
+  vector< Lit >& sorted = *(workData->sorted);
+  vector< uint32_t > candidates, positions; // the storage might still grow, hence remember the positions of the sorted literals first
+  sorted.clear();
+  for( uint32_t i = workData->start; i < workData->end; ++ i ) {
+    const Clause& clause = uhd.ca[ uhd.data.getClauses()[i] ];
+    const uint32_t cs = clause.size();
+    Lit Splus  [cs];
+    Lit Sminus [cs];
+    if( !uhd.isSimplifyCandidate( clause, workData->borderIteration, Splus, Sminus ) ) continue;
+    candidates.push_back( i );
+    positions.push_back( sorted.size() );
+    sorted.insert( sorted.end(), Splus,  Splus  + cs );
+    sorted.insert( sorted.end(), Sminus, Sminus + cs );
+  }
+  for( uint32_t j = 0 ; j < candidates.size(); ++ j )
+    uhd.uhdCandidate[ candidates[j] ] = &(sorted[ positions[j] ]);
+  return 0;
+}
+
 bool Unhiding::process (  )
 {
   if( !performSimplification() ) return false; // do not execute due to previous errors?
@@ -913,6 +1032,10 @@ void Unhiding::printStatistics( ostream& stream )
   << uhdProbeEECandss << " EE-cands, "
   << uhdProbeEE << " EEs "
   << endl;
+  stream << "c [STAT] UNHIDE(4) " 
+  << uhdParCalls << " parCalls, "
+  << uhdParSkipped << " parSkipped "
+  << endl;
 }
 
 
@@ -927,4 +1050,6 @@ void Unhiding::destroy()
   vector< Lit >().swap(  stampEE );
   vector< Lit >().swap(  stampClassEE );
   vector< char >().swap(  unhideEEflag );
+  vector< Lit* >().swap(  uhdCandidate );
+  vector< vector< Lit > >().swap(  uhdSorted );
 }
@@ -51,6 +51,9 @@ class Unhiding : public Technique {
   double unhideProbeTime;	// seconds for uhd probe
   
   unsigned uhdProbeEEChecks, uhdProbeEECandss, uhdProbeEE; // stats about probe EE
+  
+  unsigned uhdParCalls;		// number of simplification rounds that used the parallel analysis
+  unsigned uhdParSkipped;	// clauses that have been skipped after the parallel analysis
  
 	/// structure that store all necessary stamp information of the paper for each literal
 	struct literalData {
@@ -77,6 +80,21 @@ class Unhiding : public Technique {
   vector< int > currentPosition; // fur full probing approximation
   vector< Lit > currentLits; // current literals for full probing approximation
   vector< int > currentLimits; // all combination limits for full probing
+  
+  /// per clause (same index as in data.getClauses()), set by the parallel analysis if the clause has to be visited by unhideSimplify:
+  /// points to the clause literals sorted by discovery stamp, followed by their complements sorted by discovery stamp, 0 otherwise
+  vector< Lit* > uhdCandidate;
+  /// per worker of the parallel analysis, storage for the sorted literals of its candidates
+  vector< vector< Lit > > uhdSorted;
+  
+  /** data for a parallel analysis worker, which handles the clauses [start,end) of data.getClauses() */
+  struct AnalysisData {
+    Unhiding* uhd;
+    uint32_t start;
+    uint32_t end;
+    bool borderIteration;
+    vector< Lit >* sorted;
+  };
  
 public:
   
@@ -115,6 +133,18 @@ protected:
 	 * 
 	 */
 	bool unhideSimplify(bool borderIteration, bool& foundEE);
+	
+	/** check whether UHTE or UHLE would modify the given clause, or whether it is considered for unhide probing
+	 *  NOTE: does only read the clause and the stamp information, hence can be run in parallel
+	 *  @param Splus, Sminus (size of the clause) receive the sorted literals as used by unhideSimplify, unless the clause can be deleted
+	 */
+	bool isSimplifyCandidate( const Clause& clause, bool borderIteration, Lit* Splus, Lit* Sminus );
+	
+	/** run isSimplifyCandidate for all clauses in parallel, stores the result in uhdCandidate */
+	void parallelAnalysis( bool borderIteration );
+	
+	/** converts arg into AnalysisData*, checks its part of the clauses */
+	static void* runParallelAnalysis(void* arg);
 };
 
 
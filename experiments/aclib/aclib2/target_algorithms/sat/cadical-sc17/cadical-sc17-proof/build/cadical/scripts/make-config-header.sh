@@ -10,8 +10,8 @@ export LC_TIME
 
 # Get compiler, its versions and compile flags from 'makefile'.
 #
-CXX="`sed -e '/^CXX=/!d' -e 's,.*=,,' makefile`"
-CXXFLAGS="`sed -e '/^CXXFLAGS=/!d' -e 's,.*=,,' makefile`"
+CXX="`sed -e '/^CXX=/!d' -e 's,^CXX=,,' makefile`"
+CXXFLAGS="`sed -e '/^CXXFLAGS=/!d' -e 's,^CXXFLAGS=,,' makefile`"
 case x"$CXX" in 
   xg++* | xclang++*) CXXVERSION="`$CXX --version|head -1`";;
   *) CXXVERSION="unknown compiler version";;
@@ -24,6 +24,7 @@ void Internal::learn_unit_clause (int lit) {
   flags (lit).status = Flags::FIXED;
   stats.all.fixed++;
   stats.now.fixed++;
+  if (share) export_unit (lit);
 }
 
 /*------------------------------------------------------------------------*/
@@ -224,6 +225,7 @@ void Internal::analyze () {
     sort (clause.begin (), clause.end (), trail_larger (this));
     Clause * driving_clause = new_learned_redundant_clause (glue);
     driving_clause->used = 1;
+    if (share) export_clause (driving_clause);
     const int jump = var (clause[1]).level;
     UPDATE_AVERAGE (jump_avg, jump);
     backtrack (jump);
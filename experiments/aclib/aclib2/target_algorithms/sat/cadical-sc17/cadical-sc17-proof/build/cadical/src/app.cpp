@@ -60,6 +60,9 @@ void App::usage () {
 "             to check consistency of learned clauses\n"
 "             during testing and debugging (implies '-c')\n"
 "\n"
+"  -j <json>  write statistics and profiling data in JSON format\n"
+"             (with '--perf' including hardware counters)\n"
+"\n"
 "or '<option>' can be one of the following long options\n"
 "\n",
   stdout);
@@ -83,7 +86,8 @@ fputs (
 "The input is assumed to be compressed if it is given explicitly\n"
 "and has a '.gz', '.bz2', '.xz or '.7z' suffix.  The same applies to\n"
 "the output file.  For compression and decompression the utilities\n"
-"'gzip', 'bzip', '7z', and 'xz' are needed.\n",
+"'gzip', 'bzip', '7z', and 'xz' are needed, except for reading '.gz'\n"
+"and '.xz' files if 'zlib' and 'liblzma' were found by 'configure'.\n",
   stdout);
 }
 
@@ -125,6 +129,7 @@ do { solver->error (FMT,##ARGS); res = 1; goto DONE; } while (0)
 
 int App::main (int argc, char ** argv) {
   const char * proof_path = 0, * solution_path = 0, * dimacs_path = 0;
+  const char * json_path = 0;
   bool proof_specified = false, dimacs_specified = false;
   const char * dimacs_name, * err;
   int i, res = 0;
@@ -142,6 +147,10 @@ int App::main (int argc, char ** argv) {
       if (++i == argc) ERROR ("argument to '-s' missing");
       else if (solution_path) ERROR ("multiple solution files");
       else solution_path = argv[i];
+    } else if (!strcmp (argv[i], "-j")) {
+      if (++i == argc) ERROR ("argument to '-j' missing");
+      else if (json_path) ERROR ("multiple JSON files");
+      else json_path = argv[i];
     } else if (!strcmp (argv[i], "-n")) set ("--no-witness");
 #ifndef QUIET
     else if (!strcmp (argv[i], "-q")) set ("--quiet");
@@ -181,6 +190,9 @@ int App::main (int argc, char ** argv) {
   solver->section ("options");
   solver->options ();
   solver->section ("proof tracing");
+  if (proof_specified && solver->get ("threads") > 1)
+    ERROR ("proof tracing does not work with '--threads=%d'",
+      (int) solver->get ("threads"));
   if (proof_specified) {
     if (!proof_path) {
       if (isatty (1) && solver->get ("binary")) {
@@ -213,6 +225,8 @@ int App::main (int argc, char ** argv) {
     fflush (stdout);
   }
   solver->statistics ();
+  if (json_path && !solver->json (json_path))
+    ERROR ("can not write JSON statistics to '%s'", json_path);
   solver->message ("exit %d", res);
 DONE:
   Signal::reset ();
@@ -8,25 +8,29 @@ Arena::Arena (Internal * i) {
 }
 
 Arena::~Arena () {
-  delete [] from.start;
-  delete [] to.start;
+  delete [] from.memory;
+  delete [] to.memory;
 }
 
-void Arena::prepare (size_t bytes) {
+void Arena::prepare (size_t bytes, bool l) {
   assert (aligned (bytes, 8));
   LOG ("preparing 'to' space of arena with %ld bytes", (long) bytes);
   assert (!to.start);
-  to.top = to.start = new char[bytes];
-  to.end = to.start + bytes;
-  assert (aligned (to.start, 8));
+  lines = l;
+  if (lines) bytes += CACHE_LINE_SIZE;
+  to.top = to.start = to.memory = new char[bytes];
+  to.end = to.memory + bytes;
+  if (lines)
+    to.top = to.start = (char *) align ((size_t) to.memory, CACHE_LINE_SIZE);
+  assert (aligned (to.top, 8));
 }
 
 void Arena::swap () {
-  delete [] from.start;
+  delete [] from.memory;
   LOG ("delete 'from' space of arena with %ld bytes",
-    (long) (from.end - from.start));
+    (long) (from.end - from.memory));
   from = to;
-  to.start = to.top = to.end = 0;
+  to.memory = to.start = to.top = to.end = 0;
 }
 
 };
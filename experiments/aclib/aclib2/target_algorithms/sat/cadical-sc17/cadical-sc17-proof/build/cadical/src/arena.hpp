@@ -28,6 +28,16 @@ namespace CaDiCaL {
 // compared by varying the 'arena' option (which also controls the
 // allocation order of clauses during moving them).
 
+// Visiting a watched clause in 'propagate' reads the clause header and at
+// least the first two literals.  Clauses of at most 'CACHE_LINE_SIZE'
+// bytes (that is clauses with up to 14 literals) can be placed such that
+// header and all literals are in the same cache line and thus a visit
+// accesses at most one cache line.  With 'opts.arenaline' clauses which
+// would straddle a cache line boundary are moved to the start of the next
+// cache line.  Since such a clause is larger than the gap this produces,
+// the padding can be at most 'bytes - 8' for a clause of 'bytes' bytes,
+// which the caller of 'prepare' has to take into account.
+
 // The standard sequence of using the arena is as follows:
 //
 //   Arena arena;
@@ -53,11 +63,19 @@ namespace CaDiCaL {
 
 class Internal;
 
+#define CACHE_LINE_SIZE 64
+
 class Arena {
 
   Internal * internal;
 
-  struct { char * start, * top, * end; } from, to;
+  // With 'lines' the allocated memory starts at 'memory' and the cache line
+  // aligned part used for clauses at 'start'.  Otherwise both are the same.
+  // Using 'start' in 'contains' keeps it independent of this alignment.
+  //
+  struct { char * memory, * start, * top, * end; } from, to;
+
+  bool lines;   // avoid small clauses crossing cache lines in 'to'
 
 public:
 
@@ -66,9 +84,10 @@ public:
 
   // Prepare 'to' space to hold that amount of memory.  Precondition is that
   // the 'to' space is empty.  The following sequence of 'copy' operations
-  // can use as much memory in sum as pre-allocated here.
+  // can use as much memory in sum as pre-allocated here (including padding
+  // if 'l' is true, in which case the 'to' space is cache line aligned).
   //
-  void prepare (size_t bytes);
+  void prepare (size_t bytes, bool l = false);
 
   // Does the memory pointed to by 'p' belong to this arena? More precisely
   // to the 'from' space, since that is the only one remaining after 'swap'.
@@ -85,7 +104,11 @@ public:
   //
   char * copy (const char * p, size_t bytes) {
     char * res = to.top;
-    to.top += bytes;
+    if (lines && bytes <= CACHE_LINE_SIZE) {
+      const size_t used = (size_t) res & (CACHE_LINE_SIZE - 1);
+      if (used + bytes > CACHE_LINE_SIZE) res += CACHE_LINE_SIZE - used;
+    }
+    to.top = res + bytes;
     assert (to.top <= to.end);
     memcpy (res, p, bytes);
     return res;
@@ -0,0 +1,82 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+// Incremental solving under assumptions as in MiniSAT.  Assumptions are
+// always decided first (in the given order) before any other decision is
+// made.  Thus all decisions on lower decision levels are assumptions as
+// long as there are unassigned assumptions.  Learned clauses do not depend
+// on assumptions and are kept across 'solve' calls.  An assumption which
+// is already satisfied does not need a decision level and is skipped.
+
+void Internal::assume (int lit) {
+  assert (lit);
+  LOG ("assume %d", lit);
+  assumptions.push_back (lit);
+}
+
+bool Internal::assumptions_satisfied () const {
+  const const_int_iterator end = assumptions.end ();
+  for (const_int_iterator i = assumptions.begin (); i != end; i++)
+    if (val (*i) <= 0) return false;
+  return true;
+}
+
+// An assumption 'failed' is falsified while trying to decide it.  This is
+// a specialized version of 'analyze' which goes over the trail backward
+// and collects the assumptions (decisions) in the implication graph of the
+// negation of 'failed' (similar to 'analyzeFinal' in MiniSAT).  The result
+// is the set of failed assumptions in 'core'.
+
+void Internal::failing (int failed) {
+
+  assert (val (failed) < 0);
+  assert (core.empty ());
+  assert (analyzed.empty ());
+
+  LOG ("analyzing failed assumption %d", failed);
+
+  START (analyze);
+
+  core.push_back (failed);
+
+  if (var (failed).level) {
+    flags (failed).seen = true;
+    analyzed.push_back (failed);
+    const_int_iterator i = trail.end ();
+    while (i != trail.begin ()) {
+      const int lit = *--i;
+      if (!flags (lit).seen) continue;
+      const Var & v = var (lit);
+      if (!v.level) break;
+      if (!v.reason) {
+        LOG ("failed assumption %d", lit);
+        core.push_back (lit);
+        continue;
+      }
+      const const_literal_iterator end = v.reason->end ();
+      const_literal_iterator j;
+      for (j = v.reason->begin (); j != end; j++) {
+        const int other = *j;
+        if (other == lit) continue;
+        Flags & f = flags (other);
+        if (f.seen) continue;
+        if (!var (other).level) continue;
+        f.seen = true;
+        analyzed.push_back (other);
+      }
+    }
+    clear_seen ();
+  }
+
+  LOG ("found %ld failed assumptions", (long) core.size ());
+
+  STOP (analyze);
+}
+
+void Internal::reset_assumptions () {
+  assumptions.clear ();
+  core.clear ();
+}
+
+};
@@ -42,8 +42,25 @@ bool Solver::set (const char * arg) { return internal->opts.set (arg); }
 /*------------------------------------------------------------------------*/
 
 void Solver::add (int lit) { external->add (lit); }
-int Solver::val (int lit) { return external->val (lit); }
+void Solver::assume (int lit) { external->assume (lit); }
 int Solver::solve () { return external->solve (); }
+int Solver::val (int lit) { return external->val (lit); }
+bool Solver::failed (int lit) { return external->failed (lit); }
+
+/*------------------------------------------------------------------------*/
+
+void Solver::freeze (int lit) { external->freeze (lit); }
+void Solver::melt (int lit) { external->melt (lit); }
+bool Solver::frozen (int lit) { return external->frozen (lit); }
+
+/*------------------------------------------------------------------------*/
+
+void Solver::connect_terminator (Terminator * terminator) {
+  internal->terminator = terminator;
+}
+
+void Solver::disconnect_terminator () { internal->terminator = 0; }
+void Solver::terminate () { internal->terminate (); }
 
 /*------------------------------------------------------------------------*/
 
@@ -85,6 +102,22 @@ void Solver::options () { internal->opts.print (); }
 void Solver::usage () { internal->opts.usage (); }
 void Solver::statistics () { internal->stats.print (internal); }
 
+bool Solver::json (const char * path) {
+  File * file = File::write (internal, path);
+  if (!file) return false;
+  JSON json;
+  json.begin ();
+  json.add ("version", CADICAL_VERSION);
+  internal->stats.json (internal, json);
+#ifndef QUIET
+  internal->json_profile (json);
+#endif
+  json.end ();
+  json.write (file);
+  delete file;
+  return true;
+}
+
 /*------------------------------------------------------------------------*/
 
 const char * Solver::dimacs (File * file) {
@@ -33,6 +33,18 @@ class External;
 
 /*------------------------------------------------------------------------*/
 
+// Allows to terminate 'solve' asynchronously.  The 'terminate' function of
+// a connected terminator is polled regularly during search (see the option
+// 'terminateint').  If it returns 'true' then 'solve' returns '0'.
+
+class Terminator {
+public:
+  virtual ~Terminator () { }
+  virtual bool terminate () = 0;
+};
+
+/*------------------------------------------------------------------------*/
+
 class Solver {
 
   Internal * internal;
@@ -61,8 +73,42 @@ public:
   // Core functionality as in the IPASIR incremental SAT solver interface.
 
   void add (int lit);   // add literal, zero to terminate clause
+  void assume (int lit);        // assume literal for next 'solve' only
+  int solve ();         // returns 10 = SAT, 20 = UNSAT, 0 = UNKNOWN
   int val (int lit);    // get value (-1=false,1=true) of literal
-  int solve ();         // returns 10 = SAT, 20 = UNSAT
+  bool failed (int lit);        // assumption used to derive UNSAT
+
+  // The solver can be called again after 'solve' returned.  Learned
+  // clauses are kept, while assumptions are removed after each call.  After
+  // 'solve' returned '20' (UNSAT) the function 'failed' determines whether
+  // the given assumption literal was part of the reason for inconsistency
+  // (the 'failed assumptions' core).  It is reset by the next call to
+  // 'add', 'assume' or 'solve'.
+
+  //------------------------------------------------------------------------
+  // Variables which are eliminated or substituted during inprocessing and
+  // then occur in new clauses or assumptions are restored automatically,
+  // by adding back their clauses saved on the extension stack.  In order to
+  // avoid the cost of eliminating and restoring them again and again,
+  // variables can be 'frozen'.  Frozen variables are never eliminated nor
+  // substituted.  Freezing is reference counted and 'melt' decrements it.
+  // Assumptions are frozen implicitly during 'solve'.
+
+  void freeze (int lit);        // increase freeze reference counter
+  void melt (int lit);          // decrease freeze reference counter
+  bool frozen (int lit);        // reference counter non zero
+
+  //------------------------------------------------------------------------
+  // Besides the conflict and decision limits ('clim' and 'dlim') the
+  // options 'tlim' and 'mlim' limit wall-clock time (in seconds) and
+  // resident set size (in MB) of each 'solve' call.  Then 'solve' returns
+  // '0' (UNKNOWN) and the solver can be used again.  The same applies to
+  // connecting a 'Terminator' or calling 'terminate', which can be done
+  // from another thread (or a signal handler) during 'solve'.
+
+  void connect_terminator (Terminator *);
+  void disconnect_terminator ();
+  void terminate ();            // force next 'solve' or current to stop
 
   //------------------------------------------------------------------------
 
@@ -73,6 +119,12 @@ public:
   void options ();      // print current option and value list
   void statistics ();   // print statistics
 
+  // Write statistics and (unless compiled with 'QUIET') profiling data,
+  // including hardware counters with '--perf', in JSON format.  Returns
+  // 'false' if the file could not be opened for writing.
+  //
+  bool json (const char * path);
+
   //------------------------------------------------------------------------
   // Files with explicit path argument support compressed input and output
   // if appropriate helper functions 'gzip' etc. are available.  They are
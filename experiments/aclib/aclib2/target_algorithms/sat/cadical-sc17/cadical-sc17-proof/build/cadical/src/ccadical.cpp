@@ -2,24 +2,69 @@
 
 using namespace CaDiCaL;
 
+namespace CaDiCaL {
+
+// Wraps the C call-back as 'Terminator'.  The solver handle given to the C
+// functions is a pointer to this wrapper, which owns the actual solver.
+
+struct Wrapper : Terminator {
+
+  Solver * solver;
+  void * state;
+  int (*function) (void *);
+
+  bool terminate () { return function ? function (state) : false; }
+
+  Wrapper () : solver (new Solver ()), state (0), function (0) { }
+  ~Wrapper () { delete solver; }
+};
+
+};
+
 extern "C" {
 
 #include "ccadical.h"
 
-CCaDiCaL * ccadical_init () { return (CCaDiCaL*) new Solver (); }
-void ccadical_reset (CCaDiCaL * solver) { delete (Solver*) solver; }
+#define SOLVER (((Wrapper*) wrapper)->solver)
 
-void ccadical_add (CCaDiCaL * solver, int lit) {
-  ((Solver*) solver)->add (lit);
+CCaDiCaL * ccadical_init () { return (CCaDiCaL*) new Wrapper (); }
+void ccadical_reset (CCaDiCaL * wrapper) { delete (Wrapper*) wrapper; }
+
+void ccadical_add (CCaDiCaL * wrapper, int lit) {
+  SOLVER->add (lit);
 }
 
-int ccadical_sat (CCaDiCaL * solver) {
-  return ((Solver*) solver)->solve ();
+void ccadical_assume (CCaDiCaL * wrapper, int lit) {
+  SOLVER->assume (lit);
 }
 
-int ccadical_deref (CCaDiCaL * solver, int lit) {
-  return ((Solver*) solver)->val (lit);
+int ccadical_sat (CCaDiCaL * wrapper) {
+  return SOLVER->solve ();
 }
 
-};
+int ccadical_deref (CCaDiCaL * wrapper, int lit) {
+  return SOLVER->val (lit);
+}
+
+int ccadical_failed (CCaDiCaL * wrapper, int lit) {
+  return SOLVER->failed (lit);
+}
+
+void ccadical_freeze (CCaDiCaL * wrapper, int lit) {
+  SOLVER->freeze (lit);
+}
 
+void ccadical_melt (CCaDiCaL * wrapper, int lit) {
+  SOLVER->melt (lit);
+}
+
+void ccadical_set_terminate (CCaDiCaL * wrapper,
+                             void * state, int (*terminate)(void *)) {
+  Wrapper * w = (Wrapper*) wrapper;
+  w->state = state;
+  w->function = terminate;
+  if (terminate) w->solver->connect_terminator (w);
+  else w->solver->disconnect_terminator ();
+}
+
+};
@@ -9,7 +9,15 @@ CCaDiCaL * ccadical_init ();
 void ccadical_reset (CCaDiCaL *);
 
 void ccadical_add (CCaDiCaL *, int lit);
+void ccadical_assume (CCaDiCaL *, int lit);
 int ccadical_sat (CCaDiCaL *);
 int ccadical_deref (CCaDiCaL *, int lit);
+int ccadical_failed (CCaDiCaL *, int lit);
+
+void ccadical_freeze (CCaDiCaL *, int lit);
+void ccadical_melt (CCaDiCaL *, int lit);
+
+void ccadical_set_terminate (CCaDiCaL *,
+  void * state, int (*terminate)(void * state));
 
 #endif
@@ -264,6 +264,7 @@ void Internal::mark_garbage (Clause * c) {
   }
   stats.garbage += bytes;
   c->garbage = true;
+  if (c->size == 2 && watches ()) watched_garbage = true;
 }
 
 /*------------------------------------------------------------------------*/
@@ -295,9 +296,44 @@ bool Internal::tautological_clause () {
 // Assume the clause has been simplified and checked with
 // 'tautological_clause' before.
 //
+// In incremental usage new original clauses might contain literals which
+// are already assigned on the root level, even though they have been
+// propagated already.  Such clauses can not be watched.  Thus we remove
+// root level falsified literals and skip root level satisfied clauses.
+// The shrunken clause is traced, since it is not part of the original
+// formula.  For units and empty clauses this is done through
+// 'assign_unit' and 'learn_empty_clause' respectively.
+
 void Internal::add_new_original_clause () {
   stats.original++;
   int size = (int) clause.size ();
+  if (size > 1) {
+    assert (!level);
+    bool satisfied = false;
+    const const_int_iterator end = clause.end ();
+    int_iterator j = clause.begin ();
+    for (const_int_iterator i = j; !satisfied && i != end; i++) {
+      const int lit = *i, tmp = val (lit);
+      if (tmp > 0) satisfied = true;
+      else if (!tmp) *j++ = lit;
+    }
+    if (satisfied) {
+      LOG (clause, "root level satisfied original clause");
+      return;
+    }
+    const int new_size = (int) (j - clause.begin ());
+    if (new_size < size) {
+      clause.resize (new_size);
+      LOG (clause, "removed %d root level falsified literals in",
+        size - new_size);
+      size = new_size;
+      if (size > 1 && proof) proof->trace_add_clause ();
+      else if (!size) {
+        if (!unsat) learn_empty_clause ();
+        return;
+      }
+    }
+  }
   if (!size) {
     if (!unsat) {
       MSG ("original empty clause");
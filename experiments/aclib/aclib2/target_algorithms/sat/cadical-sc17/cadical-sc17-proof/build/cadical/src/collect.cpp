@@ -117,6 +117,7 @@ inline void Internal::flush_watches (int lit, Watches & saved) {
     Watch w = *i;
     Clause * c = w.clause;
     if (c->collect ()) continue;
+    if (c->garbage && w.binary) watched_garbage = true;   // reason
     if (c->moved) c = w.clause = c->copy;
     if (c->size == 2 && !w.binary) w.binary = true;
     const int new_blit_pos = (c->literals[0] == lit);
@@ -140,11 +141,43 @@ void Internal::flush_all_occs_and_watches () {
 
   if (watches ()) {
     Watches tmp;
+    watched_garbage = false;
     for (int idx = 1; idx <= max_var; idx++)
       flush_watches (idx, tmp), flush_watches (-idx, tmp);
   }
 }
 
+// Garbage binary clauses are skipped in 'propagate' only if they might
+// still be watched (see 'watched_garbage'), since otherwise checking the
+// 'garbage' flag would require to access the clause for every visited
+// binary watch.  Inprocessors such as 'transred', 'vivify' and deduplication
+// in 'probe' mark binary clauses as garbage without collecting them.  Thus
+// before the search continues their watches are removed here.  In contrast
+// to 'flush_watches' this keeps the order of watches and does not need to
+// move or delete any clause.
+
+void Internal::flush_garbage_binary_watches () {
+  assert (watched_garbage);
+  assert (watches ());
+  LOG ("flushing watches of garbage binary clauses");
+  watched_garbage = false;
+  for (int idx = 1; idx <= max_var; idx++) {
+    for (int sign = -1; sign <= 1; sign += 2) {
+      Watches & ws = watches (sign * idx);
+      const const_watch_iterator end = ws.end ();
+      watch_iterator j = ws.begin ();
+      const_watch_iterator i;
+      for (i = j; i != end; i++) {
+        const Watch w = *j++ = *i;
+        if (!w.binary || !w.clause->garbage) continue;
+        if (w.clause->reason) watched_garbage = true;
+        else j--;
+      }
+      ws.resize (j - ws.begin ());
+    }
+  }
+}
+
 /*------------------------------------------------------------------------*/
 
 // This is a simple garbage collector which does not move clauses.  It needs
@@ -202,14 +235,22 @@ void Internal::copy_non_garbage_clauses () {
 
   size_t collected_clauses = 0, collected_bytes = 0;
   size_t     moved_clauses = 0,     moved_bytes = 0;
+  size_t padding = 0;
 
-  // First determine 'moved_bytes' and 'collected_bytes'.
+  // First determine 'moved_bytes' and 'collected_bytes' as well as an
+  // upper bound on the 'padding' needed to keep clauses in cache lines.
   //
   const const_clause_iterator end = clauses.end ();
   const_clause_iterator i;
-  for (i = clauses.begin (); i != end; i++)
-    if (!(c = *i)->collect ()) moved_bytes += c->bytes (), moved_clauses++;
-    else collected_bytes += c->bytes (), collected_clauses++;
+  for (i = clauses.begin (); i != end; i++) {
+    if ((c = *i)->collect ()) {
+      collected_bytes += c->bytes (), collected_clauses++;
+      continue;
+    }
+    const size_t bytes = c->bytes ();
+    moved_bytes += bytes, moved_clauses++;
+    if (bytes <= CACHE_LINE_SIZE) padding += bytes - 8;
+  }
 
   VRB ("collect", stats.collections,
     "moving %ld bytes %.0f%% of %ld non garbage clauses",
@@ -217,9 +258,10 @@ void Internal::copy_non_garbage_clauses () {
     percent (moved_bytes, collected_bytes + moved_bytes),
     (long) moved_clauses);
 
-  // Prepare 'to' space of size 'moved_bytes'.
+  // Prepare 'to' space of size 'moved_bytes' (plus 'padding').
   //
-  arena.prepare (moved_bytes);
+  if (opts.arenaline) arena.prepare (moved_bytes + padding, true);
+  else arena.prepare (moved_bytes);
 
   // Keep clauses in arena in the same order.
   //
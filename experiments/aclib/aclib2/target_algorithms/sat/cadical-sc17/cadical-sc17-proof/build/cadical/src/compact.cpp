@@ -199,6 +199,21 @@ void Internal::compact () {
 
   PRINT ("mapped 'i2e'");
 
+  // Map the assumptions (which are frozen and thus not removed).
+  {
+    const const_int_iterator end = assumptions.end ();
+    int_iterator i;
+    for (i = assumptions.begin (); i != end; i++) {
+      const int src = *i;
+      int dst;
+      MAP_LIT (src, dst);
+      assert (dst);
+      *i = dst;
+    }
+  }
+
+  PRINT ("mapped 'assumptions'");
+
   // Map the literals in all clauses.
   {
     const const_clause_iterator end = clauses.end ();
@@ -34,15 +34,31 @@ void Internal::assume_decision (int lit) {
 }
 
 // Search for the next decision and assign it to the saved phase.  Requires
-// that not all variables are assigned.
+// that not all variables are assigned.  Unassigned assumptions are decided
+// first.  If an assumption is falsified, we determine the failed
+// assumptions with 'failing' and return '20' instead.
 
-void Internal::decide () {
+int Internal::decide () {
   START (decide);
-  stats.decisions++;
-  int idx = next_decision_variable ();
-  int decision = phases[idx] * idx;
-  assume_decision (decision);
+  int res = 0, decision = 0;
+  const const_int_iterator end = assumptions.end ();
+  for (const_int_iterator i = assumptions.begin (); i != end; i++) {
+    const int lit = *i, tmp = val (lit);
+    if (tmp > 0) continue;
+    if (tmp < 0) { failing (lit); res = 20; }
+    else decision = lit;
+    break;
+  }
+  if (!res) {
+    if (!decision) {
+      stats.decisions++;
+      int idx = next_decision_variable ();
+      decision = phases[idx] * idx;
+    }
+    assume_decision (decision);
+  }
   STOP (decide);
+  return res;
 }
 
 };
@@ -7,6 +7,7 @@ namespace CaDiCaL {
 // are equivalent and we replace them all by the literal with the smallest
 // index in an scc.  This variables are marked 'substituted' and will be
 // removed from all clauses.  Their value will be fixed during 'extend'.
+// Frozen literals are kept and act as their own representative.
 
 #define TRAVERSED UINT_MAX              // mark completely traversed
 
@@ -127,6 +128,11 @@ bool Internal::decompose_round () {
                   other = scc.back ();
                   scc.pop_back ();
                   dfs[vlit (other)].min = TRAVERSED;
+                  if (other != repr && frozen (other)) {
+                    LOG ("frozen literal %d in scc of %d", other, repr);
+                    reprs[vlit (other)] = other;
+                    continue;
+                  }
                   reprs[vlit (other)] = repr;
                   if (other != repr) {
                     substituted++;
@@ -318,7 +324,7 @@ bool Internal::decompose_round () {
     if (!active (idx)) continue;
     int other = reprs [ vlit (idx) ];
     if (other == idx) continue;
-    assert (active (other));
+    assert (active (other) || flags (other).fixed ());
     flags (idx).status = Flags::SUBSTITUTED;
     stats.all.substituted++;
     stats.now.substituted++;
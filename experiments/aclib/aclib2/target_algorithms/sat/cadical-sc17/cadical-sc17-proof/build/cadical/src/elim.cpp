@@ -336,8 +336,8 @@ inline void Internal::elim_add_resolvents (int pivot) {
 /*------------------------------------------------------------------------*/
 
 // Remove clauses with 'pivot' and '-pivot' by marking them as garbage and
-// at the same time push those with 'pivot' on the extension stack for
-// witness reconstruction (in 'extend').
+// at the same time push them on the extension stack for witness
+// reconstruction (in 'extend').
 
 inline void Internal::mark_eliminated_clauses_as_garbage (int pivot) {
 
@@ -367,16 +367,15 @@ inline void Internal::mark_eliminated_clauses_as_garbage (int pivot) {
     if (d->garbage) continue;
     mark_garbage (d);
     if (d->redundant) continue;
+    external->push_clause_on_extension_stack (d, -pivot);
     elim_update_removed (d, -pivot);
   }
   erase_occs (ns);
 
-  // This is a trick by Niklas Soerensson to avoid saving all clauses on the
-  // extension stack.  Just first in extending the witness the 'pivot' is
-  // forced to false and then if necessary fixed by checking the clauses in
-  // which 'pivot' occurs to be falsified.
-
-  external->push_unit_on_extension_stack (-pivot);
+  // Niklas Soerensson's trick of only saving the clauses with 'pivot' and
+  // then forcing 'pivot' to false first during extension is not enough for
+  // incremental solving.  If 'pivot' is used again in a later call, all the
+  // clauses with '-pivot' have to be restored too (see 'restore.cpp').
 }
 
 /*------------------------------------------------------------------------*/
@@ -386,6 +385,7 @@ inline void Internal::mark_eliminated_clauses_as_garbage (int pivot) {
 inline void Internal::try_to_eliminate_variable (int pivot) {
 
   if (!active (pivot)) return;
+  if (frozen (pivot)) return;
 
   LOG ("trying to eliminate %d", pivot);
   assert (!flags (pivot).eliminated ());
@@ -404,9 +404,9 @@ inline void Internal::try_to_eliminate_variable (int pivot) {
     return;
   }
 
-  // The 'mark_clauses_with_literal_garbage' benefits from having the
-  // 'pivot' in the phase with less occurrences than its negation.  It
-  // reduces the size of the extension stack greatly.
+  // Normalize 'pivot' to be the phase with less occurrences than its
+  // negation (originally to reduce the size of the extension stack, which
+  // now has to contain the clauses of both phases anyhow).
   //
   if (pos > neg) pivot = -pivot, swap (pos, neg);
 
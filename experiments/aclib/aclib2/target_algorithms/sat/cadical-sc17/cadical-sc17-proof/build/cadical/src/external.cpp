@@ -9,6 +9,7 @@ External::External (Internal * i)
   vals (0),
   solution (0),
   e2i (0),
+  tainted (false),
   internal (i)
 {
   assert (internal);
@@ -51,20 +52,117 @@ void External::init (int new_max_var) {
   max_var = new_max_var;
 }
 
+/*------------------------------------------------------------------------*/
+
+// Results of the last 'solve' call, i.e., the failed assumptions, are only
+// valid until the user adds another literal, assumes another literal or
+// calls 'solve' again.  At that point we also backtrack the internal solver
+// to the root level, since it might still have all variables assigned after
+// a satisfiable call to 'solve'.
+
+void External::reset_assumptions () {
+  const const_int_iterator end = assumed.end ();
+  for (const_int_iterator i = assumed.begin (); i != end; i++) {
+    const unsigned u = vlit (*i);
+    if (u < failedtab.size ()) failedtab[u] = false;
+  }
+  assumed.clear ();
+  if (internal->level) internal->backtrack ();
+}
+
 void External::add (int elit) {
+  reset_assumptions ();
   if (internal->opts.check) original.push_back (elit);
+  if (elit) {
+    const int eidx = abs (elit);
+    if (eidx <= max_var && inactive (eidx)) taint (eidx);
+  }
   const int ilit = internalize (elit);
   assert (!elit || ilit);
   if (elit) LOG ("adding external %d as internal %d", elit, ilit);
   internal->add_original_lit (ilit);
 }
 
+void External::assume (int elit) {
+  assert (elit);
+  reset_assumptions ();
+  const int eidx = abs (elit);
+  if (eidx <= max_var && inactive (eidx)) taint (eidx);
+  else if (eidx > max_var) init (eidx);
+  LOG ("assuming external %d", elit);
+  assumptions.push_back (elit);
+}
+
+/*------------------------------------------------------------------------*/
+
+void External::freeze (int elit) {
+  assert (elit), assert (elit != INT_MIN);
+  const int eidx = abs (elit);
+  if (eidx > max_var) init (eidx);
+  if ((size_t) eidx >= frozentab.size ()) frozentab.resize (eidx + 1, 0);
+  frozentab[eidx]++;
+  LOG ("external %d frozen %u times", eidx, frozentab[eidx]);
+}
+
+void External::melt (int elit) {
+  const int eidx = vidx (elit);
+  assert (frozen (eidx));
+  frozentab[eidx]--;
+  LOG ("external %d frozen %u times", eidx, frozentab[eidx]);
+}
+
+/*------------------------------------------------------------------------*/
+
+// Assumptions are frozen during 'solve' in order to keep them from being
+// eliminated or substituted by inprocessing.  If the internal solver
+// returns '20' we mark those assumptions which occur in the internal core
+// of failed assumptions as 'failed'.  Note that several external variables
+// might be mapped to the same internal variable (after 'compact' all fixed
+// variables are mapped to the first fixed variable).  Thus we go through
+// the external assumptions and check membership in the (sorted) core.
+// Portfolio mode is only used without assumptions and proof tracing.
+
 int External::solve () {
-  int res = internal->solve ();
+  reset_assumptions ();
+  if (tainted) restore_clauses ();
+  const const_int_iterator end = assumptions.end ();
+  const_int_iterator i;
+  for (i = assumptions.begin (); i != end; i++) {
+    const int elit = *i;
+    freeze (elit);
+    internal->assume (internalize (elit));
+  }
+  int res;
+#ifndef NTHREADS
+  if (internal->opts.threads > 1 &&
+      assumptions.empty () &&
+      !internal->proof &&
+      !internal->unsat)
+    res = portfolio ();
+  else
+#endif
+  {
+    res = internal->solve ();
+    if (res == 10) extend ();
+  }
   if (res == 10) {
-    extend ();
     if (internal->opts.check) check (&External::val);
+  } else if (res == 20 && !internal->core.empty ()) {
+    vector<int> & core = internal->core;
+    sort (core.begin (), core.end ());
+    if (failedtab.size () < 2*vsize) failedtab.resize (2*vsize, false);
+    for (i = assumptions.begin (); i != end; i++) {
+      const int elit = *i;
+      if (!binary_search (core.begin (), core.end (), internalize (elit)))
+        continue;
+      LOG ("external assumption %d failed", elit);
+      failedtab[vlit (elit)] = true;
+    }
   }
+  for (i = assumptions.begin (); i != end; i++) melt (*i);
+  internal->reset_assumptions ();
+  assumed.swap (assumptions);
+  assumptions.clear ();
   return res;
 }
 
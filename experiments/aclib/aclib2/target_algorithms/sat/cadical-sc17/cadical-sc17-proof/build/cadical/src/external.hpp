@@ -48,6 +48,7 @@ class External {
 
   friend class Internal;
   friend class Parser;
+  friend class Portfolio;
   friend class Solver;
   friend struct Stats;
 
@@ -66,6 +67,13 @@ class External {
   vector<int> extension;
   vector<int> original;
 
+  vector<int> assumptions;      // external assumptions for next 'solve'
+  vector<int> assumed;          // assumptions of last 'solve'
+  vector<bool> failedtab;       // failed assumptions [vlit(lit)]
+  vector<unsigned> frozentab;   // freeze reference counters [1,max_var]
+  vector<bool> taintedtab;      // need restoring clauses [1,max_var]
+  bool tainted;                 // at least one variable tainted
+
   Internal * internal;
 
   /*----------------------------------------------------------------------*/
@@ -75,6 +83,12 @@ class External {
   void push_unit_on_extension_stack (int pivot);
   void extend ();
 
+  // Restoring eliminated and substituted variables in 'restore.cpp'.
+  //
+  bool inactive (int eidx) const;
+  void taint (int eidx);
+  void restore_clauses ();
+
   External (Internal *);
   ~External ();
 
@@ -100,10 +114,40 @@ class External {
     return res;
   }
 
+  // Same as 'vlit' in 'Internal'.  Literals are unsigned with LSB as sign.
+  //
+  unsigned vlit (int lit) const {
+    return (lit < 0) + 2u * (unsigned) vidx (lit);
+  }
+
   void add (int lit);
+  void assume (int lit);
+  void reset_assumptions ();
+
+  bool failed (int lit) const {
+    assert (lit), assert (lit != INT_MIN);
+    if (abs (lit) > max_var) return false;
+    const unsigned u = vlit (lit);
+    return u < failedtab.size () && failedtab[u];
+  }
+
+  void freeze (int lit);
+  void melt (int lit);
+
+  bool frozen (int lit) const {
+    assert (lit), assert (lit != INT_MIN);
+    const size_t idx = abs (lit);
+    return idx < frozentab.size () && frozentab[idx] > 0;
+  }
 
   int solve ();
 
+#ifndef NTHREADS
+  // Solve with several threads in 'portfolio.cpp'.
+  //
+  int portfolio ();
+#endif
+
   inline int val (int lit) const {
     assert (lit != INT_MIN);
     int idx = abs (lit);
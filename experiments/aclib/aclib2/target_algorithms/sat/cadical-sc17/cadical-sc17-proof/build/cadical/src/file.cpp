@@ -6,10 +6,17 @@
 
 extern "C" {
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <sys/types.h>
 #include <unistd.h>
 #include <stdlib.h>
+#ifdef HAVE_ZLIB
+#include <zlib.h>
+#endif
+#ifdef HAVE_LZMA
+#include <lzma.h>
+#endif
 };
 
 /*------------------------------------------------------------------------*/
@@ -18,19 +25,148 @@ namespace CaDiCaL {
 
 /*------------------------------------------------------------------------*/
 
+// Size of read buffer (and input buffer for 'liblzma').
+
+#define FILE_BUFFER_SIZE (1 << 16)
+
 // Private constructor.
 
 File::File (Internal *i, bool w, int c, FILE * f, const char * n)
 :
   internal (i), writing (w),
   close_file (c), file (f),
-  _name (n), _lineno (1), _bytes (0)
+  _name (n), _lineno (1), _bytes (0),
+  pos (0), end (0), buffer (0), mapped (0),
+  decoder (0), gzipped (false), compressed (c == 2)
 {
   assert (f), assert (n);
 }
 
 /*------------------------------------------------------------------------*/
 
+// Map a regular uncompressed file into memory.  If this fails (for
+// instance for an empty file or a named pipe) we fall back to 'fread'.
+
+void File::map () {
+  assert (!writing), assert (!buffer), assert (!mapped);
+  struct stat buf;
+  if (fstat (fileno (file), &buf)) return;
+  if (!S_ISREG (buf.st_mode) || buf.st_size <= 0) return;
+  const size_t bytes = buf.st_size;
+  void * res = mmap (0, bytes, PROT_READ, MAP_PRIVATE, fileno (file), 0);
+  if (res == MAP_FAILED) return;
+  (void) madvise (res, bytes, MADV_SEQUENTIAL);
+  MSG ("memory mapped %ld bytes of '%s'", (long) bytes, name ());
+  pos = (const char *) res;
+  end = pos + bytes;
+  mapped = bytes;
+}
+
+#ifdef HAVE_ZLIB
+
+// Files are written through 'zlib' at the fastest compression level.  This
+// is chosen for proofs, which are large and written while solving, so that
+// compressing them does not slow down the solver.  Other files, such as
+// JSON statistics, are small and written once.
+
+void File::open_gz () {
+  const int fd = dup (fileno (file));
+  if (fd < 0) return;
+  gzFile gz = gzdopen (fd, writing ? "wb1" : "rb");
+  if (!gz) { close (fd); return; }
+  gzbuffer (gz, FILE_BUFFER_SIZE);
+  MSG ("%s '%s' with 'zlib'",
+    writing ? "compressing" : "decompressing", name ());
+  decoder = gz;
+  gzipped = true;
+  compressed = true;
+}
+
+#endif
+
+#ifdef HAVE_LZMA
+
+struct XZ {
+  lzma_stream stream;
+  uint8_t input[FILE_BUFFER_SIZE];
+};
+
+void File::open_xz () {
+  XZ * xz = new XZ;
+  lzma_stream init = LZMA_STREAM_INIT;
+  xz->stream = init;
+  if (lzma_stream_decoder (&xz->stream,
+                           UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK) {
+    delete xz;
+    return;
+  }
+  MSG ("decompressing '%s' with 'liblzma'", name ());
+  decoder = xz;
+  compressed = true;
+}
+
+// Decompress as much as fits into 'buffer'.  Errors in the compressed
+// input are treated as end-of-file and then lead to a parse error.
+
+size_t File::read_xz () {
+  XZ * xz = (XZ *) decoder;
+  lzma_stream & s = xz->stream;
+  s.next_out = (uint8_t *) buffer;
+  s.avail_out = FILE_BUFFER_SIZE;
+  while (s.avail_out) {
+    lzma_action action = LZMA_RUN;
+    if (!s.avail_in) {
+      s.next_in = xz->input;
+      s.avail_in = fread (xz->input, 1, FILE_BUFFER_SIZE, file);
+      if (!s.avail_in) action = LZMA_FINISH;
+    }
+    lzma_ret ret = lzma_code (&s, action);
+    if (ret != LZMA_OK) break;
+  }
+  return FILE_BUFFER_SIZE - s.avail_out;
+}
+
+#endif
+
+void File::put (const char * data, size_t bytes) {
+  assert (writing);
+#ifdef HAVE_ZLIB
+  if (gzipped) {
+    while (bytes) {
+      const unsigned chunk = bytes < INT_MAX ? bytes : INT_MAX;
+      if (gzwrite ((gzFile) decoder, data, chunk) <= 0) return;
+      data += chunk, bytes -= chunk, _bytes += chunk;
+    }
+    return;
+  }
+#endif
+  _bytes += fwrite (data, 1, bytes, file);
+}
+
+// Called by 'get' if all buffered bytes are consumed.
+
+bool File::refill () {
+  assert (!writing), assert (pos == end);
+  if (mapped) return false;
+  if (!buffer) buffer = new char[FILE_BUFFER_SIZE];
+  size_t bytes;
+#ifdef HAVE_ZLIB
+  if (gzipped) {
+    int res = gzread ((gzFile) decoder, buffer, FILE_BUFFER_SIZE);
+    bytes = res > 0 ? res : 0;
+  } else
+#endif
+#ifdef HAVE_LZMA
+  if (decoder) bytes = read_xz (); else
+#endif
+  bytes = fread (buffer, 1, FILE_BUFFER_SIZE, file);
+  pos = buffer;
+  end = buffer + bytes;
+  return bytes > 0;
+}
+
+/*------------------------------------------------------------------------*/
+
 bool File::exists (const char * path) {
   struct stat buf;
   return !stat (path, &buf);
@@ -133,6 +269,24 @@ File * File::write (Internal * internal, FILE * f, const char * n) {
 File * File::read (Internal * internal, const char * path) {
   FILE * file;
   int close_input = 2;
+#ifdef HAVE_LZMA
+  if (has_suffix (path, ".xz")) {
+    if (!(file = read_file (internal, path))) return 0;
+    File * res = new File (internal, false, 1, file, path);
+    res->open_xz ();
+    if (res->decoder) return res;
+    delete res;
+  }
+#endif
+#ifdef HAVE_ZLIB
+  if (has_suffix (path, ".gz")) {
+    if (!(file = read_file (internal, path))) return 0;
+    File * res = new File (internal, false, 1, file, path);
+    res->open_gz ();
+    if (res->decoder) return res;
+    delete res;
+  }
+#endif
   if (has_suffix (path, ".xz"))
     file = read_pipe (internal, "xz -c -d %s", path);
   else if (has_suffix (path, ".bz2"))
@@ -143,12 +297,24 @@ File * File::read (Internal * internal, const char * path) {
     file = read_pipe (internal, "7z x -so %s 2>/dev/null", path);
   else
     file = read_file (internal, path), close_input = 1;
-  return file ? new File (internal, false, close_input, file, path) : 0;
+  if (!file) return 0;
+  File * res = new File (internal, false, close_input, file, path);
+  if (close_input == 1) res->map ();
+  return res;
 }
 
 File * File::write (Internal * internal, const char * path) {
   FILE * file;
   int close_input = 2;
+#ifdef HAVE_ZLIB
+  if (has_suffix (path, ".gz")) {
+    if (!(file = write_file (internal, path))) return 0;
+    File * res = new File (internal, true, 1, file, path);
+    res->open_gz ();
+    if (res->decoder) return res;
+    delete res;
+  }
+#endif
   if (has_suffix (path, ".xz"))
     file = write_pipe (internal, "xz -c > %s", path);
   else if (has_suffix (path, ".bz2"))
@@ -164,6 +330,19 @@ File * File::write (Internal * internal, const char * path) {
 }
 
 File::~File () {
+  if (mapped) munmap ((void *) (end - mapped), mapped);
+  if (buffer) delete [] buffer;
+#ifdef HAVE_ZLIB
+  if (gzipped) gzclose ((gzFile) decoder);
+  else
+#endif
+#ifdef HAVE_LZMA
+  if (decoder) {
+    XZ * xz = (XZ *) decoder;
+    lzma_end (&xz->stream);
+    delete xz;
+  }
+#endif
   if (close_file == 1) {
     MSG ("closing file '%s'", name ());
     fclose (file);
@@ -176,7 +355,7 @@ File::~File () {
   double mb = bytes () / (double) (1 << 20);
   if (writing) MSG ("after writing %ld bytes %.1f MB", bytes (), mb);
   else MSG ("after reading %ld bytes %.1f MB", bytes (), mb);
-  if (close_file == 2) {
+  if (compressed) {
     long s = size (name ());
     double mb = s / (double) (1<<20);
     if (writing)
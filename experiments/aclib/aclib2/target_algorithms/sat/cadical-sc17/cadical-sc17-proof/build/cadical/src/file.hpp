@@ -24,7 +24,15 @@ namespace CaDiCaL {
 // Wraps a 'C' file 'FILE' with name and supports zipped reading and writing
 // through 'popen' using external helper tools.  Reading has line numbers.
 // Compression and decompression relies on external utilities, e.g., 'gzip',
-// 'bzip2', 'xz', and '7z', which should be in the 'PATH'.
+// 'bzip2', 'xz', and '7z', which should be in the 'PATH'.  If 'zlib' or
+// 'liblzma' are available ('HAVE_ZLIB' and 'HAVE_LZMA' set by 'configure')
+// then '.gz' and '.xz' files are decompressed in-process instead.  Writing
+// '.gz' files with 'zlib' is only supported through block writes and uses
+// the fastest compression level.
+
+// Reading is buffered.  Uncompressed files given by their path are mapped
+// into memory with 'mmap' and then the buffer is the whole file.  The
+// parser has direct access to the buffer for its fast path.
 
 class Internal;
 
@@ -38,8 +46,26 @@ class File {
   long _lineno;
   long _bytes;
 
+  const char * pos;     // next byte to read
+  const char * end;     // end of buffered bytes
+  char * buffer;        // read buffer (unless mapped)
+  size_t mapped;        // size of memory mapped file (if non-zero)
+  void * decoder;       // 'gzFile' or 'XZ' (in-process (de)compression)
+  bool gzipped;         // 'decoder' is a 'gzFile'
+  bool compressed;      // decompressed in-process or through a pipe
+
   File (Internal *, bool, int, FILE *, const char *);
 
+  void map ();
+  bool refill ();
+#ifdef HAVE_ZLIB
+  void open_gz ();
+#endif
+#ifdef HAVE_LZMA
+  void open_xz ();
+  size_t read_xz ();
+#endif
+
   static FILE * open_file (Internal *,
                            const char * path, const char * mode);
   static FILE * read_file (Internal *, const char * path);
@@ -80,24 +106,44 @@ public:
 
   int get () {
     assert (!writing);
-    int res = cadical_getc_unlocked (file);
+    if (pos == end && !refill ()) return EOF;
+    int res = (unsigned char) *pos++;
     if (res == '\n') _lineno++;
-    if (res != EOF) _bytes++;
+    _bytes++;
     return res;
   }
 
+  // Direct access to the buffered bytes not read yet.  After parsing them
+  // up to 'p' (including 'lines' new-lines) the parser calls 'skip'.
+  //
+  const char * begin () const { assert (!writing); return pos; }
+  const char * limit () const { assert (!writing); return end; }
+
+  void skip (const char * p, long lines) {
+    assert (pos <= p), assert (p <= end);
+    _bytes += p - pos;
+    _lineno += lines;
+    pos = p;
+  }
+
   void put (char ch) {
-    assert (writing);
+    assert (writing), assert (!gzipped);
     cadical_putc_unlocked (ch, file);
     _bytes++;
   }
 
   void put (unsigned char ch) {
-    assert (writing);
+    assert (writing), assert (!gzipped);
     cadical_putc_unlocked (ch, file);
     _bytes++;
   }
 
+  // Write a block of bytes (used for buffered proof output).  In contrast
+  // to the functions above this uses locked IO and may be called from
+  // another thread as long as only that thread accesses this file.
+  //
+  void put (const char * data, size_t bytes);
+
   void put (const char * s) {
     for (const char * p = s; *p; p++)
       put (*p);
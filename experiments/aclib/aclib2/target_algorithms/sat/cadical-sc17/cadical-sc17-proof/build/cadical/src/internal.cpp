@@ -11,6 +11,7 @@ Internal::Internal ()
   clashing (false),
   simplifying (false),
   vivifying (false),
+  watched_garbage (false),
   vsize (0),
   max_var (0),
   level (0),
@@ -35,9 +36,13 @@ Internal::Internal ()
   esched (more_noccs2 (this)),
   wg (0.5), ws (0.5),
   proof (0),
+  share (0),
+  terminator (0),
+  forced (false),
   opts (this),
 #ifndef QUIET
   profiles (this),
+  perf (0),
 #endif
   arena (this),
   output (File::write (this, stdout, "<stdou>")),
@@ -53,6 +58,9 @@ Internal::~Internal () {
   for (clause_iterator i = clauses.begin (); i != clauses.end (); i++)
     delete_clause (*i);
   if (proof) delete proof;
+#ifndef QUIET
+  if (perf) delete perf;
+#endif
   if (vtab) DELETE_ONLY (vtab, Var, vsize);
   if (ltab) DELETE_ONLY (ltab, Link, vsize);
   if (ftab) DELETE_ONLY (ftab, Flags, vsize);
@@ -124,6 +132,13 @@ void Internal::init (int new_max_var) {
   if ((size_t) new_max_var >= vsize) enlarge (new_max_var);
   signed char val = opts.phase ? 1 : -1;
   for (int i = max_var + 1; i <= new_max_var; i++) phases[i] = val;;
+  if (opts.seed) {
+    unsigned state = opts.seed;
+    for (int i = max_var + 1; i <= new_max_var; i++) {
+      state = 1664525u * (state ^ (unsigned) i) + 1013904223u;
+      phases[i] = (state >> 16) & 1 ? 1 : -1;
+    }
+  }
 #ifndef NDEBUG
   for (int i = -new_max_var; i < -max_var; i++) assert (!vals[i]);
   for (int i = max_var + 1; i <= new_max_var; i++) assert (!vals[i]);
@@ -140,6 +155,7 @@ void Internal::init (int new_max_var) {
 
 void Internal::add_original_lit (int lit) {
   assert (abs (lit) <= max_var);
+  if (level) backtrack ();
   if (lit) clause.push_back (lit);
   else {
     if (!tautological_clause ()) add_new_original_clause ();
@@ -161,6 +177,8 @@ int Internal::search () {
     else if (iterating) iterate ();        // report learned unit
     else if (satisfied ()) res = 10;       // all variables satisfied
     else if (terminating ()) break;        // limit hit or asynchronous abort
+    else if (watched_garbage) flush_garbage_binary_watches ();
+    else if (!level && importing ()) import_shared (); // import clauses
     else if (restarting ()) restart ();    // restart by backtracking
     else if (rephasing ()) rephase ();     // reset phases
     else if (reducing ()) reduce ();       // collect useless learned clauses
@@ -168,16 +186,33 @@ int Internal::search () {
     else if (subsuming ()) subsume ();     // subsumption algorithm
     else if (eliminating ()) elim ();      // bounded variable elimination
     else if (compactifying ()) compact (); // collect internal variables
-    else decide ();                        // otherwise pick next decision
+    else res = decide ();                  // next decision or assumption
   STOP (search);
   return res;
 }
 
 /*------------------------------------------------------------------------*/
 
+// The limits of the inprocessors are only initialized during the first
+// call to 'solve'.  In incremental usage they continue with the previous
+// values (relative to the total number of conflicts), except for the
+// conflict, decision, time and memory limits, which are per call.
+
 void Internal::init_solving () {
 
+  lim.conflict = (opts.clim < 0) ? -1 : stats.conflicts + opts.clim;
+  lim.decision = (opts.dlim < 0) ? -1 : stats.decisions + opts.dlim;
+
+  lim.time = (opts.tlim < 0) ? -1 : absolute_real_time () + opts.tlim;
+  lim.memory = (opts.mlim < 0) ? 0 : ((size_t) opts.mlim << 20);
+  lim.terminate = opts.terminateint;
+  lim.memcheck = stats.conflicts;
+
+  if (lim.initialized) return;
+  lim.initialized = true;
+
   lim.restart = opts.restartint;
+  lim.import = opts.shareint;
 
   lim.reduce  = opts.reduceinit;
   inc.reduce  = opts.reduceinit;
@@ -200,9 +235,6 @@ void Internal::init_solving () {
   inc.rephase = opts.rephaseint;
   lim.rephase = opts.rephaseint;
 
-  lim.conflict = (opts.clim < 0) ? -1 : stats.conflicts + opts.clim;
-  lim.decision = (opts.dlim < 0) ? -1 : stats.decisions + opts.dlim;
-
   INIT_EMA (fast_glue_avg, opts.emagluefast);
   INIT_EMA (jump_avg, opts.emajump);
   INIT_EMA (size_avg, opts.emasize);
@@ -211,6 +243,8 @@ void Internal::init_solving () {
 
 int Internal::solve () {
   SECTION ("solving");
+  stats.solves++;
+  if (level) backtrack ();
   int res;
   if (unsat) {
     LOG ("already inconsistent");
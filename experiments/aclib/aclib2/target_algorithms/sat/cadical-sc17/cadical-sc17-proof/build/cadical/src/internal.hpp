@@ -18,6 +18,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <atomic>
 
 /*------------------------------------------------------------------------*/
 
@@ -34,6 +35,7 @@
 #include "heap.hpp"
 #include "internal.hpp"
 #include "iterator.hpp"
+#include "json.hpp"
 #include "level.hpp"
 #include "limit.hpp"
 #include "logging.hpp"
@@ -43,10 +45,13 @@
 #include "occs.hpp"
 #include "options.hpp"
 #include "parse.hpp"
+#include "perf.hpp"
+#include "portfolio.hpp"
 #include "profile.hpp"
 #include "proof.hpp"
 #include "queue.hpp"
 #include "resources.hpp"
+#include "share.hpp"
 #include "stats.hpp"
 #include "util.hpp"
 #include "var.hpp"
@@ -73,6 +78,7 @@ class Internal {
   friend struct Logger;
   friend struct Message;
   friend class Parser;
+  friend class Portfolio;
   friend class Proof;
   friend class Solver;
   friend struct Stats;
@@ -107,6 +113,7 @@ class Internal {
   bool clashing;                // found clashing units in during parsing
   bool simplifying;             // simplifying thus outside of CDCL loop
   bool vivifying;               // during vivification
+  bool watched_garbage;         // garbage binary clauses might be watched
   size_t vsize;                 // actually allocated variable data size
   int max_var;                  // (internal) maximum variable index
   int level;                    // decision level ('control.size () - 1')
@@ -137,6 +144,8 @@ class Internal {
   vector<int> probes;           // remaining scheduled probes
   vector<Level> control;        // 'level + 1 == control.size ()'
   vector<Clause*> clauses;      // ordered collection of all clauses
+  vector<int> assumptions;      // assumed literals during 'solve'
+  vector<int> core;             // failed assumptions after 'solve'
   ElimSchedule esched;          // bounded variable elimination schedule
   EMA fast_glue_avg;            // fast glue average
   EMA slow_glue_avg;            // slow glue average
@@ -146,11 +155,15 @@ class Internal {
   Limit lim;                    // limits for various phases
   Inc inc;                      // limit increments
   Proof * proof;                // trace clausal proof if non zero
+  Share * share;                // sharing clauses in portfolio mode
+  Terminator * terminator;      // polled in 'terminating' if non zero
+  atomic<bool> forced;          // asynchronous 'terminate' requested
   Options opts;                 // run-time options
   Stats stats;                  // statistics
 #ifndef QUIET
   vector<Timer> timers;         // active timers for profiling functions
   Profiles profiles;            // global profiled time for functions
+  Perf * perf;                  // hardware counters (with '--perf')
 #endif
   Arena arena;                  // memory arena for moving garbage collector
   Format error;                 // last (persistent) error message
@@ -182,6 +195,16 @@ class Internal {
   //
   bool active (int lit) { return flags(lit).active (); }
 
+  // Frozen variables are not eliminated nor substituted (see 'cadical.hpp').
+  // This is only queried during inprocessing and is thus not required to be
+  // fast.  The reference counters are kept in 'External'.
+  //
+  bool frozen (int lit) { return external->frozen (externalize (lit)); }
+
+  // Reactivate an eliminated or substituted variable in 'restore.cpp'.
+  //
+  void reactivate (int lit);
+
   int active_variables () const {
     int res = max_var;
     res -= stats.now.fixed;
@@ -329,10 +352,10 @@ class Internal {
   bool rephasing ();
   void rephase ();
 
-  // Asynchronous terminating check.
+  // Checking limits and asynchronous termination in 'limit.cpp'.
   //
   bool terminating ();
-  void terminate ();            // TODO: not implemented yet.
+  void terminate ();
 
   // Reducing means determining useless clauses with 'reduce' in
   // 'reduce.cpp' as well as root level satisfied clause and then removing
@@ -354,6 +377,7 @@ class Internal {
   void flush_watches (int lit, Watches &);
   size_t flush_occs (int lit);
   void flush_all_occs_and_watches ();
+  void flush_garbage_binary_watches ();
   void copy_non_garbage_clauses ();
   void delete_garbage_clauses ();
   void check_clause_stats ();
@@ -491,12 +515,30 @@ class Internal {
   bool decompose_round ();
   void decompose ();
 
+  // Incremental solving under assumptions in 'assume.cpp'.
+  //
+  void assume (int lit);
+  bool assumptions_satisfied () const;
+  void failing (int lit);
+  void reset_assumptions ();
+
+  // Exporting and importing shared clauses in portfolio mode in
+  // 'share.cpp'.  Threads are managed in 'portfolio.cpp'.
+  //
+  void export_unit (int lit);
+  void export_clause (Clause *);
+  bool importing ();
+  void import_shared ();
+
   // Part on picking the next decision in 'decide.cpp'.
   //
-  bool satisfied () const { return trail.size () == (size_t) max_var; }
+  bool satisfied () const {
+    if (trail.size () < (size_t) max_var) return false;
+    return assumptions.empty () || assumptions_satisfied ();
+  }
   int next_decision_variable ();
   void assume_decision (int decision);
-  void decide ();
+  int decide ();                // returns 20 if an assumption failed
 
   // Main search functions in 'internal.cpp'.
   //
@@ -515,6 +557,7 @@ class Internal {
 
   void update_all_timers (double now);
   void print_profile (double now);
+  void json_profile (JSON &);
 #endif
 
   // Get the value of an internal literal: -1=false, 0=unassigned, 1=true.
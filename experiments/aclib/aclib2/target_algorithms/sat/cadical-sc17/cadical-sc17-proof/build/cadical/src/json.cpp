@@ -0,0 +1,69 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Each member is put on its own line and indented by its nesting depth.
+
+void JSON::key (const char * name) {
+  if (!first) buffer += ',';
+  if (depth) buffer += '\n';
+  buffer.append (2*depth, ' ');
+  first = false;
+  if (!name) return;
+  buffer += '"';
+  buffer += name;
+  buffer += "\": ";
+}
+
+void JSON::begin (const char * name) {
+  if (depth || !buffer.empty ()) key (name);
+  buffer += '{';
+  depth++;
+  first = true;
+}
+
+void JSON::end () {
+  assert (depth > 0);
+  depth--;
+  if (!first) {
+    buffer += '\n';
+    buffer.append (2*depth, ' ');
+  }
+  buffer += '}';
+  if (!depth) buffer += '\n';
+  first = false;
+}
+
+void JSON::add (const char * name, long value) {
+  char tmp[32];
+  sprintf (tmp, "%ld", value);
+  key (name);
+  buffer += tmp;
+}
+
+// JSON has no representation for infinity and not-a-number.
+
+void JSON::add (const char * name, double value) {
+  char tmp[32];
+  if (value != value || value - value != 0) strcpy (tmp, "null");
+  else sprintf (tmp, "%.6g", value);
+  key (name);
+  buffer += tmp;
+}
+
+void JSON::add (const char * name, const char * value) {
+  key (name);
+  buffer += '"';
+  buffer += value;
+  buffer += '"';
+}
+
+void JSON::write (File * file) {
+  assert (!depth);
+  file->put (buffer.data (), buffer.size ());
+  buffer.clear ();
+}
+
+};
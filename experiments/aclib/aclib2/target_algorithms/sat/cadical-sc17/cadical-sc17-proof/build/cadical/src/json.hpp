@@ -0,0 +1,41 @@
+#ifndef _json_hpp_INCLUDED
+#define _json_hpp_INCLUDED
+
+#include <string>
+
+namespace CaDiCaL {
+
+using namespace std;
+
+class File;
+
+// Minimal writer for statistics and profiling data in JSON format, which
+// is easier to post-process (in experiments over many instances) than the
+// 'c' comment lines of 'print_stats' and 'print_profile'.  Keys are not
+// escaped and thus should not contain quotes or backslashes.
+
+class JSON {
+
+  string buffer;
+  int depth;            // nesting depth of objects
+  bool first;           // no member written yet in current object
+
+  void key (const char *);
+
+public:
+
+  JSON () : depth (0), first (true) { }
+
+  void begin (const char * name = 0);   // start (named) object
+  void end ();                          // close innermost object
+
+  void add (const char * name, long);
+  void add (const char * name, double);
+  void add (const char * name, const char *);
+
+  void write (File *);                  // write and clear buffer
+};
+
+};
+
+#endif
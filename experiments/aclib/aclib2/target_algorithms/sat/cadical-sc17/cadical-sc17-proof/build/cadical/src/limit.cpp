@@ -4,12 +4,50 @@ namespace CaDiCaL {
 
 Limit::Limit () { memset (this, 0, sizeof *this); }
 
+// Called in every iteration of the main search loop.  The conflict and
+// decision limits as well as the flags for asynchronous termination are
+// cheap to check.  The terminator call-back and the wall-clock time are
+// only polled every 'terminateint' steps.  Determining the resident set
+// size is even more expensive and thus additionally only done every
+// 'terminateint' conflicts.  In all cases 'search' returns '0' (UNKNOWN).
+
 bool Internal::terminating () {
   if (lim.conflict >= 0 && stats.conflicts >= lim.conflict) return true;
   if (lim.decision >= 0 && stats.decisions >= lim.decision) return true;
+  if (share && share->terminated.load (memory_order_relaxed)) return true;
+  if (forced.load (memory_order_relaxed)) {
+    MSG ("forced to terminate");
+    forced = false;
+    return true;
+  }
+  if (--lim.terminate > 0) return false;
+  lim.terminate = opts.terminateint;
+  if (terminator && terminator->terminate ()) {
+    MSG ("terminated by call-back");
+    return true;
+  }
+  if (lim.time >= 0 && absolute_real_time () >= lim.time) {
+    MSG ("wall-clock time limit of %d seconds hit", opts.tlim);
+    return true;
+  }
+  if (lim.memory && stats.conflicts >= lim.memcheck) {
+    lim.memcheck = stats.conflicts + opts.terminateint;
+    if (current_resident_set_size () > lim.memory) {
+      MSG ("memory limit of %d MB hit", opts.mlim);
+      return true;
+    }
+  }
   return false;
 }
 
+// Can be called asynchronously, e.g., from another thread or a signal
+// handler, and is thus restricted to set an atomic flag.
+
+void Internal::terminate () {
+  LOG ("forcing termination");
+  forced = true;
+}
+
 Inc::Inc () { memset (this, 0, sizeof *this); }
 
 };
@@ -1,12 +1,21 @@
 #ifndef _limit_hpp_INCLUDED
 #define _limit_hpp_INCLUDED
 
+#include <cstdlib>
+
 namespace CaDiCaL {
 
 struct Limit {
 
+  bool initialized; // set during first 'solve' in 'init_solving'
+
   long conflict;  // conflict limit if non-negative
   long decision;  // decision limit if non-negative
+  double time;    // wall-clock time limit if non-negative
+  size_t memory;  // resident set size limit if non-zero
+
+  long terminate; // search steps until polling terminator and time
+  long memcheck;  // conflict limit for next memory check
 
   long elim;      // conflict limit for next 'elim'
   long probe;     // conflict limit for next 'probe'
@@ -15,6 +24,7 @@ struct Limit {
   long restart;   // conflict limit for next 'restart'
   long subsume;   // conflict limit for next 'subsume'
   long compact;   // conflict limit for next 'compact'
+  long import;    // conflict limit for next 'import_shared'
 
   int keptglue;   // maximum kept glue in 'reduce'
   int keptsize;   // maximum kept size in 'reduce'
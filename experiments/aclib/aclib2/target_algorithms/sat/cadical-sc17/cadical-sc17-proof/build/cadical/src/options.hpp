@@ -33,6 +33,12 @@
 #define QUTOPT OPTION
 #endif
 
+#ifdef NTHREADS
+#define THROPT(ARGS...) /**/
+#else
+#define THROPT OPTION
+#endif
+
 /*------------------------------------------------------------------------*/
 
 // In order to add new option, simply add a new line below.
@@ -43,6 +49,7 @@
 \
 OPTION(arena,            int,    3, 0,  3, "1=clause,2=var,3=queue") \
 OPTION(arenacompact,    bool,    1, 0,  1, "keep clauses compact") \
+OPTION(arenaline,       bool,    1, 0,  1, "keep short clauses in cache lines") \
 OPTION(arenasort,        int,    1, 0,  1, "sort clauses after arenaing") \
 OPTION(binary,          bool,    1, 0,  1, "use binary proof format") \
 OPTION(check,           bool,DEBUG, 0,  1, "save & check original CNF") \
@@ -75,6 +82,8 @@ LOGOPT(log,             bool,    0, 0,  1, "enable logging") \
 LOGOPT(logsort,         bool,    0, 0,  1, "sort logged clauses") \
 OPTION(minimize,        bool,    1, 0,  1, "minimize learned clauses") \
 OPTION(minimizedepth,    int,  1e3, 0,1e9, "minimization depth") \
+OPTION(mlim,             int,   -1, 0,1e9, "memory limit in MB (-1=none)") \
+QUTOPT(perf,            bool,    0, 0,  1, "hardware counters in profile") \
 OPTION(phase,            int,    1, 0,  1, "initial phase: 0=neg,1=pos") \
 OPTION(posize,           int,    4, 4,1e9, "size for saving position") \
 OPTION(prefetch,        bool,    1, 0,  1, "prefetch watches") \
@@ -85,6 +94,8 @@ OPTION(probereleff,   double, 0.02, 0,  1, "relative probing efficiency") \
 OPTION(probemaxeff,   double,  1e7, 0,  1, "maximum probing efficiency") \
 OPTION(probemineff,   double,  1e5, 0,  1, "minimum probing efficiency") \
 OPTION(profile,          int,    2, 0,  4, "profiling level") \
+THROPT(proofasync,      bool,    1, 0,  1, "write proof in background thread") \
+OPTION(proofbuffer,      int,   20,10, 30, "log2 of proof buffer size") \
 QUTOPT(quiet,           bool,    0, 0,  1, "disable all messages") \
 OPTION(reduceinc,        int,  300, 1,1e6, "reduce limit increment") \
 OPTION(reduceinit,       int, 2000, 0,1e6, "initial reduce limit") \
@@ -94,6 +105,12 @@ OPTION(restart,         bool,    1, 0,  1, "enable restarting") \
 OPTION(restartint,       int,    6, 1,1e9, "restart base interval") \
 OPTION(restartmargin, double,  1.1, 0, 10, "restart slow fast margin") \
 OPTION(reusetrail,      bool,    1, 0,  1, "enable trail reuse") \
+OPTION(seed,             int,    0, 0,1e9, "random initial phases (0=off)") \
+OPTION(share,           bool,    1, 0,  1, "share clauses between threads") \
+OPTION(shareglue,        int,    2, 1,1e9, "maximum glue of shared clauses") \
+OPTION(shareint,         int,  100, 1,1e9, "import interval in conflicts") \
+OPTION(sharering,        int,   16, 8, 28, "log2 of ring buffer size") \
+OPTION(sharesize,        int,    8, 1,100, "maximum size of shared clauses") \
 OPTION(simplify,        bool,    1, 0,  1, "enable simplifier") \
 OPTION(strengthen,      bool,    1, 0,  1, "strengthen during subsume") \
 OPTION(subsume,         bool,    1, 0,  1, "enable clause subsumption") \
@@ -102,6 +119,9 @@ OPTION(subsumeclslim,    int,  1e3, 0,1e9, "clause length limit") \
 OPTION(subsumeinc,       int,  1e4, 1,1e9, "interval in conflicts") \
 OPTION(subsumeinit,      int,  1e4, 0,1e9, "initial subsume limit") \
 OPTION(subsumeocclim,    int,  100, 0,1e9, "watch list length limit") \
+OPTION(terminateint,     int,  100, 1,1e9, "search steps between polling") \
+THROPT(threads,          int,    1, 1,256, "number of portfolio threads") \
+OPTION(tlim,             int,   -1, 0,1e9, "wall-clock time limit (-1=none)") \
 OPTION(transred,        bool,    1, 0,  1, "transitive reduction of BIG") \
 OPTION(transredreleff,double, 0.10, 0,  1, "relative efficiency") \
 OPTION(transredmaxeff,double,  1e7, 0,  1, "maximum efficiency") \
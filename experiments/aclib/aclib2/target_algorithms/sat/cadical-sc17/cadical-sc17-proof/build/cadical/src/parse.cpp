@@ -63,6 +63,50 @@ Parser::parse_lit (int & ch, int & lit, const int vars) {
   return 0;
 }
 
+// Fast path for parsing literals in the body of a DIMACS file directly from
+// the read buffer of 'file' (the whole file if it is memory mapped).  As
+// long as enough bytes are buffered, such that the literal and the white
+// space after it can not cross the end of the buffer, there is no need to
+// check for the end of the buffer for every character.  White space is
+// skipped in the same way.  For everything else, i.e., comments, the end
+// of the buffer, and syntax errors, it returns 'false' and the slow path
+// above is used (which also produces the appropriate error messages).
+// Longer tokens, e.g., zero padded literals, are also left to the slow path,
+// since only 'MAX_FAST_LIT_BYTES' bytes are known to be buffered.
+
+#define MAX_FAST_LIT_BYTES 16   // 11 for '-2147483648' plus delimiter
+
+inline bool Parser::parse_lit_fast (int & lit, const int vars) {
+  const char * p = file->begin ();
+  const char * end = file->limit ();
+  long lines = 0;
+  for (;;) {
+    if (end - p < MAX_FAST_LIT_BYTES) break;
+    char ch = *p;
+    if (ch == '\n') { lines++; p++; continue; }
+    if (ch == ' ' || ch == '\t' || ch == '\r') { p++; continue; }
+    const char * q = p, * stop = p + MAX_FAST_LIT_BYTES;
+    int sign = 1;
+    if (ch == '-') sign = -1, ch = *++q;
+    if (!isdigit (ch)) break;
+    int res = ch - '0';
+    while (++q < stop && isdigit (ch = *q)) {
+      const int digit = ch - '0';
+      if (INT_MAX/10 < res || INT_MAX - digit < 10*res) break;
+      res = 10*res + digit;
+    }
+    if (isdigit (ch)) break;
+    if (ch != ' ' && ch != '\t' && ch != '\n' && ch != '\r') break;
+    if (res > vars) break;
+    if (sign < 0 && !res) break;
+    file->skip (q, lines);
+    lit = sign * res;
+    return true;
+  }
+  file->skip (p, lines);
+  return false;
+}
+
 /*------------------------------------------------------------------------*/
 
 // Parsing function for CNF in DIMACS format.
@@ -100,7 +144,14 @@ const char * Parser::parse_dimacs_non_profiled () {
   MSG ("found 'p cnf %d %d' header", vars, clauses);
   external->init (vars);
   int lit = 0, parsed = 0;
-  while ((ch = parse_char ()) != EOF) {
+  for (;;) {
+    if (parse_lit_fast (lit, vars)) {
+      external->add (lit);
+      if (!lit && parsed++ >= clauses && !internal->opts.force)
+        PER ("too many clauses");
+      continue;
+    }
+    if ((ch = parse_char ()) == EOF) break;
     if (ch == ' ' || ch == '\n' || ch == '\t' || ch == '\r') continue;
     if (ch == 'c') {
 COMMENT:
@@ -117,6 +168,7 @@ COMMENT:
   }
   if (lit) PER ("last clause without '0'");
   if (parsed < clauses && !internal->opts.force) PER ("clause missing");
+  internal->stats.parse.clauses += parsed;
   MSG ("parsed %d clauses in %.2f seconds", parsed, process_time ());
   return 0;
 }
@@ -174,7 +226,15 @@ const char * Parser::parse_solution_non_profiled () {
 
 const char * Parser::parse_dimacs () {
   START (parse);
+  const double start = process_time ();
+  const long bytes = file->bytes ();
   const char * err = parse_dimacs_non_profiled ();
+  const double time = process_time () - start;
+  internal->stats.parse.bytes += file->bytes () - bytes;
+  internal->stats.parse.time += time;
+  MSG ("parsed %ld bytes at %.1f MB per second",
+    file->bytes () - bytes,
+    relative ((file->bytes () - bytes) / (double) (1 << 20), time));
   STOP (parse);
   return err;
 }
@@ -23,6 +23,7 @@ class Parser {
   const char * parse_string (const char * str, char prev);
   const char * parse_positive_int (int & ch, int & res, const char * name);
   const char * parse_lit (int & ch, int & lit, const int vars);
+  bool parse_lit_fast (int & lit, const int vars);
   const char * parse_dimacs_non_profiled ();
   const char * parse_solution_non_profiled ();
 
@@ -0,0 +1,95 @@
+#ifndef QUIET
+
+#include "internal.hpp"
+
+/*------------------------------------------------------------------------*/
+
+#ifdef __linux__
+extern "C" {
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+};
+#endif
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+#ifdef __linux__
+
+static int
+open_counter (Internal * internal, const char * name,
+              unsigned long config, int group) {
+  struct perf_event_attr attr;
+  memset (&attr, 0, sizeof attr);
+  attr.type = PERF_TYPE_HARDWARE;
+  attr.size = sizeof attr;
+  attr.config = config;
+  attr.disabled = (group < 0);
+  attr.exclude_kernel = 1;
+  attr.exclude_hv = 1;
+  attr.read_format = PERF_FORMAT_GROUP;
+  int res = syscall (__NR_perf_event_open, &attr, 0, -1, group, 0);
+  if (res < 0) MSG ("hardware counter '%s' not available", name);
+  else MSG ("measuring hardware counter '%s'", name);
+  return res;
+}
+
+#endif
+
+// Open all counters in one group with the first available counter as group
+// leader.  Counters which can not be opened are ignored.
+
+Perf::Perf (Internal * i) : internal (i), leader (-1), opened (0) {
+  for (int j = 0; j < size; j++) fds[j] = index[j] = -1;
+#ifdef __linux__
+#define COUNTER(NAME,EVENT) \
+  do { \
+    int fd = open_counter (internal, #NAME, \
+                           PERF_COUNT_HW_ ## EVENT, leader); \
+    if (fd < 0) break; \
+    if (leader < 0) leader = fd; \
+    fds[NAME] = fd; \
+    index[NAME] = opened++; \
+  } while (0);
+  COUNTERS
+#undef COUNTER
+  if (leader >= 0) {
+    ioctl (leader, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl (leader, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+#endif
+  if (!opened)
+    MSG ("no hardware counters (falling back to time only profiling)");
+}
+
+Perf::~Perf () {
+#ifdef __linux__
+  for (int j = 0; j < size; j++)
+    if (fds[j] >= 0) close (fds[j]);
+#endif
+}
+
+bool Perf::read (Counters & c) {
+#ifdef __linux__
+  if (leader < 0) return false;
+  uint64_t buffer[1 + size];
+  const ssize_t bytes = ::read (leader, buffer, sizeof buffer);
+  if (bytes != (ssize_t) ((1 + opened) * sizeof (uint64_t))) return false;
+  if (buffer[0] != (uint64_t) opened) return false;
+#define COUNTER(NAME,EVENT) \
+  if (index[NAME] >= 0) c.NAME = buffer[1 + index[NAME]];
+  COUNTERS
+#undef COUNTER
+  return true;
+#else
+  (void) c;
+  return false;
+#endif
+}
+
+};
+
+#endif // ifndef QUIET
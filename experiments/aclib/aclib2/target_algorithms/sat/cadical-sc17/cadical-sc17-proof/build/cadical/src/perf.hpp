@@ -0,0 +1,89 @@
+#ifndef QUIET
+#ifndef _perf_hpp_INCLUDED
+#define _perf_hpp_INCLUDED
+
+#include <cstdint>
+
+namespace CaDiCaL {
+
+class Internal;
+
+/*------------------------------------------------------------------------*/
+
+// With '--perf' the built in profiling (see 'profile.hpp') additionally
+// measures hardware counters for each profiled phase, in order to see for
+// instance whether 'propagate' is memory bound (many cache misses) or
+// whether inprocessing is compute bound (many instructions per cycle).
+// The counters are read through the Linux 'perf_event_open' system call.
+// If that is not available (other operating systems, no hardware counters
+// in virtual machines, or restricted by '/proc/sys/kernel/perf_event_paranoid')
+// only time is measured as without '--perf'.  Since reading the counters
+// needs a system call, the overhead of '--perf' is similar to the overhead
+// of calling 'getrusage' in 'process_time', which means that it is only
+// cheap for the lower profiling levels.
+
+#define COUNTERS \
+COUNTER(cycles,       CPU_CYCLES) \
+COUNTER(instructions, INSTRUCTIONS) \
+COUNTER(cachemisses,  CACHE_MISSES) \
+COUNTER(branchmisses, BRANCH_MISSES) \
+
+struct Counters {
+#define COUNTER(NAME,EVENT) \
+  uint64_t NAME;
+  COUNTERS
+#undef COUNTER
+
+  Counters () {
+#define COUNTER(NAME,EVENT) \
+    NAME = 0;
+    COUNTERS
+#undef COUNTER
+  }
+
+  // Add the difference 'end - start' to these counters.
+  //
+  void add (const Counters & start, const Counters & end) {
+#define COUNTER(NAME,EVENT) \
+    NAME += end.NAME - start.NAME;
+    COUNTERS
+#undef COUNTER
+  }
+};
+
+/*------------------------------------------------------------------------*/
+
+class Perf {
+
+  Internal * internal;
+
+  enum {
+#define COUNTER(NAME,EVENT) \
+    NAME,
+    COUNTERS
+#undef COUNTER
+    size
+  };
+
+  int leader;           // file descriptor of group leader (or -1)
+  int fds[size];        // file descriptors of counters (or -1)
+  int index[size];      // position in group read (or -1 if not available)
+  int opened;           // number of opened counters
+
+public:
+
+  Perf (Internal *);
+  ~Perf ();
+
+  bool available () const { return opened > 0; }
+
+  // Read all counters of the group at once (single system call).  Returns
+  // 'false' if the counters are not available or reading them failed.
+  //
+  bool read (Counters &);
+};
+
+};
+
+#endif // ifndef _perf_hpp_INCLUDED
+#endif // ifndef QUIET
@@ -0,0 +1,168 @@
+#ifndef NTHREADS
+
+#include "internal.hpp"
+
+/*------------------------------------------------------------------------*/
+
+#include <thread>
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+// Workers use the options of the master but with one of the following
+// modifications.  If there are more workers than entries in this table,
+// then additionally random initial phases with different seeds are used.
+
+static const char * diversification[] = {
+  "--phase=0",
+  "--no-elim",
+  "--restartint=50",
+  "--no-rephase",
+  "--no-probe",
+  "--reduceinit=5000",
+  "--no-vivify",
+  "--no-subsume",
+};
+
+static const int ndiversification =
+  sizeof diversification / sizeof *diversification;
+
+void Portfolio::diversify (Internal * worker, int id) {
+  assert (id > 0);
+  Internal * internal = master->internal;
+#define OPTION(N,T,V,L,H,D) \
+  worker->opts.N = internal->opts.N;
+  OPTIONS
+#undef OPTION
+  const char * arg = diversification[(id - 1) % ndiversification];
+  worker->opts.set (arg);
+  worker->opts.seed = (id - 1) / ndiversification;
+  worker->opts.check = false;
+  worker->opts.profile = 0;
+#ifndef QUIET
+  worker->opts.quiet = true;
+#endif
+  VRB ("portfolio", "worker %d uses '%s' and seed %d",
+    id, arg, worker->opts.seed);
+}
+
+// Workers get the current formula of the master, i.e., its root level
+// units and irredundant clauses, as original clauses in terms of external
+// literals.  All fixed external variables have to be considered, since
+// 'compact' maps all of them to the same internal variable.  Variables
+// eliminated or substituted by the master are unconstrained in the worker,
+// but the worker gets a copy of the extension stack to fix them up.
+
+void Portfolio::copy_formula (External * dst) {
+  Internal * internal = master->internal;
+  assert (!internal->level);
+  dst->init (master->max_var);
+  for (int eidx = 1; eidx <= master->max_var; eidx++) {
+    const int ilit = master->e2i[eidx];
+    if (!ilit) continue;
+    const int tmp = internal->fixed (ilit);
+    if (!tmp) continue;
+    dst->add (tmp < 0 ? -eidx : eidx);
+    dst->add (0);
+  }
+  const const_clause_iterator end = internal->clauses.end ();
+  for (const_clause_iterator i = internal->clauses.begin (); i != end; i++) {
+    const Clause * c = *i;
+    if (c->garbage || c->redundant) continue;
+    const const_literal_iterator eoc = c->end ();
+    for (const_literal_iterator j = c->begin (); j != eoc; j++)
+      dst->add (internal->externalize (*j));
+    dst->add (0);
+  }
+  dst->extension = master->extension;
+  dst->frozentab = master->frozentab;
+}
+
+/*------------------------------------------------------------------------*/
+
+Portfolio::Portfolio (External * e) :
+  master (e), terminated (false), winner (-1), result (0)
+{
+  Internal * internal = master->internal;
+  const int threads = internal->opts.threads;
+  assert (threads > 1);
+  START (share);
+  const size_t capacity = (size_t) 1 << internal->opts.sharering;
+  for (int id = 0; id < threads; id++) rings.push_back (new Ring (capacity));
+  internals.push_back (internal);
+  externals.push_back (master);
+  for (int id = 1; id < threads; id++) {
+    Internal * worker = new Internal ();
+    External * external = new External (worker);
+    diversify (worker, id);
+    copy_formula (external);
+    internals.push_back (worker);
+    externals.push_back (external);
+  }
+  for (int id = 0; id < threads; id++) {
+    Share * share = new Share (id, rings, terminated);
+    internals[id]->share = share;
+    shares.push_back (share);
+  }
+  STOP (share);
+  MSG ("portfolio of %d threads with %ld KB rings",
+    threads, (long) (capacity * sizeof (int) >> 10));
+}
+
+Portfolio::~Portfolio () {
+  master->internal->share = 0;
+  for (size_t id = 1; id < internals.size (); id++) {
+    delete externals[id];
+    delete internals[id];
+  }
+  for (size_t id = 0; id < shares.size (); id++) delete shares[id];
+  for (size_t id = 0; id < rings.size (); id++) delete rings[id];
+}
+
+/*------------------------------------------------------------------------*/
+
+void Portfolio::run (int id) {
+  const int res = internals[id]->solve ();
+  if (!res) return;
+  if (terminated.exchange (true)) return;
+  winner = id;
+  result = res;
+}
+
+// The master runs in the calling thread, the workers in their own threads.
+// If a worker wins with a satisfying assignment, then it is extended by the
+// worker and copied to the master.
+
+int Portfolio::solve () {
+  vector<thread> workers;
+  for (size_t id = 1; id < internals.size (); id++)
+    workers.push_back (thread (&Portfolio::run, this, (int) id));
+  run (0);
+  terminated = true;
+  for (size_t i = 0; i < workers.size (); i++) workers[i].join ();
+  Internal * internal = master->internal;
+  if (winner < 0) MSG ("portfolio without result");
+  else MSG ("portfolio thread %d won with result %d after %ld conflicts",
+         winner, result, internals[winner]->stats.conflicts);
+  if (result == 10) {
+    if (winner) {
+      External * external = externals[winner];
+      external->extend ();
+      for (int eidx = 1; eidx <= master->max_var; eidx++)
+        master->vals[eidx] = external->vals[eidx];
+    } else master->extend ();
+  }
+  return result;
+}
+
+/*------------------------------------------------------------------------*/
+
+int External::portfolio () {
+  Portfolio portfolio (this);
+  return portfolio.solve ();
+}
+
+};
+
+#endif // ifndef NTHREADS
@@ -0,0 +1,57 @@
+#ifndef _portfolio_hpp_INCLUDED
+#define _portfolio_hpp_INCLUDED
+
+#ifndef NTHREADS
+
+#include <atomic>
+#include <vector>
+
+namespace CaDiCaL {
+
+using namespace std;
+
+class External;
+class Internal;
+class Ring;
+struct Share;
+
+/*------------------------------------------------------------------------*/
+
+// Portfolio mode ('--threads=<n>' with 'n > 1').  The solver of the user
+// (the 'master') and 'n - 1' additional solver instances (the 'workers')
+// run on copies of the same formula in parallel threads with diversified
+// options.  They share units and short low glue learned clauses through
+// lock-free rings (see 'share.hpp').  The first thread which determines
+// satisfiability or unsatisfiability wins and terminates the others.
+
+class Portfolio {
+
+  External * master;
+
+  vector<Internal *> internals; // all threads, master at index '0'
+  vector<External *> externals; // same for 'External'
+  vector<Ring *> rings;         // one export ring per thread
+  vector<Share *> shares;       // one sharing context per thread
+
+  atomic<bool> terminated;      // set by the first thread with a result
+
+  int winner;                   // index of the winning thread
+  int result;                   // its result (10 or 20)
+
+  void diversify (Internal *, int id);
+  void copy_formula (External * dst);
+  void run (int id);
+
+public:
+
+  Portfolio (External *);
+  ~Portfolio ();
+
+  int solve ();
+};
+
+};
+
+#endif // ifndef NTHREADS
+
+#endif
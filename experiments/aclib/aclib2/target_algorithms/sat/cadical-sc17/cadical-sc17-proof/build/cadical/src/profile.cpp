@@ -16,9 +16,15 @@ Profiles::Profiles (Internal * s)
 {
 }
 
+// Hardware counters are only opened if '--perf' is set before the first
+// phase is profiled, since otherwise already running timers would miss
+// their starting counter values.
+
 void Internal::start_profiling (Profile * p, double s) {
   assert (p->level <= opts.profile);
+  if (opts.perf && !perf && timers.empty ()) perf = new Perf (this);
   timers.push_back (Timer (s, p));
+  if (perf) perf->read (timers.back ().counters);
 }
 
 void Internal::stop_profiling (Profile * p, double s) {
@@ -26,14 +32,18 @@ void Internal::stop_profiling (Profile * p, double s) {
   assert (!timers.empty ());
   Timer & t = timers.back ();
   assert (p == t.profile), (void) p;
-  t.update (s);
+  Counters c;
+  if (perf && perf->read (c)) t.update (s, c);
+  else t.update (s);
   timers.pop_back ();
 }
 
 void Internal::update_all_timers (double now) {
   const vector<Timer>::iterator end = timers.end ();
   vector<Timer>::iterator i = timers.begin ();
-  while (i != end) (*i++).update (now);
+  Counters c;
+  if (perf && perf->read (c)) while (i != end) (*i++).update (now, c);
+  else while (i != end) (*i++).update (now);
 }
 
 void Internal::print_profile (double now) {
@@ -52,17 +62,55 @@ void Internal::print_profile (double now) {
   // is also called during catching a signal after out of heap memory.
   // This only makes sense if 'profs' is allocated on the stack, and
   // not the heap, which should be the case.
+  const bool counters = perf && perf->available ();
+  if (counters)
+    MSG ("%12s %8s %7s %9s %9s %s",
+      "seconds", "time", "IPC", "CM/kI", "BM/kI", "phase");
   for (size_t i = 0; i < n; i++) {
     for (size_t j = i + 1; j < n; j++)
       if (profs[j]->value > profs[i]->value)
         swap (profs[i], profs[j]);
-    MSG ("%12.2f %7.2f%% %s",
-      profs[i]->value, percent (profs[i]->value, now), profs[i]->name);
+    const Profile * p = profs[i];
+    if (counters) {
+      const double ki = p->counters.instructions / 1e3;
+      MSG ("%12.2f %7.2f%% %7.2f %9.2f %9.2f %s",
+        p->value, percent (p->value, now),
+        relative (p->counters.instructions, p->counters.cycles),
+        relative (p->counters.cachemisses, ki),
+        relative (p->counters.branchmisses, ki),
+        p->name);
+    } else
+      MSG ("%12.2f %7.2f%% %s", p->value, percent (p->value, now), p->name);
   }
   MSG ("  ===============================");
   MSG ("%12.2f %7.2f%% all", now, 100.0);
 }
 
+// Profiled phases as JSON object (only those enabled by '--profile').
+
+void Internal::json_profile (JSON & json) {
+  update_all_timers (process_time ());
+  json.begin ("profile");
+  json.add ("level", (long) opts.profile);
+  json.add ("perf", (perf && perf->available ()) ? "yes" : "no");
+#define PROFILE(NAME,LEVEL) \
+  if (LEVEL <= opts.profile) { \
+    const Profile & p = profiles.NAME; \
+    json.begin (#NAME); \
+    json.add ("time", p.value); \
+    if (perf && perf->available ()) { \
+      json.add ("cycles", (long) p.counters.cycles); \
+      json.add ("instructions", (long) p.counters.instructions); \
+      json.add ("cachemisses", (long) p.counters.cachemisses); \
+      json.add ("branchmisses", (long) p.counters.branchmisses); \
+    } \
+    json.end (); \
+  }
+  PROFILES
+#undef PROFILE
+  json.end ();
+}
+
 };
 
 #endif // ifndef QUIET
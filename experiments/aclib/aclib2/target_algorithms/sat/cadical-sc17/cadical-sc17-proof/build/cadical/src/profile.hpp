@@ -26,6 +26,8 @@ class Internal;
 //
 // To profile say 'foo', just add another line 'PROFILE(foo)' and wrap
 // the code to be profiled within a 'START (foo)' / 'STOP (foo)' block.
+//
+// With '--perf' also hardware counters are accumulated (see 'perf.hpp').
 
 /*------------------------------------------------------------------------*/
 
@@ -51,7 +53,9 @@ PROFILE(deduplicate,2) \
 PROFILE(propagate,4) \
 PROFILE(reduce,2) \
 PROFILE(restart,3) \
+PROFILE(restore,2) \
 PROFILE(search,1) \
+PROFILE(share,2) \
 PROFILE(simplify,1) \
 PROFILE(subsume,2) \
 PROFILE(transred,2) \
@@ -64,6 +68,7 @@ PROFILE(vivify,2) \
 struct Profile {
 
   double value;      // accumulated time
+  Counters counters; // accumulated hardware counters (with '--perf')
   const char * name; // name of the profiled function (or 'phase')
   const int level;   // allows to cheaply test if profiling is enabled
 
@@ -77,12 +82,19 @@ struct Profile {
 struct Timer {
 
   double started;       // starting time (in seconds) for this phase
+  Counters counters;    // hardware counters when started (with '--perf')
   Profile * profile;    // update this profile if phase stops
 
   Timer (double s, Profile * p) : started (s), profile (p) { }
   Timer () { }
 
   void update (double now) { profile->value += now - started; started = now; }
+
+  void update (double now, const Counters & c) {
+    update (now);
+    profile->counters.add (counters, c);
+    counters = c;
+  }
 };
 
 /*------------------------------------------------------------------------*/
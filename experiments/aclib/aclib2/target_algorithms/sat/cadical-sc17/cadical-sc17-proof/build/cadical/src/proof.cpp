@@ -1,5 +1,14 @@
 #include "internal.hpp"
 
+/*------------------------------------------------------------------------*/
+
+#ifndef NTHREADS
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#endif
+
 namespace CaDiCaL {
 
 using namespace std;
@@ -24,92 +33,235 @@ void Internal::close_proof () {
 
 /*------------------------------------------------------------------------*/
 
+#ifndef NTHREADS
+
+// The background writer thread takes full buffers from the search thread
+// and writes them in order to the proof file.  Empty buffers are recycled.
+// At most 'max_buffers' buffers are allocated.  If the writer can not keep
+// up, the search thread waits until a buffer was written, which bounds the
+// amount of memory used for buffering.
+
+struct Writer {
+
+  File * file;
+
+  mutex lock;
+  condition_variable written;           // signalled by the writer
+  condition_variable filled;            // signalled by the search thread
+
+  deque<vector<char> *> full;           // buffers waiting to be written
+  vector<vector<char> *> empty;         // recycled buffers
+  size_t allocated;                     // buffers allocated in total
+  bool done;                            // no more buffers coming
+
+  long buffers;                         // number of written buffers
+  long waits;                           // search thread had to wait
+
+  thread worker;
+
+  enum { max_buffers = 4 };
+
+  Writer (File * f) :
+    file (f), allocated (1), done (false), buffers (0), waits (0),
+    worker (&Writer::run, this)
+  { }
+
+  ~Writer () {
+    for (size_t i = 0; i < empty.size (); i++) delete empty[i];
+  }
+
+  void run () {
+    unique_lock<mutex> guard (lock);
+    for (;;) {
+      while (full.empty () && !done) filled.wait (guard);
+      if (full.empty ()) break;
+      vector<char> * buffer = full.front ();
+      guard.unlock ();
+      file->put (buffer->data (), buffer->size ());
+      buffer->clear ();
+      guard.lock ();
+      full.pop_front ();
+      empty.push_back (buffer);
+      buffers++;
+      written.notify_one ();
+    }
+  }
+
+  // Hand over a full buffer and get back an empty one.
+
+  vector<char> * swap (vector<char> * buffer) {
+    unique_lock<mutex> guard (lock);
+    full.push_back (buffer);
+    filled.notify_one ();
+    vector<char> * res;
+    if (empty.empty () && allocated < max_buffers) {
+      res = new vector<char> (), allocated++;
+      res->reserve (buffer->capacity ());
+    } else {
+      if (empty.empty ()) waits++;
+      while (empty.empty ()) written.wait (guard);
+      res = empty.back ();
+      empty.pop_back ();
+    }
+    return res;
+  }
+
+  void finish () {
+    {
+      lock_guard<mutex> guard (lock);
+      done = true;
+      filled.notify_one ();
+    }
+    worker.join ();
+  }
+};
+
+#endif
+
+/*------------------------------------------------------------------------*/
+
 Proof::Proof (Internal * s, File * f, bool b, bool o)
 :
-  internal (s), file (f), binary (b), owned (o)
+  internal (s), file (f), binary (b), owned (o), writer (0)
 {
+  limit = (size_t) 1 << internal->opts.proofbuffer;
+  buffer = new vector<char> ();
+  buffer->reserve (limit + (1 << 10));
+#ifndef NTHREADS
+  if (internal->opts.proofasync) {
+    MSG ("writing proof '%s' in background thread", file->name ());
+    writer = new Writer (file);
+  }
+#endif
 }
 
-Proof::~Proof () { if (owned) delete file; }
+Proof::~Proof () {
+  flush ();
+#ifndef NTHREADS
+  if (writer) {
+    writer->finish ();
+    MSG ("proof writer wrote %ld buffers (search waited %ld times)",
+      writer->buffers, writer->waits);
+    delete writer;
+  }
+#endif
+  delete buffer;
+  if (owned) delete file;
+}
+
+// Write out all buffered proof lines (either directly or by handing the
+// buffer over to the background writer).
+
+void Proof::flush () {
+  if (buffer->empty ()) return;
+#ifndef NTHREADS
+  if (writer) { buffer = writer->swap (buffer); return; }
+#endif
+  file->put (buffer->data (), buffer->size ());
+  buffer->clear ();
+}
 
 /*------------------------------------------------------------------------*/
 
+// Same as 'File::put (int)' but into the buffer.
+
+void Proof::put (int lit) {
+  if (!lit) put ('0');
+  else if (lit == INT_MIN) put ("-2147483648");
+  else {
+    char tmp[11];
+    int i = sizeof tmp;
+    tmp[--i] = 0;
+    unsigned idx = abs (lit);
+    while (idx) {
+      assert (i > 0);
+      tmp[--i] = '0' + idx % 10;
+      idx /= 10;
+    }
+    if (lit < 0) put ('-');
+    put (tmp + i);
+  }
+}
+
 // Support for binary DRAT format.
 
 inline void Proof::put_binary_zero () {
   assert (binary);
-  assert (file);
-  file->put ((unsigned char) 0);
+  put ((char) 0);
 }
 
 inline void Proof::put_binary_lit (int lit) {
   assert (binary);
-  assert (file);
   assert (lit != INT_MIN);
   unsigned x = 2*abs (lit) + (lit < 0);
-  unsigned char ch;
+  char ch;
   while (x & ~0x7f) {
     ch = (x & 0x7f) | 0x80;
-    file->put (ch);
+    put (ch);
     x >>= 7;
   }
   ch = x;
-  file->put (ch);
+  put (ch);
 }
 
 /*------------------------------------------------------------------------*/
 
 void Proof::trace_empty_clause () {
   LOG ("tracing empty clause");
-  if (binary) file->put ('a'), put_binary_zero ();
-  else file->put ("0\n");
+  if (binary) put ('a'), put_binary_zero ();
+  else put ("0\n");
+  traced ();
 }
 
 void Proof::trace_unit_clause (int unit) {
   LOG ("tracing unit clause %d", unit);
   const int elit = externalize (unit);
-  if (binary) file->put ('a'), put_binary_lit (elit), put_binary_zero ();
-  else file->put (elit), file->put (" 0\n");
+  if (binary) put ('a'), put_binary_lit (elit), put_binary_zero ();
+  else put (elit), put (" 0\n");
+  traced ();
 }
 
 /*------------------------------------------------------------------------*/
 
 inline void Proof::trace_clause (Clause * c, bool add) {
-  if (binary) file->put (add ? 'a' : 'd');
-  else if (!add) file->put ("d ");
+  if (binary) put (add ? 'a' : 'd');
+  else if (!add) put ("d ");
   const const_literal_iterator end = c->end ();
   const_literal_iterator i = c->begin ();
   while (i != end) {
     const int elit = externalize (*i++);
     if (binary) put_binary_lit (elit);
-    else file->put (elit), file->put (" ");
+    else put (elit), put (" ");
   }
   if (binary) put_binary_zero ();
-  else file->put ("0\n");
+  else put ("0\n");
 }
 
 void Proof::trace_add_clause (Clause * c) {
   LOG (c, "tracing addition");
   trace_clause (c, true);
+  traced ();
 }
 
 void Proof::trace_delete_clause (Clause * c) {
   LOG (c, "tracing deletion");
   trace_clause (c, false);
+  traced ();
 }
 
 void Proof::trace_add_clause () {
   LOG (internal->clause, "tracing addition");
-  if (binary) file->put ('a');
+  if (binary) put ('a');
   const const_int_iterator end = internal->clause.end ();
   const_int_iterator i = internal->clause.begin ();
   while (i != end) {
     const int elit = externalize (*i++);
     if (binary) put_binary_lit (elit);
-    else file->put (elit), file->put (" ");
+    else put (elit), put (" ");
   }
   if (binary) put_binary_zero ();
-  else file->put ("0\n");
+  else put ("0\n");
+  traced ();
 }
 
 /*------------------------------------------------------------------------*/
@@ -120,18 +272,19 @@ void Proof::trace_add_clause () {
 
 void Proof::trace_flushing_clause (Clause * c) {
   LOG (c, "tracing flushing fixed");
-  if (binary) file->put ('a');
+  if (binary) put ('a');
   const const_literal_iterator end = c->end ();
   for (const_literal_iterator i = c->begin (); i != end; i++) {
     const int ilit = *i;
     if (internal->fixed (ilit) < 0) continue;
     const int elit = externalize (ilit);
     if (binary) put_binary_lit (elit);
-    else file->put (elit), file->put (" ");
+    else put (elit), put (" ");
   }
   if (binary) put_binary_zero ();
-  else file->put ("0\n");
+  else put ("0\n");
   trace_clause (c, false);
+  traced ();
 }
 
 // While strengthening clauses, e.g., through self-subsuming resolutions,
@@ -142,18 +295,19 @@ void Proof::trace_flushing_clause (Clause * c) {
 
 void Proof::trace_strengthen_clause (Clause * c, int remove) {
   LOG (c, "tracing strengthen %d in", remove);
-  if (binary) file->put ('a');
+  if (binary) put ('a');
   const const_literal_iterator end = c->end ();
   for (const_literal_iterator i = c->begin (); i != end; i++) {
     const int ilit = *i;
     if (ilit == remove) continue;
     const int elit = externalize (ilit);
     if (binary) put_binary_lit (elit);
-    else file->put (elit), file->put (" ");
+    else put (elit), put (" ");
   }
   if (binary) put_binary_zero ();
-  else file->put ("0\n");
+  else put ("0\n");
   trace_clause (c, false);
+  traced ();
 }
 
 };
@@ -1,13 +1,26 @@
 #ifndef _proof_h_INCLUDED
 #define _proof_h_INCLUDED
 
+#include <vector>
+
 namespace CaDiCaL {
 
+using namespace std;
+
 // Provides proof tracing in the DRAT format.
 
+// Proof lines are not written to the file directly but collected in a
+// buffer.  After a complete proof line was added and the buffer reached
+// 'opts.proofbuffer' bytes the buffer is written, by default in the
+// background by a writer thread (see 'Writer' in 'proof.cpp'), which
+// keeps the search thread from blocking on IO or compression.  Since
+// buffers only contain complete lines and are written in order, the
+// produced byte stream is exactly the same as with unbuffered writing.
+
 class File;
 class Clause;
 class Internal;
+struct Writer;
 
 class Proof {
 
@@ -17,9 +30,20 @@ class Proof {
   bool binary;
   bool owned;
 
+  vector<char> * buffer;        // proof lines not written yet
+  size_t limit;                 // flush buffer if it reaches this size
+  Writer * writer;              // background writer thread if non zero
+
+  void put (char ch) { buffer->push_back (ch); }
+  void put (const char * s) { while (*s) put (*s++); }
+  void put (int lit);
+
   void put_binary_zero ();
   void put_binary_lit (int lit);
 
+  void flush ();
+  void traced () { if (buffer->size () >= limit) flush (); }
+
   void trace_clause (Clause *, bool add);
 
   int externalize (int lit);
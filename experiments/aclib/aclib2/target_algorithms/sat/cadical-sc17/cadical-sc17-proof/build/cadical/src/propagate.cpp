@@ -81,7 +81,10 @@ void Internal::assign_driving (int lit, Clause * c) {
 // to reduce the number of times clauses have to be visited (2008 JSAT paper
 // by Chu, Harwood and Stuckey).  The watches know if a watched clause is
 // binary, in which case it never has to be visited.  If a binary clause is
-// falsified we continue propagating.
+// falsified we continue propagating.  The other literal of a binary clause
+// is kept in the watch as blocking literal and garbage binary clauses are
+// only watched if 'watched_garbage' is set (otherwise their watches are
+// flushed eagerly), so binary watches do not access the clause at all.
 
 // Finally, for long clauses we save the position of the last watch
 // replacement in 'pos', which in turn reduces certain quadratic accumulated
@@ -100,6 +103,12 @@ bool Internal::propagate () {
   //
   long before = propagated;
 
+  // Only check for garbage binary clauses if they might still be watched
+  // (inprocessors might mark binary clauses as garbage without flushing
+  // their watches, e.g., 'vivify', which also uses this function).
+  //
+  const bool check_garbage = watched_garbage;
+
   while (!conflict && propagated < trail.size ()) {
 
     const int lit = -trail[propagated++];
@@ -118,7 +127,8 @@ bool Internal::propagate () {
 
       if (w.binary) {
 
-        if (w.clause->garbage) continue;
+        if (check_garbage && w.clause->garbage) continue;
+        assert (!w.clause->garbage);
         assert (!w.clause->ignore);
 
         // Binary clauses are treated separately since they do not require
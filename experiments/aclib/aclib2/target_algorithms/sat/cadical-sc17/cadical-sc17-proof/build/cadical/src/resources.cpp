@@ -1,11 +1,8 @@
-#ifndef QUIET
-
 #include "internal.hpp"
 
 // This is pretty Linux specific code for reporting resource, that is
-// time and memory usage and if you can not compile it then just disable
-// it by specifying 'quiet', which disables all messages include resource
-// usage messages, e.g., with 'configure.sh -q'.
+// time and memory usage.  It is also used for enforcing the wall-clock
+// time and memory limits ('tlim' and 'mlim') and thus always included.
 
 extern "C" {
 #include <sys/time.h>
@@ -19,6 +16,15 @@ namespace CaDiCaL {
 
 // TODO: port these functions to different OS.
 
+// Wall-clock time since the epoch, which is only meaningful relative to
+// another call to this function.
+
+double absolute_real_time () {
+  struct timeval tv;
+  if (gettimeofday (&tv, 0)) return 0;
+  return 1e-6 * tv.tv_usec + tv.tv_sec;
+}
+
 // We use 'getrusage' for the next two functions, which is pretty standard
 // on Unix but probably not available on Windows etc. For different variants
 // of Unix not all fields are meaningful (or even existing).
@@ -59,5 +65,3 @@ size_t current_resident_set_size () {
 }
 
 };
-
-#endif // ifndef QUIET
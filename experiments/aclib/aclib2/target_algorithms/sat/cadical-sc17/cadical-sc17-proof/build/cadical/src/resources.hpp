@@ -1,11 +1,13 @@
-#ifndef QUIET
 #ifndef _resources_hpp_INCLUDED
 #define _resources_hpp_INCLUDED
 
+#include <cstdlib>
+
 namespace CaDiCaL {
 
 // low-level time and memory usage functions
 
+double absolute_real_time ();
 double process_time ();
 size_t maximum_resident_set_size ();
 size_t current_resident_set_size ();
@@ -13,4 +15,3 @@ size_t current_resident_set_size ();
 };
 
 #endif // ifndef _resources_hpp_INCLUDED
-#endif // ifndef QUIET
@@ -38,7 +38,7 @@ void Internal::restart () {
   START (restart);
   stats.restarts++;
   LOG ("restart %ld", stats.restarts);
-  backtrack (reuse_trail ());
+  backtrack (importing () ? 0 : reuse_trail ());
   lim.restart = stats.conflicts + opts.restartint;
   report ('R', 2);
   STOP (restart);
@@ -0,0 +1,112 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+// In incremental usage eliminated or substituted variables might show up
+// again in new clauses or assumptions.  Their clauses have been removed
+// from the internal solver but have been saved on the extension stack.  An
+// external variable which is used again is 'tainted'.  Its internal
+// variable is reactivated (or a new internal variable is allocated if the
+// old one was removed by 'compact') and before the next 'solve' all the
+// clauses on the extension stack with a tainted pivot are added back as
+// irredundant clauses and removed from the extension stack.
+
+// Note that restored clauses are added without proof tracing, since we do
+// not know how to produce DRAT proofs for this situation yet.
+
+bool External::inactive (int eidx) const {
+  assert (0 < eidx), assert (eidx <= max_var);
+  const int ilit = e2i[eidx];
+  if (!ilit) return true;                       // removed by 'compact'
+  const Flags & f = internal->flags (ilit);
+  return f.eliminated () || f.substituted ();
+}
+
+void External::taint (int eidx) {
+  assert (inactive (eidx));
+  int ilit = e2i[eidx];
+  if (ilit) internal->reactivate (ilit);
+  else {
+    ilit = internal->max_var + 1;
+    internal->init (ilit);
+    e2i[eidx] = ilit;
+    internal->i2e[ilit] = eidx;
+    LOG ("remapping external %d to new internal %d", eidx, ilit);
+  }
+  if ((size_t) eidx >= taintedtab.size ()) taintedtab.resize (vsize, false);
+  taintedtab[eidx] = true;
+  tainted = true;
+  LOG ("tainted external %d", eidx);
+}
+
+// Clauses on the extension stack are stored as a zero, followed by the
+// pivot (witness) literal and then the rest of the clause.  A clause saved
+// when eliminating 'x' only contains variables which were still active at
+// that point and thus any inactive variable in it was eliminated (or
+// substituted) later, i.e., its clauses occur later on the extension stack.
+// Therefore a single forward pass suffices, if we taint those inactive
+// variables of restored clauses too.
+
+void External::restore_clauses () {
+
+  assert (tainted);
+  assert (!internal->level);
+
+  START (restore);
+
+  long restored = 0;
+
+  const const_int_iterator end = extension.end ();
+  int_iterator j = extension.begin ();
+  const_int_iterator i = j;
+
+  while (i != end) {
+    assert (!*i);
+    const_int_iterator start = i++;
+    assert (i != end);
+    const int pivot = *i;
+    const_int_iterator stop = i + 1;
+    while (stop != end && *stop) stop++;
+    const size_t pidx = abs (pivot);
+    if (pidx < taintedtab.size () && taintedtab[pidx]) {
+      for (const_int_iterator k = i; k != stop; k++) {
+        const int elit = *k, eidx = abs (elit);
+        if (inactive (eidx)) taint (eidx);
+        internal->add_original_lit (internalize (elit));
+      }
+      internal->add_original_lit (0);
+      restored++;
+    } else {
+      while (start != stop) *j++ = *start++;
+    }
+    i = stop;
+  }
+  extension.resize (j - extension.begin ());
+
+  fill (taintedtab.begin (), taintedtab.end (), false);
+  tainted = false;
+
+  internal->stats.restored += restored;
+  VRB ("restore", "restored %ld clauses from extension stack", restored);
+
+  STOP (restore);
+}
+
+/*------------------------------------------------------------------------*/
+
+void Internal::reactivate (int lit) {
+  Flags & f = flags (lit);
+  if (f.eliminated ()) {
+    assert (stats.now.eliminated > 0);
+    stats.now.eliminated--;
+  } else {
+    assert (f.substituted ());
+    assert (stats.now.substituted > 0);
+    stats.now.substituted--;
+  }
+  f.status = Flags::ACTIVE;
+  f.removed = f.added = true;
+  LOG ("reactivated %d", abs (lit));
+}
+
+};
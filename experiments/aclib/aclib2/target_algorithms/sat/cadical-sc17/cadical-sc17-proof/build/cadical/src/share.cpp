@@ -0,0 +1,178 @@
+#include "internal.hpp"
+
+namespace CaDiCaL {
+
+/*------------------------------------------------------------------------*/
+
+Ring::Ring (size_t c) :
+  capacity (c), mask (c - 1), reserved (0), published (0)
+{
+  assert (capacity > 2), assert (!(capacity & mask));
+  data = new atomic<int>[capacity];
+  for (size_t i = 0; i < capacity; i++)
+    data[i].store (0, memory_order_relaxed);
+}
+
+Ring::~Ring () { delete [] data; }
+
+// The producer is the only thread writing 'reserved' and 'published' and
+// thus can read 'published' relaxed.  The release fence after reserving
+// guarantees that a consumer, which reads any of the new values, also sees
+// the new reserved position after its own acquire fence (see 'pull').
+
+void Ring::push (const vector<int> & lits, int glue) {
+  const size_t size = lits.size ();
+  assert (size + 2 <= capacity);
+  const size_t start = published.load (memory_order_relaxed);
+  const size_t end = start + size + 2;
+  reserved.store (end, memory_order_relaxed);
+  atomic_thread_fence (memory_order_release);
+  size_t pos = start;
+  data[pos++ & mask].store ((int) size, memory_order_relaxed);
+  data[pos++ & mask].store (glue, memory_order_relaxed);
+  const const_int_iterator eol = lits.end ();
+  for (const_int_iterator i = lits.begin (); i != eol; i++)
+    data[pos++ & mask].store (*i, memory_order_relaxed);
+  assert (pos == end);
+  published.store (end, memory_order_release);
+}
+
+// The 'cursor' always points to the start of a clause (or the published
+// position).  Values between 'cursor' and 'head' are only valid if the
+// producer has not reserved space beyond 'cursor + capacity' before we
+// finished reading them.  Otherwise we drop all values read in this round
+// and continue at 'head', which again is at the start of a clause.
+
+size_t Ring::pull (size_t & cursor, vector<int> & buffer) const {
+  const size_t head = published.load (memory_order_acquire);
+  if (cursor == head) return 0;
+  size_t dropped = head - cursor;
+  if (dropped <= capacity) {
+    const size_t before = buffer.size ();
+    for (size_t pos = cursor; pos != head; pos++)
+      buffer.push_back (data[pos & mask].load (memory_order_relaxed));
+    atomic_thread_fence (memory_order_acquire);
+    const size_t limit = reserved.load (memory_order_relaxed);
+    if (limit - cursor <= capacity) dropped = 0;
+    else buffer.resize (before);
+  }
+  cursor = head;
+  return dropped;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Units and short learned clauses with small glue are exported in terms of
+// external literals, since internal variable indices differ between the
+// solver threads (for instance due to 'compact').
+
+void Internal::export_unit (int lit) {
+  assert (share);
+  if (!opts.share || share->importing) return;
+  vector<int> & exported = share->exported;
+  assert (exported.empty ());
+  exported.push_back (externalize (lit));
+  share->ring ()->push (exported, 1);
+  exported.clear ();
+  stats.shared.exported++;
+}
+
+void Internal::export_clause (Clause * c) {
+  assert (share);
+  if (!opts.share) return;
+  if (c->size > opts.sharesize) return;
+  if (c->glue > opts.shareglue) return;
+  vector<int> & exported = share->exported;
+  assert (exported.empty ());
+  const const_literal_iterator end = c->end ();
+  for (const_literal_iterator i = c->begin (); i != end; i++)
+    exported.push_back (externalize (*i));
+  share->ring ()->push (exported, c->glue);
+  exported.clear ();
+  stats.shared.exported++;
+}
+
+/*------------------------------------------------------------------------*/
+
+// Clauses are only imported on the root level.  Instead of forcing a full
+// backtrack, which would throw away the trail every 'shareint' conflicts,
+// the search loop waits until the next restart, which then backtracks to
+// the root level instead of reusing the trail (see 'restart'), or until a
+// learned unit brings the solver back to the root level anyhow.
+
+bool Internal::importing () {
+  if (!share || !opts.share) return false;
+  return stats.conflicts >= lim.import;
+}
+
+// Imported clauses are added as redundant clauses on the root level.  An
+// exported variable might have been eliminated or substituted in this
+// solver thread (or even removed by 'compact').  Such clauses are simply
+// ignored.  Root level satisfied clauses are skipped too and root level
+// falsified literals are removed.  Remaining units are assigned and
+// propagated as usual in the main search loop.
+
+void Internal::import_shared () {
+
+  START (share);
+
+  lim.import = stats.conflicts + opts.shareint;
+
+  vector<int> & buffer = share->buffer;
+  assert (buffer.empty ());
+  for (size_t id = 0; id < share->rings.size (); id++) {
+    if ((int) id == share->id) continue;
+    Ring * ring = share->rings[id];
+    stats.shared.dropped += ring->pull (share->cursors[id], buffer);
+  }
+
+  if (!buffer.empty ()) {
+
+    assert (!level);
+    share->importing = true;
+    assert (clause.empty ());
+
+    const const_int_iterator end = buffer.end ();
+    const_int_iterator i = buffer.begin ();
+    while (!unsat && i != end) {
+      const int size = *i++;
+      const int glue = *i++;
+      const const_int_iterator eoc = i + size;
+      assert (eoc <= end);
+      bool skip = false;
+      for (; !skip && i != eoc; i++) {
+        const int elit = *i, eidx = abs (elit);
+        if (eidx > external->max_var || external->inactive (eidx)) {
+          skip = true;
+          continue;
+        }
+        const int ilit = external->internalize (elit);
+        const int tmp = fixed (ilit);
+        if (tmp > 0) skip = true;
+        else if (!tmp) clause.push_back (ilit);
+      }
+      i = eoc;
+      if (skip) { clause.clear (); continue; }
+      stats.shared.imported++;
+      if (clause.empty ()) {
+        LOG ("imported empty clause");
+        learn_empty_clause ();
+      } else if (clause.size () == 1) {
+        LOG ("imported unit clause %d", clause[0]);
+        assign_unit (clause[0]);
+      } else {
+        Clause * c = new_clause (true, glue);
+        LOG (c, "imported");
+        watch_clause (c);
+      }
+      clause.clear ();
+    }
+
+    share->importing = false;
+    buffer.clear ();
+  }
+
+  STOP (share);
+}
+
+};
@@ -0,0 +1,81 @@
+#ifndef _share_hpp_INCLUDED
+#define _share_hpp_INCLUDED
+
+#include <atomic>
+#include <vector>
+
+namespace CaDiCaL {
+
+using namespace std;
+
+/*------------------------------------------------------------------------*/
+
+// In portfolio mode (see 'portfolio.cpp') each solver thread exports units
+// and short low glue learned clauses into its own 'Ring'.  This is a
+// bounded single-producer multiple-consumer broadcast buffer without locks.
+// Every importing thread keeps its own read 'cursor' for every other ring.
+// The ring is lossy: if the producer wraps around and overwrites clauses
+// not yet read by a slow consumer, then the consumer simply drops them.
+
+// Clauses are stored as a sequence of 'int' values, first the size, then
+// the glue and then the (external) literals.  The writer first 'reserves'
+// the space, then writes the literals and finally 'publishes' them.  The
+// reader reads up to the published position and afterwards checks with
+// the reserved position that nothing it has read was overwritten in the
+// mean time (this is the same protocol as in sequence locks).
+
+class Ring {
+
+  const size_t capacity;        // power of two
+  const size_t mask;            // 'capacity - 1'
+
+  atomic<int> * data;
+
+  atomic<size_t> reserved;      // written by producer before writing
+  atomic<size_t> published;     // written by producer after writing
+
+public:
+
+  Ring (size_t capacity);
+  ~Ring ();
+
+  size_t size () const { return capacity; }
+
+  // Called by the producer only.
+  //
+  void push (const vector<int> & lits, int glue);
+
+  // Called by a consumer with its own 'cursor' for this ring.  Appends all
+  // complete and not overwritten clauses as '<size> <glue> <lits> ...' to
+  // 'buffer'.  Returns the number of dropped 'int' values.
+  //
+  size_t pull (size_t & cursor, vector<int> & buffer) const;
+};
+
+/*------------------------------------------------------------------------*/
+
+// Each 'Internal' has a 'Share' object in portfolio mode.  It gives access
+// to all the rings, the thread's own read cursors, and the global flag for
+// asynchronous termination, which is set by the first thread which
+// determines satisfiability or unsatisfiability.
+
+struct Share {
+
+  int id;                       // thread / ring index
+  vector<Ring *> & rings;       // rings of all threads
+  vector<size_t> cursors;       // read positions in other rings
+  vector<int> buffer;           // pulled but not yet imported clauses
+  vector<int> exported;         // temporary for externalized clauses
+  atomic<bool> & terminated;    // first result cancels the others
+  bool importing;               // avoid exporting imported units
+
+  Share (int i, vector<Ring *> & r, atomic<bool> & t) :
+    id (i), rings (r), cursors (r.size (), 0),
+    terminated (t), importing (false) { }
+
+  Ring * ring () { return rings[id]; }
+};
+
+};
+
+#endif
@@ -65,6 +65,8 @@ void Stats::print (Internal * internal) {
   PRT ("learned:         %15ld   %10.2f    per conflict", learned, relative (learned, stats.conflicts));
   PRT ("memory:          %15ld   %10.2f    bytes and MB", m, m/(double)(1l<<20));
   PRT ("minimized:       %15ld   %10.2f %%  of 1st-UIP-literals", stats.minimized, percent (stats.minimized, stats.learned));
+  PRT ("parsed:          %15ld   %10.2f    MB per second", stats.parse.bytes, relative (stats.parse.bytes / (double) (1 << 20), stats.parse.time));
+  PRT ("  clauses:       %15ld   %10.2f    bytes per clause", stats.parse.clauses, relative (stats.parse.bytes, stats.parse.clauses));
   PRT ("probings:        %15ld   %10.2f    conflicts per probing", stats.probings, relative (stats.conflicts, stats.probings));
   PRT ("probed:          %15ld   %10.2f    per failed", stats.probed, relative (stats.probed, stats.failed));
   PRT ("  hbrs:          %15ld   %10.2f    per probed", stats.hbrs, relative (stats.hbrs, stats.probed));
@@ -87,8 +89,13 @@ void Stats::print (Internal * internal) {
   PRT ("  elimres2:      %15ld   %10.2f %%  per resolved", stats.elimres2, percent (stats.elimres, stats.elimres));
   PRT ("  elimrestried:  %15ld   %10.2f %%  per resolved", stats.elimrestried, percent (stats.elimrestried, stats.elimres));
   PRT ("restarts:        %15ld   %10.2f    conflicts per restart", stats.restarts, relative (stats.conflicts, stats.restarts));
+  PRT ("restored:        %15ld   %10.2f    per solve", stats.restored, relative (stats.restored, stats.solves));
   PRT ("reused:          %15ld   %10.2f %%  per restart", stats.reused, percent (stats.reused, stats.restarts));
   PRT ("searched:        %15ld   %10.2f    per decision", stats.searched, relative (stats.searched, stats.decisions));
+  PRT ("shared:          %15ld   %10.2f    per conflict", stats.shared.exported, relative (stats.shared.exported, stats.conflicts));
+  PRT ("  imported:      %15ld   %10.2f    per conflict", stats.shared.imported, relative (stats.shared.imported, stats.conflicts));
+  PRT ("  dropped:       %15ld   %10.2f    per conflict", stats.shared.dropped, relative (stats.shared.dropped, stats.conflicts));
+  PRT ("solves:          %15ld   %10.2f    conflicts per solve", stats.solves, relative (stats.conflicts, stats.solves));
   PRT ("strengthened:    %15ld   %10.2f    per subsumed", stats.strengthened, relative (stats.strengthened, stats.subsumed));
   PRT ("  subirr:        %15ld   %10.2f %%  of subsumed", stats.subirr, percent (stats.subirr, stats.subsumed));
   PRT ("  subred:        %15ld   %10.2f %%  of subsumed", stats.subred, percent (stats.subred, stats.subsumed));
@@ -118,4 +125,65 @@ void Stats::print (Internal * internal) {
 
 }
 
+/*------------------------------------------------------------------------*/
+
+// In contrast to 'print' all counters are written without derived values,
+// which can easily be computed during post-processing.
+
+void Stats::json (Internal * internal, JSON & json) {
+
+  Stats & stats = internal->stats;
+
+#define JSN(NAME) json.add (#NAME, (long) stats.NAME)
+#define JSM(GROUP,NAME) json.add (#NAME, (long) stats.GROUP.NAME)
+
+  json.begin ("statistics");
+  json.add ("time", process_time ());
+  json.add ("memory", (long) maximum_resident_set_size ());
+  JSN (conflicts);
+  JSN (decisions);
+  json.begin ("propagations");
+  JSM (propagations, search);
+  JSM (propagations, probe);
+  JSM (propagations, vivify);
+  JSM (propagations, transred);
+  json.end ();
+  json.begin ("parse");
+  JSM (parse, bytes);
+  JSM (parse, clauses);
+  json.add ("time", stats.parse.time);
+  json.end ();
+  json.begin ("shared");
+  JSM (shared, exported);
+  JSM (shared, imported);
+  JSM (shared, dropped);
+  json.end ();
+  JSN (compacts); JSN (rephased); JSN (restarts); JSN (restored);
+  JSN (reused); JSN (solves); JSN (added); JSN (removed); JSN (bumped);
+  JSN (bumplast); JSN (searched); JSN (reductions); JSN (reduced);
+  JSN (collected); JSN (collections); JSN (hbrs); JSN (hbrsizes);
+  JSN (hbreds); JSN (hbrsubs); JSN (subsumed); JSN (duplicated);
+  JSN (strengthened); JSN (subirr); JSN (subred); JSN (subtried);
+  JSN (subchecks); JSN (subchecks2); JSN (subsumptions); JSN (elimres);
+  JSN (elimres2); JSN (elimrestried); JSN (eliminations);
+  JSN (decompositions); JSN (vivifications); JSN (vivifychecks);
+  JSN (vivifydecs); JSN (vivifyreused); JSN (vivifysched);
+  JSN (vivifysubs); JSN (vivifystrs); JSN (vivifyunits); JSN (transreds);
+  JSN (transitive); JSN (learned); JSN (minimized); JSN (redundant);
+  JSN (irredundant); JSN (irrbytes); JSN (original); JSN (garbage);
+  JSN (units); JSN (binaries); JSN (probings); JSN (probed); JSN (failed);
+#ifdef STATS
+  JSN (visits); JSN (traversed);
+#endif
+  json.begin ("all");
+  JSM (all, fixed);
+  JSM (all, eliminated);
+  JSM (all, substituted);
+  json.end ();
+  json.end ();
+
+#undef JSN
+#undef JSM
+}
+
 };
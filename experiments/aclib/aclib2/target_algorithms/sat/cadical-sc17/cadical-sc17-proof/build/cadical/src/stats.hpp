@@ -7,6 +7,7 @@
 namespace CaDiCaL {
 
 class Internal;
+class JSON;
 
 struct Stats {
 
@@ -25,9 +26,24 @@ struct Stats {
   long compacts;     // number of compactifications
   long rephased;     // actual number of happened rephases
   long restarts;     // actual number of happened restarts
+  long restored;     // restored clauses from extension stack
   long reused;       // number of reused trails
   long reports;      // 'report' counter
   long sections;     // 'section' counter
+  long solves;       // number of 'solve' calls
+
+  struct {
+    long bytes;      // parsed bytes (after decompression)
+    long clauses;    // parsed clauses
+    double time;     // process time spent parsing
+  } parse;
+
+  struct {
+    long exported;   // exported units and clauses (portfolio)
+    long imported;   // imported units and clauses (portfolio)
+    long dropped;    // dropped values due to ring overflow
+  } shared;
+
   long added;        // irredundant clauses
   long removed;      // literals in likely to be kept clauses
   long bumped;       // seen and bumped variables in 'analyze'
@@ -91,6 +107,7 @@ struct Stats {
   Stats ();
 
   void print (Internal *);
+  void json (Internal *, JSON &);   // raw counters (see 'Solver::json')
 };
 
 /*------------------------------------------------------------------------*/
@@ -12,6 +12,7 @@ void Internal::reset_watches () {
   assert (wtab);
   RELEASE_DELETE (wtab, Watches, 2*vsize);
   wtab = 0;
+  watched_garbage = false;
 }
 
 // This can be quite costly since lots of memory is accessed in a rather
@@ -77,6 +78,7 @@ void Internal::disconnect_watches () {
   for (int idx = 1; idx <= max_var; idx++)
     for (int sign = -1; sign <= 1; sign += 2)
       watches (sign * idx).clear ();
+  watched_garbage = false;
 }
 
 };
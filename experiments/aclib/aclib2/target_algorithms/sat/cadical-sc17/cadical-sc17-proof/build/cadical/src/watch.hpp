@@ -16,6 +16,22 @@ namespace CaDiCaL {
 // One would also need to use at least one more bit (either taken away from
 // the variable space or the clauses) to denote whether the watch is binary.
 
+// For binary clauses the blocking literal is the other literal of the
+// clause.  Thus propagating binary clauses only needs the watch and does
+// not access the clause, which is only needed as reason (see also the
+// comments before 'flush_garbage_binary_watches' in 'collect.cpp').
+
+// Binary clauses are still allocated as 'Clause' objects, and their watches
+// keep the 'clause' pointer.  A pure binary watch encoding, which only
+// stores the other literal and drops both the pointer and the allocation,
+// is not implemented.  It would need reasons in 'analyze' to become a
+// literal (or a tagged pointer), and proof tracing would need to rebuild
+// binary clauses from that literal.  All inprocessors iterating 'clauses'
+// (subsumption, elimination, probing, vivification, decomposition,
+// 'transred' and deduplication) would also need to visit watch lists to
+// find binary clauses.  With that encoding this structure would shrink
+// from 16 to 8 bytes.
+
 class Clause;
 
 struct Watch {
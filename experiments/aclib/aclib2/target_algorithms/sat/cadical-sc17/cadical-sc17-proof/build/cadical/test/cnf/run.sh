@@ -0,0 +1,39 @@
+#!/bin/sh
+
+# Runs 'cadical' on the CNFs in this directory and checks the exit code
+# (10 for satisfiable, 20 for unsatisfiable).  The binary is taken from
+# 'CADICALBUILD' (set by 'make test', relative to 'test') or from '../build'.
+
+cd `dirname $0`/..
+CADICAL=${CADICALBUILD:-../build}/cadical
+[ -x $CADICAL ] || { echo "run.sh: can not find '$CADICAL'" 1>&2; exit 1; }
+
+failed=0
+
+run () {
+  $CADICAL -q cnf/$1.cnf > cnf/$1.log 2> cnf/$1.err
+  res=$?
+  if [ $res = $2 ]
+  then
+    cat cnf/$1.cnf | $CADICAL -q > cnf/$1.log 2> cnf/$1.err
+    res=$?
+  fi
+  if [ $res = $2 ]
+  then
+    echo "$1: ok"
+    rm -f cnf/$1.log cnf/$1.err
+  else
+    echo "$1: failed (exit code $res, expected $2, see 'test/cnf/$1.log')"
+    failed=1
+  fi
+}
+
+# Each CNF is parsed from a memory mapped file and from a pipe.  The last
+# literals are zero padded, longer than what the fast literal parser reads,
+# and end the file without a new-line.  The 'zeropadsat' file fills the
+# read buffer used for pipes exactly, so its last literal ends the buffer.
+
+run zeropadsat 10
+run zeropadunsat 20
+
+exit $failed
@@ -0,0 +1,31 @@
+# - Try to find the SQLite3 include dir and library
+#
+# Usage of this module as follows:
+#
+#     find_package(SQLite3)
+#
+# Variables defined by this module:
+#
+#  SQLITE3_FOUND             System has SQLite3
+#  SQLITE3_INCLUDE_DIR       SQLite3 include directory
+#  SQLITE3_LIBRARIES         Link these to use SQLite3
+
+find_path(SQLITE3_INCLUDE_DIR sqlite3.h
+    $ENV{SQLITE3_DIR}/include
+    /usr/include
+    /usr/local/include
+    /opt/local/include
+)
+
+find_library(SQLITE3_LIBRARIES NAMES sqlite3
+    PATHS
+    $ENV{SQLITE3_DIR}/lib
+    /usr/lib
+    /usr/local/lib
+    /opt/local/lib
+)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(SQLite3 DEFAULT_MSG SQLITE3_LIBRARIES SQLITE3_INCLUDE_DIR)
+
+mark_as_advanced(SQLITE3_INCLUDE_DIR SQLITE3_LIBRARIES)
@@ -24,6 +24,7 @@
 #include "solver.h"
 #include "shareddata.h"
 #include <iomanip>
+#include <algorithm>
 
 using namespace CMSat;
 
@@ -33,7 +34,11 @@ DataSync::DataSync(Solver* _solver, SharedData* _sharedData, uint32_t _thread_nu
     , thread_num(_thread_num)
     , seen(solver->seen)
     , toClear(solver->toClear)
-{}
+{
+    if (sharedData != NULL) {
+        longCursors.resize(sharedData->long_rings.size(), 0);
+    }
+}
 
 void DataSync::new_var(bool bva)
 {
@@ -76,9 +81,15 @@ void DataSync::updateVars(
 
 bool DataSync::syncData()
 {
-    if (!enabled()
-        || lastSyncConf + solver->conf.sync_every_confl >= solver->sumConflicts()
-    ) {
+    if (!enabled())
+        return true;
+
+    //Long clauses are pulled lock-free at every restart, so that the rings
+    //need not hold all clauses learnt in 'sync_every_confl' conflicts
+    if (!syncLongFromOthers())
+        return false;
+
+    if (lastSyncConf + solver->conf.sync_every_confl >= solver->sumConflicts()) {
         //cout << "sharedData:" << sharedData << endl;
         //cout << "conf: " << solver->sumConflicts() << endl;
         //cout << "todo: " << lastSyncConf + SYNC_EVERY_CONFL << endl;
@@ -94,13 +105,18 @@ bool DataSync::syncData()
     sharedData->unit_mutex.unlock();
     if (!ok) return false;
 
-    sharedData->bin_mutex.lock();
+    //With many threads, do not wait for the binaries of others: try again
+    //at the next restart
+    if (!sharedData->bin_mutex.try_lock())
+        return true;
     extend_bins_if_needed();
     clear_set_binary_values();
     ok = shareBinData();
     sharedData->bin_mutex.unlock();
     if (!ok) return false;
 
+    printLongStats();
+
     lastSyncConf = solver->sumConflicts();
 
     return true;
@@ -347,3 +363,124 @@ void DataSync::signalNewBinClause(Lit lit1, Lit lit2)
     }
     newBinClauses.push_back(std::make_pair(lit1, lit2));
 }
+
+void DataSync::signalNewLongClause(const vector<Lit>& lits, const uint32_t glue)
+{
+    if (!enabled()
+        || glue > solver->conf.share_long_max_glue
+        || lits.size() > solver->conf.share_long_max_size
+    ) {
+        return;
+    }
+
+    longExport.clear();
+    for(Lit lit: lits) {
+        if (solver->varData[lit.var()].is_bva)
+            return;
+
+        lit = solver->map_inter_to_outer(lit);
+        lit = map_outside_without_bva(lit);
+        longExport.push_back(lit.toInt());
+    }
+
+    //We don't want to get it back from others
+    longSeenBefore(longExport.data(), longExport.size());
+
+    sharedData->long_rings[thread_num]->push(longExport, glue);
+    stats.sentLongData++;
+}
+
+//Long clauses are exchanged through the rings in syncLongFromOthers() and
+//signalNewLongClause(), only the statistics are reported with the rest
+void DataSync::printLongStats() const
+{
+    if (solver->conf.verbosity >= 2) {
+        cout
+        << "c [sync] long got " << stats.recvLongData
+        << " sent " << stats.sentLongData
+        << " dropped " << stats.droppedLongData << " words"
+        << " known: " << longHashes.size()
+        << endl;
+    }
+}
+
+bool DataSync::syncLongFromOthers()
+{
+    assert(longBuf.empty());
+    for(size_t i = 0; i < sharedData->long_rings.size(); i++) {
+        if (i == thread_num)
+            continue;
+
+        stats.droppedLongData += sharedData->long_rings[i]->pull(longCursors[i], longBuf);
+    }
+
+    size_t at = 0;
+    while(at < longBuf.size() && solver->okay()) {
+        const uint32_t size = longBuf[at];
+        const uint32_t glue = longBuf[at+1];
+        const uint32_t* lits = longBuf.data() + at + 2;
+        at += size + 2;
+        assert(at <= longBuf.size());
+
+        if (!longSeenBefore(lits, size)) {
+            addOneLongFromOthers(lits, size, glue);
+        }
+    }
+    longBuf.clear();
+
+    return solver->okay();
+}
+
+//Keyed on the sorted literals, so the order in which they were learnt
+//does not matter. A hash collision only loses a clause.
+bool DataSync::longSeenBefore(const uint32_t* lits, const uint32_t size)
+{
+    longSorted.assign(lits, lits + size);
+    std::sort(longSorted.begin(), longSorted.end());
+    uint64_t hash = size;
+    for(const uint32_t lit: longSorted) {
+        hash = hash*1000003ULL ^ lit;
+    }
+
+    if (longHashes.size() >= (1U << 20)) {
+        longHashes.clear();
+    }
+
+    return !longHashes.insert(hash).second;
+}
+
+bool DataSync::addOneLongFromOthers(
+    const uint32_t* lits
+    , const uint32_t size
+    , const uint32_t glue
+) {
+    longLits.clear();
+    for(uint32_t i = 0; i < size; i++) {
+        Lit lit = Lit::toLit(lits[i]);
+        if (lit.var() >= solver->nVarsOutside())
+            return true;
+
+        lit = solver->map_to_with_bva(lit);
+        lit = solver->varReplacer->getLitReplacedWithOuter(lit);
+        lit = solver->map_outer_to_inter(lit);
+        if (solver->varData[lit.var()].removed != Removed::none)
+            return true;
+
+        if (solver->value(lit) == l_True)
+            return true;
+
+        longLits.push_back(lit);
+    }
+
+    ClauseStats clStats;
+    clStats.glue = glue;
+
+    //Don't add DRUP: it would add to the thread data, too
+    Clause* cl = solver->addClauseInt(longLits, true, clStats, true, NULL, false);
+    if (cl != NULL) {
+        solver->longRedCls.push_back(solver->clAllocator.getOffset(cl));
+    }
+    stats.recvLongData++;
+
+    return solver->okay();
+}
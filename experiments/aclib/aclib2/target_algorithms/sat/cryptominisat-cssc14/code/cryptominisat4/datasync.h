@@ -22,6 +22,7 @@
 #include "solvertypes.h"
 #include "watched.h"
 #include "watcharray.h"
+#include <unordered_set>
 
 namespace CMSat {
 
@@ -44,6 +45,7 @@ class DataSync
 
         template <class T> void signalNewBinClause(T& ps);
         void signalNewBinClause(Lit lit1, Lit lit2);
+        void signalNewLongClause(const vector<Lit>& lits, uint32_t glue);
 
         struct Stats
         {
@@ -51,6 +53,9 @@ class DataSync
             uint32_t recvUnitData = 0;
             uint32_t sentBinData = 0;
             uint32_t recvBinData = 0;
+            uint32_t sentLongData = 0;
+            uint32_t recvLongData = 0;
+            uint64_t droppedLongData = 0;
         };
         const Stats& getStats() const;
 
@@ -65,6 +70,10 @@ class DataSync
         void clear_set_binary_values();
         void addOneBinToOthers(const Lit lit1, const Lit lit2);
         bool shareBinData();
+        void printLongStats() const;
+        bool syncLongFromOthers();
+        bool addOneLongFromOthers(const uint32_t* lits, uint32_t size, uint32_t glue);
+        bool longSeenBefore(const uint32_t* lits, uint32_t size);
 
         //stuff to sync
         vector<std::pair<Lit, Lit> > newBinClauses;
@@ -72,6 +81,7 @@ class DataSync
         //stats
         uint64_t lastSyncConf = 0;
         vector<uint32_t> syncFinish;
+        vector<size_t> longCursors; ///<Read position in other threads' rings
         Stats stats;
 
         //Other systems
@@ -83,6 +93,11 @@ class DataSync
         vector<uint16_t>& seen;
         vector<Lit>& toClear;
         vector<uint32_t> outer_to_without_bva_map;
+        vector<uint32_t> longExport;
+        vector<uint32_t> longBuf;
+        vector<uint32_t> longSorted;
+        vector<Lit> longLits;
+        std::unordered_set<uint64_t> longHashes; ///<Long clauses already known
 };
 
 inline const DataSync::Stats& DataSync::getStats() const
@@ -261,6 +261,10 @@ void Main::add_supported_options()
         ,"Number of threads")
     ("sync", po::value(&conf.sync_every_confl)->default_value(conf.sync_every_confl)
         , "Sync threads every N conflicts")
+    ("sharelongglue", po::value(&conf.share_long_max_glue)->default_value(conf.share_long_max_glue)
+        , "Share learnt long clauses with at most this glue between threads (0 = none)")
+    ("sharelongsize", po::value(&conf.share_long_max_size)->default_value(conf.share_long_max_size)
+        , "Share learnt long clauses with at most this size between threads")
     ("maxtime", po::value(&conf.maxTime)->default_value(conf.maxTime, "MAX")
         , "Stop solving after this much time, print stats and exit")
     ("maxconfl", po::value(&conf.maxConfl)->default_value(conf.maxConfl, "MAX")
@@ -574,6 +578,10 @@ void Main::add_supported_options()
         , "SQL database name. Default is used by PHP system, so it's highly recommended")
     ("sqlserver", po::value(&conf.sqlServer)->default_value(conf.sqlServer)
         , "SQL server hostname/IP")
+    #ifdef USE_SQLITE3
+    ("sqlite", po::value(&conf.sqliteFilename)->default_value(conf.sqliteFilename)
+        , "Write to this local SQLite file instead of the SQL server. Writing is done in a background thread")
+    #endif
     ;
 
     po::options_description printOptions("Printing options");
@@ -652,7 +660,7 @@ void Main::add_supported_options()
     .add(xorOptions)
     #endif
     .add(gateOptions)
-    #ifdef USE_MYSQL
+    #if defined(USE_MYSQL) || defined(USE_SQLITE3)
     .add(sqlOptions)
     #endif
     .add(miscOptions)
@@ -1597,6 +1597,9 @@ bool Searcher::handle_conflict(PropBy confl)
     glue = std::min<uint32_t>(glue, std::numeric_limits<uint32_t>::max());
     cl = handle_last_confl_otf_subsumption(cl, glue);
     assert(learnt_clause.size() <= 3 || cl != NULL);
+    if (learnt_clause.size() > 2) {
+        solver->datasync->signalNewLongClause(learnt_clause, glue);
+    }
     attach_and_enqueue_learnt_clause(cl);
 
     varDecayActivity();
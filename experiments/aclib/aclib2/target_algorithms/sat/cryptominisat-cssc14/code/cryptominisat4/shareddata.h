@@ -26,17 +26,128 @@
 
 #include <vector>
 #include <mutex>
+#include <atomic>
+#include <cassert>
 using std::vector;
 using std::mutex;
 
 namespace CMSat {
 
+/**
+@brief Learnt long clauses one thread offers to the others
+
+SharedData holds one ring per thread. Only the owning thread writes to it,
+from DataSync::signalNewLongClause(), and only clauses within
+--sharelongglue and --sharelongsize that contain no BVA variables. They are
+stored as 'size, glue, lits...' in outside numbering without BVA, so every
+thread can map them back to its own variables.
+
+The cursors are not in the ring: every DataSync keeps one cursor per other
+thread's ring (longCursors) and advances it in syncLongFromOthers(), which
+runs only when that thread synchronises. Such a thread can therefore fall
+behind, and the owner never waits for it. If the owner has overwritten words
+a reader has not consumed yet, pull() drops the whole unread range and returns
+its size for the 'dropped' statistics. 'reserved' is moved before and
+'published' after the owner writes a clause, so a reader can tell whether the
+words it just copied were overwritten while it was copying them.
+*/
+class ClauseRing
+{
+    public:
+        explicit ClauseRing(const size_t _capacity) :
+            capacity(_capacity)
+            , mask(_capacity-1)
+            , data(new std::atomic<uint32_t>[_capacity])
+            , reserved(0)
+            , published(0)
+        {
+            assert((capacity & mask) == 0);
+            for(size_t i = 0; i < capacity; i++) {
+                data[i].store(0, std::memory_order_relaxed);
+            }
+        }
+
+        ~ClauseRing()
+        {
+            delete[] data;
+        }
+
+        size_t size() const
+        {
+            return capacity;
+        }
+
+        //Only called by the owning thread
+        void push(const vector<uint32_t>& lits, const uint32_t glue)
+        {
+            assert(lits.size() + 2 <= capacity);
+            const size_t start = published.load(std::memory_order_relaxed);
+            const size_t end = start + lits.size() + 2;
+            reserved.store(end, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_release);
+
+            size_t pos = start;
+            data[pos++ & mask].store(lits.size(), std::memory_order_relaxed);
+            data[pos++ & mask].store(glue, std::memory_order_relaxed);
+            for(const uint32_t lit: lits) {
+                data[pos++ & mask].store(lit, std::memory_order_relaxed);
+            }
+            assert(pos == end);
+            published.store(end, std::memory_order_release);
+        }
+
+        //Appends all complete clauses from 'cursor' on to 'buf' and moves
+        //the cursor. Returns the number of words dropped due to overwrite.
+        size_t pull(size_t& cursor, vector<uint32_t>& buf) const
+        {
+            const size_t head = published.load(std::memory_order_acquire);
+            if (cursor == head)
+                return 0;
+
+            size_t dropped = head - cursor;
+            if (dropped <= capacity) {
+                const size_t before = buf.size();
+                for(size_t pos = cursor; pos != head; pos++) {
+                    buf.push_back(data[pos & mask].load(std::memory_order_relaxed));
+                }
+                std::atomic_thread_fence(std::memory_order_acquire);
+                const size_t limit = reserved.load(std::memory_order_relaxed);
+                if (limit - cursor <= capacity) {
+                    dropped = 0;
+                } else {
+                    buf.resize(before);
+                }
+            }
+            cursor = head;
+
+            return dropped;
+        }
+
+    private:
+        const size_t capacity; ///<Power of two, in words
+        const size_t mask;
+        std::atomic<uint32_t>* data;
+        std::atomic<size_t> reserved; ///<Written by producer before writing
+        std::atomic<size_t> published; ///<Written by producer after writing
+};
+
 class SharedData
 {
     public:
         SharedData(const uint32_t _num_threads) :
             num_threads(_num_threads)
-        {}
+        {
+            for(uint32_t i = 0; i < num_threads; i++) {
+                long_rings.push_back(new ClauseRing(1U << 18));
+            }
+        }
+
+        ~SharedData()
+        {
+            for(ClauseRing* ring: long_rings) {
+                delete ring;
+            }
+        }
 
         struct Spec {
             Spec() {
@@ -58,6 +169,9 @@ class SharedData
         mutex unit_mutex;
         mutex bin_mutex;
 
+        //Long clauses, one ring per thread, no locking
+        vector<ClauseRing*> long_rings;
+
         uint32_t num_threads;
 
         size_t calc_memory_use_bins()
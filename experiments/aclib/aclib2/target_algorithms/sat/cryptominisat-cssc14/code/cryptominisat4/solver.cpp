@@ -55,6 +55,10 @@ using std::endl;
 #include "mysqlstats.h"
 #endif
 
+#ifdef USE_SQLITE3
+#include "sqlitestats.h"
+#endif
+
 //#define DRUP_DEBUG
 
 //#define DEBUG_RENUMBER
@@ -78,6 +82,11 @@ Solver::Solver(const SolverConf _conf, bool* _needToInterrupt) :
     , nextCleanLimit(0)
 {
     if (conf.doSQL) {
+        #ifdef USE_SQLITE3
+        if (!conf.sqliteFilename.empty()) {
+            sqlStats = new SQLiteStats(conf.sqliteFilename);
+        } else
+        #endif
         #ifdef USE_MYSQL
         sqlStats = new MySQLStats();
         #else
@@ -115,6 +115,7 @@ SolverConf::SolverConf() :
         , sqlUser ("cmsat_solver")
         , sqlPass ("")
         , sqlDatabase("cmsat")
+        , sqliteFilename("")
 
         //Var-elim
         , doVarElim        (true)
@@ -209,5 +210,7 @@ SolverConf::SolverConf() :
         , maxDumpRedsSize(std::numeric_limits<uint32_t>::max())
         , origSeed(0)
         , sync_every_confl(6000)
+        , share_long_max_glue(3)
+        , share_long_max_size(30)
 {
 }
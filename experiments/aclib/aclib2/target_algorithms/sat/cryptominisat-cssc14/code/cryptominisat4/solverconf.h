@@ -186,6 +186,7 @@ class SolverConf
         std::string    sqlUser;
         std::string    sqlPass;
         std::string    sqlDatabase;
+        std::string    sqliteFilename; ///<If set, write to this SQLite file instead of MySQL
 
         //Var-elim
         int      doVarElim;          ///<Perform variable elimination
@@ -282,6 +283,8 @@ class SolverConf
         unsigned  maxDumpRedsSize; ///<When dumping the redundant clauses, this is the maximum clause size that should be dumped
         unsigned origSeed;
         unsigned long long sync_every_confl;
+        unsigned share_long_max_glue; ///<Share learnt long clauses with at most this glue between threads
+        unsigned share_long_max_size; ///<Share learnt long clauses with at most this size between threads
 };
 
 } //end namespace
@@ -0,0 +1,715 @@
+/*
+ * CryptoMiniSat
+ *
+ * Copyright (c) 2009-2013, Mate Soos. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.0 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+*/
+
+#include "sqlitestats.h"
+#include "solvertypes.h"
+#include "solver.h"
+#include "time_mem.h"
+#include <sstream>
+#include <string>
+#include <time.h>
+#include "constants.h"
+
+using namespace CMSat;
+using std::cout;
+using std::endl;
+using std::string;
+
+//Column names are the same as in MySQLStats. SQLite columns don't need
+//types, so the same list is used to create the table and to insert into it.
+
+static const char* restartColumns =
+    //Position
+    "runID, simplifications, restarts, conflicts, time"
+
+    //Clause stats
+    ", numIrredBins, numIrredTris, numIrredLongs"
+    ", numRedBins, numRedTris, numRedLongs"
+    ", numIrredLits, numRedLits"
+
+    //Conflict stats
+    ", glue, glueSD, glueMin, glueMax"
+    ", size, sizeSD, sizeMin, sizeMax"
+    ", resolutions, resolutionsSD, resolutionsMin, resolutionsMax"
+    ", conflAfterConfl"
+
+    //Search stats
+    ", branchDepth, branchDepthSD, branchDepthMin, branchDepthMax"
+    ", branchDepthDelta, branchDepthDeltaSD, branchDepthDeltaMin, branchDepthDeltaMax"
+    ", trailDepth, trailDepthSD, trailDepthMin, trailDepthMax"
+    ", trailDepthDelta, trailDepthDeltaSD, trailDepthDeltaMin, trailDepthDeltaMax"
+    ", agility"
+
+    //Propagations
+    ", propBinIrred, propBinRed"
+    ", propTriIrred, propTriRed"
+    ", propLongIrred, propLongRed"
+
+    //Conflicts
+    ", conflBinIrred, conflBinRed"
+    ", conflTriIrred, conflTriRed"
+    ", conflLongIrred, conflLongRed"
+
+    //Reds
+    ", learntUnits, learntBins, learntTris, learntLongs"
+
+    //Misc
+    ", watchListSizeTraversed, watchListSizeTraversedSD"
+    ", watchListSizeTraversedMin, watchListSizeTraversedMax"
+
+    //Resolutions
+    ", resolBin, resolTri, resolLIrred, resolLRed"
+
+    //Var stats
+    ", propagations"
+    ", decisions"
+    ", avgDecLevelVarLT"
+    ", avgTrailLevelVarLT"
+    ", avgDecLevelVar"
+    ", avgTrailLevelVar"
+    ", flipped, varSetPos, varSetNeg"
+    ", free, replaced, eliminated, \"set\"";
+
+static const char* reduceDBColumns =
+    //Position
+    "runID, simplifications, restarts, conflicts, time"
+    ", reduceDBs"
+
+    //Actual data
+    ", irredClsVisited, irredLitsVisited"
+    ", redClsVisited, redLitsVisited"
+
+    //Clean data
+    ", preRemovedNum, preRemovedLits, preRemovedGlue"
+    ", preRemovedResolBin, preRemovedResolTri, preRemovedResolLIrred, preRemovedResolLRed"
+    ", preRemovedAge, preRemovedAct"
+    ", preRemovedLitVisited, preRemovedProp, preRemovedConfl"
+    ", preRemovedLookedAt, preRemovedUsedUIP"
+
+    ", removedNum, removedLits, removedGlue"
+    ", removedResolBin, removedResolTri, removedResolLIrred, removedResolLRed"
+    ", removedAge, removedAct"
+    ", removedLitVisited, removedProp, removedConfl"
+    ", removedLookedAt, removedUsedUIP"
+
+    ", remainNum, remainLits, remainGlue"
+    ", remainResolBin, remainResolTri, remainResolLIrred, remainResolLRed"
+    ", remainAge, remainAct"
+    ", remainLitVisited, remainProp, remainConfl"
+    ", remainLookedAt, remainUsedUIP";
+
+SQLiteStats::SQLiteStats(const string& _filename) :
+    filename(_filename)
+{
+    for(size_t i = 0; i < t_num; i++) {
+        stmts[i] = NULL;
+    }
+}
+
+SQLiteStats::~SQLiteStats()
+{
+    if (setup_ok) {
+        flush();
+        {
+            std::unique_lock<std::mutex> lock(mu);
+            finishing = true;
+        }
+        cond_full.notify_one();
+        writer.join();
+        delete batch;
+    }
+
+    for(size_t i = 0; i < t_num; i++) {
+        sqlite3_finalize(stmts[i]);
+    }
+    sqlite3_close(db);
+}
+
+bool SQLiteStats::exec(const string& sql)
+{
+    char* err = NULL;
+    if (sqlite3_exec(db, sql.c_str(), NULL, NULL, &err) != SQLITE_OK) {
+        cout
+        << "c ERROR while executing SQLite statement: " << sql << endl
+        << "c " << (err ? err : sqlite3_errmsg(db))
+        << endl;
+        sqlite3_free(err);
+        return false;
+    }
+
+    return true;
+}
+
+bool SQLiteStats::prepare(
+    const Table table
+    , const char* name
+    , const char* columns
+) {
+    std::stringstream ss;
+    ss << "CREATE TABLE IF NOT EXISTS " << name << " (" << columns << ");";
+    if (!exec(ss.str()))
+        return false;
+
+    size_t numElems = 1;
+    for(const char* c = columns; *c; c++) {
+        numElems += (*c == ',');
+    }
+
+    ss.str("");
+    ss << "INSERT INTO " << name << " (" << columns << ") VALUES (";
+    for(size_t i = 0; i < numElems; i++) {
+        ss << (i ? ",?" : "?");
+    }
+    ss << ");";
+
+    if (sqlite3_prepare_v2(db, ss.str().c_str(), -1, &stmts[table], NULL) != SQLITE_OK) {
+        cout
+        << "c ERROR in sqlite3_prepare_v2(), query was: " << ss.str() << endl
+        << "c " << sqlite3_errmsg(db)
+        << endl;
+        return false;
+    }
+    assert(sqlite3_bind_parameter_count(stmts[table]) == (int)numElems);
+
+    return true;
+}
+
+bool SQLiteStats::setup(const Solver* solver)
+{
+    if (sqlite3_open(filename.c_str(), &db) != SQLITE_OK) {
+        cout
+        << "c ERROR while opening SQLite file '" << filename << "': "
+        << sqlite3_errmsg(db)
+        << endl;
+        sqlite3_close(db);
+        db = NULL;
+        return false;
+    }
+
+    //Several runs may write to the same file, wait for each other. If the
+    //machine crashes we lose the statistics, not a database.
+    sqlite3_busy_timeout(db, 60*1000);
+    if (!exec("PRAGMA synchronous = OFF;")
+        || !exec("PRAGMA journal_mode = MEMORY;")
+    ) {
+        return false;
+    }
+
+    bool ok = true;
+    ok &= prepare(t_solverRun, "solverRun", "runID, version, time");
+    ok &= prepare(t_tags, "tags", "runID, tagname, tag");
+    ok &= prepare(t_startup, "startup", "runID, startTime, verbosity");
+    ok &= prepare(t_finishup, "finishup", "runID, endTime, status");
+    ok &= prepare(t_restart, "restart", restartColumns);
+    ok &= prepare(t_reduceDB, "reduceDB", reduceDBColumns);
+    ok &= prepare(t_timepassed, "timepassed"
+        , "runID, simplifications, conflicts, time"
+          ", name, elapsed, timeout, percenttimeremain");
+    ok &= prepare(t_timepassedmin, "timepassed"
+        , "runID, simplifications, conflicts, time, name, elapsed");
+    #ifdef STATS_NEEDED_EXTRA
+    ok &= prepare(t_varDataInit, "varDataInit"
+        , "varInitID, runID, simplifications, restarts, conflicts, time");
+    ok &= prepare(t_vars, "vars"
+        , "varInitID, var"
+          ", posPolarSet, negPolarSet, flippedPolarity"
+          ", posDecided, negDecided"
+          ", decLevelAvg, decLevelSD, decLevelMin, decLevelMax"
+          ", trailLevelAvg, trailLevelSD, trailLevelMin, trailLevelMax");
+    ok &= prepare(t_clauseSizeDistrib, "clauseSizeDistrib"
+        , "runID, conflicts, size, num");
+    ok &= prepare(t_clauseGlueDistrib, "clauseGlueDistrib"
+        , "runID, conflicts, glue, num");
+    ok &= prepare(t_sizeGlue, "sizeGlue"
+        , "runID, conflicts, size, glue, num");
+    #endif
+    if (!ok)
+        return false;
+
+    //The runID is only random, it's not checked for uniqueness as with
+    //MySQL, since we can't read back what the writer thread inserted
+    getRandomID();
+    if (solver->getConf().verbosity >= 1) {
+        cout << "c SQLite runID is " << runID
+        << " writing to '" << filename << "'" << endl;
+    }
+
+    batch = new Batch;
+    writer = std::thread(&SQLiteStats::run, this);
+    setup_ok = true;
+
+    begin_row(t_solverRun);
+    add((uint64_t)runID);
+    add(string(Solver::getVersion()));
+    add((uint64_t)time(NULL));
+    end_row();
+
+    add_tags(solver);
+
+    begin_row(t_startup);
+    add((uint64_t)runID);
+    add((uint64_t)time(NULL));
+    add((uint64_t)solver->getConf().verbosity);
+    end_row();
+
+    return true;
+}
+
+void SQLiteStats::add_tags(const Solver* solver)
+{
+    for(const std::pair<string, string>& tag: solver->get_sql_tags()) {
+        begin_row(t_tags);
+        add((uint64_t)runID);
+        add(tag.first);
+        add(tag.second);
+        end_row();
+    }
+}
+
+void SQLiteStats::finishup(const lbool status)
+{
+    std::stringstream ss;
+    ss << status;
+
+    begin_row(t_finishup);
+    add((uint64_t)runID);
+    add((uint64_t)time(NULL));
+    add(ss.str());
+    end_row();
+
+    //Make sure everything is in the file when solve() returns
+    flush();
+    std::unique_lock<std::mutex> lock(mu);
+    while(!full.empty()) {
+        cond_done.wait(lock);
+    }
+}
+
+void SQLiteStats::begin_row(const Table table)
+{
+    Row row;
+    row.table = table;
+    row.start = batch->values.size();
+    batch->rows.push_back(row);
+}
+
+void SQLiteStats::add(const uint64_t value)
+{
+    Value v;
+    v.type = Value::integer;
+    v.i = value;
+    batch->values.push_back(v);
+}
+
+void SQLiteStats::add(const double value)
+{
+    Value v;
+    v.type = Value::real;
+    v.d = value;
+    batch->values.push_back(v);
+}
+
+void SQLiteStats::add(const string& value)
+{
+    Value v;
+    v.type = Value::text;
+    v.s = value;
+    batch->values.push_back(v);
+}
+
+void SQLiteStats::end_row()
+{
+    if (batch->rows.size() >= batchRows) {
+        flush();
+    }
+}
+
+void SQLiteStats::flush()
+{
+    if (batch->rows.empty())
+        return;
+
+    std::unique_lock<std::mutex> lock(mu);
+
+    //Don't let the search run arbitrarily far ahead of the disk
+    while(full.size() >= 4) {
+        cond_done.wait(lock);
+    }
+    full.push_back(batch);
+    lock.unlock();
+    cond_full.notify_one();
+
+    batch = new Batch;
+}
+
+void SQLiteStats::run()
+{
+    std::unique_lock<std::mutex> lock(mu);
+    for(;;) {
+        while(full.empty() && !finishing) {
+            cond_full.wait(lock);
+        }
+        if (full.empty())
+            break;
+
+        //Keep it in the queue while writing, so 'finishup' can wait on it
+        Batch* b = full.front();
+        lock.unlock();
+        write(*b);
+        delete b;
+        lock.lock();
+        full.pop_front();
+        cond_done.notify_all();
+    }
+}
+
+void SQLiteStats::write(const Batch& b)
+{
+    exec("BEGIN TRANSACTION;");
+    for(size_t r = 0; r < b.rows.size(); r++) {
+        const Row& row = b.rows[r];
+        const size_t end = (r+1 < b.rows.size()) ? b.rows[r+1].start : b.values.size();
+        sqlite3_stmt* stmt = stmts[row.table];
+        assert(end - row.start == (size_t)sqlite3_bind_parameter_count(stmt));
+
+        for(size_t i = row.start; i < end; i++) {
+            const Value& v = b.values[i];
+            const int at = i - row.start + 1;
+            switch(v.type) {
+                case Value::integer:
+                    sqlite3_bind_int64(stmt, at, v.i);
+                    break;
+                case Value::real:
+                    sqlite3_bind_double(stmt, at, v.d);
+                    break;
+                case Value::text:
+                    sqlite3_bind_text(stmt, at, v.s.c_str(), -1, SQLITE_TRANSIENT);
+                    break;
+            }
+        }
+
+        if (sqlite3_step(stmt) != SQLITE_DONE) {
+            cout
+            << "c ERROR while executing SQLite prepared statement: "
+            << sqlite3_errmsg(db)
+            << endl;
+            std::exit(-1);
+        }
+        sqlite3_reset(stmt);
+    }
+    exec("COMMIT;");
+}
+
+#ifdef STATS_NEEDED_EXTRA
+void SQLiteStats::varDataDump(
+    const Solver* solver
+    , const Searcher* search
+    , const vector<Var>& varsToDump
+    , const vector<VarData>& varData
+) {
+    //Can't use the auto-increment ID as MySQLStats, we don't wait for the
+    //insert, so number them ourselves
+    varInitID++;
+    begin_row(t_varDataInit);
+    add(varInitID);
+    add((uint64_t)runID);
+    add((uint64_t)solver->getSolveStats().numSimplify);
+    add((uint64_t)search->sumRestarts());
+    add((uint64_t)search->sumConflicts());
+    add(cpuTime());
+    end_row();
+
+    for(const Var var: varsToDump) {
+        const VarData::Stats& stats = varData[var].stats;
+
+        begin_row(t_vars);
+        add(varInitID);
+
+        //Back-number variables
+        add((uint64_t)solver->map_inter_to_outer(var));
+
+        //Overall stats
+        add((uint64_t)stats.posPolarSet);
+        add((uint64_t)stats.negPolarSet);
+        add((uint64_t)stats.flippedPolarity);
+        add((uint64_t)stats.posDecided);
+        add((uint64_t)stats.negDecided);
+
+        //Dec level history stats
+        add((double)stats.decLevelHist.avg());
+        add((double)sqrt(stats.decLevelHist.var()));
+        add((uint64_t)stats.decLevelHist.getMin());
+        add((uint64_t)stats.decLevelHist.getMax());
+
+        //Trail level history stats
+        add((double)stats.trailLevelHist.avg());
+        add((double)sqrt(stats.trailLevelHist.var()));
+        add((uint64_t)stats.trailLevelHist.getMin());
+        add((uint64_t)stats.trailLevelHist.getMax());
+        end_row();
+    }
+}
+
+void SQLiteStats::clauseSizeDistrib(
+    uint64_t sumConflicts
+    , const vector<uint32_t>& sizes
+) {
+    for(size_t i = 0; i < sizes.size(); i++) {
+        begin_row(t_clauseSizeDistrib);
+        add((uint64_t)runID);
+        add(sumConflicts);
+        add((uint64_t)i);
+        add((uint64_t)sizes[i]);
+        end_row();
+    }
+}
+
+void SQLiteStats::clauseGlueDistrib(
+    uint64_t sumConflicts
+    , const vector<uint32_t>& glues
+) {
+    for(size_t i = 0; i < glues.size(); i++) {
+        begin_row(t_clauseGlueDistrib);
+        add((uint64_t)runID);
+        add(sumConflicts);
+        add((uint64_t)i);
+        add((uint64_t)glues[i]);
+        end_row();
+    }
+}
+
+void SQLiteStats::clauseSizeGlueScatter(
+    uint64_t sumConflicts
+    , boost::multi_array<uint32_t, 2>& sizeAndGlue
+) {
+    for(size_t i = 0; i < sizeAndGlue.shape()[0]; i++) {
+        for(size_t i2 = 0; i2 < sizeAndGlue.shape()[1]; i2++) {
+            begin_row(t_sizeGlue);
+            add((uint64_t)runID);
+            add(sumConflicts);
+            add((uint64_t)i);
+            add((uint64_t)i2);
+            add((uint64_t)sizeAndGlue[i][i2]);
+            end_row();
+        }
+    }
+}
+#endif //STATS_NEEDED_EXTRA
+
+void SQLiteStats::reduceDB(
+    const ClauseUsageStats& irredStats
+    , const ClauseUsageStats& redStats
+    , const CleaningStats& clean
+    , const Solver* solver
+) {
+    begin_row(t_reduceDB);
+
+    //Position of solving
+    add((uint64_t)runID);
+    add((uint64_t)solver->getSolveStats().numSimplify);
+    add((uint64_t)solver->sumRestarts());
+    add((uint64_t)solver->sumConflicts());
+    add(cpuTime());
+    add((uint64_t)solver->getSolveStats().nbReduceDB);
+
+    //Clause data for IRRED and RED
+    add((uint64_t)irredStats.sumLookedAt);
+    add((uint64_t)irredStats.sumLitVisited);
+    add((uint64_t)redStats.sumLookedAt);
+    add((uint64_t)redStats.sumLitVisited);
+
+    //Clean data
+    const CleaningStats::Data* datas[3] = {&clean.preRemove, &clean.removed, &clean.remain};
+    for(const CleaningStats::Data* d: datas) {
+        add(d->num);
+        add(d->lits);
+        add(d->glue);
+        add(d->resol.bin);
+        add(d->resol.tri);
+        add(d->resol.irredL);
+        add(d->resol.redL);
+        add(d->age);
+        add(d->act);
+        add(d->numLitVisited);
+        add(d->numProp);
+        add(d->numConfl);
+        add(d->numLookedAt);
+        add(d->used_for_uip_creation);
+    }
+
+    end_row();
+}
+
+void SQLiteStats::time_passed(
+    const Solver* solver
+    , const string& name
+    , double time_passed
+    , bool time_out
+    , double percent_time_remain
+) {
+    begin_row(t_timepassed);
+    add((uint64_t)runID);
+    add((uint64_t)solver->getSolveStats().numSimplify);
+    add((uint64_t)solver->sumConflicts());
+    add(cpuTime());
+    add(name);
+    add(time_passed);
+    add((uint64_t)time_out);
+    add(percent_time_remain);
+    end_row();
+}
+
+void SQLiteStats::time_passed_min(
+    const Solver* solver
+    , const string& name
+    , double time_passed
+) {
+    begin_row(t_timepassedmin);
+    add((uint64_t)runID);
+    add((uint64_t)solver->getSolveStats().numSimplify);
+    add((uint64_t)solver->sumConflicts());
+    add(cpuTime());
+    add(name);
+    add(time_passed);
+    end_row();
+}
+
+void SQLiteStats::restart(
+    const PropStats& thisPropStats
+    , const Searcher::Stats& thisStats
+    , const VariableVariance& varVarStats
+    , const Solver* solver
+    , const Searcher* search
+) {
+    const Searcher::Hist& searchHist = search->getHistory();
+    const Solver::BinTriStats& binTri = solver->getBinTriStats();
+
+    begin_row(t_restart);
+
+    //Position of solving
+    add((uint64_t)runID);
+    add((uint64_t)solver->getSolveStats().numSimplify);
+    add((uint64_t)search->sumRestarts());
+    add((uint64_t)search->sumConflicts());
+    add(cpuTime());
+
+    //Clause stats
+    add((uint64_t)binTri.irredBins);
+    add((uint64_t)binTri.irredTris);
+    add((uint64_t)solver->getNumLongIrredCls());
+    add((uint64_t)binTri.redBins);
+    add((uint64_t)binTri.redTris);
+    add((uint64_t)solver->getNumLongRedCls());
+    add((uint64_t)solver->litStats.irredLits);
+    add((uint64_t)solver->litStats.redLits);
+
+    //Conflict stats
+    add((double)searchHist.glueHist.getLongtTerm().avg());
+    add((double)sqrt(searchHist.glueHist.getLongtTerm().var()));
+    add((uint64_t)searchHist.glueHist.getLongtTerm().getMin());
+    add((uint64_t)searchHist.glueHist.getLongtTerm().getMax());
+
+    add((double)searchHist.conflSizeHist.avg());
+    add((double)sqrt(searchHist.conflSizeHist.var()));
+    add((uint64_t)searchHist.conflSizeHist.getMin());
+    add((uint64_t)searchHist.conflSizeHist.getMax());
+
+    add((double)searchHist.numResolutionsHist.avg());
+    add((double)sqrt(searchHist.numResolutionsHist.var()));
+    add((uint64_t)searchHist.numResolutionsHist.getMin());
+    add((uint64_t)searchHist.numResolutionsHist.getMax());
+
+    add((double)searchHist.conflictAfterConflict.avg()*100.0);
+
+    //Search stats
+    add((double)searchHist.branchDepthHist.avg());
+    add((double)sqrt(searchHist.branchDepthHist.var()));
+    add((uint64_t)searchHist.branchDepthHist.getMin());
+    add((uint64_t)searchHist.branchDepthHist.getMax());
+
+    add((double)searchHist.branchDepthDeltaHist.avg());
+    add((double)sqrt(searchHist.branchDepthDeltaHist.var()));
+    add((uint64_t)searchHist.branchDepthDeltaHist.getMin());
+    add((uint64_t)searchHist.branchDepthDeltaHist.getMax());
+
+    add((double)searchHist.trailDepthHist.getLongtTerm().avg());
+    add((double)sqrt(searchHist.trailDepthHist.getLongtTerm().var()));
+    add((uint64_t)searchHist.trailDepthHist.getLongtTerm().getMin());
+    add((uint64_t)searchHist.trailDepthHist.getLongtTerm().getMax());
+
+    add((double)searchHist.trailDepthDeltaHist.avg());
+    add((double)sqrt(searchHist.trailDepthDeltaHist.var()));
+    add((uint64_t)searchHist.trailDepthDeltaHist.getMin());
+    add((uint64_t)searchHist.trailDepthDeltaHist.getMax());
+
+    add((double)searchHist.agilityHist.avg());
+
+    //Prop
+    add((uint64_t)thisPropStats.propsBinIrred);
+    add((uint64_t)thisPropStats.propsBinRed);
+    add((uint64_t)thisPropStats.propsTriIrred);
+    add((uint64_t)thisPropStats.propsTriRed);
+    add((uint64_t)thisPropStats.propsLongIrred);
+    add((uint64_t)thisPropStats.propsLongRed);
+
+    //Confl
+    add((uint64_t)thisStats.conflStats.conflsBinIrred);
+    add((uint64_t)thisStats.conflStats.conflsBinRed);
+    add((uint64_t)thisStats.conflStats.conflsTriIrred);
+    add((uint64_t)thisStats.conflStats.conflsTriRed);
+    add((uint64_t)thisStats.conflStats.conflsLongIrred);
+    add((uint64_t)thisStats.conflStats.conflsLongRed);
+
+    //Red
+    add((uint64_t)thisStats.learntUnits);
+    add((uint64_t)thisStats.learntBins);
+    add((uint64_t)thisStats.learntTris);
+    add((uint64_t)thisStats.learntLongs);
+
+    //Misc
+    add((double)searchHist.watchListSizeTraversed.avg());
+    add((double)sqrt(searchHist.watchListSizeTraversed.var()));
+    add((uint64_t)searchHist.watchListSizeTraversed.getMin());
+    add((uint64_t)searchHist.watchListSizeTraversed.getMax());
+
+    //Resolv stats
+    add((uint64_t)thisStats.resolvs.bin);
+    add((uint64_t)thisStats.resolvs.tri);
+    add((uint64_t)thisStats.resolvs.irredL);
+    add((uint64_t)thisStats.resolvs.redL);
+
+    //Var stats
+    add((uint64_t)thisPropStats.propagations);
+    add((uint64_t)thisStats.decisions);
+    add(varVarStats.avgDecLevelVarLT);
+    add(varVarStats.avgTrailLevelVarLT);
+    add(varVarStats.avgDecLevelVar);
+    add(varVarStats.avgTrailLevelVar);
+    add((uint64_t)thisPropStats.varFlipped);
+    add((uint64_t)thisPropStats.varSetPos);
+    add((uint64_t)thisPropStats.varSetNeg);
+    add((uint64_t)solver->getNumFreeVars());
+    add((uint64_t)solver->getNumVarsReplaced());
+    add((uint64_t)solver->getNumVarsElimed());
+    add((uint64_t)search->getTrailSize());
+
+    end_row();
+}
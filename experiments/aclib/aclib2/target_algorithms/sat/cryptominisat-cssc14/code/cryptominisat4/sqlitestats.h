@@ -0,0 +1,181 @@
+/*
+ * CryptoMiniSat
+ *
+ * Copyright (c) 2009-2013, Mate Soos. All rights reserved.
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.0 of the License.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Lesser General Public License for more details.
+ *
+ * You should have received a copy of the GNU Lesser General Public
+ * License along with this library; if not, write to the Free Software
+ * Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston,
+ * MA 02110-1301  USA
+*/
+
+#ifndef __SQLITESTATS_H__
+#define __SQLITESTATS_H__
+
+#include "sqlstats.h"
+
+#include <sqlite3.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <deque>
+
+namespace CMSat {
+
+/**
+@brief Writes the same records as MySQLStats into a local SQLite file
+
+Meant for nodes without a MySQL server. The tables are created in the file
+if they don't exist yet, rows of different runs are told apart by 'runID'.
+The search thread only copies the values of a row into the current batch.
+Full batches are handed to a writer thread, which inserts them through
+prepared statements inside one transaction per batch.
+*/
+class SQLiteStats: public SQLStats
+{
+public:
+    explicit SQLiteStats(const string& filename);
+    ~SQLiteStats() override;
+
+    void restart(
+        const PropStats& thisPropStats
+        , const Searcher::Stats& thisStats
+        , const VariableVariance& varVarStats
+        , const Solver* solver
+        , const Searcher* searcher
+    ) override;
+
+    #ifdef STATS_NEEDED_EXTRA
+    void clauseSizeDistrib(
+        uint64_t sumConflicts
+        , const vector<uint32_t>& sizes
+    ) override;
+
+    void clauseGlueDistrib(
+        uint64_t sumConflicts
+        , const vector<uint32_t>& glues
+    ) override;
+
+    void clauseSizeGlueScatter(
+        uint64_t sumConflicts
+        , boost::multi_array<uint32_t, 2>& sizeAndGlue
+    ) override;
+
+    void varDataDump(
+        const Solver* solver
+        , const Searcher* search
+        , const vector<Var>& varsToDump
+        , const vector<VarData>& varData
+    ) override;
+    #endif
+
+    void reduceDB(
+        const ClauseUsageStats& irredStats
+        , const ClauseUsageStats& redStats
+        , const CleaningStats& clean
+        , const Solver* solver
+    ) override;
+
+    void time_passed(
+        const Solver* solver
+        , const string& name
+        , double time_passed
+        , bool time_out
+        , double percent_time_remain
+    ) override;
+
+    void time_passed_min(
+        const Solver* solver
+        , const string& name
+        , double time_passed
+    ) override;
+
+    bool setup(const Solver* solver) override;
+    void finishup(lbool status) override;
+
+private:
+    //One prepared statement per table
+    enum Table {
+        t_solverRun = 0
+        , t_tags
+        , t_startup
+        , t_finishup
+        , t_restart
+        , t_reduceDB
+        , t_timepassed
+        , t_timepassedmin
+        #ifdef STATS_NEEDED_EXTRA
+        , t_varDataInit
+        , t_vars
+        , t_clauseSizeDistrib
+        , t_clauseGlueDistrib
+        , t_sizeGlue
+        #endif
+        , t_num
+    };
+
+    struct Value {
+        enum Type {integer, real, text};
+        Type type;
+        int64_t i = 0;
+        double d = 0;
+        string s;
+    };
+
+    struct Row {
+        Table table;
+        size_t start; ///<Position of first value in 'Batch::values'
+    };
+
+    struct Batch {
+        vector<Row> rows;
+        vector<Value> values;
+    };
+
+    bool exec(const string& sql);
+    bool prepare(Table table, const char* name, const char* columns);
+    void add_tags(const Solver* solver);
+
+    //Filling the current batch (search thread)
+    void begin_row(Table table);
+    void add(uint64_t value);
+    void add(double value);
+    void add(const string& value);
+    void end_row();
+
+    //Handing over to the writer thread
+    void flush();
+    void run();
+    void write(const Batch& batch);
+
+    string filename;
+    sqlite3* db = NULL;
+    sqlite3_stmt* stmts[t_num];
+    bool setup_ok = false;
+    size_t batchRows = 1000;
+    #ifdef STATS_NEEDED_EXTRA
+    uint64_t varInitID = 0;
+    #endif
+
+    Batch* batch = NULL;
+    std::deque<Batch*> full;
+    std::mutex mu;
+    std::condition_variable cond_full;
+    std::condition_variable cond_done;
+    bool finishing = false;
+    std::thread writer;
+};
+
+} //end namespace
+
+#endif //__SQLITESTATS_H__
@@ -462,14 +462,15 @@ bool Solver::addClause_(vec <Lit> &ps) {
 
 void Solver::attachClause(CRef cr) {
     const Clause &c = ca[cr];
+    Lit c0 = ca.watched(cr, 0), c1 = ca.watched(cr, 1);
 
     assert(c.size() > 1);
     if(c.size() == 2) {
-        watchesBin[~c[0]].push(Watcher(cr, c[1]));
-        watchesBin[~c[1]].push(Watcher(cr, c[0]));
+        watchesBin[~c0].push(Watcher(cr, c1));
+        watchesBin[~c1].push(Watcher(cr, c0));
     } else {
-        watches[~c[0]].push(Watcher(cr, c[1]));
-        watches[~c[1]].push(Watcher(cr, c[0]));
+        watches[~c0].push(Watcher(cr, c1));
+        watches[~c1].push(Watcher(cr, c0));
     }
     if(c.learnt()) stats[learnts_literals] += c.size();
     else stats[clauses_literals] += c.size();
@@ -487,25 +488,26 @@ void Solver::attachClausePurgatory(CRef cr) {
 
 void Solver::detachClause(CRef cr, bool strict) {
     const Clause &c = ca[cr];
+    Lit c0 = ca.watched(cr, 0), c1 = ca.watched(cr, 1);
 
     assert(c.size() > 1);
     if(c.size() == 2) {
         if(strict) {
-            remove(watchesBin[~c[0]], Watcher(cr, c[1]));
-            remove(watchesBin[~c[1]], Watcher(cr, c[0]));
+            remove(watchesBin[~c0], Watcher(cr, c1));
+            remove(watchesBin[~c1], Watcher(cr, c0));
         } else {
             // Lazy detaching: (NOTE! Must clean all watcher lists before garbage collecting this clause)
-            watchesBin.smudge(~c[0]);
-            watchesBin.smudge(~c[1]);
+            watchesBin.smudge(~c0);
+            watchesBin.smudge(~c1);
         }
     } else {
         if(strict) {
-            remove(watches[~c[0]], Watcher(cr, c[1]));
-            remove(watches[~c[1]], Watcher(cr, c[0]));
+            remove(watches[~c0], Watcher(cr, c1));
+            remove(watches[~c1], Watcher(cr, c0));
         } else {
             // Lazy detaching: (NOTE! Must clean all watcher lists before garbage collecting this clause)
-            watches.smudge(~c[0]);
-            watches.smudge(~c[1]);
+            watches.smudge(~c0);
+            watches.smudge(~c1);
         }
     }
     if(c.learnt()) stats[learnts_literals] -= c.size();
@@ -550,8 +552,11 @@ void Solver::removeClause(CRef cr, bool inPurgatory) {
     else
         detachClause(cr);
     // Don't leave pointers to free'd memory!
-    if(locked(c)) vardata[var(c[0])].reason = CRef_Undef;
-    c.mark(1);
+    if(ca.isShared(cr)) {
+        for(int i = 0; i < c.size(); i++)
+            if(reason(var(c[i])) == cr) vardata[var(c[i])].reason = CRef_Undef;
+    } else if(locked(c)) vardata[var(c[0])].reason = CRef_Undef;
+    ca.mark(cr, 1);
     ca.free(cr);
 }
 
@@ -744,9 +749,11 @@ void Solver::analyze(CRef confl, vec <Lit> &out_learnt, vec <Lit> &selectors, in
     do {
         assert(confl != CRef_Undef); // (otherwise should be UIP)
         Clause &c = ca[confl];
+        // Shared original clauses are never reordered: the implied literal 'p' is skipped below
+        bool shared = ca.isShared(confl);
         // Special case for binary clauses
         // The first one has to be SAT
-        if(p != lit_Undef && c.size() == 2 && value(c[0]) == l_False) {
+        if(p != lit_Undef && !shared && c.size() == 2 && value(c[0]) == l_False) {
 
             assert(value(c[1]) == l_True);
             Lit tmp = c[0];
@@ -757,9 +764,9 @@ void Solver::analyze(CRef confl, vec <Lit> &out_learnt, vec <Lit> &selectors, in
             parallelImportClauseDuringConflictAnalysis(c, confl);
             claBumpActivity(c);
         } else { // original clause
-            if(!c.getSeen()) {
+            if(!ca.getSeen(confl)) {
                 stats[originalClausesSeen]++;
-                c.setSeen(true);
+                ca.setSeen(confl, true);
             }
         }
 
@@ -784,8 +791,9 @@ void Solver::analyze(CRef confl, vec <Lit> &out_learnt, vec <Lit> &selectors, in
         }
 
 
-        for(int j = (p == lit_Undef) ? 0 : 1; j < c.size(); j++) {
+        for(int j = (p == lit_Undef || shared) ? 0 : 1; j < c.size(); j++) {
             Lit q = c[j];
+            if(q == p) continue;
 
             if(!seen[var(q)]) {
                 if(level(var(q)) == 0) {
@@ -851,7 +859,7 @@ void Solver::analyze(CRef confl, vec <Lit> &out_learnt, vec <Lit> &selectors, in
             else {
                 Clause &c = ca[reason(var(out_learnt[i]))];
                 // Thanks to Siert Wieringa for this bug fix!
-                for(int k = ((c.size() == 2) ? 0 : 1); k < c.size(); k++)
+                for(int k = ((c.size() == 2 || ca.isShared(reason(x))) ? 0 : 1); k < c.size(); k++)
                     if(!seen[var(c[k])] && level(var(c[k])) > 0) {
                         out_learnt[j++] = out_learnt[i];
                         break;
@@ -929,15 +937,18 @@ bool Solver::litRedundant(Lit p, uint32_t abstract_levels) {
     int top = analyze_toclear.size();
     while(analyze_stack.size() > 0) {
         assert(reason(var(analyze_stack.last())) != CRef_Undef);
-        Clause &c = ca[reason(var(analyze_stack.last()))];
+        CRef cr = reason(var(analyze_stack.last()));
+        Clause &c = ca[cr];
         analyze_stack.pop(); //
-        if(c.size() == 2 && value(c[0]) == l_False) {
+        // The implied literal of a shared clause can be anywhere, but its variable is already seen
+        bool shared = ca.isShared(cr);
+        if(!shared && c.size() == 2 && value(c[0]) == l_False) {
             assert(value(c[1]) == l_True);
             Lit tmp = c[0];
             c[0] = c[1], c[1] = tmp;
         }
 
-        for(int i = 1; i < c.size(); i++) {
+        for(int i = shared ? 0 : 1; i < c.size(); i++) {
             Lit p = c[i];
             if(!seen[var(p)]) {
                 if(level(var(p)) > 0) {
@@ -989,7 +1000,7 @@ void Solver::analyzeFinal(Lit p, vec <Lit> &out_conflict) {
                 //                for (int j = 1; j < c.size(); j++) Minisat (glucose 2.0) loop
                 // Bug in case of assumptions due to special data structures for Binary.
                 // Many thanks to Sam Bayless (sbayless@cs.ubc.ca) for discover this bug.
-                for(int j = ((c.size() == 2) ? 0 : 1); j < c.size(); j++)
+                for(int j = ((c.size() == 2 || ca.isShared(reason(x))) ? 0 : 1); j < c.size(); j++)
                     if(level(var(c[j])) > 0)
                         seen[var(c[j])] = 1;
             }
@@ -1064,8 +1075,52 @@ CRef Solver::propagate() {
                 continue;
             }
 
-            // Make sure the false literal is data[1]:
             CRef cr = i->cref;
+            if(ca.isShared(cr)) {
+                // Shared original clause: its literals stay in place, only the positions of the
+                // watched literals (thread local) move
+                const Clause &c = ca[cr];
+                SharedWatch &sw = ca.sharedWatch(cr);
+                Lit false_lit = ~p;
+                if(c[sw.w0] == false_lit) {
+                    unsigned tmp = sw.w0;
+                    sw.w0 = sw.w1, sw.w1 = tmp;
+                }
+                assert(c[sw.w1] == false_lit);
+                i++;
+
+                Lit first = c[sw.w0];
+                Watcher w = Watcher(cr, first);
+                if(first != blocker && value(first) == l_True) {
+                    *j++ = w;
+                    continue;
+                }
+
+                bool found = false;
+                for(int k = 0; k < c.size(); k++) {
+                    if(k != (int) sw.w0 && k != (int) sw.w1 && value(c[k]) != l_False) {
+                        sw.w1 = k;
+                        watches[~c[k]].push(w);
+                        found = true;
+                        break;
+                    }
+                }
+                if(found) continue;
+
+                // Did not find watch -- clause is unit under assignment:
+                *j++ = w;
+                if(value(first) == l_False) {
+                    confl = cr;
+                    qhead = trail.size();
+                    // Copy the remaining watches:
+                    while(i < end)
+                        *j++ = *i++;
+                } else
+                    uncheckedEnqueue(first, cr);
+                continue;
+            }
+
+            // Make sure the false literal is data[1]:
             Clause &c = ca[cr];
             assert(!c.getOneWatched());
             Lit false_lit = ~p;
@@ -1946,7 +2001,7 @@ void Solver::relocAll(ClauseAllocator &to) {
     for(int i = 0; i < trail.size(); i++) {
         Var v = var(trail[i]);
 
-        if(reason(v) != CRef_Undef && (ca[reason(v)].reloced() || locked(ca[reason(v)])))
+        if(reason(v) != CRef_Undef && !ca.isShared(reason(v)) && (ca[reason(v)].reloced() || locked(ca[reason(v)])))
             ca.reloc(vardata[v].reason, to);
     }
 
@@ -1979,6 +2034,32 @@ void Solver::garbageCollect() {
     to.moveTo(ca);
 }
 
+
+// Moves the original clauses into 'arena', which the clones of this solver then share (read-only)
+// instead of copying them. Only the learnt clauses stay in the clause allocator of the solver.
+void Solver::shareOriginalClauses(ClauseAllocator &arena) {
+    assert(decisionLevel() == 0);
+    assert(ca.shared == NULL && !incremental);
+
+    arena.extra_clause_field = true; // The extra field keeps the index of the thread local watches
+    int i, j;
+    for(i = j = 0; i < clauses.size(); i++) {
+        Clause &c = ca[clauses[i]];
+        if(c.mark() != 0) continue;
+        CRef cr = arena.alloc(c);
+        arena[cr].setSharedIndex(j);
+        ca.shared_watches.push(SharedWatch(c.getSeen())); // c[0] and c[1] are the watched literals
+        ca.free(clauses[i]);
+        c.relocate(cr | CRef_Shared);
+        clauses[j++] = clauses[i];
+    }
+    clauses.shrink(i - j);
+    ca.shared = &arena;
+
+    // References to the original clauses are redirected to the arena by the relocation
+    garbageCollect();
+}
+
 //--------------------------------------------------------------
 // Functions related to MultiThread.
 // Useless in case of single core solver (aka original glucose)
@@ -186,6 +186,7 @@ public:
     virtual void garbageCollect();
     void    checkGarbage(double gf);
     void    checkGarbage();
+    void    shareOriginalClauses(ClauseAllocator& arena); // Moves the original clauses into an arena read by all clones
 
     // Extra results: (read-only member variable)
     //
@@ -305,7 +306,7 @@ protected:
     {
         const ClauseAllocator& ca;
         WatcherDeleted(const ClauseAllocator& _ca) : ca(_ca) {}
-        bool operator()(const Watcher& w) const { return ca[w.cref].mark() == 1; }
+        bool operator()(const Watcher& w) const { return ca.mark(w.cref) == 1; }
     };
 
     struct VarOrderLt {
@@ -508,6 +509,11 @@ inline bool     Solver::addClause       (Lit p)                 { add_tmp.clear(
 inline bool     Solver::addClause       (Lit p, Lit q)          { add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); return addClause_(add_tmp); }
 inline bool     Solver::addClause       (Lit p, Lit q, Lit r)   { add_tmp.clear(); add_tmp.push(p); add_tmp.push(q); add_tmp.push(r); return addClause_(add_tmp); }
  inline bool     Solver::locked          (const Clause& c) const { 
+   if(ca.isShared(c)) { // The literals of a shared clause are not reordered, the implied one can be anywhere
+     for(int i = 0; i < c.size(); i++)
+       if(value(c[i]) == l_True && reason(var(c[i])) != CRef_Undef && ca.lea(reason(var(c[i]))) == &c) return true;
+     return false;
+   }
    if(c.size()>2) 
      return value(c[0]) == l_True && reason(var(c[0])) != CRef_Undef && ca.lea(reason(var(c[0]))) == &c; 
    return 
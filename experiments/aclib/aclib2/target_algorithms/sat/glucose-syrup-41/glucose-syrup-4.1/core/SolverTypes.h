@@ -246,6 +246,10 @@ public:
     float&       activity    ()              { assert(header.extra_size > 0); return data[header.size].act; }
     uint32_t     abstraction () const        { assert(header.extra_size > 0); return data[header.size].abs; }
 
+    // Original clauses of the arena shared by all threads keep their number in the extra field (see ClauseAllocator)
+    uint32_t     sharedIndex () const        { assert(header.extra_size > 0); return data[header.size].abs; }
+    void         setSharedIndex(uint32_t i)  { assert(header.extra_size > 0); data[header.size].abs = i; }
+
     // Handle imported clauses lazy sharing
     bool        wasImported() const {return header.extra_size > 1;}
     uint32_t    importedFrom () const       { assert(header.extra_size > 1); return data[header.size + 1].abs;}
@@ -277,20 +281,65 @@ public:
 
 
     const CRef CRef_Undef = RegionAllocator<uint32_t>::Ref_Undef;
+    const CRef CRef_Shared = 0x80000000; // Tags references into the shared arena of original clauses
+
+    // The original clauses can be moved into one arena which is read (and never written) by all
+    // the threads of the parallel solver, see Solver::shareOriginalClauses(). Such a clause keeps
+    // its literals in place, its thread local part is a SharedWatch: the positions of the two
+    // watched literals (c[0] and c[1] of a thread local clause) and the mark and seen flags.
+    struct SharedWatch {
+        unsigned w0   : 30;
+        unsigned mark : 2;
+        unsigned w1   : 31;
+        unsigned seen : 1;
+        SharedWatch(bool s = false) : w0(0), mark(0), w1(1), seen(s) {}
+    };
+
     class ClauseAllocator : public RegionAllocator<uint32_t>
     {
         static int clauseWord32Size(int size, int extra_size){
             return (sizeof(Clause) + (sizeof(Lit) * (size + extra_size))) / sizeof(uint32_t); }
     public:
         bool extra_clause_field;
+        ClauseAllocator*  shared;         // Arena of the original clauses common to all threads (or NULL)
+        vec<SharedWatch>  shared_watches; // Thread local part of the shared clauses, by their index
 
-        ClauseAllocator(uint32_t start_cap) : RegionAllocator<uint32_t>(start_cap), extra_clause_field(false){}
-        ClauseAllocator() : extra_clause_field(false){}
+        ClauseAllocator(uint32_t start_cap) : RegionAllocator<uint32_t>(start_cap), extra_clause_field(false), shared(NULL){}
+        ClauseAllocator() : extra_clause_field(false), shared(NULL){}
 
+        // The shared arena and the thread local watches stay with this allocator (only the region moves)
         void moveTo(ClauseAllocator& to){
             to.extra_clause_field = extra_clause_field;
             RegionAllocator<uint32_t>::moveTo(to); }
 
+        void copyTo(ClauseAllocator& to) const {
+            RegionAllocator<uint32_t>::copyTo(to);
+            to.extra_clause_field = extra_clause_field;
+            to.shared = shared;
+            shared_watches.memCopyTo(to.shared_watches); }
+
+        bool isShared(CRef r) const { return (r & CRef_Shared) && r != CRef_Undef; }
+        bool isShared(const Clause& c) const {
+            if (shared == NULL || shared->size() == 0) return false;
+            const uint32_t* first = (const uint32_t*)shared->lea(0);
+            return (const uint32_t*)&c >= first && (const uint32_t*)&c < first + shared->size(); }
+
+        SharedWatch&       sharedWatch(CRef r)       { return shared_watches[operator[](r).sharedIndex()]; }
+        const SharedWatch& sharedWatch(CRef r) const { return shared_watches[operator[](r).sharedIndex()]; }
+
+        // Watched literal 'i' (0 or 1) of a clause, wherever it is stored:
+        Lit      watched   (CRef r, int i) const {
+            const Clause& c = operator[](r);
+            if (!isShared(r)) return c[i];
+            const SharedWatch& w = sharedWatch(r);
+            return c[i == 0 ? w.w0 : w.w1]; }
+
+        // Mark and seen flags of a clause, wherever it is stored:
+        uint32_t mark      (CRef r) const           { return isShared(r) ? sharedWatch(r).mark : operator[](r).mark(); }
+        void     mark      (CRef r, uint32_t m)     { if (isShared(r)) sharedWatch(r).mark = m; else operator[](r).mark(m); }
+        bool     getSeen   (CRef r)                 { return isShared(r) ? sharedWatch(r).seen : operator[](r).getSeen(); }
+        void     setSeen   (CRef r, bool b)         { if (isShared(r)) sharedWatch(r).seen = b; else operator[](r).setSeen(b); }
+
         template<class Lits>
         CRef alloc(const Lits& ps, bool learnt = false, bool imported = false)
         {
@@ -300,26 +349,32 @@ public:
             bool use_extra = learnt | extra_clause_field;
             int extra_size = imported?3:(use_extra?1:0);
             CRef cid = RegionAllocator<uint32_t>::alloc(clauseWord32Size(ps.size(), extra_size));
+            if (RegionAllocator<uint32_t>::size() > CRef_Shared)
+                throw OutOfMemoryException(); // References must not collide with the tag of the shared arena
             new (lea(cid)) Clause(ps, extra_size, learnt);
 
             return cid;
         }
 
         // Deref, Load Effective Address (LEA), Inverse of LEA (AEL):
-        Clause&       operator[](Ref r)       { return (Clause&)RegionAllocator<uint32_t>::operator[](r); }
-        const Clause& operator[](Ref r) const { return (Clause&)RegionAllocator<uint32_t>::operator[](r); }
-        Clause*       lea       (Ref r)       { return (Clause*)RegionAllocator<uint32_t>::lea(r); }
-        const Clause* lea       (Ref r) const { return (Clause*)RegionAllocator<uint32_t>::lea(r); }
+        // NOTE: a clause of the shared arena is returned as well, it must only be read.
+        Clause&       operator[](Ref r)       { return isShared(r) ? (*shared)[r ^ CRef_Shared] : (Clause&)RegionAllocator<uint32_t>::operator[](r); }
+        const Clause& operator[](Ref r) const { return isShared(r) ? (*shared)[r ^ CRef_Shared] : (Clause&)RegionAllocator<uint32_t>::operator[](r); }
+        Clause*       lea       (Ref r)       { return isShared(r) ? shared->lea(r ^ CRef_Shared) : (Clause*)RegionAllocator<uint32_t>::lea(r); }
+        const Clause* lea       (Ref r) const { return isShared(r) ? shared->lea(r ^ CRef_Shared) : (Clause*)RegionAllocator<uint32_t>::lea(r); }
         Ref           ael       (const Clause* t){ return RegionAllocator<uint32_t>::ael((uint32_t*)t); }
 
         void free(CRef cid)
         {
+            if (isShared(cid)) return; // Only the thread local watches of a shared clause are dropped
             Clause& c = operator[](cid);
             RegionAllocator<uint32_t>::free(clauseWord32Size(c.size(), c.has_extra()));
         }
 
         void reloc(CRef& cr, ClauseAllocator& to)
         {
+            if (isShared(cr)) return; // The shared arena is never collected
+
             Clause& c = operator[](cr);
 
             if (c.reloced()) { cr = c.relocation(); return; }
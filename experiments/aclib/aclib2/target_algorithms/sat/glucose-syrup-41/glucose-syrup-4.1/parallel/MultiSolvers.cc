@@ -65,6 +65,7 @@ static IntOption opt_nbsolversmultithreads(_parallel, "nthreads", "Number of cor
 static IntOption opt_maxnbsolvers(_parallel, "maxnbthreads", "Maximum number of core threads to ask for (when nbthreads=0)", 4);
 static IntOption opt_maxmemory(_parallel, "maxmemory", "Maximum memory to use (in Mb, 0 for no software limit)", 20000);
 static IntOption opt_statsInterval(_parallel, "statsinterval", "Seconds (real time) between two stats reports", 5);
+static BoolOption opt_shareOriginals(_parallel, "shareoriginals", "Store the original clauses once for all threads", true);
 //
 // Shared with ClausesBuffer.cc
 BoolOption opt_whenFullRemoveOlder(_parallel, "removeolder", "When the FIFO for exchanging clauses between threads is full, remove older clauses", false);
@@ -96,7 +97,7 @@ MultiSolvers::MultiSolvers(ParallelSolver *s) :
         use_simplification(true), ok(true), maxnbthreads(4), nbthreads(opt_nbsolversmultithreads), nbsolvers(opt_nbsolversmultithreads), nbcompanions(4), nbcompbysolver(2),
         allClonesAreBuilt(0), showModel(false), winner(-1), var_decay(1 / 0.95), clause_decay(1 / 0.999), cla_inc(1), var_inc(1), random_var_freq(0.02), restart_first(100),
         restart_inc(1.5), learntsize_factor((double) 1 / (double) 3), learntsize_inc(1.1), expensive_ccmin(true), polarity_mode(polarity_false), maxmemory(opt_maxmemory),
-        maxnbsolvers(opt_maxnbsolvers), verb(0), verbEveryConflicts(10000), numvar(0), numclauses(0) {
+        maxnbsolvers(opt_maxnbsolvers), verb(0), verbEveryConflicts(10000), numvar(0), numclauses(0), originals(NULL) {
     result = l_Undef;
     SharedCompanion *sc = new SharedCompanion();
     this->sharedcomp = sc;
@@ -126,7 +127,9 @@ MultiSolvers::MultiSolvers() : MultiSolvers(new ParallelSolver(-1)) {
 }
 
 
-MultiSolvers::~MultiSolvers() { }
+MultiSolvers::~MultiSolvers() {
+    delete originals;
+}
 
 
 /**
@@ -153,6 +156,20 @@ void MultiSolvers::generateAllSolvers() {
 }
 
 
+/**
+ * Move the original clauses of solver 0 into one arena, before cloning it.
+ * Clones then only copy their watches and learnt clauses.
+ */
+
+void MultiSolvers::shareOriginalClauses() {
+    assert(allClonesAreBuilt == 0 && originals == NULL);
+    if(!opt_shareOriginals || nbsolvers == 1 || !okay()) return;
+
+    originals = new ClauseAllocator();
+    solvers[0]->shareOriginalClauses(*originals);
+}
+
+
 /**
  * Choose solver for threads i (if no given in command line see above)
  */
@@ -585,14 +602,18 @@ void MultiSolvers::adjustParameters() {
 
 void MultiSolvers::adjustNumberOfCores() {
     float mem = memUsed();
+    // The arena of the original clauses is allocated once, whatever the number of solvers
+    float shared = originals == NULL ? 0 : (float) originals->getCap() * ClauseAllocator::Unit_Size / (1024 * 1024);
     if(nbthreads == 0) { // Automatic configuration
         if(verb >= 1)
             printf("c |  Automatic Adjustement of the number of solvers. MaxMemory=%5d, MaxCores=%3d.                       |\n", maxmemory, maxnbsolvers);
-        unsigned int tmpnbsolvers = maxmemory * 4 / 10 / mem;
+        float bysolver = mem - shared > 1 ? mem - shared : 1;
+        float budget = (float) maxmemory * 4 / 10 - shared;
+        unsigned int tmpnbsolvers = budget > 0 ? budget / bysolver : 0;
         if(tmpnbsolvers > maxnbsolvers) tmpnbsolvers = maxnbsolvers;
         if(tmpnbsolvers < 1) tmpnbsolvers = 1;
         if(verb >= 1)
-            printf("c |  One Solver is taking %.2fMb... Let's take %d solvers for this run (max 40%% of the maxmemory).       |\n", mem, tmpnbsolvers);
+            printf("c |  One Solver is taking %.2fMb (+%.2fMb shared)... Let's take %d solvers for this run (max 40%% of the maxmemory).|\n", bysolver, shared, tmpnbsolvers);
         nbsolvers = tmpnbsolvers;
         nbthreads = nbsolvers;
     } else {
@@ -605,6 +626,7 @@ lbool MultiSolvers::solve() {
     pthread_attr_t thAttr;
     int i;
 
+    shareOriginalClauses();
     adjustNumberOfCores();
     sharedcomp->setNbThreads(nbsolvers);
     if(verb >= 1)
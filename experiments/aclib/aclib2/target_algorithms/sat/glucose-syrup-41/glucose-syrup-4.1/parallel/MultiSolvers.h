@@ -83,6 +83,7 @@ public:
   ParallelSolver *getPrimarySolver();
   
   void generateAllSolvers();
+  void shareOriginalClauses();
   
   // Solving:
   //
@@ -154,6 +155,7 @@ struct Stats {
     enum { polarity_true = 0, polarity_false = 1, polarity_user = 2, polarity_rnd = 3 };
 
    //ClauseAllocator     ca;
+   ClauseAllocator * originals; // Original clauses, read by all solvers (NULL if each one has its own copy)
    SharedCompanion * sharedcomp;
 
     void informEnd(lbool res);
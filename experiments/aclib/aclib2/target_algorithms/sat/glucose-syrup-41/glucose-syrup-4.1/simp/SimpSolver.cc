@@ -800,7 +800,7 @@ void SimpSolver::cleanUpClauses()
     occurs.cleanAll();
     int i,j;
     for (i = j = 0; i < clauses.size(); i++)
-        if (ca[clauses[i]].mark() == 0)
+        if (ca.mark(clauses[i]) == 0)
             clauses[j++] = clauses[i];
     clauses.shrink(i - j);
 }
@@ -160,7 +160,7 @@ class SimpSolver : public Solver {
     struct ClauseDeleted {
         const ClauseAllocator& ca;
         explicit ClauseDeleted(const ClauseAllocator& _ca) : ca(_ca) {}
-        bool operator()(const CRef& cr) const { return ca[cr].mark() == 1; } };
+        bool operator()(const CRef& cr) const { return ca.mark(cr) == 1; } };
 
     // Solver state:
     //
@@ -8,6 +8,9 @@ TCross::TCross( int N )
   fMaxNumOfABcycle = 2000; /* Set an appropriate value (2000 is usually enough) */
 
   fN = N;
+  fRand = tRand;
+  fFlagEdgeFreq = 1;
+  fEdgeFreqDiff.Define( fN, 0 );
   tBestTmp.Define( fN );
 
   near_data = new int* [ fN ];
@@ -181,7 +184,7 @@ void TCross::SetParents( const TIndi& tPa1, const TIndi& tPa2, int flagC[ 10 ],
 }
 
 
-void TCross::DoIt( TIndi& tKid, TIndi& tPa2, int numOfKids, int flagP, int flagC[ 10 ], int **fEdgeFreq )
+void TCross::DoIt( TIndi& tKid, TIndi& tPa2, int numOfKids, int flagP, int flagC[ 10 ], TEdgeFreq& fEdgeFreq )
 {
   int Num;     
   int jnum, centerAB; 
@@ -202,7 +205,7 @@ void TCross::DoIt( TIndi& tKid, TIndi& tPa2, int numOfKids, int flagP, int flagC
     Num = fNumOfABcycle;
 
   if( fEsetType == 1 ){         /* Single-AB */
-    tRand->Permutation( fPermu, fNumOfABcycle, fNumOfABcycle ); 
+    fRand->Permutation( fPermu, fNumOfABcycle, fNumOfABcycle ); 
   }
   else if( fEsetType == 2 ){    /* Block2 */
     for( int k =0; k< fNumOfABcycle; ++k )
@@ -231,7 +234,7 @@ void TCross::DoIt( TIndi& tKid, TIndi& tPa2, int numOfKids, int flagP, int flagC
 	  fABcycleInEset[ fNumOfABcycleInEset++ ] = s; 
 	else{
 	  if( fWeight_RR[ centerAB ][ s ] > 0 && fABcycle[ s ][ 0 ] < fABcycle[ centerAB ][ 0 ] ){
-	    if( rand() %2 == 0 )
+	    if( fRand->Rand() %2 == 0 )
 	      fABcycleInEset[ fNumOfABcycleInEset++ ] = s; 
 	  }
 	}
@@ -302,7 +305,8 @@ void TCross::DoIt( TIndi& tKid, TIndi& tPa2, int numOfKids, int flagP, int flagC
   if( fFlagImp == 1 ){           
     this->GoToBest( tKid ); 
     tKid.fEvaluationValue = tKid.fEvaluationValue - BestGain;
-    this->IncrementEdgeFreq( fEdgeFreq );
+    if( fFlagEdgeFreq == 1 )
+      this->IncrementEdgeFreq( fEdgeFreq );
   }
 }
 
@@ -338,7 +342,7 @@ void TCross::SetABcycle( const TIndi& tPa1, const TIndi& tPa2, int flagC[ 10 ],
     if(flag_st==1)          
     {
       fPosiCurr=0;
-      r=rand()%koritsu_many;
+      r=fRand->Rand()%koritsu_many;
       st=koritsu[r];    
       check_koritsu[st]=fPosiCurr;
       fRoute[fPosiCurr]=st;
@@ -362,7 +366,7 @@ void TCross::SetABcycle( const TIndi& tPa1, const TIndi& tPa2, int flagC[ 10 ],
 	ci=near_data[pr][fPosiCurr%2+1];
 	break;
       case 2:   
-	r=rand()%2;
+	r=fRand->Rand()%2;
 	ci=near_data[pr][fPosiCurr%2+1+2*r];
 	if(r==0) this->Swap(near_data[pr][fPosiCurr%2+1],near_data[pr][fPosiCurr%2+3]);
 	break;
@@ -461,7 +465,7 @@ void TCross::SetABcycle( const TIndi& tPa1, const TIndi& tPa2, int flagC[ 10 ],
   while(bunki_many!=0)
   {            
     fPosiCurr=0;   
-    r=rand()%bunki_many;
+    r=fRand->Rand()%bunki_many;
     st=bunki[r];
     fRoute[fPosiCurr]=st;
     ci=st;
@@ -560,8 +564,8 @@ void TCross::FormABcycle()
   diff = 0;
   for( j = 0; j < cem/2; ++j ) 
   {
-    diff = diff + eval->fEdgeDis[fC[2*j]][fC[1+2*j]]
-                - eval->fEdgeDis[fC[1+2*j]][fC[2+2*j]];
+    diff = diff + eval->Direct( fC[2*j], fC[1+2*j] )
+                - eval->Direct( fC[1+2*j], fC[2+2*j] );
   }
   fGainAB[fNumOfABcycle] = diff;
   ++fNumOfABcycle;
@@ -630,20 +634,84 @@ void TCross::ChangeSol( TIndi& tKid, int ABnum, int type )
 }
 
 
+/* Distance functors for SearchNearEdge() */
+class TDisMatrix {
+public:
+  TDisMatrix( int **edgeDis ) : fEdgeDis( edgeDis ) {}
+  int operator()( int i, int j ) const { return fEdgeDis[ i ][ j ]; }
+private:
+  int **fEdgeDis;
+};
+
+class TDisCoord {
+public:
+  TDisCoord( TEvaluator* eval ) : fEval( eval ) {}
+  int operator()( int i, int j ) const { return fEval->CalDis( i, j ); }
+private:
+  TEvaluator* fEval;
+};
+
+
+template <class TDis>
+void TCross::SearchNearEdge( TIndi& tKid, int nearMax, TDis dis, 
+			     int& max_diff, int& aa, int& bb, int& a1, int& b1 )
+{
+  int a, b, c, d, j1, j2, near_num, diff;
+  int dis_ab, dis_ac, dis_bc, dis_cd;
+
+  for( int s = 1; s <= fNumOfElementInCU; ++s )  
+  { 
+    a = fListOfCenterUnit[ s ];
+
+    for( near_num = 1; near_num <= nearMax; ++near_num )   
+    {
+      c = eval->fNearCity[ a ][ near_num ];
+      if( fCenterUnit[ c ] == 0 )   
+      {
+	/* The distances are symmetric, so each one is looked up only once */
+	dis_ac = dis( a, c );
+	for( j1 = 0; j1 < 2; ++j1 )
+	{
+	  b = fListOfCenterUnit[ s-1+2*j1 ];
+	  dis_ab = dis( a, b );
+	  dis_bc = dis( b, c );
+	  for( j2 = 0; j2 < 2; ++j2 )
+	  {
+	    d = tKid.fLink[ c ][ j2 ];
+	    dis_cd = dis( c, d );
+	    diff = dis_ab + dis_cd - dis_ac - dis( b, d );
+	    if( diff > max_diff ) 
+	    { 
+	      aa = a; bb = b; a1 = c; b1 = d;
+	      max_diff = diff;
+	    }
+	    diff = dis_ab + dis_cd - dis( a, d ) - dis_bc;
+	    if( diff > max_diff ) 
+	    {
+	      aa = a; bb = b; a1 = d; b1 = c;
+	      max_diff = diff;
+	    } 
+	  }
+	}
+      }
+    }
+  }
+}
+
+
 void TCross::MakeCompleteSol( TIndi& tKid )
 {
-  int j,j1,j2,j3;
-  int st,ci,pre,curr,next,a,b,c,d,aa,bb,a1,b1;
+  int j,j3;
+  int st,ci,pre,curr,next,a,b,c,aa,bb,a1,b1;
   int city_many;
   int remain_unit_many;
   int ucm;
   int unit_num;
   int min_unit_city; 
-  int near_num;
   int unit_many;               
   int center_un;               
   int select_un;               
-  int diff,max_diff;
+  int max_diff;
   int count;      
   int nearMax;
 
@@ -700,40 +768,12 @@ void TCross::MakeCompleteSol( TIndi& tKid )
     /* nearMax must be smaller than or equal to eva->fNearNumMax (kopt.cpp ) */
 
   RESTART:;
-    for( int s = 1; s <= fNumOfElementInCU; ++s )  
-    { 
-      a = fListOfCenterUnit[ s ];
-
-      for( near_num = 1; near_num <= nearMax; ++near_num )   
-      {
-	c = eval->fNearCity[ a ][ near_num ];
-	if( fCenterUnit[ c ] == 0 )   
-	{
-	  for( j1 = 0; j1 < 2; ++j1 )
-	  {
-	    b = fListOfCenterUnit[ s-1+2*j1 ];
-            for( j2 = 0; j2 < 2; ++j2 )
-	    {
-	      d = tKid.fLink[ c ][ j2 ];
-	      diff = eval->fEdgeDis[a][b] + eval->fEdgeDis[c][d] -
-                     eval->fEdgeDis[a][c] - eval->fEdgeDis[b][d];
-	      if( diff > max_diff ) 
-	      { 
-	        aa = a; bb = b; a1 = c; b1 = d;
-	        max_diff = diff;
-	      }
-	      diff = eval->fEdgeDis[a][b] + eval->fEdgeDis[d][c] - 
-		     eval->fEdgeDis[a][d] - eval->fEdgeDis[b][c];
-	      if( diff > max_diff ) 
-	      {
-	        aa = a; bb = b; a1 = d; b1 = c;
-	        max_diff = diff;
-	      } 
-	    }
-	  }
-	}
-      }
-    }
+    /* The test whether the distance matrix is stored is done once here 
+       instead of in every eval->Direct() of the search */
+    if( eval->fEdgeDis != NULL )
+      this->SearchNearEdge( tKid, nearMax, TDisMatrix( eval->fEdgeDis ), max_diff, aa, bb, a1, b1 );
+    else
+      this->SearchNearEdge( tKid, nearMax, TDisCoord( eval ), max_diff, aa, bb, a1, b1 );
 
     if( a1 == -1 && nearMax == 10 ){  /* This value must also be changed if nearMax is chenged above */
       nearMax = 50;
@@ -741,7 +781,7 @@ void TCross::MakeCompleteSol( TIndi& tKid )
     }    
     else if( a1 == -1 && nearMax == 50  )
     {       
-      int r = rand() % ( fNumOfElementInCU - 1 );
+      int r = fRand->Rand() % ( fNumOfElementInCU - 1 );
       a = fListOfCenterUnit[ r ];
       b = fListOfCenterUnit[ r+1 ];
       for( j = 0; j < fN; ++j )
@@ -754,8 +794,8 @@ void TCross::MakeCompleteSol( TIndi& tKid )
 	  break;
 	}
       }
-      max_diff = eval->fEdgeDis[aa][bb] + eval->fEdgeDis[a1][b1] -
-         	 eval->fEdgeDis[a][a1] - eval->fEdgeDis[b][b1];
+      max_diff = eval->Direct( aa, bb ) + eval->Direct( a1, b1 ) -
+         	 eval->Direct( a, a1 ) - eval->Direct( b, b1 );
     }  
 
     if( tKid.fLink[aa][0] == bb ) tKid.fLink[aa][0]=a1;
@@ -976,7 +1016,7 @@ void TCross::GoToBest( TIndi& tKid )
 }
 
 
-void TCross::IncrementEdgeFreq( int **fEdgeFreq )
+void TCross::IncrementEdgeFreq( TEdgeFreq& fEdgeFreq )
 {
   int j, jnum, cem;
   int r1, r2, b1, b2;
@@ -1001,10 +1041,10 @@ void TCross::IncrementEdgeFreq( int **fEdgeFreq )
       // r2 - r1 remove
       // r2 - b2 add
 
-      ++fEdgeFreq[ r1 ][ b1 ];
-      --fEdgeFreq[ r1 ][ r2 ];
-      --fEdgeFreq[ r2 ][ r1 ];
-      ++fEdgeFreq[ r2 ][ b2 ];
+      fEdgeFreq.Inc( r1, b1 );
+      fEdgeFreq.Dec( r1, r2 );
+      fEdgeFreq.Dec( r2, r1 );
+      fEdgeFreq.Inc( r2, b2 );
 
     }
   }
@@ -1016,25 +1056,26 @@ void TCross::IncrementEdgeFreq( int **fEdgeFreq )
     a1 = fBestModiEdge[ s ][ 2 ];   
     b1 = fBestModiEdge[ s ][ 3 ];
 
-    --fEdgeFreq[ aa ][ bb ];
-    --fEdgeFreq[ a1 ][ b1 ];
-    ++fEdgeFreq[ aa ][ a1 ];
-    ++fEdgeFreq[ bb ][ b1 ];
-    --fEdgeFreq[ bb ][ aa ];
-    --fEdgeFreq[ b1 ][ a1 ];
-    ++fEdgeFreq[ a1 ][ aa ];
-    ++fEdgeFreq[ b1 ][ bb ];
+    fEdgeFreq.Dec( aa, bb );
+    fEdgeFreq.Dec( a1, b1 );
+    fEdgeFreq.Inc( aa, a1 );
+    fEdgeFreq.Inc( bb, b1 );
+    fEdgeFreq.Dec( bb, aa );
+    fEdgeFreq.Dec( b1, a1 );
+    fEdgeFreq.Inc( a1, aa );
+    fEdgeFreq.Inc( b1, bb );
   }
 }
 
 
-int TCross::Cal_ADP_Loss( int **fEdgeFreq )
+int TCross::Cal_ADP_Loss( TEdgeFreq& fEdgeFreq )
 {
   int j, jnum, cem;
   int r1, r2, b1, b2;
   int aa, bb, a1;
   double DLoss; 
   double h1, h2;
+  TEdgeFreq& fEdgeFreqTmp = ( fFlagEdgeFreq == 1 ) ? fEdgeFreq : fEdgeFreqDiff;
 
   
   DLoss = 0;
@@ -1057,18 +1098,18 @@ int TCross::Cal_ADP_Loss( int **fEdgeFreq )
       // r2 - r1 remove
       // r2 - b2 add
 
-      DLoss -= (fEdgeFreq[ r1 ][ r2 ]-1);
-      DLoss -= (fEdgeFreq[ r2 ][ r1 ]-1);
-      DLoss += fEdgeFreq[ r2 ][ b2 ];
-      DLoss += fEdgeFreq[ b2 ][ r2 ];
+      DLoss -= (this->GetFreq( fEdgeFreq, r1, r2 )-1);
+      DLoss -= (this->GetFreq( fEdgeFreq, r2, r1 )-1);
+      DLoss += this->GetFreq( fEdgeFreq, r2, b2 );
+      DLoss += this->GetFreq( fEdgeFreq, b2, r2 );
 
       // Remove
-      --fEdgeFreq[ r1 ][ r2 ]; 
-      --fEdgeFreq[ r2 ][ r1 ]; 
+      fEdgeFreqTmp.Dec( r1, r2 ); 
+      fEdgeFreqTmp.Dec( r2, r1 ); 
 
       // Add
-      ++fEdgeFreq[ r2 ][ b2 ]; 
-      ++fEdgeFreq[ b2 ][ r2 ]; 
+      fEdgeFreqTmp.Inc( r2, b2 ); 
+      fEdgeFreqTmp.Inc( b2, r2 ); 
     }
   }
 
@@ -1080,27 +1121,27 @@ int TCross::Cal_ADP_Loss( int **fEdgeFreq )
     a1 = fModiEdge[ s ][ 2 ];   
     b1 = fModiEdge[ s ][ 3 ];
 
-    DLoss -= (fEdgeFreq[ aa ][ bb ]-1);
-    DLoss -= (fEdgeFreq[ bb ][ aa ]-1);
-    DLoss -= (fEdgeFreq[ a1 ][ b1 ]-1);
-    DLoss -= (fEdgeFreq[ b1 ][ a1 ]-1);
+    DLoss -= (this->GetFreq( fEdgeFreq, aa, bb )-1);
+    DLoss -= (this->GetFreq( fEdgeFreq, bb, aa )-1);
+    DLoss -= (this->GetFreq( fEdgeFreq, a1, b1 )-1);
+    DLoss -= (this->GetFreq( fEdgeFreq, b1, a1 )-1);
 
-    DLoss += fEdgeFreq[ aa ][ a1 ];
-    DLoss += fEdgeFreq[ a1 ][ aa ];
-    DLoss += fEdgeFreq[ bb ][ b1 ];
-    DLoss += fEdgeFreq[ b1 ][ bb ];
+    DLoss += this->GetFreq( fEdgeFreq, aa, a1 );
+    DLoss += this->GetFreq( fEdgeFreq, a1, aa );
+    DLoss += this->GetFreq( fEdgeFreq, bb, b1 );
+    DLoss += this->GetFreq( fEdgeFreq, b1, bb );
 
     // Remove
-    --fEdgeFreq[ aa ][ bb ];
-    --fEdgeFreq[ bb ][ aa ];
-    --fEdgeFreq[ a1 ][ b1 ];
-    --fEdgeFreq[ b1 ][ a1 ];
+    fEdgeFreqTmp.Dec( aa, bb );
+    fEdgeFreqTmp.Dec( bb, aa );
+    fEdgeFreqTmp.Dec( a1, b1 );
+    fEdgeFreqTmp.Dec( b1, a1 );
 
     // Add
-    ++fEdgeFreq[ aa ][ a1 ];
-    ++fEdgeFreq[ a1 ][ aa ];
-    ++fEdgeFreq[ bb ][ b1 ];
-    ++fEdgeFreq[ b1 ][ bb ];
+    fEdgeFreqTmp.Inc( aa, a1 );
+    fEdgeFreqTmp.Inc( a1, aa );
+    fEdgeFreqTmp.Inc( bb, b1 );
+    fEdgeFreqTmp.Inc( b1, bb );
   }
 
   
@@ -1118,10 +1159,10 @@ int TCross::Cal_ADP_Loss( int **fEdgeFreq )
       r1 = fC[2+2*j]; r2 = fC[3+2*j]; 
       b1 = fC[1+2*j]; b2 = fC[4+2*j]; 
 
-      ++fEdgeFreq[ r1 ][ r2 ]; 
-      ++fEdgeFreq[ r2 ][ r1 ]; 
-      --fEdgeFreq[ r2 ][ b2 ]; 
-      --fEdgeFreq[ b2 ][ r2 ]; 
+      fEdgeFreqTmp.Inc( r1, r2 ); 
+      fEdgeFreqTmp.Inc( r2, r1 ); 
+      fEdgeFreqTmp.Dec( r2, b2 ); 
+      fEdgeFreqTmp.Dec( b2, r2 ); 
     }
   }
 
@@ -1134,17 +1175,17 @@ int TCross::Cal_ADP_Loss( int **fEdgeFreq )
     b1 = fModiEdge[ s ][ 3 ];
 
     // Remove
-    ++fEdgeFreq[ aa ][ bb ];
-    ++fEdgeFreq[ bb ][ aa ];
+    fEdgeFreqTmp.Inc( aa, bb );
+    fEdgeFreqTmp.Inc( bb, aa );
 
-    ++fEdgeFreq[ a1 ][ b1 ];
-    ++fEdgeFreq[ b1 ][ a1 ];
+    fEdgeFreqTmp.Inc( a1, b1 );
+    fEdgeFreqTmp.Inc( b1, a1 );
 
-    --fEdgeFreq[ aa ][ a1 ];
-    --fEdgeFreq[ a1 ][ aa ];
+    fEdgeFreqTmp.Dec( aa, a1 );
+    fEdgeFreqTmp.Dec( a1, aa );
 
-    --fEdgeFreq[ bb ][ b1 ];
-    --fEdgeFreq[ b1 ][ bb ];
+    fEdgeFreqTmp.Dec( bb, b1 );
+    fEdgeFreqTmp.Dec( b1, bb );
 
   }
 
@@ -1152,13 +1193,14 @@ int TCross::Cal_ADP_Loss( int **fEdgeFreq )
 }
 
 
-double TCross::Cal_ENT_Loss( int **fEdgeFreq )
+double TCross::Cal_ENT_Loss( TEdgeFreq& fEdgeFreq )
 {
   int j, jnum, cem;
   int r1, r2, b1, b2;
   int aa, bb, a1;
   double DLoss; 
   double h1, h2;
+  TEdgeFreq& fEdgeFreqTmp = ( fFlagEdgeFreq == 1 ) ? fEdgeFreq : fEdgeFreqDiff;
 
   
   DLoss = 0;
@@ -1183,22 +1225,22 @@ double TCross::Cal_ENT_Loss( int **fEdgeFreq )
       // r2 - b2 add
 
       // Remove
-      h1 = (double)( fEdgeFreq[ r1 ][ r2 ] - 1 )/(double)fNumOfPop;
-      h2 = (double)( fEdgeFreq[ r1 ][ r2 ] )/(double)fNumOfPop;
-      if( fEdgeFreq[ r1 ][ r2 ] - 1 != 0 )
+      h1 = (double)( this->GetFreq( fEdgeFreq, r1, r2 ) - 1 )/(double)fNumOfPop;
+      h2 = (double)( this->GetFreq( fEdgeFreq, r1, r2 ) )/(double)fNumOfPop;
+      if( this->GetFreq( fEdgeFreq, r1, r2 ) - 1 != 0 )
 	DLoss -= h1 * log( h1 );
       DLoss += h2 * log( h2 );
-      --fEdgeFreq[ r1 ][ r2 ]; 
-      --fEdgeFreq[ r2 ][ r1 ]; 
+      fEdgeFreqTmp.Dec( r1, r2 ); 
+      fEdgeFreqTmp.Dec( r2, r1 ); 
 
       // Add
-      h1 = (double)( fEdgeFreq[ r2 ][ b2 ] + 1 )/(double)fNumOfPop;
-      h2 = (double)( fEdgeFreq[ r2 ][ b2 ])/(double)fNumOfPop;
+      h1 = (double)( this->GetFreq( fEdgeFreq, r2, b2 ) + 1 )/(double)fNumOfPop;
+      h2 = (double)( this->GetFreq( fEdgeFreq, r2, b2 ))/(double)fNumOfPop;
       DLoss -= h1 * log( h1 );
-      if( fEdgeFreq[ r2 ][ b2 ] != 0 )
+      if( this->GetFreq( fEdgeFreq, r2, b2 ) != 0 )
 	DLoss += h2 * log( h2 );
-      ++fEdgeFreq[ r2 ][ b2 ]; 
-      ++fEdgeFreq[ b2 ][ r2 ]; 
+      fEdgeFreqTmp.Inc( r2, b2 ); 
+      fEdgeFreqTmp.Inc( b2, r2 ); 
     }
   }
 
@@ -1211,42 +1253,42 @@ double TCross::Cal_ENT_Loss( int **fEdgeFreq )
     b1 = fModiEdge[ s ][ 3 ];
 
     // Remove
-    h1 = (double)( fEdgeFreq[ aa ][ bb ] - 1 )/(double)fNumOfPop;
-    h2 = (double)( fEdgeFreq[ aa ][ bb ] )/(double)fNumOfPop;
-    if( fEdgeFreq[ aa ][ bb ] - 1 != 0 )
+    h1 = (double)( this->GetFreq( fEdgeFreq, aa, bb ) - 1 )/(double)fNumOfPop;
+    h2 = (double)( this->GetFreq( fEdgeFreq, aa, bb ) )/(double)fNumOfPop;
+    if( this->GetFreq( fEdgeFreq, aa, bb ) - 1 != 0 )
       DLoss -= h1 * log( h1 );
     DLoss += h2 * log( h2 );
-    --fEdgeFreq[ aa ][ bb ];
-    --fEdgeFreq[ bb ][ aa ];
+    fEdgeFreqTmp.Dec( aa, bb );
+    fEdgeFreqTmp.Dec( bb, aa );
 
-    h1 = (double)( fEdgeFreq[ a1 ][ b1 ] - 1 )/(double)fNumOfPop;
-    h2 = (double)( fEdgeFreq[ a1 ][ b1 ] )/(double)fNumOfPop;
-    if( fEdgeFreq[ a1 ][ b1 ] - 1 != 0 )
+    h1 = (double)( this->GetFreq( fEdgeFreq, a1, b1 ) - 1 )/(double)fNumOfPop;
+    h2 = (double)( this->GetFreq( fEdgeFreq, a1, b1 ) )/(double)fNumOfPop;
+    if( this->GetFreq( fEdgeFreq, a1, b1 ) - 1 != 0 )
       DLoss -= h1 * log( h1 );
     DLoss += h2 * log( h2 );
-    --fEdgeFreq[ a1 ][ b1 ];
-    --fEdgeFreq[ b1 ][ a1 ];
+    fEdgeFreqTmp.Dec( a1, b1 );
+    fEdgeFreqTmp.Dec( b1, a1 );
 
     // Add
-    h1 = (double)( fEdgeFreq[ aa ][ a1 ] + 1 )/(double)fNumOfPop;
-    h2 = (double)( fEdgeFreq[ aa ][ a1 ])/(double)fNumOfPop;
+    h1 = (double)( this->GetFreq( fEdgeFreq, aa, a1 ) + 1 )/(double)fNumOfPop;
+    h2 = (double)( this->GetFreq( fEdgeFreq, aa, a1 ))/(double)fNumOfPop;
     DLoss -= h1 * log( h1 );
-    if( fEdgeFreq[ aa ][ a1 ] != 0 )
+    if( this->GetFreq( fEdgeFreq, aa, a1 ) != 0 )
       DLoss += h2 * log( h2 );
-    ++fEdgeFreq[ aa ][ a1 ];
-    ++fEdgeFreq[ a1 ][ aa ];
+    fEdgeFreqTmp.Inc( aa, a1 );
+    fEdgeFreqTmp.Inc( a1, aa );
 
-    h1 = (double)( fEdgeFreq[ bb ][ b1 ] + 1 )/(double)fNumOfPop;
-    h2 = (double)( fEdgeFreq[ bb ][ b1 ])/(double)fNumOfPop;
+    h1 = (double)( this->GetFreq( fEdgeFreq, bb, b1 ) + 1 )/(double)fNumOfPop;
+    h2 = (double)( this->GetFreq( fEdgeFreq, bb, b1 ))/(double)fNumOfPop;
     DLoss -= h1 * log( h1 );
-    if( fEdgeFreq[ bb ][ b1 ] != 0 )
+    if( this->GetFreq( fEdgeFreq, bb, b1 ) != 0 )
       DLoss += h2 * log( h2 );
-    ++fEdgeFreq[ bb ][ b1 ];
-    ++fEdgeFreq[ b1 ][ bb ];
+    fEdgeFreqTmp.Inc( bb, b1 );
+    fEdgeFreqTmp.Inc( b1, bb );
   }
   DLoss = -DLoss;  
 
-  // restore EdgeFreq
+  // restore EdgeFreq (fEdgeFreqDiff becomes empty again if it was used)
   for( int s = 0; s < fNumOfAppliedCycle; ++s ){
     jnum = fAppliedCylce[ s ];
     
@@ -1261,10 +1303,10 @@ double TCross::Cal_ENT_Loss( int **fEdgeFreq )
       r1 = fC[2+2*j]; r2 = fC[3+2*j]; 
       b1 = fC[1+2*j]; b2 = fC[4+2*j]; 
 
-      ++fEdgeFreq[ r1 ][ r2 ]; 
-      ++fEdgeFreq[ r2 ][ r1 ]; 
-      --fEdgeFreq[ r2 ][ b2 ]; 
-      --fEdgeFreq[ b2 ][ r2 ]; 
+      fEdgeFreqTmp.Inc( r1, r2 ); 
+      fEdgeFreqTmp.Inc( r2, r1 ); 
+      fEdgeFreqTmp.Dec( r2, b2 ); 
+      fEdgeFreqTmp.Dec( b2, r2 ); 
     }
   }
 
@@ -1275,17 +1317,17 @@ double TCross::Cal_ENT_Loss( int **fEdgeFreq )
     a1 = fModiEdge[ s ][ 2 ];   
     b1 = fModiEdge[ s ][ 3 ];
 
-    ++fEdgeFreq[ aa ][ bb ];
-    ++fEdgeFreq[ bb ][ aa ];
+    fEdgeFreqTmp.Inc( aa, bb );
+    fEdgeFreqTmp.Inc( bb, aa );
 
-    ++fEdgeFreq[ a1 ][ b1 ];
-    ++fEdgeFreq[ b1 ][ a1 ];
+    fEdgeFreqTmp.Inc( a1, b1 );
+    fEdgeFreqTmp.Inc( b1, a1 );
 
-    --fEdgeFreq[ aa ][ a1 ];
-    --fEdgeFreq[ a1 ][ aa ];
+    fEdgeFreqTmp.Dec( aa, a1 );
+    fEdgeFreqTmp.Dec( a1, aa );
 
-    --fEdgeFreq[ bb ][ b1 ];
-    --fEdgeFreq[ b1 ][ bb ];
+    fEdgeFreqTmp.Dec( bb, b1 );
+    fEdgeFreqTmp.Dec( b1, bb );
 
   }
 
@@ -1493,7 +1535,7 @@ void TCross::Search_Eset( int centerAB )
       else if( flag_AddDelete == -1 )
 	this->Delete_AB( selected_AB );
       
-      fMoved_AB[ selected_AB ] = nIter + tRand->Integer( 1, fTmax ); 
+      fMoved_AB[ selected_AB ] = nIter + fRand->Integer( 1, fTmax ); 
       assert( fBest_Num_C == fNum_C );
       fBest_Num_E = fNum_E;
 
@@ -1512,7 +1554,7 @@ void TCross::Search_Eset( int centerAB )
       else if( flag_AddDelete_nt == -1 )
 	this->Delete_AB( selected_AB_nt );
 
-      fMoved_AB[ selected_AB_nt ] = nIter + tRand->Integer( 1, fTmax ); 
+      fMoved_AB[ selected_AB_nt ] = nIter + fRand->Integer( 1, fTmax ); 
     } 
 
     if( flag_AddDelete == 0 )
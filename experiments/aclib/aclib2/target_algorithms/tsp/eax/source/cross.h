@@ -17,6 +17,10 @@
 #include "evaluator.h"
 #endif
 
+#ifndef __EDGEFREQ__
+#include "edgefreq.h"
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
@@ -29,7 +33,7 @@ public:
   void SetParents( const TIndi& tPa1, const TIndi& tPa2,     /* Set information of the parent tours */
 		   int flagC[ 10 ], int numOfKids ); 
   void DoIt( TIndi& tKid, TIndi& tPa2, int numOfKids,        /* Main procedure of EAX */
-	     int flagP, int flagC[ 10 ], int** fEdgeFreq ); 
+	     int flagP, int flagC[ 10 ], TEdgeFreq& fEdgeFreq ); 
   void SetABcycle( const TIndi& parent1, const TIndi& parent2, /* Step 2 of EAX */
 		   int flagC[ 10 ], int numOfKids );
   void FormABcycle();                                   /* Store an AB-cycle found */
@@ -37,11 +41,20 @@ public:
   void ChangeSol( TIndi& tKid, int ABnum, int type );   /* Apply an AB-cycle to an intermediate solution */
   void MakeCompleteSol( TIndi& tKid );                  /* Step 5 of EAX */
   void MakeUnit();                                      /* Step 5-1 of EAX */ 
+  template <class TDis>                                 /* Search the best 2-opt move joining the */
+  void SearchNearEdge( TIndi& tKid, int nearMax, TDis dis, /* center unit with a near city (Step 5-2) */
+		       int& max_diff, int& aa, int& bb, int& a1, int& b1 );
   void BackToPa1( TIndi& tKid );                        /* Undo the parent p_A */
   void GoToBest( TIndi& tKid );                         /* Modify tKid to the best offspring solution */
-  void IncrementEdgeFreq( int **fEdgeFreq );            /* Increment fEdgeFreq[][] */
-  int Cal_ADP_Loss( int **fEdgeFreq );                  /* Compute the difference in the averate distance */
-  double Cal_ENT_Loss( int **fEdgeFreq );               /* Compute the difference in the edge entropy */
+  void IncrementEdgeFreq( TEdgeFreq& fEdgeFreq );       /* Increment fEdgeFreq[][] */
+  int Cal_ADP_Loss( TEdgeFreq& fEdgeFreq );             /* Compute the difference in the averate distance */
+  double Cal_ENT_Loss( TEdgeFreq& fEdgeFreq );          /* Compute the difference in the edge entropy */
+  int GetFreq( TEdgeFreq& fEdgeFreq, int a, int b )     /* fEdgeFreq[a][b] with the temporary changes */
+  {
+    if( fFlagEdgeFreq == 1 )
+      return fEdgeFreq.Get( a, b );
+    return fEdgeFreq.Get( a, b ) + fEdgeFreqDiff.Get( a, b ); 
+  }
 
   void SetWeight( const TIndi& parent1, const TIndi& parent2 ); /* Block2 */
   int Cal_C_Naive();                                            /* Block2 */
@@ -55,9 +68,13 @@ public:
   int fNumOfGeneratedCh;
   TEvaluator* eval;			 
   int fNumOfPop;
+  TRandom* fRand;                       /* Random number sequence (tRand by default) */
+  int fFlagEdgeFreq;                    /* 1: fEdgeFreq[][] is updated in DoIt(), 0: it is only read (shared by threads) */
   
 private:
   int fFlagImp;         
+  TEdgeFreq fEdgeFreqDiff;  /* Temporary changes of fEdgeFreq[][] in Cal_ADP_Loss() and Cal_ENT_Loss() 
+                               (only if fFlagEdgeFreq = 0, otherwise fEdgeFreq[][] is changed and restored) */
   int fN;
   TIndi tBestTmp;
   int r,exam;
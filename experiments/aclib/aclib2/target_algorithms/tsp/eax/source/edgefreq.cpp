@@ -0,0 +1,87 @@
+#ifndef __EDGEFREQ__
+#include "edgefreq.h"
+#endif
+
+
+TEdgeFreq::TEdgeFreq()
+{
+  fN = 0;
+  fMatrix = NULL;
+  fNum = NULL;
+  fSize = NULL;
+  fTo = NULL;
+  fFreq = NULL;
+}
+
+
+TEdgeFreq::~TEdgeFreq()
+{
+  if( fMatrix != NULL ){
+    for( int i = 0; i < fN; ++i ) 
+      delete [] fMatrix[ i ];
+    delete [] fMatrix;
+  }
+  if( fTo != NULL ){
+    for( int i = 0; i < fN; ++i ){ 
+      delete [] fTo[ i ];
+      delete [] fFreq[ i ];
+    }
+  }
+  delete [] fTo;
+  delete [] fFreq;
+  delete [] fNum;
+  delete [] fSize;
+}
+
+
+void TEdgeFreq::Define( int N, int flagMatrix )
+{
+  fN = N;
+  if( flagMatrix == 1 ){
+    fMatrix = new int* [ fN ];
+    for( int i = 0; i < fN; ++i ) 
+      fMatrix[ i ] = new int [ fN ];
+    this->Clear();
+    return;
+  }
+  fNum = new int [ fN ];
+  fSize = new int [ fN ];
+  fTo = new int* [ fN ];
+  fFreq = new int* [ fN ];
+  for( int i = 0; i < fN; ++i ){ 
+    fNum[ i ] = 0;
+    fSize[ i ] = 4;
+    fTo[ i ] = new int [ fSize[ i ] ];
+    fFreq[ i ] = new int [ fSize[ i ] ];
+  }
+}
+
+
+void TEdgeFreq::Clear()
+{
+  if( fMatrix != NULL ){
+    for( int i = 0; i < fN; ++i ) 
+      for( int j = 0; j < fN; ++j ) 
+	fMatrix[ i ][ j ] = 0;
+    return;
+  }
+  for( int i = 0; i < fN; ++i ) 
+    fNum[ i ] = 0;
+}
+
+
+void TEdgeFreq::Extend( int a )
+{
+  int size = 2 * fSize[ a ];
+  int *to = new int [ size ];
+  int *freq = new int [ size ];
+  for( int k = 0; k < fNum[ a ]; ++k ){
+    to[ k ] = fTo[ a ][ k ];
+    freq[ k ] = fFreq[ a ][ k ];
+  }
+  delete [] fTo[ a ];
+  delete [] fFreq[ a ];
+  fTo[ a ] = to;
+  fFreq[ a ] = freq;
+  fSize[ a ] = size;
+}
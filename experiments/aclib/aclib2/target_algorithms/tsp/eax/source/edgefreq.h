@@ -0,0 +1,71 @@
+#ifndef __EDGEFREQ__
+#define __EDGEFREQ__
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+
+
+/* Frequency of the edges of the population. For small instances the 
+   frequencies are stored in a full N x N matrix as for the distances (see 
+   TEvaluator::fEdgeDis). Otherwise only the edges with a non-zero frequency 
+   are stored, in a short list per city, since the edges of the population 
+   concentrate on a few neighbors of each city. */
+class TEdgeFreq {
+public:
+  TEdgeFreq();
+  ~TEdgeFreq();
+  void Define( int N, int flagMatrix );  /* Allocate the matrix (flagMatrix = 1) or 
+                                            the lists of the N cities */
+  void Clear();                          /* Set all the frequencies to zero */
+
+  int Get( int a, int b )                /* Frequency of the edge (a,b) */
+  {
+    if( fMatrix != NULL )
+      return fMatrix[ a ][ b ];
+    for( int k = 0; k < fNum[ a ]; ++k )
+      if( fTo[ a ][ k ] == b ) 
+	return fFreq[ a ][ k ];
+    return 0;
+  }
+
+  void Inc( int a, int b ) { this->Add( a, b, 1 ); }   /* ++fEdgeFreq[a][b] */
+  void Dec( int a, int b ) { this->Add( a, b, -1 ); }  /* --fEdgeFreq[a][b] */
+
+  void Add( int a, int b, int d )        /* Add d to the frequency of the edge (a,b) */
+  {
+    if( fMatrix != NULL ){
+      fMatrix[ a ][ b ] += d;
+      return;
+    }
+    int k;
+    for( k = 0; k < fNum[ a ]; ++k )
+      if( fTo[ a ][ k ] == b ) 
+	break;
+    if( k == fNum[ a ] ){
+      if( k == fSize[ a ] ) 
+	this->Extend( a );
+      fTo[ a ][ k ] = b;
+      fFreq[ a ][ k ] = 0;
+      ++fNum[ a ];
+    }
+    fFreq[ a ][ k ] += d;
+    if( fFreq[ a ][ k ] == 0 ){          /* Remove the entry */
+      --fNum[ a ];
+      fTo[ a ][ k ] = fTo[ a ][ fNum[ a ] ];
+      fFreq[ a ][ k ] = fFreq[ a ][ fNum[ a ] ];
+    }
+  }
+
+private:
+  void Extend( int a );                  /* Double the size of the list of a */
+
+  int fN;
+  int **fMatrix;                         /* fMatrix[a][b]: frequency of (a,b) (NULL if the lists are used) */
+  int *fNum;                             /* fNum[a]: number of the edges (a,*) stored */
+  int *fSize;                            /* fSize[a]: size of fTo[a][] and fFreq[a][] */
+  int **fTo;                             /* fTo[a][k]: the other end of the k-th edge of a */
+  int **fFreq;                           /* fFreq[a][k]: frequency of the k-th edge of a */
+};
+
+#endif
@@ -8,9 +8,16 @@
 void MakeRandSol( TEvaluator* eval , TIndi& indi );
 void Make2optSol( TEvaluator* eval , TIndi& indi );
 
+struct TThreadArg {
+  TEnvironment* env;
+  int t;
+};
+
+
 TEnvironment::TEnvironment()
 {
   fEvaluator = new TEvaluator();
+  fNumOfThread = 1;
 }
 
 
@@ -21,10 +28,15 @@ TEnvironment::~TEnvironment()
   delete fEvaluator;
   delete tCross;
 
-  int N = fEvaluator->Ncity;
-  for( int i = 0; i < N; ++i ) 
-    delete [] fEdgeFreq[ i ];
-  delete [] fEdgeFreq;
+  if( fNumOfThread > 1 ){
+    for( int t = 0; t < fNumOfThread; ++t ) 
+      delete tCrossOfThread[ t ];
+    delete [] tCrossOfThread;
+    delete [] tRandOfThread;
+    delete [] tKidPop;
+    delete [] fSeedOfPair;
+    delete [] fNumOfChOfPair;
+  }
 }
 
 
@@ -49,9 +61,24 @@ void TEnvironment::Define()
   tKopt->eval = fEvaluator;
   tKopt->SetInvNearList();
 
-  fEdgeFreq = new int* [ N ]; 
-  for( int i = 0; i < N; ++i ) 
-    fEdgeFreq[ i ] = new int [ N ]; 
+  fEdgeFreq.Define( N, N <= fEvaluator->fMaxNcityForEdgeDis );
+
+  if( fNumOfThread > 1 ){
+    tCrossOfThread = new TCross* [ fNumOfThread ];
+    tRandOfThread = new TRandom [ fNumOfThread ];
+    for( int t = 0; t < fNumOfThread; ++t ){
+      tCrossOfThread[ t ] = new TCross( N );
+      tCrossOfThread[ t ]->eval = fEvaluator;
+      tCrossOfThread[ t ]->fNumOfPop = fNumOfPop;
+      tCrossOfThread[ t ]->fRand = &tRandOfThread[ t ];
+      tCrossOfThread[ t ]->fFlagEdgeFreq = 0;
+    }
+    tKidPop = new TIndi [ fNumOfPop ];
+    for ( int i = 0; i < fNumOfPop; ++i )
+      tKidPop[ i ].Define( N );
+    fSeedOfPair = new int [ fNumOfPop ];
+    fNumOfChOfPair = new int [ fNumOfPop ];
+  }
 }
 
 
@@ -60,14 +87,14 @@ void TEnvironment::DoIt()
 	
 // end hh added
 
-  this->fTimeStart = clock();   
+  this->fTimeStart = this->GetTime();   
 
   if( fFileNameInitPop == NULL )
     this->InitPop();                       
   else
     this->ReadPop( fFileNameInitPop );     
 
-  this->fTimeInit = clock();    
+  this->fTimeInit = this->GetTime();    
 
 // hh changed (added restart mechanism):
 	noFurtherRestarts = 0;
@@ -87,17 +114,20 @@ void TEnvironment::DoIt()
 
               this->SelectForMating();
 
-              for( int s =0; s < fNumOfPop; ++s )
-                {
-                  this->GenerateKids( s );     
-                  this->SelectForSurvival( s ); 
-                }
+              if( fNumOfThread > 1 )
+                this->GenerateKidsParallel();
+              else
+                for( int s =0; s < fNumOfPop; ++s )
+                  {
+                    this->GenerateKids( s );     
+                    this->SelectForSurvival( s ); 
+                  }
               ++fCurNumOfGen;
             }
 
           // hh changed: control restart loop
           if (this->noFurtherRestarts == 0) {
-            printf ("hh: restarting, best_in_restart %d avg_pop %lf time_to_global_best = %lf.. \n",fBestValue, fAverageValue, ((double)(clock() - this->fTimeStart)/(double)CLOCKS_PER_SEC));
+            printf ("hh: restarting, best_in_restart %d avg_pop %lf time_to_global_best = %lf.. \n",fBestValue, fAverageValue, (this->GetTime() - this->fTimeStart));
             this->InitPop();                       
 	
           }
@@ -105,7 +135,7 @@ void TEnvironment::DoIt()
 
         } // hh: end restart loop
 
-  this->fTimeEnd = clock();   
+  this->fTimeEnd = this->GetTime();   
 }
  
 
@@ -133,8 +163,8 @@ bool TEnvironment::TerminationCondition()
           returnCode = true;
         }
         // jdl: Once we're sure everything works as expected, we can comment next line:
-        if (((double)(clock() - this->fTimeStart)/(double)CLOCKS_PER_SEC) > fCutoffTime){
-          printf ("jdl: stopping because current time (%lf) larger than cut-off time (%lf)\n", ((double)(clock() - this->fTimeStart)/(double)CLOCKS_PER_SEC), fCutoffTime);
+        if ((this->GetTime() - this->fTimeStart) > fCutoffTime){
+          printf ("jdl: stopping because current time (%lf) larger than cut-off time (%lf)\n", (this->GetTime() - this->fTimeStart), fCutoffTime);
 	  this->noFurtherRestarts = 1;
           returnCode = true;
         }
@@ -145,7 +175,7 @@ bool TEnvironment::TerminationCondition()
   
   // jdl added this code block, and changed the 3 "return true" above into a variable assignment
   if ( returnCode ) {
-    timeLastRunTook = (double)(clock() - this->fTimeStart)/(double)CLOCKS_PER_SEC;    
+    timeLastRunTook = this->GetTime() - this->fTimeStart;    
     return true;
   }
 
@@ -188,7 +218,7 @@ void TEnvironment::SetAverageBest()
   // ts: Added the check as the best solution in the population may be the first one (index 0); otherwise wrong report in screen output
   if (fBestValue < fBestValueOverall) {
     fBestValueOverall = fBestValue;
-    timeToFindBestSol = (double)(clock() - this->fTimeStart)/(double)CLOCKS_PER_SEC;    
+    timeToFindBestSol = this->GetTime() - this->fTimeStart;    
   }
   
   for(int i = 0; i < fNumOfPop; ++i ){
@@ -199,7 +229,7 @@ void TEnvironment::SetAverageBest()
       // jdl added 2 lines below
       if (fBestValue < fBestValueOverall) {
         fBestValueOverall = fBestValue;
-        timeToFindBestSol = (double)(clock() - this->fTimeStart)/(double)CLOCKS_PER_SEC;    
+        timeToFindBestSol = this->GetTime() - this->fTimeStart;    
       }
     }
   }
@@ -249,14 +279,85 @@ void TEnvironment::GenerateKids( int s )
 }
 
 
+void TEnvironment::GenerateKidsParallel()
+{
+  /* Each pair of parents is crossed with the population and the edge frequencies at the 
+     beginning of the generation and with its own random number sequence. Hence the result 
+     depends on the random seed only, not on the number of threads or their scheduling. 
+     The offspring solutions replace the parents and fEdgeFreq[][] is recomputed afterwards. */
+  for( int s = 0; s < fNumOfPop; ++s )
+    fSeedOfPair[ s ] = tRand->Rand();
+  fNextPair = 0;
+
+  pthread_t thread[ fNumOfThread ];
+  TThreadArg arg[ fNumOfThread ];
+  for( int t = 0; t < fNumOfThread; ++t ){
+    arg[ t ].env = this;
+    arg[ t ].t = t;
+    if( pthread_create( &thread[ t ], NULL, TEnvironment::RunGenerateKids, &arg[ t ] ) != 0 ){
+      printf( "Error in creating a thread\n" );
+      exit( 1 );
+    }
+  }
+  for( int t = 0; t < fNumOfThread; ++t )
+    pthread_join( thread[ t ], NULL );
+
+  for( int s = 0; s < fNumOfPop; ++s ){
+    tCurPop[ fIndexForMating[ s ] ] = tKidPop[ s ];
+    fAccumurateNumCh += fNumOfChOfPair[ s ];
+  }
+  this->GetEdgeFreq();
+}
+
+
+void* TEnvironment::RunGenerateKids( void* arg )
+{
+  TThreadArg* a = (TThreadArg*)arg;
+  a->env->GenerateKidsOfThread( a->t );
+  return NULL;
+}
+
+
+void TEnvironment::GenerateKidsOfThread( int t )
+{
+  TCross* cross = tCrossOfThread[ t ];
+  int s;
+
+  while( 1 )
+  {
+    s = __sync_fetch_and_add( &fNextPair, 1 );
+    if( s >= fNumOfPop ) 
+      break;
+
+    /* tKidPop[s] starts as a copy of the parent p_A, which is read by the (s-1)-th pair */
+    tRandOfThread[ t ].Seed( fSeedOfPair[ s ] );
+    tKidPop[ s ] = tCurPop[ fIndexForMating[ s ] ];
+    cross->SetParents( tKidPop[ s ], tCurPop[ fIndexForMating[ s+1 ] ], fFlagC, fNumOfKids );  
+    cross->DoIt( tKidPop[ s ], tCurPop[ fIndexForMating[ s+1 ] ], fNumOfKids, 1, fFlagC, fEdgeFreq );
+    fNumOfChOfPair[ s ] = cross->fNumOfGeneratedCh;
+  }
+}
+
+
+double TEnvironment::GetTime()
+{
+  /* With several threads clock() sums the CPU time of all the threads, so the wall-clock 
+     time is used instead to let the cutoff time cover the same span as a sequential run. */
+  if( fNumOfThread > 1 ){
+    struct timespec ts;
+    clock_gettime( CLOCK_MONOTONIC, &ts );
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+  }
+  return (double)clock()/(double)CLOCKS_PER_SEC;
+}
+
+
 void TEnvironment::GetEdgeFreq()
 {
   int N = fEvaluator->Ncity;
   int k0, k1;
   
-  for( int j1 = 0; j1 < N; ++j1 )
-    for( int j2 = 0; j2 < N; ++j2 ) 
-      fEdgeFreq[ j1 ][ j2 ] = 0;
+  fEdgeFreq.Clear();
 
   
   for( int i = 0; i < fNumOfPop; ++i )
@@ -265,8 +366,8 @@ void TEnvironment::GetEdgeFreq()
     {
       k0 = tCurPop[ i ].fLink[ j ][ 0 ];
       k1 = tCurPop[ i ].fLink[ j ][ 1 ];
-      ++fEdgeFreq[ j ][ k0 ];
-      ++fEdgeFreq[ j ][ k1 ];
+      fEdgeFreq.Inc( j, k0 );
+      fEdgeFreq.Inc( j, k1 );
     }
   }
 }
@@ -292,8 +393,8 @@ void TEnvironment::PrintOn( int n, char* dstFile )
 	   n, 
 	   tBest.fEvaluationValue, 
 	   fCurNumOfGen, 
-	   (int)((double)(this->fTimeInit - this->fTimeStart)/(double)CLOCKS_PER_SEC), 
-	   (int)((double)(this->fTimeEnd - this->fTimeStart)/(double)CLOCKS_PER_SEC) );
+	   (int)(this->fTimeInit - this->fTimeStart), 
+	   (int)(this->fTimeEnd - this->fTimeStart) );
   
   fclose( fp );
 }
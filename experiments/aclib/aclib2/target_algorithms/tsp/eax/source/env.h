@@ -26,6 +26,7 @@
 #include <assert.h>
 #include <string.h>
 #include <time.h>
+#include <pthread.h>
 
 class TEnvironment {
 public:
@@ -43,6 +44,11 @@ public:
   void SelectForSurvival( int s );       /* Not do anything */
   void GenerateKids( int s );            /* Generate offspring solutions from a selected pair of  
                                             parents. Selection for survival is also performed here. */
+  void GenerateKidsParallel();           /* Generate offspring solutions from all the pairs of parents 
+                                            with fNumOfThread threads */
+  void GenerateKidsOfThread( int t );    /* Work of the t-th thread in GenerateKidsParallel() */
+  static void* RunGenerateKids( void* arg ); /* Entry point of the threads */
+  double GetTime();                      /* CPU time in seconds (wall-clock time with several threads) */
   void GetEdgeFreq();                    /* Compute the frequency of the edges of the population */
 
   void PrintOn( int n, char* dstFile );  /* Display and write summary of results */
@@ -67,7 +73,7 @@ public:
                                             solution was found */ 
   long int fBestAccumeratedNumCh;        /* The accumulated number of offspring solutions at which 
                                             the current best solution was found */
-  int **fEdgeFreq;                       /* The frequency of the edges of the population */
+  TEdgeFreq fEdgeFreq;                   /* The frequency of the edges of the population */
   double fAverageValue;                  /* The average tour lengths of the population */
   int fBestValue;                        /* The tour lenght of the best tour in the population */
   int fBestValueOverall;                 /* The tour lenght of the best tour in the population (across several soft restarts) */
@@ -76,6 +82,15 @@ public:
   int fBestIndex;                        /* Index of the best population member */
   int* fIndexForMating;                  /* Mating list (r[] in the paper) */
 
+  int fNumOfThread;                      /* Number of threads generating offspring solutions */
+  TCross** tCrossOfThread;               /* EAX workspace of each thread */
+  TRandom* tRandOfThread;                /* Random number sequence of each thread */
+  TIndi* tKidPop;                        /* tKidPop[s]: best offspring solution of the s-th pair */
+  int* fSeedOfPair;                      /* fSeedOfPair[s]: random seed of the s-th pair */
+  int* fNumOfChOfPair;                   /* fNumOfChOfPair[s]: number of offspring solutions 
+                                            generated from the s-th pair */
+  int fNextPair;                         /* Next pair to be processed by a thread */
+
   int fStagBest;                         /* The number of generations during which no improvement  
                                             is found in the best tour */
   int fFlagC[ 10 ];                      /* Specify configurations of EAX and selection strategy */
@@ -90,7 +105,7 @@ public:
 	int noFurtherRestarts;							/* flag indicating when no further restarts should be performed */
 // hh end
 
-  clock_t fTimeStart, fTimeInit, fTimeEnd;  /* Use them to measure the execution time */
+  double fTimeStart, fTimeInit, fTimeEnd;   /* Use them to measure the execution time (in seconds) */
 };
 
 
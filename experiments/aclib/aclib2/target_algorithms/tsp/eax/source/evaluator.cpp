@@ -2,19 +2,27 @@
 #include "evaluator.h"
 #endif
 
+#include <algorithm>
+#include <unistd.h>
+
 TEvaluator::TEvaluator()
 {
   fEdgeDis = NULL;
   fNearCity = NULL;
   Ncity = 0;
   fNearNumMax = 50;  
+  fMaxNcityForEdgeDis = 8000;
+  fDisType = 0;
+  fFlagNearCache = 0;
 }
 
 TEvaluator::~TEvaluator()
 {
-  for ( int i = 0; i < Ncity; ++i ) 
-    delete[] fEdgeDis[ i ];
-  delete[] fEdgeDis;
+  if( fEdgeDis != NULL ){
+    for ( int i = 0; i < Ncity; ++i ) 
+      delete[] fEdgeDis[ i ];
+    delete[] fEdgeDis;
+  }
   for ( int i = 0; i < Ncity; ++i ) 
     delete[] fNearCity[ i ];
   delete[] fNearCity;
@@ -62,7 +70,6 @@ void TEvaluator::SetInstance( char filename[] )
 
   x = new double [ Ncity ]; 
   y = new double [ Ncity ]; 
-  int checkedN[ Ncity ];
 
   int xi, yi; 
   for( int i = 0; i < Ncity; ++i ) 
@@ -78,8 +85,6 @@ void TEvaluator::SetInstance( char filename[] )
   fclose(fp);
   //////////////////////////
 
-  fEdgeDis = new int* [ Ncity ];
-  for( int i = 0; i < Ncity; ++i ) fEdgeDis[ i ] = new int [ Ncity ];
   fNearCity = new int* [ Ncity ];
   for( int i = 0; i < Ncity; ++i ) fNearCity[ i ] = new int [ fNearNumMax+1 ];
 
@@ -116,66 +121,231 @@ void TEvaluator::SetInstance( char filename[] )
   ////////////////////////////////////////////////////
 
 
-  if( strcmp( type, "EUC_2D" ) == 0  ) {
-    for( int i = 0; i < Ncity ; ++i )
-    {
-      for( int j = 0; j < Ncity ; ++j )
-      {
-	fEdgeDis[ i ][ j ]=(int)(sqrt((x[i]-x[j])*(x[i]-x[j])+(y[i]-y[j])*(y[i]-y[j]))+0.5);
-      }
-    }
-  }
-  else if( strcmp( type, "ATT" ) == 0  ) { 
-    for( int i = 0; i < Ncity; ++i )
-    {
-      for( int j = 0; j < Ncity; ++j ) 
-      {
-	double r = (sqrt(((x[i]-x[j])*(x[i]-x[j])+(y[i]-y[j])*(y[i]-y[j]))/10.0));
-	int t = (int)r;
-	if( (double)t < r ) fEdgeDis[ i ][ j ] = t+1;
-	else fEdgeDis[ i ][ j ] = t; 
-      }
-    }
+  if( strcmp( type, "EUC_2D" ) == 0  ) 
+    fDisType = 0;
+  else if( strcmp( type, "ATT" ) == 0  ) 
+    fDisType = 1;
+  else if( strcmp( type, "CEIL_2D" ) == 0  ) 
+    fDisType = 2;
+  else{
+    printf( "EDGE_WEIGHT_TYPE is not supported\n" );
+    exit( 1 );
   }
-  else if( strcmp( type, "CEIL_2D" ) == 0  ) {  
+
+  /* The full distance matrix is only stored for small instances. Otherwise the 
+     distances are computed from the coordinates on demand (see Direct()). */
+  if( Ncity <= fMaxNcityForEdgeDis ){
+    fEdgeDis = new int* [ Ncity ];
+    for( int i = 0; i < Ncity; ++i ) fEdgeDis[ i ] = new int [ Ncity ];
     for( int i = 0; i < Ncity ; ++i )
     {
-      for( int j = 0; j < Ncity ; ++j )
-      {
-	fEdgeDis[ i ][ j ]=(int)ceil(sqrt((x[i]-x[j])*(x[i]-x[j])+(y[i]-y[j])*(y[i]-y[j])));
-      }
+      fEdgeDis[ i ][ i ] = this->CalDis( i, i );
+      for( int j = 0; j < i ; ++j )
+	fEdgeDis[ i ][ j ] = fEdgeDis[ j ][ i ] = this->CalDis( i, j );
     }
   }
-  else{
-    printf( "EDGE_WEIGHT_TYPE is not supported\n" );
-    exit( 1 );
+
+  /* The neighbor lists depend on the instance only. With fFlagNearCache they are read from 
+     <instance>.near if it was written for the same instance, and written there otherwise. */
+  char cacheName[ strlen( filename ) + 8 ];
+  sprintf( cacheName, "%s.near", filename );
+  if( fFlagNearCache == 0 || this->ReadNearCity( cacheName ) == false ){
+    this->SetNearCity();
+    if( fFlagNearCache == 1 )
+      this->WriteNearCity( cacheName );
+  }
+}
+
+
+class TNearCmp {
+public:
+  TNearCmp( const int* dis ) : fDis( dis ) {}
+  bool operator()( int a, int b ) const {  /* Shorter first, ties broken by the larger index */
+    if( fDis[ a ] != fDis[ b ] ) return fDis[ a ] < fDis[ b ];
+    return a > b;
   }
+  const int* fDis;
+};
 
-  int ci;
-  int j1 ,j2 ,j3;
-  int city_num = 0;
-  int min_dis;
 
-  for( ci = 0; ci < Ncity; ++ci )
+void TEvaluator::SetNearCity()
+{
+  /* The cities are bucketed into a uniform grid with about two cities per cell. 
+     For each city the surrounding cells are scanned ring by ring until no city 
+     outside the scanned rings can be as near as the current fNearNumMax-th nearest 
+     one. The candidates are ordered by distance with ties broken by the larger 
+     index, which gives the same lists as a selection over all the cities. */
+  double minX = x[ 0 ], maxX = x[ 0 ], minY = y[ 0 ], maxY = y[ 0 ];
+  for( int i = 1; i < Ncity; ++i ){
+    if( x[ i ] < minX ) minX = x[ i ];
+    if( x[ i ] > maxX ) maxX = x[ i ];
+    if( y[ i ] < minY ) minY = y[ i ];
+    if( y[ i ] > maxY ) maxY = y[ i ];
+  }
+  double w = maxX - minX, h = maxY - minY;
+  double side = sqrt( 2.0 * w * h / Ncity );
+  if( side < 2.0 * w / Ncity ) side = 2.0 * w / Ncity;
+  if( side < 2.0 * h / Ncity ) side = 2.0 * h / Ncity;
+  if( side <= 0.0 ) side = 1.0;
+  int nx = (int)( w / side ) + 1;
+  int ny = (int)( h / side ) + 1;
+
+  int* cellX = new int [ Ncity ];
+  int* cellY = new int [ Ncity ];
+  int* cellStart = new int [ nx*ny+1 ];
+  int* cellCity = new int [ Ncity ];
+  for( int c = 0; c <= nx*ny; ++c ) cellStart[ c ] = 0;
+  for( int i = 0; i < Ncity; ++i ){
+    cellX[ i ] = std::min( (int)( ( x[ i ] - minX ) / side ), nx-1 );
+    cellY[ i ] = std::min( (int)( ( y[ i ] - minY ) / side ), ny-1 );
+    ++cellStart[ cellY[ i ]*nx + cellX[ i ] + 1 ];
+  }
+  for( int c = 0; c < nx*ny; ++c ) cellStart[ c+1 ] += cellStart[ c ];
+  for( int i = 0; i < Ncity; ++i ){
+    int c = cellY[ i ]*nx + cellX[ i ];
+    cellCity[ cellStart[ c ]++ ] = i;
+  }
+  for( int c = nx*ny; c > 0; --c ) cellStart[ c ] = cellStart[ c-1 ];
+  cellStart[ 0 ] = 0;
+
+  /* Upper bound of the Euclidean length of an edge of distance d plus one */
+  double scale = ( fDisType == 1 ) ? sqrt( 10.0 ) : 1.0;
+  int numNear = std::min( fNearNumMax, Ncity-1 );
+  int* dis = new int [ Ncity ];
+  int* cand = new int [ Ncity ];
+  int* kth = new int [ Ncity ];
+  int numCand;
+
+  for( int ci = 0; ci < Ncity; ++ci )
   {
-    for( j3 = 0; j3 < Ncity; ++j3 ) checkedN[ j3 ] = 0;
-    checkedN[ ci ] = 1;
-    fNearCity[ ci ][ 0 ] = ci;
-    for( j1 = 1; j1 <= fNearNumMax; ++j1 ) 
+    numCand = 0;
+    for( int r = 0; numNear > 0; ++r )
     {
-      min_dis = 100000000;
-      for( j2 = 0; j2 < Ncity; ++j2 )
-      { 
-	if( fEdgeDis[ ci ][ j2 ] <= min_dis && checkedN[ j2 ] == 0 )
+      for( int cy = cellY[ ci ]-r; cy <= cellY[ ci ]+r; ++cy )
+      {
+	if( cy < 0 || cy >= ny ) continue;
+	int step = ( cy == cellY[ ci ]-r || cy == cellY[ ci ]+r ) ? 1 : 2*r;
+	for( int cx = cellX[ ci ]-r; cx <= cellX[ ci ]+r; cx += step )
 	{
-	  city_num = j2;
-          min_dis = fEdgeDis[ ci ][ j2 ];
+	  if( cx < 0 || cx >= nx ) continue;
+	  int c = cy*nx + cx;
+	  for( int k = cellStart[ c ]; k < cellStart[ c+1 ]; ++k )
+	  {
+	    int j = cellCity[ k ];
+	    if( j == ci ) continue;
+	    dis[ j ] = this->Direct( ci, j );
+	    cand[ numCand++ ] = j;
+	  }
 	}
       }
-      fNearCity[ ci ][ j1 ] = city_num;
-      checkedN[ city_num ] = 1;
+
+      if( r >= nx && r >= ny ) break;
+      if( numCand >= numNear ){
+	for( int k = 0; k < numCand; ++k ) kth[ k ] = dis[ cand[ k ] ];
+	std::nth_element( kth, kth + numNear-1, kth + numCand );
+	if( r * side > ( kth[ numNear-1 ] + 1 ) * scale ) break;
+      }
     }
+
+    std::sort( cand, cand + numCand, TNearCmp( dis ) );
+    fNearCity[ ci ][ 0 ] = ci;
+    for( int j1 = 1; j1 <= fNearNumMax; ++j1 ) 
+      fNearCity[ ci ][ j1 ] = ( j1 <= numNear ) ? cand[ j1-1 ] : fNearCity[ ci ][ j1-1 ];
+  }
+
+  delete [] cellX;
+  delete [] cellY;
+  delete [] cellStart;
+  delete [] cellCity;
+  delete [] dis;
+  delete [] cand;
+  delete [] kth;
+}
+
+
+unsigned long long TEvaluator::HashInstance()
+{
+  /* FNV-1a over the coordinates */
+  unsigned long long h = 14695981039346656037ULL;
+  const unsigned char* p;
+  for( int i = 0; i < Ncity; ++i ){
+    p = (const unsigned char*)&x[ i ];
+    for( int b = 0; b < (int)sizeof( double ); ++b ) h = ( h ^ p[ b ] ) * 1099511628211ULL;
+    p = (const unsigned char*)&y[ i ];
+    for( int b = 0; b < (int)sizeof( double ); ++b ) h = ( h ^ p[ b ] ) * 1099511628211ULL;
   }
+  return ( h ^ (unsigned long long)fDisType ) * 1099511628211ULL;
+}
+
+
+/* The cache file is a flat binary file: a header of four ints (a magic number, Ncity, 
+   fNearNumMax and fDisType) and the hash of the instance, followed by the rows 
+   fNearCity[i][0..fNearNumMax] of all the cities. */
+static const int NEAR_CACHE_MAGIC = 0x4e584145;  
+
+bool TEvaluator::ReadNearCity( char filename[] )
+{
+  FILE* fp;
+  int head[ 4 ];
+  unsigned long long hash;
+
+  fp = fopen( filename, "rb" );
+  if( fp == NULL )
+    return false;
+
+  if( fread( head, sizeof( int ), 4, fp ) != 4 || fread( &hash, sizeof( hash ), 1, fp ) != 1 ||
+      head[ 0 ] != NEAR_CACHE_MAGIC || head[ 1 ] != Ncity || head[ 2 ] != fNearNumMax || 
+      head[ 3 ] != fDisType || hash != this->HashInstance() ){
+    fclose( fp );
+    return false;
+  }
+
+  for( int i = 0; i < Ncity; ++i ){
+    if( fread( fNearCity[ i ], sizeof( int ), fNearNumMax+1, fp ) != (size_t)( fNearNumMax+1 ) ){
+      fclose( fp );
+      return false;
+    }
+    /* A corrupt file must not put invalid cities into fNearCity[][] (row i starts with i) */
+    bool valid = ( fNearCity[ i ][ 0 ] == i );
+    for( int k = 1; valid && k <= fNearNumMax; ++k )
+      valid = ( fNearCity[ i ][ k ] >= 0 && fNearCity[ i ][ k ] < Ncity );
+    if( valid == false ){
+      fclose( fp );
+      return false;
+    }
+  }
+  fclose( fp );
+  return true;
+}
+
+
+void TEvaluator::WriteNearCity( char filename[] )
+{
+  FILE* fp;
+  int head[ 4 ];
+  unsigned long long hash;
+  bool ok;
+
+  /* Written to a temporary file and renamed so that concurrent runs never read a partial file */
+  char tmpName[ strlen( filename ) + 24 ];
+  sprintf( tmpName, "%s.%d", filename, (int)getpid() );
+  fp = fopen( tmpName, "wb" );
+  if( fp == NULL )
+    return;
+
+  head[ 0 ] = NEAR_CACHE_MAGIC;
+  head[ 1 ] = Ncity;
+  head[ 2 ] = fNearNumMax;
+  head[ 3 ] = fDisType;
+  hash = this->HashInstance();
+  ok = ( fwrite( head, sizeof( int ), 4, fp ) == 4 && fwrite( &hash, sizeof( hash ), 1, fp ) == 1 );
+  for( int i = 0; ok && i < Ncity; ++i )
+    ok = ( fwrite( fNearCity[ i ], sizeof( int ), fNearNumMax+1, fp ) == (size_t)( fNearNumMax+1 ) );
+  if( fclose( fp ) != 0 ) 
+    ok = false;
+
+  if( ok == false || rename( tmpName, filename ) != 0 )
+    remove( tmpName );
 }
 
 
@@ -185,8 +355,8 @@ void TEvaluator::DoIt( TIndi& indi )
   d = 0;  
   for( int i = 0; i < Ncity; ++i )
   {  
-    d = d + fEdgeDis[ i ][ indi.fLink[i][0] ];
-    d = d + fEdgeDis[ i ][ indi.fLink[i][1] ];
+    d = d + this->Direct( i, indi.fLink[i][0] );
+    d = d + this->Direct( i, indi.fLink[i][1] );
   }
   indi.fEvaluationValue = d/2;
 }
@@ -293,9 +463,9 @@ bool TEvaluator::CheckValid( int* array, int value )
     
   distance = 0;  
   for( int i = 0; i < Ncity-1; ++i ){
-    distance += fEdgeDis[ array[ i ]-1 ][ array[ i+1 ]-1 ];
+    distance += this->Direct( array[ i ]-1, array[ i+1 ]-1 );
   }
-  distance += fEdgeDis[ array[ Ncity-1 ]-1 ][ array[ 0 ]-1 ];
+  distance += this->Direct( array[ Ncity-1 ]-1, array[ 0 ]-1 );
   if( distance != value ){
     return false;
   }
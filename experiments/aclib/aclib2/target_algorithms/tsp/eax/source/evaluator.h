@@ -8,6 +8,7 @@
 
 #include <string.h>
 #include <assert.h>
+#include <math.h>
 
 class TEvaluator {
  public:
@@ -18,10 +19,38 @@ class TEvaluator {
   void WriteTo( FILE* fp, TIndi& indi );     /* Write an tour */
   bool ReadFrom( FILE* fp, TIndi& indi );    /* Read an tour */
   bool CheckValid( int* array, int value ); /* Check an tour */ 
+  void SetNearCity();                        /* Set fNearCity[][] */
+  bool ReadNearCity( char filename[] );      /* Read fNearCity[][] from a cache file */
+  void WriteNearCity( char filename[] );     /* Write fNearCity[][] to a cache file */
+  unsigned long long HashInstance();         /* Hash of the coordinates and the distance type */
+
+  int Direct( int i, int j )                 /* Distance between i and j */
+  {
+    if( fEdgeDis != NULL )
+      return fEdgeDis[ i ][ j ];
+    return this->CalDis( i, j );
+  }
+
+  int CalDis( int i, int j )                 /* Compute the distance between i and j 
+                                                from the coordinates */
+  {
+    double d = (x[i]-x[j])*(x[i]-x[j])+(y[i]-y[j])*(y[i]-y[j]);
+    if( fDisType == 1 ){
+      double r = sqrt( d/10.0 );
+      int t = (int)r;
+      return ( (double)t < r ) ? t+1 : t;
+    }
+    else if( fDisType == 2 )
+      return (int)ceil( sqrt( d ) );
+    return (int)( sqrt( d )+0.5 );
+  }
 
   int fNearNumMax;  /* Maximum number of k (see below) */
   int **fNearCity;  /* NearCity[i][k]: k-th nearest city from */
-  int  **fEdgeDis;  /* EdgeDis[i][j]: distance between i and j */
+  int  **fEdgeDis;  /* EdgeDis[i][j]: distance between i and j (NULL if Ncity > fMaxNcityForEdgeDis) */
+  int fMaxNcityForEdgeDis; /* Largest instance for which fEdgeDis[][] is stored */
+  int fDisType;     /* 0: EUC_2D, 1: ATT, 2: CEIL_2D */
+  int fFlagNearCache; /* 1: fNearCity[][] is cached in the file <instance>.near */
   int Ncity;        /* Number of cities */
   double *x;        /* x[i]: x-coordinate of */
   double *y;        /* y[i]: x-coordinate of */
@@ -222,11 +222,11 @@ LLL1: t1_st = rand()%fN;
     {
       fT[4] = eval->fNearCity[ fT[1] ][ num1 ]; 
       fT[3] = this->GetPrev( fT[4] );
-      dis1 = eval->fEdgeDis[fT[1]][fT[2]] - eval->fEdgeDis[fT[1]][fT[4]];
+      dis1 = eval->Direct( fT[1], fT[2] ) - eval->Direct( fT[1], fT[4] );
 
       if( dis1 > 0 ){
 	dis2 = dis1 + 
-               eval->fEdgeDis[fT[3]][fT[4]] - eval->fEdgeDis[fT[3]][fT[2]];
+               eval->Direct( fT[3], fT[4] ) - eval->Direct( fT[3], fT[2] );
  
 	if( dis2 > 0 ){
 	  this->IncrementImp( fFlagRev );
@@ -248,11 +248,11 @@ LLL1: t1_st = rand()%fN;
     {
       fT[4] = eval->fNearCity[ fT[1] ][ num1 ]; 
       fT[3] = this->GetNext( fT[4] );
-      dis1 = eval->fEdgeDis[fT[1]][fT[2]] - eval->fEdgeDis[fT[1]][fT[4]];
+      dis1 = eval->Direct( fT[1], fT[2] ) - eval->Direct( fT[1], fT[4] );
 
       if( dis1 > 0 ){
 	dis2 = dis1 + 
-               eval->fEdgeDis[fT[3]][fT[4]] - eval->fEdgeDis[fT[3]][fT[2]];
+               eval->Direct( fT[3], fT[4] ) - eval->Direct( fT[3], fT[2] );
  
 	if( dis2 > 0 ){
 	  this->IncrementImp( fFlagRev );
@@ -37,9 +37,18 @@ int main( int argc, char* argv[] )
 	srand( d );
 
   gEnv->fFileNameInitPop = NULL;
-  if( argc == 10 )
+  if( argc >= 10 && strcmp( argv[9], "-" ) != 0 )
     gEnv->fFileNameInitPop = argv[9];
 // hh end
+  if( argc >= 11 ){
+    sscanf( argv[10], "%d", &d );  /* Number of threads ("-" as argv[9] for no initial population) */
+    if( d > 1 )
+      gEnv->fNumOfThread = d;
+  }
+  if( argc >= 12 ){
+    sscanf( argv[11], "%d", &d );  /* 1: cache the neighbor lists in <instance>.near */
+    gEnv->fEvaluator->fFlagNearCache = ( d == 1 ) ? 1 : 0;
+  }
 
   gEnv->Define();
   
@@ -42,6 +42,7 @@ void InitURandom( int dd )
 
 TRandom::TRandom()
 {
+  fFlagOwn = 0;
 }
 
 
@@ -50,15 +51,34 @@ TRandom::~TRandom()
 }
 
 
+void TRandom::Seed( int seed )
+{
+  fFlagOwn = 1;
+  fXsubi[ 0 ] = 0x330E;
+  fXsubi[ 1 ] = (unsigned short)( seed & 0xFFFF );
+  fXsubi[ 2 ] = (unsigned short)( ( seed >> 16 ) & 0xFFFF );
+}
+
+
+int TRandom::Rand()
+{
+  if( fFlagOwn == 1 )
+    return (int)nrand48( fXsubi );
+  return rand();
+}
+
+
 int TRandom::Integer( int minNumber, int maxNumber )
 {
-  return minNumber + (int)(drand48() * (double)(maxNumber - minNumber + 1));
+  double r = ( fFlagOwn == 1 ) ? erand48( fXsubi ) : drand48();
+  return minNumber + (int)(r * (double)(maxNumber - minNumber + 1));
 }
 
 
 double TRandom::Double( double minNumber, double maxNumber )
 {
-  return minNumber + drand48() * (maxNumber - minNumber);
+  double r = ( fFlagOwn == 1 ) ? erand48( fXsubi ) : drand48();
+  return minNumber + r * (maxNumber - minNumber);
 }
 
 
@@ -75,7 +95,7 @@ void TRandom::Permutation( int *array, int numOfElement, int numOfSample )
   for(j=0;j<numOfElement;j++) b[j]=0;
   for(i=0;i<numOfSample;i++)
   {  
-    r=rand()%(numOfElement-i);
+    r=this->Rand()%(numOfElement-i);
     k=0;
     for(j=0;j<=r;j++)
     {
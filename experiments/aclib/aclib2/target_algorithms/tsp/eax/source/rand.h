@@ -13,11 +13,18 @@ class TRandom {
  public:
   TRandom();
   ~TRandom();
+  void Seed( int seed );             /* Use an own random number sequence instead of 
+                                        the global one of rand() and drand48() */
+  int Rand();                        /* Same as rand() */
   int Integer( int minNumber, int maxNumber ); 
   double Double( double minNumber, double maxNumber );
   void Permutation( int *array, int numOfelement, int numOfSample );
   double NormalDistribution( double mu, double sigma );
   void Shuffle( int *array, int numOfElement );
+
+ private:
+  int fFlagOwn;                      /* 1 if fXsubi[] is used */
+  unsigned short fXsubi[ 3 ];        /* State of the own sequence */
 };
 
 extern TRandom* tRand;